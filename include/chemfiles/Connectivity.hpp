@@ -10,6 +10,7 @@
 
 #include "chemfiles/sorted_set.hpp"
 #include "chemfiles/exports.h"
+#include "chemfiles/external/span.hpp"
 
 namespace chemfiles {
 
@@ -294,9 +295,9 @@ inline bool operator>=(const Improper& lhs, const Improper& rhs) {
 }
 
 /// The connectivity struct store a cache of the bonds, angles and dihedrals
-/// in the system. The `recalculate` function should be called when bonds are
-/// added or removed. The `bonds` set is the main source of information, all the
-/// other data are cached from it.
+/// in the system. The `bonds` set is the main source of information, all the
+/// other data are cached from it, and lazily recomputed when accessed after
+/// bonds are added or removed.
 class Connectivity final {
 public:
     Connectivity() = default;
@@ -319,20 +320,39 @@ public:
     /// Add a bond between the atoms `i` and `j`
     void add_bond(size_t i, size_t j, Bond::BondOrder bond_order = Bond::UNKNOWN);
 
+    /// Add all the `bonds` at once, with the corresponding `bond_orders`. If
+    /// `bond_orders` is empty, all the new bonds get an `Bond::UNKNOWN` bond
+    /// order. Bonds already present in this connectivity and duplicated bonds
+    /// keep the first bond order they were added with, as with `add_bond`.
+    ///
+    /// This sorts the new bonds and merges them with the existing ones, and
+    /// is much faster than calling `add_bond` for each bond.
+    ///
+    /// @throws Error if `bond_orders` is not empty and does not have the same
+    ///               size as `bonds`
+    void add_bonds(const std::vector<Bond>& bonds, const std::vector<Bond::BondOrder>& bond_orders);
+
+    /// Get the indexes of all the atoms bonded to the atom at `index`,
+    /// sorted in increasing order. The returned span is invalidated when
+    /// adding or removing bonds.
+    span<const size_t> bonded_atoms(size_t index) const;
+
     /// Remove any bond between the atoms `i` and `j`
     void remove_bond(size_t i, size_t j);
 
-    /// Update the indexes of the bonds after atom removal
-    ///
-    /// This function shifts all indexes bigger than `index` in the
-    /// bonds/angles/dihedrals/impropers lists by -1.
-    void atom_removed(size_t index);
-
     /// Get the bond order of the bond between i and j
     Bond::BondOrder bond_order(size_t i, size_t j) const;
 private:
-    /// Recalculate the angles and the dihedrals from the bond list
-    void recalculate() const;
+    /// Recalculate the angles from the bond list
+    void recalculate_angles() const;
+    /// Recalculate the dihedral angles from the bond list
+    void recalculate_dihedrals() const;
+    /// Recalculate the improper dihedral angles from the bond list
+    void recalculate_impropers() const;
+    /// Recalculate the compressed sparse row adjacency from the bond list
+    void recalculate_neighbors() const;
+    /// Mark all the data cached from the bond list as outdated
+    void invalidate_cache();
 
     /// Biggest index within the atoms we know about. Used to pre-allocate
     /// memory when recomputing bonds.
@@ -345,8 +365,20 @@ private:
     mutable sorted_set<Dihedral> dihedrals_;
     /// Improper dihedral angles in the system
     mutable sorted_set<Improper> impropers_;
-    /// Is the cached content up to date ?
-    mutable bool uptodate_ = false;
+    /// Are the angles up to date?
+    mutable bool angles_uptodate_ = false;
+    /// Are the dihedral angles up to date?
+    mutable bool dihedrals_uptodate_ = false;
+    /// Are the improper dihedral angles up to date?
+    mutable bool impropers_uptodate_ = false;
+    /// Atoms bonded to each atom, in compressed sparse row format: the
+    /// atoms bonded to atom `i` are stored in `neighbors_` between
+    /// `neighbors_offsets_[i]` and `neighbors_offsets_[i + 1]`
+    mutable std::vector<size_t> neighbors_;
+    /// Offsets of the first neighbor of each atom in `neighbors_`
+    mutable std::vector<size_t> neighbors_offsets_;
+    /// Are `neighbors_` and `neighbors_offsets_` up to date?
+    mutable bool neighbors_uptodate_ = false;
     /// Store the bond orders
     std::vector<Bond::BondOrder> bond_orders_;
 };
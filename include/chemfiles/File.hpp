@@ -143,6 +143,7 @@ public:
     /// compressed file.
     TextFile(std::shared_ptr<MemoryBuffer> memory, File::Mode mode, File::Compression compression);
 
+    ~TextFile() override;
     TextFile(TextFile&&) = default;
     TextFile& operator=(TextFile&&) = default;
     TextFile(const TextFile&) = delete;
@@ -173,6 +174,15 @@ public:
     /// string using `string_view::to_string()`.
     string_view readline();
 
+    /// Read the next `count` lines from the file. All the returned
+    /// `string_view` point into an internal buffer, which is grown as needed
+    /// to contain all of the lines at once. They can be invalidated after
+    /// another call to `readline` or `readlines`.
+    ///
+    /// If the end of file is reached before reading `count` lines, the
+    /// returned vector contains less than `count` lines.
+    std::vector<string_view> readlines(size_t count);
+
     /// Read the full file into an owned string. This is a convenience method
     /// for format that need the full file read before parsing can start.
     std::string readall();
@@ -180,18 +190,46 @@ public:
     /// Format and write some data to the file using the `fmt` library.
     ///
     /// This function has the same interface as `fmt::print(...)`, writting data
-    /// to the file instead of stdout.
+    /// to the file instead of stdout. The data is formatted into an internal
+    /// buffer, and only written to the underlying `TextFileImpl` when the
+    /// buffer is full or when calling `flush`.
     template <typename Str, typename... Args>
     void print(const Str& format, const Args&... args) {
         this->vprint(format, fmt::make_format_args(args...));
     }
 
+    /// Write `value` to the file, right-aligned in `width` characters and
+    /// with `precision` digits after the decimal point. This produces the
+    /// same output as `print("{:{width}.{precision}f}", value)`, but does not
+    /// go through fmt's generic float formatting for usual values.
+    void print_fixed(double value, unsigned width, unsigned precision);
+
+    /// Write `value` to the file, producing the same output as
+    /// `print("{:g}", value)` without going through fmt's generic float
+    /// formatting for usual values.
+    void print_general(double value);
+
+    /// Write `count` characters starting at `data` to the file, after all the
+    /// data from previous calls to `print`.
+    ///
+    /// @throws FileError if it could not write all of the data to the file
+    void write(const char* data, size_t count);
+
+    /// Write all the data from previous calls to `print` to the underlying
+    /// `TextFileImpl`.
+    ///
+    /// @throws FileError if it could not write all of the data to the file
+    void flush();
+
 private:
     /// Fill the buffer, calling `refill` and setting all needed internal values
     void fill_buffer(size_t start);
 
     /// Actually format and print data to the file
     void vprint(fmt::string_view format, fmt::format_args args);
+    /// Add `count` already formatted characters starting at `data` to the
+    /// write buffer
+    void print_buffered(const char* data, size_t count);
 
     /// Check if the buffer was initialized and contains data from the
     /// underlying  `TextFileImpl`.
@@ -216,6 +254,9 @@ private:
     bool got_impl_eof_ = false;
     /// Did we actually reached the end of file while reading a line?
     bool eof_ = false;
+    /// Buffer storing formatted data waiting to be written to the
+    /// `TextFileImpl`
+    fmt::memory_buffer write_buffer_;
 };
 
 } // namespace chemfiles
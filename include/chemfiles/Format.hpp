@@ -95,6 +95,35 @@ public:
     ///
     /// @return The number of frames
     virtual size_t nsteps() = 0;
+
+    /// Only read the atoms at the given `indices` in the next calls to `read`
+    /// and `read_step`. The `indices` are sorted and do not contain
+    /// duplicated values. An empty `indices` vector means that all atoms
+    /// should be read again.
+    ///
+    /// Formats able to skip the data for the other atoms while decoding a
+    /// step should override this function and return `true`. The frames
+    /// filled by this format must then only contain the requested atoms, in
+    /// the same order as `indices`. The default implementation returns
+    /// `false`, in which case the `Trajectory` will extract the atoms from the
+    /// full frame after reading it.
+    ///
+    /// @throw FormatError if some of the `indices` are known to be out of
+    ///                    bounds for this file.
+    ///
+    /// @param indices The indices of the atoms to read
+    /// @return Whether this format will only decode the requested atoms
+    virtual bool set_atom_subset(std::vector<size_t> indices);
+
+    /// Check if this format can write frames using single precision storage
+    /// (see `Frame::set_single_precision`) directly.
+    ///
+    /// Formats reading the positions and velocities with
+    /// `Frame::positions_f32` and `Frame::velocities_f32` in `write` should
+    /// override this function and return `true`. The default implementation
+    /// returns `false`, in which case the `Trajectory` will convert such
+    /// frames to double precision before calling `write`.
+    virtual bool write_single_precision() const;
 };
 
 /// The `TextFormat` class defines a common, simpler interface for text based
@@ -121,6 +150,18 @@ public:
     virtual void read_next(Frame& frame);
     virtual void write_next(const Frame& frame);
 
+    /// Check if the data written by `write_next` for a frame only depends on
+    /// this frame, and not on the previously written frames. If this is the
+    /// case, multiple frames can be serialized in parallel to memory with
+    /// different instances of this format, and the resulting data appended
+    /// to the file with `write_serialized`. The default implementation
+    /// returns `false`.
+    virtual bool independent_steps() const;
+
+    /// Write a full step already serialized by `write_next`, typically with
+    /// another instance of this format writing to memory.
+    void write_serialized(const char* data, size_t count);
+
 protected:
     /// Text file used to read/write data
     TextFile file_;
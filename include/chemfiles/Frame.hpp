@@ -6,6 +6,7 @@
 
 #include <string>
 #include <vector>
+#include <utility>
 
 #include "chemfiles/exports.h"
 #include "chemfiles/types.hpp"
@@ -111,16 +112,30 @@ public:
 
     /// Get the positions (in Angstroms) of the atoms in this frame.
     ///
+    /// If this frame uses single precision storage, it is converted to double
+    /// precision storage first (see `Frame::set_single_precision`).
+    ///
     /// @example{frame/positions.cpp}
     span<Vector3D> positions() {
+        if (single_precision_) {
+            set_single_precision(false);
+        }
         return positions_;
     }
 
     /// Get the positions (in Angstroms) of the atoms in this frame as a const
     /// reference
     ///
+    /// If this frame uses single precision storage, this returns a double
+    /// precision copy of the data, which is updated the first time this
+    /// function is called after the single precision data was modified.
+    ///
     /// @example{frame/positions.cpp}
     const std::vector<Vector3D>& positions() const {
+        if (single_precision_) {
+            update_double_precision_mirror();
+            return positions_mirror_;
+        }
         return positions_;
     }
 
@@ -135,8 +150,14 @@ public:
     /// Get an velocities (in Angstroms/ps) of the atoms in this frame, if this
     /// frame contains velocity data.
     ///
+    /// If this frame uses single precision storage, it is converted to double
+    /// precision storage first (see `Frame::set_single_precision`).
+    ///
     /// @example{frame/velocities.cpp}
     optional<span<Vector3D>> velocities() {
+        if (single_precision_) {
+            set_single_precision(false);
+        }
         if (velocities_) {
             return {*velocities_};
         } else {
@@ -147,8 +168,20 @@ public:
     /// Get an velocities (in Angstroms/ps) of the atoms in this frame as a
     /// const reference, if this frame contains velocity data.
     ///
+    /// If this frame uses single precision storage, this returns a double
+    /// precision copy of the data, which is updated the first time this
+    /// function is called after the single precision data was modified.
+    ///
     /// @example{frame/velocities.cpp}
     optional<const std::vector<Vector3D>&> velocities() const {
+        if (single_precision_) {
+            update_double_precision_mirror();
+            if (velocities_mirror_) {
+                return {*velocities_mirror_};
+            } else {
+                return nullopt;
+            }
+        }
         if (velocities_) {
             return {*velocities_};
         } else {
@@ -156,6 +189,121 @@ public:
         }
     }
 
+    /// Check if this frame stores its positions and velocities in single
+    /// precision.
+    ///
+    /// @example{frame/single_precision.cpp}
+    bool single_precision() const {
+        return single_precision_;
+    }
+
+    /// Set the precision used to store the positions and velocities in this
+    /// frame, converting the existing data if needed.
+    ///
+    /// Single precision storage uses half the memory of the default double
+    /// precision storage, and allows formats storing single precision data
+    /// (XTC, TRR and Amber NetCDF) to read it without conversion. The data is
+    /// then accessed with `Frame::positions_f32` and `Frame::velocities_f32`.
+    /// The non-const double precision accessors convert the frame back to
+    /// double precision storage, and the const ones return a double precision
+    /// copy of the data.
+    ///
+    /// @example{frame/single_precision.cpp}
+    void set_single_precision(bool single);
+
+    /// Get the single precision positions (in Angstroms) of the atoms in this
+    /// frame.
+    ///
+    /// The double precision copy returned by the const `Frame::positions` is
+    /// updated on the next call to it, so the returned span should not be
+    /// modified after such call.
+    ///
+    /// @throw Error if this frame does not use single precision storage
+    ///
+    /// @example{frame/single_precision.cpp}
+    span<Vector3F> positions_f32();
+
+    /// Get the single precision positions (in Angstroms) of the atoms in this
+    /// frame as a const reference.
+    ///
+    /// @throw Error if this frame does not use single precision storage
+    ///
+    /// @example{frame/single_precision.cpp}
+    const std::vector<Vector3F>& positions_f32() const;
+
+    /// Get the single precision velocities (in Angstroms/ps) of the atoms in
+    /// this frame, if this frame contains velocity data.
+    ///
+    /// @throw Error if this frame does not use single precision storage
+    ///
+    /// @example{frame/single_precision.cpp}
+    optional<span<Vector3F>> velocities_f32();
+
+    /// Get the single precision velocities (in Angstroms/ps) of the atoms in
+    /// this frame as a const reference, if this frame contains velocity data.
+    ///
+    /// @throw Error if this frame does not use single precision storage
+    ///
+    /// @example{frame/single_precision.cpp}
+    optional<const std::vector<Vector3F>&> velocities_f32() const;
+
+    /// Add a per-atom column named `name` to this frame, containing one value
+    /// of type `T` for each atom. `T` can be either `double` or `Vector3D`.
+    ///
+    /// Columns store numeric data for all the atoms of a frame (such as
+    /// forces or partial charges) in a single contiguous array, instead of
+    /// one `Property` in each atom. They are resized when adding or removing
+    /// atoms, and extracted by `Frame::subset`.
+    ///
+    /// The new values are initialized to 0. If a column with this name and
+    /// type already exists, this function returns it without modification.
+    ///
+    /// @throw Error if a column with the same name but a different type
+    ///              already exists in this frame
+    ///
+    /// @example{frame/add_column.cpp}
+    template <typename T>
+    span<T> add_column(const std::string& name);
+
+    /// Get the per-atom column with the given `name` and values of type `T`,
+    /// if it exists in this frame. `T` can be either `double` or `Vector3D`.
+    ///
+    /// If no column with the given `name` and type is found, this function
+    /// returns `nullopt`.
+    ///
+    /// @example{frame/column.cpp}
+    template <typename T>
+    optional<span<T>> column(const std::string& name);
+
+    /// Get the per-atom column with the given `name` and values of type `T`
+    /// as a const reference, if it exists in this frame. `T` can be either
+    /// `double` or `Vector3D`.
+    ///
+    /// If no column with the given `name` and type is found, this function
+    /// returns `nullopt`.
+    ///
+    /// @example{frame/column.cpp}
+    template <typename T>
+    optional<const std::vector<T>&> column(const std::string& name) const;
+
+    /// Get the kind of the values in the per-atom column with the given
+    /// `name`: either `Property::DOUBLE` or `Property::VECTOR3D`. If there
+    /// is no column with this name, this function returns `nullopt`.
+    ///
+    /// @example{frame/column.cpp}
+    optional<Property::Kind> column_kind(const std::string& name) const;
+
+    /// Get the names of all the per-atom columns in this frame, sorted in
+    /// alphabetical order.
+    ///
+    /// @example{frame/columns.cpp}
+    std::vector<std::string> columns() const;
+
+    /// Remove the per-atom column with the given `name`, if it exists.
+    ///
+    /// @example{frame/columns.cpp}
+    void remove_column(const std::string& name);
+
     /// Resize the frame to contain `size` atoms.
     ///
     /// If the new number of atoms is bigger than the old one, missing data is
@@ -190,6 +338,28 @@ public:
     /// @example{frame/remove.cpp}
     void remove(size_t i);
 
+    /// Remove all the atoms at the given `indices` in the system. This is
+    /// much faster than removing the atoms one by one.
+    ///
+    /// @throws chemfiles::OutOfBounds if any value in `indices` is bigger
+    ///         than the number of atoms in this frame
+    ///
+    /// @example{frame/remove.cpp}
+    void remove(const std::vector<size_t>& indices);
+
+    /// Get a new frame containing only the atoms at the given `indices`, in
+    /// the same order as `indices`. The unit cell, step and properties of
+    /// this frame are copied to the new frame, and the topology is extracted
+    /// with `Topology::subset`.
+    ///
+    /// @throws chemfiles::OutOfBounds if any value in `indices` is bigger
+    ///         than the number of atoms in this frame
+    /// @throws chemfiles::Error if `indices` contains the same index
+    ///         multiple times
+    ///
+    /// @example{frame/subset.cpp}
+    Frame subset(const std::vector<size_t>& indices) const;
+
     /// Get the current simulation step.
     ///
     /// The step is set by the `Trajectory` when reading a frame.
@@ -250,6 +420,21 @@ public:
         topology_.add_bond(atom_i, atom_j, bond_order);
     }
 
+    /// Add all the `bonds` in the system at once, with the corresponding
+    /// `bond_orders`. If `bond_orders` is empty, all the new bonds get an
+    /// unknown bond order.
+    ///
+    /// @example{frame/add_bonds.cpp}
+    ///
+    /// @param bonds the list of bonds to add
+    /// @param bond_orders the bond orders of the new bonds
+    /// @throws OutOfBounds if any atom in `bonds` is greater than `size()`
+    /// @throws Error if `bond_orders` is not empty and does not have the same
+    ///               size as `bonds`
+    void add_bonds(const std::vector<Bond>& bonds, const std::vector<Bond::BondOrder>& bond_orders = {}) {
+        topology_.add_bonds(bonds, bond_orders);
+    }
+
     /// Remove a bond in the system, between the atoms at index `atom_i` and
     /// `atom_j`.
     ///
@@ -381,18 +566,62 @@ private:
     Frame(const Frame&) = default;
     Frame& operator=(const Frame&) = default;
 
+    /// Type used to store per-atom columns with values of type `T`
+    template <typename T>
+    using columns_t = std::vector<std::pair<std::string, std::vector<T>>>;
+
+    /// Get the storage for the per-atom columns with values of type `T`. The
+    /// pointer is only used to select the right overload.
+    columns_t<double>& columns_storage(double*) {
+        return double_columns_;
+    }
+    const columns_t<double>& columns_storage(double*) const {
+        return double_columns_;
+    }
+    columns_t<Vector3D>& columns_storage(Vector3D*) {
+        return vector3d_columns_;
+    }
+    const columns_t<Vector3D>& columns_storage(Vector3D*) const {
+        return vector3d_columns_;
+    }
+
+    /// Update `positions_mirror_` and `velocities_mirror_` from the single
+    /// precision storage, if they are not already up to date
+    void update_double_precision_mirror() const;
+    /// Get the position of the atom at index `i`, in double precision
+    Vector3D position(size_t i) const;
+
     /// Current simulation step
     size_t step_ = 0;
-    /// Positions of the particles
+    /// Positions of the particles, empty for frames using single precision
+    /// storage
     std::vector<Vector3D> positions_;
-    /// Velocities of the particles
+    /// Velocities of the particles, always `nullopt` for frames using single
+    /// precision storage
     optional<std::vector<Vector3D>> velocities_;
+    /// Positions of the particles, for frames using single precision storage
+    std::vector<Vector3F> positions_f32_;
+    /// Velocities of the particles, for frames using single precision storage
+    optional<std::vector<Vector3F>> velocities_f32_;
+    /// Double precision copy of `positions_f32_`, for the const `positions()`
+    mutable std::vector<Vector3D> positions_mirror_;
+    /// Double precision copy of `velocities_f32_`, for the const `velocities()`
+    mutable optional<std::vector<Vector3D>> velocities_mirror_;
+    /// Are `positions_mirror_` and `velocities_mirror_` up to date with the
+    /// single precision storage?
+    mutable bool mirror_uptodate_ = false;
+    /// Does this frame use single precision storage?
+    bool single_precision_ = false;
     /// Topology of the described system
     Topology topology_;
     /// Unit cell of the system
     UnitCell cell_;
     /// Properties stored in this frame
     property_map properties_;
+    /// Per-atom columns with scalar values
+    columns_t<double> double_columns_;
+    /// Per-atom columns with vector values
+    columns_t<Vector3D> vector3d_columns_;
 };
 
 } // namespace chemfiles
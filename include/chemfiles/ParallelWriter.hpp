@@ -0,0 +1,109 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#ifndef CHEMFILES_PARALLEL_WRITER_HPP
+#define CHEMFILES_PARALLEL_WRITER_HPP
+
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <condition_variable>
+
+#include "chemfiles/Frame.hpp"
+#include "chemfiles/Format.hpp"
+#include "chemfiles/FormatFactory.hpp"
+
+namespace chemfiles {
+
+/// Pipelined writer for text formats with independent steps (see
+/// `TextFormat::independent_steps`).
+///
+/// Frames are serialized to memory in parallel by a pool of worker threads,
+/// each one using a separate instance of the format. The resulting data is
+/// then appended in order to the output format by a single writer thread. At
+/// most `2 * threads` frames are kept in memory at any given time, and
+/// `ParallelWriter::write` blocks until there is space for a new frame.
+class ParallelWriter final {
+public:
+    /// Create a new `ParallelWriter` using `threads` workers, each one
+    /// serializing frames with a format created by `creator`; and appending
+    /// the resulting data to `output`. The `output` must stay alive as long
+    /// as this `ParallelWriter`.
+    ParallelWriter(TextFormat& output, memory_stream_t creator, size_t threads);
+    ~ParallelWriter();
+
+    ParallelWriter(const ParallelWriter&) = delete;
+    ParallelWriter& operator=(const ParallelWriter&) = delete;
+    ParallelWriter(ParallelWriter&&) = delete;
+    ParallelWriter& operator=(ParallelWriter&&) = delete;
+
+    /// Queue the `frame` for writing, waiting for space in the queue if
+    /// needed.
+    ///
+    /// @throws Error if an error occurred while serializing or writing a
+    ///               previous frame
+    void write(Frame frame);
+
+    /// Wait for all queued frames to be written to the output format.
+    ///
+    /// @throws Error if an error occurred while serializing or writing one
+    ///               of the frames
+    void finish();
+
+private:
+    /// A single frame to serialize and write
+    struct job {
+        /// The frame to serialize
+        Frame frame;
+        /// Serialized data
+        std::shared_ptr<MemoryBuffer> data;
+        /// Has a worker started serializing this job?
+        bool started = false;
+        /// Is the serialized data ready to be written?
+        bool done = false;
+    };
+
+    /// Main loop for the threads serializing frames
+    void serialize_frames();
+    /// Main loop for the thread writing serialized data to the output
+    void write_frames();
+    /// Store the current exception to be re-thrown on the calling thread,
+    /// and stop all threads. Must be called with `mutex_` locked.
+    void set_error(std::exception_ptr error);
+    /// Re-throw any error from the worker threads. Must be called with
+    /// `mutex_` locked.
+    void check_error();
+
+    /// Format receiving the serialized data
+    TextFormat& output_;
+    /// Function used to create formats to serialize frames in memory
+    memory_stream_t creator_;
+    /// Maximal number of frames waiting to be serialized or written
+    size_t max_jobs_;
+
+    /// Mutex protecting all the data below
+    std::mutex mutex_;
+    /// Condition variable used to notify all threads that `jobs_`, `stop_`
+    /// or `error_` changed
+    std::condition_variable changed_;
+    /// Jobs waiting to be serialized or written, in the same order as the
+    /// calls to `write`
+    std::deque<std::shared_ptr<job>> jobs_;
+    /// First error from one of the threads
+    std::exception_ptr error_;
+    /// Should all the threads stop?
+    bool stop_ = false;
+
+    /// Threads serializing frames
+    std::vector<std::thread> workers_;
+    /// Thread writing data to `output_`
+    std::thread writer_;
+};
+
+} // namespace chemfiles
+
+#endif
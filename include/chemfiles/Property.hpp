@@ -6,7 +6,9 @@
 
 #include <new>
 #include <string>
-#include <map>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
 
 #include "chemfiles/types.hpp"
 #include "chemfiles/exports.h"
@@ -245,15 +247,24 @@ struct property_metadata<Property::VECTOR3D> {
 ///
 /// Properties are sorted internally, and iteration over the property will yield
 /// properties in sorting order.
+///
+/// The properties are stored in a flat sorted array, in a single heap
+/// allocation which also contains the number of properties and the capacity of
+/// the array. An empty map is only a null pointer, and does not allocate.
 class CHFL_EXPORT property_map final {
 public:
-    using const_iterator = std::map<std::string, Property>::const_iterator;
+    using value_type = std::pair<std::string, Property>;
+    /// Iterator over the properties, sorted by name. This used to be a
+    /// `std::map<std::string, Property>::const_iterator`, and is now a
+    /// random access iterator over `std::pair<std::string, Property>`.
+    using const_iterator = const value_type*;
 
     property_map() = default;
-    property_map(property_map&&) = default;
-    property_map& operator=(property_map&&) = default;
-    property_map(const property_map&) = default;
-    property_map& operator=(const property_map&) = default;
+    ~property_map();
+    property_map(property_map&& other) noexcept;
+    property_map& operator=(property_map&& other) noexcept;
+    property_map(const property_map& other);
+    property_map& operator=(const property_map& other);
 
     /// Set an arbitrary property with the given `name` and `value`. If a
     /// property with this name already exist, it is replaced with the new
@@ -268,26 +279,60 @@ public:
 
     /// Get the number of properties in this property map
     size_t size() const {
-        return data_.size();
+        return storage_ != nullptr ? storage_->size : 0;
     }
 
     /// Get an iterator to the first property in the property map
     const_iterator begin() const {
-        return data_.begin();
+        return data();
     }
 
     /// Get an iterator to the end of properties
     const_iterator end() const {
-        return data_.end();
+        return data() + size();
     }
 
 private:
-    std::map<std::string, Property> data_;
+    /// Header of the heap allocation, directly followed by the properties
+    struct storage {
+        /// Number of properties in this map
+        size_t size;
+        /// Number of properties this allocation can hold
+        size_t capacity;
+    };
+
+    /// Offset of the first property from the start of the heap allocation
+    static constexpr size_t DATA_OFFSET = (sizeof(storage) + alignof(value_type) - 1) / alignof(value_type) * alignof(value_type);
+
+    /// Get a pointer to the first property, or `nullptr` if there is no storage
+    value_type* data() {
+        if (storage_ == nullptr) {
+            return nullptr;
+        }
+        return static_cast<value_type*>(static_cast<void*>(reinterpret_cast<char*>(storage_) + DATA_OFFSET));
+    }
+
+    /// Get a pointer to the first property, or `nullptr` if there is no storage
+    const value_type* data() const {
+        if (storage_ == nullptr) {
+            return nullptr;
+        }
+        return static_cast<const value_type*>(static_cast<const void*>(reinterpret_cast<const char*>(storage_) + DATA_OFFSET));
+    }
+
+    /// Make sure there is space for at least `capacity` properties
+    void reserve(size_t capacity);
+    /// Remove all properties and release the heap storage
+    void clear();
+
+    /// Heap storage for the properties, or `nullptr` if the map is empty
+    storage* storage_ = nullptr;
+
     friend bool operator==(const property_map& lhs, const property_map& rhs);
 };
 
 inline bool operator==(const property_map& lhs, const property_map& rhs) {
-    return lhs.data_ == rhs.data_;
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
 inline bool operator!=(const property_map& lhs, const property_map& rhs) {
@@ -6,6 +6,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <algorithm>
 
 #include "chemfiles/exports.h"
@@ -134,14 +135,15 @@ private:
     /// Additional properties of this residue
     property_map properties_;
 
-    /// Update the atomic indexes in this residue after an atom has been
-    /// removed from the containing topology.
+    /// Update the atomic indexes in this residue after atoms have been
+    /// removed or reordered in the containing topology.
     ///
-    /// This function shifts all the indexes bigger than `i` by -1.
-    void atom_removed(size_t i);
-
-    /// remove the atom at index i from this residue
-    void remove(size_t i);
+    /// `new_indices[i]` is the new index of the atom at index `i`, or
+    /// `static_cast<size_t>(-1)` if this atom was removed. Atoms past the end
+    /// of `new_indices` are not part of the topology, and are shifted to stay
+    /// at the same place relative to the end of the topology, which now
+    /// contains `new_size` atoms.
+    void renumber(const std::vector<size_t>& new_indices, size_t new_size);
 
     friend bool operator==(const Residue& lhs, const Residue& rhs);
 
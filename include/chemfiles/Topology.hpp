@@ -4,6 +4,7 @@
 #ifndef CHEMFILES_TOPOLOGY_HPP
 #define CHEMFILES_TOPOLOGY_HPP
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -105,6 +106,30 @@ public:
     /// @throws OutOfBounds if `i` is greater than size()
     void remove(size_t i);
 
+    /// Delete all the atoms at the given `indices` in this topology, as well
+    /// as all the bonds involving these atoms.
+    ///
+    /// This function modify the index of all the remaining atoms, and modify
+    /// the bond list and residues accordingly. This is much faster than
+    /// removing the atoms one by one.
+    ///
+    /// @example{topology/remove.cpp}
+    ///
+    /// @param indices the indexes of the atoms to remove, in any order
+    /// @throws OutOfBounds if any value in `indices` is greater than size()
+    void remove(const std::vector<size_t>& indices);
+
+    /// Get a new topology containing only the atoms at the given `indices`,
+    /// in the same order as `indices`. Bonds between these atoms are kept,
+    /// as well as the residues containing at least one of these atoms.
+    ///
+    /// @example{topology/subset.cpp}
+    ///
+    /// @param indices the indexes of the atoms to keep
+    /// @throws OutOfBounds if any value in `indices` is greater than size()
+    /// @throws Error if `indices` contains the same index multiple times
+    Topology subset(const std::vector<size_t>& indices) const;
+
     /// Add a bond in the system, between the atoms at index `atom_i` and
     /// `atom_j`.
     ///
@@ -117,6 +142,22 @@ public:
     /// @throws Error if `atom_i == atom_j`, as this is an invalid bond
     void add_bond(size_t atom_i, size_t atom_j, Bond::BondOrder bond_order = Bond::UNKNOWN);
 
+    /// Add all the `bonds` in the system at once, with the corresponding
+    /// `bond_orders`. If `bond_orders` is empty, all the new bonds get an
+    /// unknown bond order.
+    ///
+    /// This is equivalent to calling `add_bond` for each bond, but is a lot
+    /// faster when adding a large number of bonds.
+    ///
+    /// @example{topology/add_bonds.cpp}
+    ///
+    /// @param bonds the list of bonds to add
+    /// @param bond_orders the bond orders of the new bonds
+    /// @throws OutOfBounds if any atom in `bonds` is greater than `size()`
+    /// @throws Error if `bond_orders` is not empty and does not have the same
+    ///               size as `bonds`
+    void add_bonds(const std::vector<Bond>& bonds, const std::vector<Bond::BondOrder>& bond_orders = {});
+
     /// Remove a bond in the system, between the atoms at index `atom_i` and
     /// `atom_j`.
     ///
@@ -282,8 +323,22 @@ private:
     Connectivity connect_;
     /// List of residues in the system.
     std::vector<Residue> residues_;
-    /// Association between atom indexes and residues indexes.
-    std::unordered_map<size_t, size_t> residue_mapping_;
+    /// Get the index of the residue containing the atom at `index`, or
+    /// `UINT32_MAX` if this atom is not in a residue
+    uint32_t residue_index(size_t index) const;
+    /// Record that the atom at `index` is part of the residue at `res_index`
+    void set_residue_index(size_t index, uint32_t res_index);
+
+    /// Association between atom indexes and residues indexes. Atoms without
+    /// residue are associated with `UINT32_MAX`, and this vector only extends
+    /// up to the last atom in a residue, and never past the number of atoms in
+    /// the topology when the residue was added.
+    std::vector<uint32_t> residue_mapping_;
+    /// Association between atom indexes and residues indexes, for atoms which
+    /// did not exist yet in the topology when their residue was added. Keeping
+    /// them separated prevents a single huge atom index in a residue from
+    /// allocating memory for all the atoms before it.
+    std::unordered_map<size_t, uint32_t> residue_mapping_overflow_;
 };
 
 } // namespace chemfiles
@@ -6,10 +6,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "chemfiles/exports.h"
 #include "chemfiles/Frame.hpp"
 #include "chemfiles/UnitCell.hpp"
+#include "chemfiles/Selection.hpp"
 #include "chemfiles/external/span.hpp"  // IWYU pragma: keep
 #include "chemfiles/external/optional.hpp"
 
@@ -17,6 +19,7 @@ namespace chemfiles {
 class Format;
 class Topology;
 class MemoryBuffer;
+class ParallelWriter;
 
 /// A `Trajectory` is a chemistry file on the hard drive. It is the entry point
 /// of the chemfiles library.
@@ -154,6 +157,31 @@ public:
     /// @throws FormatError if the format does not support writing.
     void write(const Frame& frame);
 
+    /// Use `threads` threads to serialize frames in parallel when writing to
+    /// this trajectory.
+    ///
+    /// Frames passed to `Trajectory::write` are then copied and queued, and
+    /// a pool of worker threads converts them to text while a separate
+    /// thread appends the results to the file in order. `Trajectory::write`
+    /// only blocks when `2 * threads` frames are already waiting to be
+    /// written, bounding the memory used by queued frames.
+    ///
+    /// This is only used by text formats where each step can be written
+    /// independently of the others (XYZ, GRO, SDF, MOL2 and Tinker), other
+    /// formats keep writing frames sequentially. Calling this function with
+    /// `threads` set to 0 or 1 waits for all queued frames to be written and
+    /// goes back to sequential writing. Errors happening on the worker
+    /// threads are reported by the next call to `Trajectory::write` or
+    /// `Trajectory::close`.
+    ///
+    /// @example{trajectory/set_write_threads.cpp}
+    ///
+    /// @param threads number of threads to use for serialization
+    ///
+    /// @throws FileError if the trajectory was not opened in write or append
+    ///                   mode
+    void set_write_threads(size_t threads);
+
     /// Use the given `topology` instead of any pre-existing `Topology` when
     /// reading or writing.
     ///
@@ -208,6 +236,61 @@ public:
     /// @example{trajectory/set_cell.cpp}
     void set_cell(const UnitCell& cell);
 
+    /// Only read the atoms at the given `indices` from this trajectory.
+    ///
+    /// The frames returned by `read` and `read_step` will only contain the
+    /// requested atoms, in increasing index order, together with the
+    /// corresponding sub-topology: bonds between two selected atoms, and
+    /// residues containing at least one selected atom. Formats that support it
+    /// (XTC, TRR and Amber NetCDF) skip the work associated with the other
+    /// atoms while decoding the file. For other formats, the full frame is read
+    /// and the atoms are extracted afterward.
+    ///
+    /// Calling this function with an empty `indices` vector reads all the
+    /// atoms again. This only affects reading, frames are always written in
+    /// full.
+    ///
+    /// @example{trajectory/set_atom_subset.cpp}
+    ///
+    /// @param indices indices of the atoms to read. Duplicated indices are
+    ///                ignored.
+    ///
+    /// @throws OutOfBounds if a custom topology is set and some of the
+    ///                     `indices` are bigger than its size.
+    void set_atom_subset(std::vector<size_t> indices);
+
+    /// Only read the atoms matching the given `selection` from this
+    /// trajectory. The selection must match single atoms.
+    ///
+    /// The selection is evaluated on the next frame read from this trajectory,
+    /// after applying any custom topology or unit cell, and the resulting
+    /// atomic indices are then used for all subsequent reads, as if they had
+    /// been given to `set_atom_subset(std::vector<size_t>)`. This means that
+    /// selections depending on the positions are not re-evaluated for each
+    /// frame.
+    ///
+    /// @example{trajectory/set_atom_subset.cpp}
+    ///
+    /// @param selection selection to use to find the atoms to read
+    ///
+    /// @throws SelectionError if the selection does not match single atoms.
+    void set_atom_subset(Selection selection);
+
+    /// Set the precision used to store positions and velocities in the frames
+    /// returned by `read` and `read_step` (see `Frame::set_single_precision`).
+    ///
+    /// Formats storing single precision data (XTC, TRR and Amber NetCDF)
+    /// decode it directly in the single precision storage of the frame. For
+    /// other formats, the frame is converted after reading.
+    ///
+    /// @example{trajectory/set_single_precision.cpp}
+    ///
+    /// @param single `true` to read frames using single precision storage,
+    ///               and `false` (the default) to use double precision storage
+    void set_single_precision(bool single) {
+        single_precision_ = single;
+    }
+
     /// Get the number of steps (the number of frames) in this trajectory.
     ///
     /// @example{trajectory/nsteps.cpp}
@@ -247,8 +330,12 @@ private:
 
     /// Perform a few checks before reading a frame
     void pre_read(size_t step);
-    /// Set the frame topology and/or cell after reading it
+    /// Set the frame topology and/or cell after reading it, and extract the
+    /// atom subset if needed
     void post_read(Frame& frame);
+    /// Use the given sorted `indices` as the atom subset, and notify the
+    /// format about it
+    void use_atom_subset(std::vector<size_t> indices);
     /// Check that the trajectory is still open, and throw a `FileError` is it
     /// has been closed.
     void check_opened() const;
@@ -257,10 +344,16 @@ private:
     std::string path_;
     /// Opening mode of the associated file
     char mode_ = '\0';
+    /// Name of the format used for the associated file
+    std::string format_name_;
     /// Current step
     size_t step_ = 0;
     /// Number of steps in the file, if available
     size_t nsteps_ = 0;
+    /// Pipelined writer used to serialize frames in parallel, or `nullptr`
+    /// when writing sequentially. This must be declared before `format_`,
+    /// so that it is replaced first when moving a trajectory.
+    std::unique_ptr<ParallelWriter> parallel_writer_;
     /// Format used to read the associated file. It will be `nullptr` is the
     /// trajectory is closed
     std::unique_ptr<Format> format_;
@@ -270,6 +363,18 @@ private:
     /// UnitCell to use for reading/writing files when no unit cell information
     /// is present
     optional<UnitCell> custom_cell_;
+    /// Sorted indexes of the atoms to read, or an empty vector to read all
+    /// atoms
+    std::vector<size_t> atom_subset_;
+    /// Does the format only decode the atoms in `atom_subset_`?
+    bool native_atom_subset_ = false;
+    /// `custom_topology_` restricted to the atoms in `atom_subset_`, used
+    /// when the format natively reads the subset
+    optional<Topology> custom_subset_topology_;
+    /// Selection to evaluate on the next frame read to get `atom_subset_`
+    std::unique_ptr<Selection> atom_subset_selection_;
+    /// Should the frames be read with single precision storage?
+    bool single_precision_ = false;
     /// The internal memory buffer, shared with the MemoryFile implementation
     std::shared_ptr<MemoryBuffer> buffer_;
 };
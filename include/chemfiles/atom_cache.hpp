@@ -0,0 +1,67 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#ifndef CHEMFILES_ATOM_CACHE_HPP
+#define CHEMFILES_ATOM_CACHE_HPP
+
+#include <array>
+#include <cstring>
+#include <string>
+
+#include "chemfiles/Atom.hpp"
+#include "chemfiles/string_view.hpp"
+
+namespace chemfiles {
+
+/// Cache of the atoms created by a reader, indexed by name and type.
+///
+/// Creating an atom looks up its type in the periodic table. For names that are
+/// not one or two letters elements (`"HW1"`, `"C12"`, LAMMPS numeric types,
+/// ...) this requires normalizing and hashing the name. Most files only
+/// contain a handful of different atom names, so the cache keeps the last atom
+/// created for a small set of names, and copies it for the following atoms
+/// with the same name and type.
+///
+/// The cache is direct-mapped: each name can only be stored in one slot,
+/// selected from the name characters, and replaces the atom previously stored
+/// there. A cache is not thread safe, each thread must use its own.
+class AtomCache {
+public:
+    /// Get an atom with the given `name`, and the same type. The returned
+    /// reference is valid until the next call to `get`.
+    const Atom& get(string_view name) {
+        return this->get(name, name);
+    }
+
+    /// Get an atom with the given `name` and `type`. The returned reference is
+    /// valid until the next call to `get`.
+    const Atom& get(string_view name, string_view type) {
+        auto& cached = atoms_[slot(name)];
+        if (!equal(cached.name(), name) || !equal(cached.type(), type)) {
+            cached = Atom(name.to_string(), type.to_string());
+        }
+        return cached;
+    }
+
+private:
+    /// Number of slots in the cache, this must be a power of two
+    static constexpr size_t CACHE_SIZE = 64;
+
+    static bool equal(const std::string& lhs, string_view rhs) {
+        return lhs.size() == rhs.size() && std::memcmp(lhs.data(), rhs.data(), rhs.size()) == 0;
+    }
+
+    static size_t slot(string_view name) {
+        size_t hash = name.size();
+        for (auto c: name) {
+            hash = hash * 31 + static_cast<unsigned char>(c);
+        }
+        return hash & (CACHE_SIZE - 1);
+    }
+
+    std::array<Atom, CACHE_SIZE> atoms_;
+};
+
+} // namespace chemfiles
+
+#endif
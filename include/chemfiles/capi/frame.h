@@ -8,6 +8,7 @@
 #include <stdbool.h>  // IWYU pragma: keep
 
 #include "chemfiles/capi/types.h"
+#include "chemfiles/capi/property.h"
 #include "chemfiles/exports.h"
 
 #ifdef __cplusplus
@@ -291,6 +292,106 @@ CHFL_EXPORT CHFL_PROPERTY* chfl_frame_get_property(
     const CHFL_FRAME* frame, const char* name
 );
 
+/// Add a per-atom column named `name` to this `frame`, containing one value of
+/// the given `kind` for each atom. `kind` must be either `CHFL_PROPERTY_DOUBLE`
+/// or `CHFL_PROPERTY_VECTOR3D`.
+///
+/// The new values are initialized to 0. If a column with the same name and
+/// kind already exists, this function does nothing.
+///
+/// @example{capi/chfl_frame/add_column.c}
+/// @return The operation status code. You can use `chfl_last_error` to learn
+///         about the error if the status code is not `CHFL_SUCCESS`.
+CHFL_EXPORT chfl_status chfl_frame_add_column(
+    CHFL_FRAME* frame, const char* name, chfl_property_kind kind
+);
+
+/// Get a pointer to the values of the per-atom column named `name` in the
+/// `frame`, for a column containing `CHFL_PROPERTY_DOUBLE` values.
+///
+/// This function set the pointer pointed to by `data` to point to the first
+/// element of the column, and give the number of atoms in the integer pointed
+/// to by `size`.
+///
+/// If the frame is resized (by writing to it, or calling `chfl_frame_resize`,
+/// `chfl_frame_remove` or `chfl_frame_add_atom`), or if a new column is
+/// added, the pointer is invalidated.
+///
+/// If the frame memory is released using `chfl_free`, the memory behind the
+/// `*data` pointer is released too.
+///
+/// @example{capi/chfl_frame/column.c}
+/// @return The operation status code. You can use `chfl_last_error` to learn
+///         about the error if the status code is not `CHFL_SUCCESS`.
+CHFL_EXPORT chfl_status chfl_frame_double_column(
+    CHFL_FRAME* frame, const char* name, double** data, uint64_t* size
+);
+
+/// Get a pointer to the values of the per-atom column named `name` in the
+/// `frame`, for a column containing `CHFL_PROPERTY_VECTOR3D` values.
+///
+/// This function set the pointer pointed to by `data` to point to the first
+/// element of the column, and give the number of atoms in the integer pointed
+/// to by `size`.
+///
+/// If the frame is resized (by writing to it, or calling `chfl_frame_resize`,
+/// `chfl_frame_remove` or `chfl_frame_add_atom`), or if a new column is
+/// added, the pointer is invalidated.
+///
+/// If the frame memory is released using `chfl_free`, the memory behind the
+/// `*data` pointer is released too.
+///
+/// @example{capi/chfl_frame/column.c}
+/// @return The operation status code. You can use `chfl_last_error` to learn
+///         about the error if the status code is not `CHFL_SUCCESS`.
+CHFL_EXPORT chfl_status chfl_frame_vector3d_column(
+    CHFL_FRAME* frame, const char* name, chfl_vector3d** data, uint64_t* size
+);
+
+/// Get the kind of values (either `CHFL_PROPERTY_DOUBLE` or
+/// `CHFL_PROPERTY_VECTOR3D`) stored in the per-atom column named `name` in
+/// the `frame` in `kind`.
+///
+/// @example{capi/chfl_frame/column.c}
+/// @return The operation status code. You can use `chfl_last_error` to learn
+///         about the error if the status code is not `CHFL_SUCCESS`.
+CHFL_EXPORT chfl_status chfl_frame_column_kind(
+    const CHFL_FRAME* frame, const char* name, chfl_property_kind* kind
+);
+
+/// Get the number of per-atom columns in this `frame` in `count`.
+///
+/// @example{capi/chfl_frame/columns.c}
+/// @return The operation status code. You can use `chfl_last_error` to learn
+///         about the error if the status code is not `CHFL_SUCCESS`.
+CHFL_EXPORT chfl_status chfl_frame_columns_count(
+    const CHFL_FRAME* frame, uint64_t* count
+);
+
+/// Get the name of the per-atom column at the given `index` in the `frame`
+/// in the string buffer `name`. The columns are sorted by name, and `index`
+/// must be smaller than the result of `chfl_frame_columns_count`.
+///
+/// The buffer size must be passed in `buffsize`. This function will truncate
+/// the name to fit in the buffer.
+///
+/// @example{capi/chfl_frame/columns.c}
+/// @return The operation status code. You can use `chfl_last_error` to learn
+///         about the error if the status code is not `CHFL_SUCCESS`.
+CHFL_EXPORT chfl_status chfl_frame_column_name(
+    const CHFL_FRAME* frame, uint64_t index, char* name, uint64_t buffsize
+);
+
+/// Remove the per-atom column named `name` from the `frame`. This function
+/// does nothing if there is no such column.
+///
+/// @example{capi/chfl_frame/columns.c}
+/// @return The operation status code. You can use `chfl_last_error` to learn
+///         about the error if the status code is not `CHFL_SUCCESS`.
+CHFL_EXPORT chfl_status chfl_frame_remove_column(
+    CHFL_FRAME* frame, const char* name
+);
+
 /// Add a bond between the atoms at indexes `i` and `j` in the `frame`.
 ///
 /// @example{capi/chfl_frame/add_bond.c}
@@ -279,6 +279,89 @@ CHFL_EXPORT chfl_status chfl_topology_bond_order(
     const CHFL_TOPOLOGY* topology, uint64_t i, uint64_t j, chfl_bond_order* order
 );
 
+/// Get the masses of all the atoms in the `topology` in the pre-allocated
+/// array `masses` of size `natoms`.
+///
+/// `natoms` must be equal to the number of atoms in the topology, as given
+/// by `chfl_topology_atoms_count`. This function is faster than getting the
+/// mass of each atom with `chfl_atom_from_topology` and `chfl_atom_mass`.
+///
+/// @example{capi/chfl_topology/masses.c}
+/// @return The operation status code. You can use `chfl_last_error` to learn
+///         about the error if the status code is not `CHFL_SUCCESS`.
+CHFL_EXPORT chfl_status chfl_topology_masses(
+    const CHFL_TOPOLOGY* topology, double masses[], uint64_t natoms
+);
+
+/// Get the charges of all the atoms in the `topology` in the pre-allocated
+/// array `charges` of size `natoms`.
+///
+/// `natoms` must be equal to the number of atoms in the topology, as given
+/// by `chfl_topology_atoms_count`. This function is faster than getting the
+/// charge of each atom with `chfl_atom_from_topology` and `chfl_atom_charge`.
+///
+/// @example{capi/chfl_topology/masses.c}
+/// @return The operation status code. You can use `chfl_last_error` to learn
+///         about the error if the status code is not `CHFL_SUCCESS`.
+CHFL_EXPORT chfl_status chfl_topology_charges(
+    const CHFL_TOPOLOGY* topology, double charges[], uint64_t natoms
+);
+
+/// Get the atomic types of all the atoms in the `topology`, as indexes in a
+/// table of the different types.
+///
+/// The different types are stored in the pre-allocated array `types`, in the
+/// order of their first appearance in the topology. When calling this
+/// function, `ntypes` must point to the size of the `types` array, and it is
+/// set to the number of different types on success. There can not be more
+/// types than atoms, so an array of size `natoms` is always large enough.
+/// For each atom `i`, the index of its type in `types` is stored in `ids[i]`,
+/// where `ids` is a pre-allocated array of size `natoms`, equal to the number
+/// of atoms in the topology.
+///
+/// The pointers in `types` point to memory inside the `topology`, and are
+/// only valid until the next modification of the topology.
+///
+/// @example{capi/chfl_topology/atom_types.c}
+/// @return The operation status code. You can use `chfl_last_error` to learn
+///         about the error if the status code is not `CHFL_SUCCESS`.
+CHFL_EXPORT chfl_status chfl_topology_atom_types(
+    const CHFL_TOPOLOGY* topology,
+    const char* types[], uint64_t* ntypes,
+    uint64_t ids[], uint64_t natoms
+);
+
+/// Get the identifiers of the residues containing the atoms in the
+/// `topology` in the pre-allocated array `ids` of size `natoms`.
+///
+/// `natoms` must be equal to the number of atoms in the topology, as given
+/// by `chfl_topology_atoms_count`. For atoms which are not part of any
+/// residue, or which are part of a residue without identifier, the
+/// corresponding value in `ids` is set to `INT64_MIN`.
+///
+/// @example{capi/chfl_topology/residue_ids.c}
+/// @return The operation status code. You can use `chfl_last_error` to learn
+///         about the error if the status code is not `CHFL_SUCCESS`.
+CHFL_EXPORT chfl_status chfl_topology_residue_ids(
+    const CHFL_TOPOLOGY* topology, int64_t ids[], uint64_t natoms
+);
+
+/// Get the values of the atomic property with the given `name` for all the
+/// atoms in the `topology` in the pre-allocated array `values` of size
+/// `natoms`.
+///
+/// `natoms` must be equal to the number of atoms in the topology, as given
+/// by `chfl_topology_atoms_count`. For atoms without this property, or where
+/// this property is not a `CHFL_PROPERTY_DOUBLE`, the corresponding value in
+/// `values` is set to NaN.
+///
+/// @example{capi/chfl_topology/double_property.c}
+/// @return The operation status code. You can use `chfl_last_error` to learn
+///         about the error if the status code is not `CHFL_SUCCESS`.
+CHFL_EXPORT chfl_status chfl_topology_double_property(
+    const CHFL_TOPOLOGY* topology, const char* name, double values[], uint64_t natoms
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -52,9 +52,28 @@ public:
     /// Seek to the specified `position` in the file
     void seek(uint64_t position);
 
+    /// Get the size of the file in bytes
+    uint64_t size();
+
     /// Read exactly `count` char, and store them in the `data` array
     void read_char(char* data, size_t count);
 
+    /// Get the full content of the file, from the start to the end.
+    ///
+    /// When the file is memory-mapped, the returned view points directly
+    /// inside the mapping, and nothing is copied. Otherwise, the file is read
+    /// into `buffer`. In both cases, the view is only valid as long as this
+    /// file and `buffer` are alive.
+    string_view read_all(std::string& buffer);
+
+    /// Read the next `count` bytes in the file.
+    ///
+    /// When the file is memory-mapped, the returned view points directly
+    /// inside the mapping, and nothing is copied. Otherwise, the data is read
+    /// into `buffer`. In both cases, the view is only valid as long as this
+    /// file and `buffer` are alive, and nothing is written to the file.
+    string_view read_view(size_t count, std::string& buffer);
+
     /// Read a single char value from the file
     char read_single_char() {
         char value;
@@ -0,0 +1,62 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#ifndef CHEMFILES_MSGPACK_DATA_HPP
+#define CHEMFILES_MSGPACK_DATA_HPP
+
+#include <string>
+#include <memory>
+
+#include <msgpack.hpp>
+
+#include "chemfiles/File.hpp"
+#include "chemfiles/string_view.hpp"
+
+namespace chemfiles {
+class BinaryFile;
+class MemoryBuffer;
+
+/// Raw data from a msgpack-based file (MMTF or BinaryCIF), and the msgpack
+/// objects unpacked from it.
+///
+/// Strings and binary arrays in the msgpack objects reference the raw data
+/// instead of copying it, so both are kept alive together. Depending on where
+/// the data is coming from, it lives in a memory-mapped file, a decompressed
+/// buffer or a memory buffer.
+class MsgPackData final {
+public:
+    /// Read the file at `path`. Uncompressed files are memory-mapped, and
+    /// compressed files are decompressed in memory.
+    ///
+    /// @throws msgpack::unpack_error if the data is not valid msgpack
+    MsgPackData(std::string path, File::Mode mode, File::Compression compression);
+
+    /// Use the data in `memory`, which must already be decompressed
+    ///
+    /// @throws msgpack::unpack_error if the data is not valid msgpack
+    explicit MsgPackData(std::shared_ptr<MemoryBuffer> memory);
+
+    ~MsgPackData();
+    MsgPackData(const MsgPackData&) = delete;
+    MsgPackData& operator=(const MsgPackData&) = delete;
+    MsgPackData(MsgPackData&&) = delete;
+    MsgPackData& operator=(MsgPackData&&) = delete;
+
+    /// Get the root msgpack object
+    const msgpack::object& get() const {
+        return handle_.get();
+    }
+
+private:
+    /// Unpack `data`, which must point inside `file_`, `buffer_` or `memory_`
+    void unpack(string_view data);
+
+    std::unique_ptr<BinaryFile> file_;
+    std::string buffer_;
+    std::shared_ptr<MemoryBuffer> memory_;
+    msgpack::object_handle handle_;
+};
+
+} // namespace chemfiles
+
+#endif
@@ -239,6 +239,17 @@ public:
     template<typename T>
     void read(size_t step, T* data, size_t count);
 
+    /// read `count` values of this variable at the given `step`, starting
+    /// with the value at index `start` in the variable data for this step,
+    /// and writing them to `data`. If this variable is not a record variable
+    /// `step` must be 0.
+    ///
+    /// @throws if `start + count` is bigger than the number of values in this
+    ///         variable
+    /// @throws if the pointer type does not match this variable type
+    template<typename T>
+    void read(size_t step, size_t start, T* data, size_t count);
+
     /// write the content of `data` to this variable at the given `step`. If
     /// this variable is not a record variable `step` must be 0.
     ///
@@ -290,6 +301,10 @@ extern template void Variable::read(size_t step, int32_t* data, size_t count);
 extern template void Variable::read(size_t step, float* data, size_t count);
 extern template void Variable::read(size_t step, double* data, size_t count);
 
+extern template void Variable::read(size_t step, size_t start, int32_t* data, size_t count);
+extern template void Variable::read(size_t step, size_t start, float* data, size_t count);
+extern template void Variable::read(size_t step, size_t start, double* data, size_t count);
+
 extern template void Variable::write(size_t step, const char* data, size_t count);
 extern template void Variable::write(size_t step, const int32_t* data, size_t count);
 extern template void Variable::write(size_t step, const float* data, size_t count);
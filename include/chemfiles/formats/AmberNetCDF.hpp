@@ -29,6 +29,7 @@ public:
     void read(Frame& frame) override final;
     void read_step(size_t step, Frame& frame) override final;
     void write(const Frame& frame) override;
+    bool set_atom_subset(std::vector<size_t> indices) override final;
 
 protected:
     struct variable_scale_t {
@@ -40,6 +41,15 @@ protected:
     UnitCell read_cell();
     /// read the values from the variable at the current internal step to the array
     void read_array(variable_scale_t& variable, span<Vector3D> array);
+    /// read the values from the variable at the current internal step to the
+    /// single precision array
+    void read_array(variable_scale_t& variable, span<Vector3F> array);
+    /// read the values for the atoms in `atom_subset_` from the variable at
+    /// the current internal step to the array
+    void read_array_subset(variable_scale_t& variable, span<Vector3D> array);
+    /// read the values for the atoms in `atom_subset_` from the variable at
+    /// the current internal step to the single precision array
+    void read_array_subset(variable_scale_t& variable, span<Vector3F> array);
 
     /// write the unit cell at the current step
     void write_cell(const UnitCell& cell);
@@ -66,6 +76,9 @@ protected:
     std::vector<float> buffer_f32_;
     std::vector<double> buffer_f64_;
 
+    /// Indexes of the atoms to read, or an empty vector to read all atoms
+    std::vector<size_t> atom_subset_;
+
     virtual void initialize(const Frame& frame) = 0;
 
 private:
@@ -0,0 +1,157 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#ifndef CHEMFILES_FORMAT_BINARY_CIF_HPP
+#define CHEMFILES_FORMAT_BINARY_CIF_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "chemfiles/File.hpp"
+#include "chemfiles/Format.hpp"
+
+#include "chemfiles/UnitCell.hpp"
+#include "chemfiles/string_view.hpp"
+#include "chemfiles/external/optional.hpp"
+
+#include "chemfiles/formats/mmCIF.hpp"
+
+namespace chemfiles {
+class Frame;
+class MemoryBuffer;
+class MsgPackData;
+class FormatMetadata;
+
+/// A single decoded column from a category in a BinaryCIF file. Depending on
+/// the encoding used in the file, the column contains either integers,
+/// floating point numbers or strings.
+class BinaryCIFColumn {
+public:
+    /// Kind of value stored in a row of a column
+    enum Mask: uint8_t {
+        /// The value is present
+        PRESENT = 0,
+        /// The value is not specified (`.` in text CIF files)
+        NOT_SPECIFIED = 1,
+        /// The value is unknown (`?` in text CIF files)
+        UNKNOWN = 2,
+    };
+
+    /// Create an empty numeric column
+    BinaryCIFColumn() = default;
+
+    /// Create a column containing floating point `values`
+    explicit BinaryCIFColumn(std::vector<double> values): kind_(NUMBERS), numbers_(std::move(values)) {}
+
+    /// Create a column containing integer `values`
+    explicit BinaryCIFColumn(std::vector<int64_t> values): kind_(INTEGERS), integers_(std::move(values)) {}
+
+    /// Create a column containing strings. The value of the row `i` is the
+    /// string going from `offsets[indices[i]]` to `offsets[indices[i] + 1]`
+    /// in `data`.
+    BinaryCIFColumn(std::string data, std::vector<size_t> offsets, std::vector<int64_t> indices);
+
+    /// Get the number of rows in this column
+    size_t size() const {
+        switch (kind_) {
+        case NUMBERS:
+            return numbers_.size();
+        case INTEGERS:
+            return integers_.size();
+        case STRINGS:
+            return indices_.size();
+        }
+        return 0;
+    }
+
+    /// Set the mask for this column, indicating which values are missing
+    void set_mask(std::vector<uint8_t> mask);
+
+    /// Check if the value at `row` is present, i.e. not marked as unknown or
+    /// not specified
+    bool is_present(size_t row) const {
+        return mask_.empty() || mask_[row] == PRESENT;
+    }
+
+    /// Get the value at `row` as a number, parsing it for string columns.
+    ///
+    /// @throws FormatError if the value is not a valid number
+    double number(size_t row) const;
+
+    /// Get the value at `row` as an integer, truncating floating point values
+    /// and parsing it for string columns.
+    ///
+    /// @throws FormatError if the value is not a valid integer
+    int64_t integer(size_t row) const;
+
+    /// Get the value at `row` as a string. Missing values are given as `.`
+    /// or `?`, as they would be in a text CIF file. This function can only be
+    /// called on string columns, see `to_strings`.
+    string_view string(size_t row) const;
+
+    /// Convert the values in a numeric column to strings. This does nothing
+    /// if the column already contains strings.
+    void to_strings();
+
+private:
+    /// Kind of values stored in a column
+    enum Kind: uint8_t {
+        NUMBERS,
+        INTEGERS,
+        STRINGS,
+    };
+
+    Kind kind_ = NUMBERS;
+    /// Values of a floating point column
+    std::vector<double> numbers_;
+    /// Values of an integer column
+    std::vector<int64_t> integers_;
+    /// Storage for all the strings in a string column, and the offsets of
+    /// each unique string in this storage
+    std::string strings_;
+    std::vector<size_t> offsets_;
+    /// For each row of a string column, index of the string in `offsets_`
+    std::vector<int64_t> indices_;
+    /// Mask of the values, empty if all values are present
+    std::vector<uint8_t> mask_;
+};
+
+/// BinaryCIF reader, for the msgpack-based binary version of mmCIF files
+/// distributed by the PDB. Only the `_atom_site` category and a few other
+/// categories (`_cell`, `_entry` and `_struct`) are used.
+class BinaryCIFFormat final: public Format {
+public:
+    BinaryCIFFormat(std::string path, File::Mode mode, File::Compression compression);
+    BinaryCIFFormat(std::shared_ptr<MemoryBuffer> memory, File::Mode mode, File::Compression compression);
+
+    void read_step(size_t step, Frame& frame) override;
+    void read(Frame& frame) override;
+    size_t nsteps() override;
+
+private:
+    /// Decode the BinaryCIF `data`, using `source` in error messages. All the
+    /// values used by chemfiles are copied out of `data`.
+    void decode(const MsgPackData& data, const std::string& source);
+
+    /// Decoded columns of the `_atom_site` category
+    mmCIFAtomSiteColumns<BinaryCIFColumn> columns_;
+    /// First row in `_atom_site` for each model. The last value is the total
+    /// number of rows.
+    std::vector<size_t> models_start_;
+    /// Next step to read
+    size_t step_ = 0;
+    /// The cell for all frames
+    UnitCell cell_;
+    /// Frame name, from `_struct.title`
+    std::string name_;
+    /// The PDB id code, from `_entry.id`
+    std::string pdb_idcode_;
+};
+
+template<> const FormatMetadata& format_metadata<BinaryCIFFormat>();
+
+} // namespace chemfiles
+
+#endif
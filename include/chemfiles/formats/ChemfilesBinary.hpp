@@ -0,0 +1,84 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#ifndef CHEMFILES_FORMAT_CHEMFILES_BINARY_HPP
+#define CHEMFILES_FORMAT_CHEMFILES_BINARY_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "chemfiles/File.hpp"
+#include "chemfiles/Format.hpp"
+#include "chemfiles/Topology.hpp"
+
+#include "chemfiles/files/BinaryFile.hpp"
+#include "chemfiles/external/optional.hpp"
+
+namespace chemfiles {
+class Frame;
+class FormatMetadata;
+
+/// Chemfiles native binary trajectory format.
+///
+/// The file starts with a small header, followed by a sequence of blocks and
+/// an index of all the blocks at the end of the file. Each frame block stores
+/// the step, unit cell and properties of the frame, followed by one column of
+/// values for each kind of per-atom data (positions, velocities and per-atom
+/// columns of the frame). The topology is stored in separate blocks, which are
+/// only written when the topology changes.
+///
+/// The values in a column are split into blocks of about 1 MiB, and each
+/// block is compressed independently with the codec selected by the
+/// compression of the file (none, zlib or lzma). This allows to compress and
+/// decompress the blocks in parallel, and to read uncompressed data directly
+/// from the memory-mapped file.
+class ChemfilesBinaryFormat final: public Format {
+public:
+    ChemfilesBinaryFormat(std::string path, File::Mode mode, File::Compression compression);
+    ~ChemfilesBinaryFormat() override;
+
+    void read_step(size_t step, Frame& frame) override;
+    void read(Frame& frame) override;
+    void write(const Frame& frame) override;
+    size_t nsteps() override;
+    bool write_single_precision() const override;
+
+private:
+    /// Read the index at the end of the file, and return the offset of the
+    /// index block (i.e. the end of the data), or `nullopt` if the file does
+    /// not end with a valid index
+    optional<uint64_t> read_index();
+    /// Build the index by going over all the blocks in the file, and return
+    /// the end of the last complete block. This is used when the file was not
+    /// closed properly and does not end with an index.
+    uint64_t scan_blocks();
+    /// Write the index of all the blocks at the current position in the file
+    void write_index();
+    /// Get the topology stored in the block at `index` in `topologies_`
+    const Topology& topology(size_t index);
+
+    /// Associated binary file
+    LittleEndianFile file_;
+    /// Codec used to compress the data in new blocks
+    uint8_t codec_ = 0;
+    /// Offset of each frame block in the file
+    std::vector<uint64_t> frames_;
+    /// Offset of each topology block in the file
+    std::vector<uint64_t> topologies_;
+    /// The next step to read
+    size_t step_ = 0;
+    /// Index and value of the last topology read or written, the index is
+    /// `nullopt` if no topology was read or written yet
+    optional<size_t> last_topology_index_;
+    Topology last_topology_;
+    /// Storage for the data read from the file, when the file is not
+    /// memory-mapped
+    std::string buffer_;
+};
+
+template<> const FormatMetadata& format_metadata<ChemfilesBinaryFormat>();
+
+} // namespace chemfiles
+
+#endif
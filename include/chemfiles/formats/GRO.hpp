@@ -31,6 +31,7 @@ public:
 
     void read_next(Frame& frame) override;
     void write_next(const Frame& frame) override;
+    bool independent_steps() const override { return true; }
     optional<uint64_t> forward() override;
 
 private:
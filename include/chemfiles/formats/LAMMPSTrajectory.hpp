@@ -9,10 +9,13 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "chemfiles/File.hpp"
 #include "chemfiles/Format.hpp"
 
+#include "chemfiles/files/BinaryFile.hpp"
+
 #include "chemfiles/external/optional.hpp"
 
 namespace chemfiles {
@@ -34,8 +37,22 @@ class LAMMPSTrajectoryFormat final : public TextFormat {
     void write_next(const Frame& frame) override;
     optional<uint64_t> forward() override;
 
+    /// Read the step starting at `position` in the file, as returned by
+    /// `forward()`, without scanning the file to find the other steps
+    void read_at(uint64_t position, Frame& frame);
+
+    /// Keep the atoms in the same order as in the file instead of ordering
+    /// them by atom ID, and store the IDs in `atom_ids()`. This is used to
+    /// merge the files written by different processors.
+    void keep_file_order() { keep_file_order_ = true; }
+    /// Get the atom IDs from the last step read with `keep_file_order`, or an
+    /// empty vector if the file does not contain atom IDs
+    const std::vector<size_t>& atom_ids() const { return atom_ids_; }
+
   private:
     std::array<double, 3> read_cell(Frame& frame);
+    bool keep_file_order_ = false;
+    std::vector<size_t> atom_ids_;
     size_t min_numeric_type_ = 0;
     size_t max_numeric_type_ = 0;
     std::unordered_map<std::string, size_t> type_list_;
@@ -43,6 +60,119 @@ class LAMMPSTrajectoryFormat final : public TextFormat {
 
 template <> const FormatMetadata& format_metadata<LAMMPSTrajectoryFormat>();
 
+/// LAMMPS binary dump reader, for files created by `dump atom` or
+/// `dump custom` with `dump_modify binary yes`.
+class LAMMPSBinaryFormat final : public Format {
+  public:
+    LAMMPSBinaryFormat(std::string path, File::Mode mode, File::Compression compression);
+
+    /// Open the file at `path` for reading, using the `offsets` and `units`
+    /// of a previous reader for the same file instead of building the index
+    /// of the steps again
+    LAMMPSBinaryFormat(std::string path, std::vector<uint64_t> offsets, std::string units);
+
+    void read_step(size_t step, Frame& frame) override;
+    void read(Frame& frame) override;
+    size_t nsteps() override;
+
+    /// Keep the atoms in the same order as in the file instead of ordering
+    /// them by atom ID, and store the IDs in `atom_ids()`. This is used to
+    /// merge the files written by different processors.
+    void keep_file_order() { keep_file_order_ = true; }
+    /// Get the atom IDs from the last step read with `keep_file_order`, or an
+    /// empty vector if the file does not contain atom IDs
+    const std::vector<size_t>& atom_ids() const { return atom_ids_; }
+    /// Get the position of the start of each step in the file
+    const std::vector<uint64_t>& offsets() const { return offsets_; }
+    /// Get the unit style of the simulation, or an empty string if the file
+    /// does not contain it
+    const std::string& units() const { return units_; }
+
+  private:
+    bool keep_file_order_ = false;
+    std::vector<size_t> atom_ids_;
+    /// Associated binary file
+    LittleEndianFile file_;
+    /// Position of the start of each step in the file
+    std::vector<uint64_t> offsets_;
+    /// Unit style of the simulation. LAMMPS only writes it in the first step
+    /// of a dump, so it is taken from there and used for all the steps.
+    std::string units_;
+    /// The next step to read
+    size_t step_ = 0;
+    /// Buffer for the per-atom values of a step
+    std::vector<double> values_;
+};
+
+template <> const FormatMetadata& format_metadata<LAMMPSBinaryFormat>();
+
+/// Reader for LAMMPS dumps split over multiple files, using the same
+/// wildcards as the `dump` command in the file name: `*` stands for the
+/// timestep, and `%` for the processor. All the matching files are read as a
+/// single trajectory, and the files written by different processors for the
+/// same step are merged using the atom IDs.
+///
+/// There can be more matching files than the process is allowed to open at
+/// the same time, so only the position of the steps in each file is kept
+/// after the constructor, and the files are opened again when reading.
+class LAMMPSMultiFileFormat final : public Format {
+  public:
+    LAMMPSMultiFileFormat(std::string path, File::Mode mode, File::Compression compression);
+
+    void read_step(size_t step, Frame& frame) override;
+    void read(Frame& frame) override;
+    size_t nsteps() override;
+
+  private:
+    /// A file matching the pattern
+    struct FileIndex {
+        /// Path to the file
+        std::string path;
+        /// Position of the start of each step in the file
+        std::vector<uint64_t> positions;
+    };
+
+    /// A single step in one of the files
+    struct Piece {
+        /// Index of the file in `files_`
+        size_t file;
+        /// Step inside this file
+        size_t step;
+    };
+
+    /// Open the file at `index` in `files_` for reading
+    std::unique_ptr<Format> open(size_t index) const;
+    /// Read a single `piece` in `frame`, using `format` which must have been
+    /// created by `open(piece.file)`
+    void read_piece(Format& format, Piece piece, Frame& frame) const;
+
+    /// Are the files LAMMPS binary dumps?
+    bool binary_ = false;
+    /// Are the files written by different processors (using `%` in the
+    /// pattern)? In this case, the atoms are always ordered with their IDs
+    /// after merging all the pieces of a step.
+    bool per_processor_ = false;
+    /// Compression of the files
+    File::Compression compression_ = File::DEFAULT;
+    /// Unit style of the simulation in binary dumps. LAMMPS only writes it in
+    /// the first file, so it is taken from there and used for all the files.
+    std::string units_;
+    /// All the files matching the pattern
+    std::vector<FileIndex> files_;
+    /// For each step in the trajectory, all the pieces containing the atoms
+    /// of this step, in the order of the processors
+    std::vector<std::vector<Piece>> steps_;
+    /// The next step to read
+    size_t step_ = 0;
+    /// Reader for the last file used when there is a single piece by step,
+    /// and index of this file in `files_`. This is the only file kept open
+    /// between calls to `read`.
+    std::unique_ptr<Format> current_;
+    size_t current_file_ = 0;
+};
+
+template <> const FormatMetadata& format_metadata<LAMMPSMultiFileFormat>();
+
 } // namespace chemfiles
 
 #endif
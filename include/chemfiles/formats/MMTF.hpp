@@ -4,6 +4,7 @@
 #ifndef CHEMFILES_FORMAT_MMTF_HPP
 #define CHEMFILES_FORMAT_MMTF_HPP
 
+#include <map>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -14,6 +15,8 @@
 #include "chemfiles/File.hpp"
 #include "chemfiles/Format.hpp"
 
+#include "chemfiles/Atom.hpp"
+#include "chemfiles/Connectivity.hpp"
 #include "chemfiles/UnitCell.hpp"
 #include "chemfiles/external/span.hpp"
 
@@ -22,6 +25,7 @@ class Frame;
 class Residue;
 class Vector3D;
 class MemoryBuffer;
+class MsgPackData;
 class FormatMetadata;
 
 /// MMTF file format reader and writer.
@@ -42,8 +46,16 @@ public:
 
 private:
 
-    /// Perform the MMTF decoding steps
-    void decode(const char* data, size_t size, const std::string& source);
+    /// Perform the MMTF decoding steps on the data in `msgpack_`, for
+    /// everything except the atomic coordinates.
+    void decode();
+
+    /// Decode the atomic coordinates, if this was not already done. This
+    /// also releases the raw MMTF data.
+    void decode_coordinates();
+
+    /// Create the atoms and bonds for all the group types in the structure
+    void create_group_templates();
 
     /// Add a model to a frame, increasing all the private indicies below
     void read_model(Frame& frame);
@@ -54,11 +66,12 @@ private:
     /// Called by read_model to create new residues. Uses/updates groupIndex_
     Residue create_residue(const std::string& current_assembly, size_t group_type);
 
-    /// Read a group from the MMTF structure, adding atoms and a residue to frame
+    /// Read a group from the MMTF structure, adding atoms and a residue to
+    /// frame, and the bonds inside the group to `bonds_`
     void read_group(Frame& frame, size_t group_type, Residue& residue, span<Vector3D> positions);
 
-    /// Add inter residue bonds to the structure.
-    void add_inter_residue_bonds(Frame& frame);
+    /// Add inter residue bonds to `bonds_`
+    void add_inter_residue_bonds();
 
     /// Apply symmetry operations to the frame
     void apply_symmetry(Frame& frame);
@@ -78,6 +91,27 @@ private:
     /// Location of MMTF file on disk. Only used if opened in write mode.
     std::string filename_;
 
+    /// Where the data is coming from, used for error messages
+    std::string source_;
+
+    /// Raw MMTF data and its msgpack representation, kept alive until the
+    /// coordinates are decoded
+    std::unique_ptr<MsgPackData> msgpack_;
+
+    /// Encoded atomic coordinates, decoded when reading the first frame.
+    /// Decoding the coordinates is the most expensive part of decoding MMTF,
+    /// and doing it lazily makes opening a file a lot faster.
+    std::map<std::string, msgpack::object> coordinates_;
+
+    /// Atoms for each group type in `structure_.groupList`, created once and
+    /// shared by all the groups/residues with this type
+    std::vector<std::vector<Atom>> group_atoms_;
+
+    /// Bonds and bond orders for the frame being read, added to the frame all
+    /// at once at the end of `read_model`
+    std::vector<Bond> bonds_;
+    std::vector<Bond::BondOrder> bond_orders_;
+
     /// Current model being read. Ranges from [0, structure.numModels)
     size_t modelIndex_ = 0;
 
@@ -13,7 +13,10 @@
 #include "chemfiles/File.hpp"
 #include "chemfiles/Format.hpp"
 
+#include "chemfiles/types.hpp"
 #include "chemfiles/Residue.hpp"
+#include "chemfiles/Topology.hpp"
+#include "chemfiles/atom_cache.hpp"
 #include "chemfiles/string_view.hpp"
 #include "chemfiles/external/optional.hpp"
 
@@ -60,6 +63,13 @@ public:
     static void link_standard_residue_bonds(Frame& frame);
 
 private:
+    // Read all the records in the next frame. If `reuse_topology` is true,
+    // only read the positions of the atoms and check that the other records
+    // match the ones of the last frame, returning false as soon as they do not
+    bool read_records(Frame& frame, bool reuse_topology);
+    // Check that `record` matches the next part of `last_records_` if
+    // `reuse_topology` is true, or add it to `last_records_` otherwise.
+    bool check_record(string_view record, bool reuse_topology);
     // Read HEADER record
     void read_HEADER(Frame& frame, string_view line);
     // Read TITLE record
@@ -72,13 +82,15 @@ private:
     void read_HELIX(string_view line);
     // reads SHEET and TURN records. i1 and i2 are the indicies of the chain ids
     void read_secondary(string_view line, size_t i1, size_t i2, string_view record);
-    // Read CONECT record
-    void read_CONECT(Frame& frame, string_view line);
+    // Read CONECT record, adding the corresponding bonds to `bonds`
+    void read_CONECT(const Frame& frame, string_view line, std::vector<Bond>& bonds);
     // Runs when a chain is terminated to update residue information
     void chain_ended(Frame& frame);
 
     /// Residue information in the current step
     std::map<FullResidueId, Residue> residues_;
+    /// Atoms already created while reading this file
+    AtomCache atom_cache_;
     /// Number of models written/read to the file.
     size_t models_ = 0;
     /// List of all atom offsets. This maybe pushed in read_ATOM or if a TER
@@ -96,6 +108,22 @@ private:
     /// read. Else It is set to the final residue of a secondary structure and
     /// the text description which should be set.
     optional<std::pair<FullResidueId, std::string>> current_secinfo_;
+
+    /// Topology of the last frame read, which is re-used for the next frame
+    /// if all the records defining it are the same. This is the case for NMR
+    /// ensembles and trajectories stored as multiple MODEL.
+    optional<Topology> last_topology_;
+    /// Content of the ATOM/HETATM (without the positions), TER and CONECT
+    /// records of the last frame read
+    std::string last_records_;
+    /// Position of the next record to compare in `last_records_` when
+    /// re-using the topology
+    size_t last_records_offset_ = 0;
+    /// Value of `current_secinfo_` before and after reading the last frame
+    optional<std::pair<FullResidueId, std::string>> last_secinfo_before_;
+    optional<std::pair<FullResidueId, std::string>> last_secinfo_after_;
+    /// Positions of the atoms when re-using the topology
+    std::vector<Vector3D> positions_;
 };
 
 template<> const FormatMetadata& format_metadata<PDBFormat>();
@@ -5,6 +5,7 @@
 #define CHEMFILES_TRR_FORMAT_HPP
 
 #include <string>
+#include <vector>
 
 #include "chemfiles/File.hpp"
 #include "chemfiles/Format.hpp"
@@ -26,12 +27,16 @@ class TRRFormat final : public Format {
     void read(Frame& frame) override;
     void write(const Frame& frame) override;
     size_t nsteps() override;
+    bool set_atom_subset(std::vector<size_t> indices) override;
+    bool write_single_precision() const override;
 
   private:
     /// Associated XDR file
     XDRFile file_;
     /// The next step to read
     size_t step_ = 0;
+    /// Indexes of the atoms to read, or an empty vector to read all atoms
+    std::vector<size_t> atom_subset_;
 };
 
 template<> const FormatMetadata& format_metadata<TRRFormat>();
@@ -15,12 +15,67 @@
 
 #include "chemfiles/Residue.hpp"
 #include "chemfiles/UnitCell.hpp"
+#include "chemfiles/string_view.hpp"
+#include "chemfiles/external/optional.hpp"
 
 namespace chemfiles {
 class Frame;
 class MemoryBuffer;
 class FormatMetadata;
 
+/// Columns of the `_atom_site` category used by the mmCIF and BinaryCIF
+/// readers. `Column` is how each reader refers to a column: an index in the
+/// loop for mmCIF, and the decoded values for BinaryCIF.
+template<typename Column>
+struct mmCIFAtomSiteColumns {
+    Column type_symbol = Column();
+    Column cartn_x = Column();
+    Column cartn_y = Column();
+    Column cartn_z = Column();
+    optional<Column> label_atom_id;
+    optional<Column> group_pdb;
+    optional<Column> label_alt_id;
+    optional<Column> formal_charge;
+    optional<Column> label_comp_id;
+    optional<Column> label_asym_id;
+    optional<Column> auth_asym_id;
+    optional<Column> label_seq_id;
+    optional<Column> label_entity_id;
+    optional<Column> model_num;
+};
+
+/// Group atoms in residues while reading the `_atom_site` category of mmCIF
+/// and BinaryCIF files
+class mmCIFResidues {
+public:
+    /// Add the atom at index `atom` to the residue with id `resid` in the
+    /// chain `chainid`. If this residue does not exist yet, it is created with
+    /// the given `name`, and the `chainname` and `group_pdb` values if they
+    /// are present.
+    void add_atom(
+        size_t atom, int64_t resid, string_view chainid, string_view name,
+        optional<string_view> chainname, optional<string_view> group_pdb
+    );
+
+    /// Add all the residues to the `frame`, and clear this for the next frame
+    void add_to(Frame& frame);
+
+    /// Remove all residues
+    void clear();
+
+private:
+    /// All the residues, in the order they appear in the file
+    std::vector<Residue> residues_;
+    /// Map of residue indexes, indexed by chainid and residue id. We use an
+    /// indirection to keep the residues in the same order as in the file
+    std::map<std::pair<std::string, int64_t>, size_t> indexes_;
+    /// Residue containing the previous atom. Consecutive atoms are usually in
+    /// the same residue, so this saves a lookup in `indexes_`
+    optional<size_t> last_residue_;
+    std::string last_chainid_;
+    int64_t last_resid_ = 0;
+};
+
 /// mmCIF Crystallographic Information Framework for MacroMolecules
 /// reader and writer.
 class mmCIFFormat final: public Format {
@@ -44,12 +99,15 @@ private:
     void init_();
     /// Underlying file representation
     TextFile file_;
-    /// Map of STAR records to their index
-    std::map<std::string, size_t> atom_site_map_;
-    /// Vector with all the residues.
-    std::vector<Residue> residues_;
-    /// Map of residue indexes, indexed by residue id and chainid. We use an indirection to keep the residue order (and don't sort them with the map id).
-    std::map<std::pair<std::string, int64_t>, size_t> map_residues_indexes;
+    /// Index of the columns used by chemfiles in the `_atom_site` loop
+    mmCIFAtomSiteColumns<size_t> columns_;
+    /// Total number of columns in the `_atom_site` loop
+    size_t columns_count_ = 0;
+    /// Fields in the current line of the `_atom_site` loop, pointing inside
+    /// the file buffer
+    std::vector<string_view> fields_;
+    /// Residues in the frame being read
+    mmCIFResidues residues_;
     /// Storing the positions of all the steps in the file, so that we can
     /// just `seekpos` them instead of reading the whole step.
     std::vector<uint64_t> steps_positions_;
@@ -0,0 +1,107 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#ifndef CHEMFILES_PARALLEL_HPP
+#define CHEMFILES_PARALLEL_HPP
+
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <exception>
+#include <system_error>
+
+#include "chemfiles/File.hpp"
+#include "chemfiles/string_view.hpp"
+
+namespace chemfiles {
+
+/// Minimal number of lines handled by each thread when parsing the atoms of a
+/// single frame in parallel in text formats. Below this, starting the threads
+/// costs more than parsing the lines.
+constexpr size_t MIN_LINES_PER_THREAD = 10000;
+
+/// Get the number of threads to use to process `count` items, such that each
+/// thread gets at least `min_per_thread` items. This is never more than the
+/// number of hardware threads, and always at least 1.
+inline size_t parallel_threads(size_t count, size_t min_per_thread) {
+    auto nthreads = static_cast<size_t>(std::thread::hardware_concurrency());
+    nthreads = std::min(nthreads, count / std::max<size_t>(min_per_thread, 1));
+    return std::max<size_t>(nthreads, 1);
+}
+
+/// Split the [0, count) range in `nchunks` contiguous chunks, and call
+/// `function(chunk, begin, end)` for each of them. Every chunk except the
+/// first one runs on a separate thread, and the first chunk runs on the
+/// calling thread. If a thread can not be started, the corresponding chunk
+/// runs on the calling thread instead.
+///
+/// This function returns once all the chunks are done. If any call to
+/// `function` throws an exception, the exception from the first such chunk is
+/// then re-thrown.
+template <typename Function>
+void parallel_for(size_t count, size_t nchunks, Function function) {
+    nchunks = std::max<size_t>(std::min(nchunks, count), 1);
+    auto errors = std::vector<std::exception_ptr>(nchunks);
+    auto run_chunk = [&](size_t chunk) {
+        try {
+            auto begin = count * chunk / nchunks;
+            auto end = count * (chunk + 1) / nchunks;
+            function(chunk, begin, end);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    auto threads = std::vector<std::thread>();
+    for (size_t chunk = 1; chunk < nchunks; chunk++) {
+        try {
+            threads.emplace_back(run_chunk, chunk);
+        } catch (const std::system_error&) {
+            // could not start a new thread, do the work on this one
+            run_chunk(chunk);
+        }
+    }
+    run_chunk(0);
+    for (auto& thread: threads) {
+        thread.join();
+    }
+
+    for (auto& error: errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/// Call `function(i, line)` for each of the next `count` lines in `file`,
+/// where `i` is the index of the line in [0, count). If there are enough
+/// lines, they are all read in memory first and then split between multiple
+/// threads, so `function` must be safe to call concurrently for different
+/// lines. Missing lines at the end of the file are passed as empty lines.
+///
+/// Each thread calls its own copy of `function`, which can then contain
+/// per-thread state such as a `FieldSplitter`.
+template <typename Function>
+void parallel_lines(TextFile& file, size_t count, Function function) {
+    auto nthreads = parallel_threads(count, MIN_LINES_PER_THREAD);
+    if (nthreads == 1) {
+        for (size_t i = 0; i < count; i++) {
+            function(i, file.readline());
+        }
+        return;
+    }
+
+    auto lines = file.readlines(count);
+    lines.resize(count, string_view());
+    parallel_for(count, nthreads, [&](size_t, size_t begin, size_t end) {
+        auto chunk_function = function;
+        for (size_t i = begin; i < end; i++) {
+            chunk_function(i, lines[i]);
+        }
+    });
+}
+
+}
+
+#endif
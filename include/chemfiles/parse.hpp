@@ -124,7 +124,7 @@ namespace detail {
 }
 
 /// Read a value of type T from the `input`. This is specialized/implemented for
-/// double, std::string, and all signed and unsigned integer types.
+/// double, std::string, string_view, and all signed and unsigned integer types.
 ///
 /// @throw chemfiles::Error if the input is empty
 template<typename T>
@@ -143,6 +143,17 @@ template<> inline std::string parse(string_view input) {
     return input.to_string();
 }
 
+/// Reads a string value from the `input`, without copying it. The result
+/// points inside `input`.
+///
+/// @throw chemfiles::Error if the input is empty
+template<> inline string_view parse(string_view input) {
+    if (input.empty()) {
+        throw error("tried to read a string, got an empty value");
+    }
+    return input;
+}
+
 /// Reads double value from the `input`. This only supports plain numbers (no
 /// hex or octal notation), with ASCII digits (the system locale is ignored).
 /// This does not support parsing NaN or infinity doubles, since they don't
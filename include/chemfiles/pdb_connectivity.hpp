@@ -4,102 +4,75 @@
 #ifndef CHEMFILES_PDB_CONNECTIVITY_HPP
 #define CHEMFILES_PDB_CONNECTIVITY_HPP
 
-#include <vector>
-#include <string>
-#include <unordered_map>
+#include <cstdint>
+#include <algorithm>
 
+#include "chemfiles/string_view.hpp"
 #include "chemfiles/external/optional.hpp"
 
 namespace chemfiles {
 
-/// A string interner for PDB connectivity. This convert an index to a string,
-/// allow to save memory in the PDB connectivity table.
+/// Atoms and bonds in a standard residue, from the PDB's connectivity table.
 ///
-/// The set of known strings is set at compile time by the pdb_connectivity.py
-/// script.
-class InternedName {
-public:
-    /// `InternedName` can be converted implicitly to string
-    operator const std::string&() const {
-        return INTERNER_.at(index_);
-    }
+/// All the data lives in constant arrays generated by the pdb_connectivity.py
+/// script, so using a template never allocates memory.
+struct ResidueTemplate {
+    /// A bond between the atoms at index `first` and `second` in `atoms`
+    struct Bond {
+        uint8_t first;
+        uint8_t second;
+    };
 
-    /// Get the string corresponding to this interned name
-    const std::string& string() const {
-        return INTERNER_.at(index_);
+    /// Name of the residue
+    const char* name;
+    /// Names of the atoms in this residue, sorted in lexicographic order
+    const char* const* atoms;
+    /// Number of atoms in this residue
+    size_t atoms_count;
+    /// Bonds between atoms in this residue, each bond is only present once
+    const Bond* bonds;
+    /// Number of bonds in this residue
+    size_t bonds_count;
+
+    /// Get the index of the atom with the given `name` in this template, or
+    /// `nullopt` if there is no such atom
+    optional<size_t> atom_index(string_view name) const {
+        auto end = atoms + atoms_count;
+        auto it = std::lower_bound(atoms, end, name, [](const char* lhs, string_view rhs) {
+            return string_view(lhs) < rhs;
+        });
+        if (it != end && string_view(*it) == name) {
+            return static_cast<size_t>(it - atoms);
+        } else {
+            return nullopt;
+        }
     }
-private:
-    InternedName(size_t index): index_(index) {}
-    size_t index_;
-
-    friend bool operator==(const InternedName&, const InternedName&);
-    friend bool operator!=(const InternedName& lhs, const InternedName& rhs);
-    friend struct std::hash<InternedName>;
-    friend class PDBConnectivity;
-
-    /// The whole list of known strings. This is generated at compile time
-    /// with the pdb_connectivity.py script.
-    static const std::vector<std::string> INTERNER_;
 };
 
-inline bool operator==(const InternedName& lhs, const InternedName& rhs) {
-    return lhs.index_ == rhs.index_;
-}
-
-inline bool operator!=(const InternedName& lhs, const InternedName& rhs) {
-    return lhs.index_ != rhs.index_;
-}
-
-inline bool operator<(const InternedName& lhs, const InternedName& rhs) {
-    return lhs.string() < rhs.string();
-}
-
-inline bool operator<=(const InternedName& lhs, const InternedName& rhs) {
-    return lhs.string() <= rhs.string();
-}
-
-inline bool operator>(const InternedName& lhs, const InternedName& rhs) {
-    return lhs.string() > rhs.string();
-}
-
-inline bool operator>=(const InternedName& lhs, const InternedName& rhs) {
-    return lhs.string() >= rhs.string();
-}
-
-}  // namespace chemfiles
-
-namespace std {
-    template<> struct hash<chemfiles::InternedName> {
-        typedef chemfiles::InternedName argument_type;
-        typedef ::size_t result_type;
-        result_type operator()(argument_type const& s) const noexcept {
-            return std::hash<::size_t>{}(s.index_);
-        }
-    };
-}
-
-namespace chemfiles {
-
 class PDBConnectivity {
 public:
-    using ResidueConnectMap = std::unordered_multimap<InternedName, InternedName>;
-    using PDBConnectMap = std::unordered_map<std::string, ResidueConnectMap>;
-
-    static optional<const ResidueConnectMap&> find(const std::string& name) {
-        const auto& it = PDB_CONNECTIVITY_MAP_.find(name);
-        if (it == PDB_CONNECTIVITY_MAP_.end()) {
-            return nullopt;
+    /// Get the template for the residue with the given `name`, or `nullptr`
+    /// if this is not a standard residue.
+    static const ResidueTemplate* find(string_view name) {
+        auto end = TEMPLATES_ + TEMPLATES_COUNT_;
+        auto it = std::lower_bound(TEMPLATES_, end, name, [](const ResidueTemplate& lhs, string_view rhs) {
+            return string_view(lhs.name) < rhs;
+        });
+        if (it != end && string_view(it->name) == name) {
+            return it;
         } else {
-            return {it->second};
+            return nullptr;
         }
     }
 
 private:
-    static const PDBConnectMap PDB_CONNECTIVITY_MAP_;
+    /// All the known residue templates, sorted by name. This is generated at
+    /// compile time with the pdb_connectivity.py script.
+    static const ResidueTemplate TEMPLATES_[];
+    /// Number of entries in `TEMPLATES_`
+    static const size_t TEMPLATES_COUNT_;
 };
 
 }  // namespace chemfiles
 
-
-
 #endif
@@ -166,6 +166,12 @@ inline Vector3D& Vector3D::operator/=(double rhs) {
 // compatible with the `chfl_vector3d` type (`double[3]`).
 static_assert(std::is_standard_layout<Vector3D>::value, "Vector3D must have a standard layout");
 
+/// 3D vector in single precision, used to store positions and velocities in
+/// frames using single precision storage (see `Frame::set_single_precision`).
+/// Like `Vector3D`, it is equivalent to a `float[3]` array.
+using Vector3F = std::array<float, 3>;
+static_assert(sizeof(Vector3F) == 3 * sizeof(float), "Vector3F must not contain padding");
+
 /// A 3x3 matrix class.
 ///
 /// This type defines the following operators, with the usual meaning:
@@ -46,6 +46,65 @@ inline bool is_ascii_whitespace(char c) {
     return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\x0C';
 }
 
+/// Split lines into fields separated by ASCII whitespace, ignoring empty
+/// fields. The storage for the fields is kept from one line to the next, so a
+/// single splitter can split many lines without allocating memory.
+class FieldSplitter {
+public:
+    using const_iterator = std::vector<string_view>::const_iterator;
+
+    /// Split `line` into fields, replacing the fields from the previous call.
+    /// The fields point inside `line`, and are only valid as long as the
+    /// underlying data is. This returns the number of fields.
+    size_t split(string_view line) {
+        fields_.clear();
+        auto current = line.data();
+        auto end = line.data() + line.size();
+        while (true) {
+            while (current != end && is_separator(*current)) {
+                current++;
+            }
+            if (current == end) {
+                break;
+            }
+
+            auto start = current;
+            while (current != end && !is_separator(*current)) {
+                current++;
+            }
+            fields_.emplace_back(start, static_cast<size_t>(current - start));
+        }
+        return fields_.size();
+    }
+
+    /// Get the number of fields in the last line
+    size_t size() const {
+        return fields_.size();
+    }
+
+    /// Get the field at index `i` in the last line
+    string_view operator[](size_t i) const {
+        return fields_[i];
+    }
+
+    const_iterator begin() const {
+        return fields_.begin();
+    }
+
+    const_iterator end() const {
+        return fields_.end();
+    }
+
+private:
+    static bool is_separator(char c) {
+        // all ASCII whitespace are smaller than or equal to ' ', so most
+        // characters only need a single comparison
+        return static_cast<unsigned char>(c) <= ' ' && is_ascii_whitespace(c);
+    }
+
+    std::vector<string_view> fields_;
+};
+
 // Check whether the given character is an ASCII lowercase letter (a-z)
 inline bool is_ascii_lowercase(char c) {
     return 'a' <= c && c <= 'z';
@@ -142,6 +201,11 @@ std::string hostname();
 std::string user_name();
 /// Get the process current directory
 std::string current_directory();
+/// Get the names of all the entries (files, directories, ...) in the
+/// directory at `path`, excluding `.` and `..`.
+///
+/// @throws FileError if the directory can not be opened
+std::vector<std::string> list_directory(const std::string& path);
 
 }
 
@@ -3,8 +3,8 @@
 
 """
 This script reads the standard connectivty table provided by
-the PDB and produces a C++ header file that maps residue names
-to their connectivity by atom name.
+the PDB and produces a C++ header file containing, for each
+residue, the sorted list of atom names and the bonds between these atoms.
 
 WARNING: The entire PDB dictionary is quite large, so it is recomended to
 only use part of it (see usage).
@@ -18,21 +18,6 @@ http://ftp.wwpdb.org/pub/pdb/data/monomers/het_dictionary.txt
 import sys
 import re
 
-class Interner:
-    def __init__(self):
-        self.list = []
-
-    def get(self, string):
-        for (i, known) in enumerate(self.list):
-            if string == known:
-                return i
-        self.list.append(string)
-        return len(self.list) - 1
-
-
-INTERNER = Interner()
-
-
 def join_and_wrap_80(indent, list):
     result = ""
     line = indent
@@ -51,16 +36,44 @@ class Residue:
         self.code = code.strip()
         self.atoms = {}
 
-    def __str__(self):
-        connectivity = []
-        for atom, connections in self.atoms.iteritems():
+    def identifier(self):
+        return re.sub(r"[^A-Za-z0-9]", "_", self.code)
+
+    def atom_names(self):
+        names = set(self.atoms.keys())
+        for connections in self.atoms.values():
+            names.update(connections)
+        return sorted(names)
+
+    def bonds(self):
+        index = {name: i for (i, name) in enumerate(self.atom_names())}
+        bonds = set()
+        for atom, connections in self.atoms.items():
             for connected in connections:
-                connectivity.append('{{{}, {}}}'.format(atom, connected))
-        connectivity = join_and_wrap_80("        ", connectivity)
-        return '{{"{}", {{\n{}    }}}}'.format(self.code, connectivity)
+                i, j = index[atom], index[connected]
+                bonds.add((min(i, j), max(i, j)))
+        return sorted(bonds)
+
+    def write_tables(self, fd):
+        names = self.atom_names()
+        bonds = self.bonds()
+        assert len(names) < 256
+
+        fd.write("const char* const ATOMS_{}[] = {{\n".format(self.identifier()))
+        fd.write(join_and_wrap_80("    ", ['"{}"'.format(name) for name in names]).rstrip("\n"))
+        fd.write("\n};\n")
+        fd.write("const ResidueTemplate::Bond BONDS_{}[] = {{\n".format(self.identifier()))
+        fd.write(join_and_wrap_80("    ", ["{{{}, {}}}".format(i, j) for (i, j) in bonds]).rstrip("\n"))
+        fd.write("\n};\n\n")
+
+    def template(self):
+        return '{{"{}", ATOMS_{}, {}, BONDS_{}, {}}}'.format(
+            self.code, self.identifier(), len(self.atom_names()),
+            self.identifier(), len(self.bonds()),
+        )
 
     def add_atom(self, name, connected):
-        self.atoms[INTERNER.get(name)] = [INTERNER.get(s) for s in connected]
+        self.atoms[name] = connected
 
 def read_residues(path, accepted_residues=None):
     residues = []
@@ -93,6 +106,9 @@ using namespace chemfiles;
 """
 
 def write_elements(path, residues):
+    # templates are looked up with a binary search on the residue name
+    residues = sorted(residues, key=lambda r: r.code)
+
     with open(path, "w") as fd:
         fd.write(HEADER)
 
@@ -100,14 +116,16 @@ def write_elements(path, residues):
         fd.write(join_and_wrap_80("// ", [r.code for r in residues]))
         fd.write("\n\n")
 
-        fd.write("const std::vector<std::string> InternedName::INTERNER_ = {\n")
-        fd.write(join_and_wrap_80("    ", ['"{}"'.format(name) for name in INTERNER.list]))
-        fd.write("};\n\n\n")
+        fd.write("namespace {\n")
+        for residue in residues:
+            residue.write_tables(fd)
+        fd.write("}\n\n")
 
-        fd.write("const PDBConnectivity::PDBConnectMap PDBConnectivity::PDB_CONNECTIVITY_MAP_ = {\n")
+        fd.write("const ResidueTemplate PDBConnectivity::TEMPLATES_[] = {\n")
         for residue in residues:
-            fd.write("    " + str(residue) + ",\n")
+            fd.write("    " + residue.template() + ",\n")
         fd.write("};\n\n")
+        fd.write("const size_t PDBConnectivity::TEMPLATES_COUNT_ = {};\n".format(len(residues)))
 
 
 def usage():
@@ -4,6 +4,7 @@
 #include <cassert>
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <unordered_map>
 
 #include "chemfiles/Atom.hpp"
@@ -26,7 +27,63 @@ static std::string normalize_atomic_name(const std::string& type) {
     return normalized;
 }
 
+/// Marker for names which are not in the short elements table
+static constexpr size_t NOT_A_SHORT_ELEMENT = static_cast<size_t>(-1);
+
+/// Get the index of a one or two ASCII letters element name in the short
+/// elements table. The index is the same for all the possible cases of the
+/// name, i.e. "CL", "Cl", "cL" and "cl" share the same index.
+static size_t short_element_index(const std::string& type) {
+    if (type.empty() || type.length() > 2) {
+        return NOT_A_SHORT_ELEMENT;
+    }
+
+    auto first = to_ascii_uppercase(type[0]);
+    if (first < 'A' || first > 'Z') {
+        return NOT_A_SHORT_ELEMENT;
+    }
+
+    // 0 is used for single letter names, and 1-26 for the second letter
+    size_t second = 0;
+    if (type.length() == 2) {
+        auto c = to_ascii_lowercase(type[1]);
+        if (c < 'a' || c > 'z') {
+            return NOT_A_SHORT_ELEMENT;
+        }
+        second = static_cast<size_t>(c - 'a') + 1;
+    }
+
+    return static_cast<size_t>(first - 'A') * 27 + second;
+}
+
+/// Get the table of elements with one or two letters names, indexed by
+/// `short_element_index`. This allow to look for most elements without
+/// having to normalize and hash the name.
+static const std::vector<const AtomicData*>& short_elements_table() {
+    static const auto TABLE = [](){
+        auto table = std::vector<const AtomicData*>(26 * 27, nullptr);
+        for (const auto& it: PERIODIC_TABLE) {
+            auto index = short_element_index(it.first);
+            if (index != NOT_A_SHORT_ELEMENT) {
+                table[index] = &it.second;
+            }
+        }
+        return table;
+    }();
+    return TABLE;
+}
+
 optional<const AtomicData&> chemfiles::find_in_periodic_table(const std::string& type) {
+    auto index = short_element_index(type);
+    if (index != NOT_A_SHORT_ELEMENT) {
+        auto element = short_elements_table()[index];
+        if (element != nullptr) {
+            return *element;
+        } else {
+            return nullopt;
+        }
+    }
+
     atomic_data_map::const_iterator it;
     if (type.length() <= 2) {
         it = PERIODIC_TABLE.find(normalize_atomic_name(type));
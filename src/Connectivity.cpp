@@ -9,6 +9,7 @@
 
 #include "chemfiles/Connectivity.hpp"
 #include "chemfiles/error_fmt.hpp"
+#include "chemfiles/parallel.hpp"
 #include "chemfiles/sorted_set.hpp"
 
 using namespace chemfiles;
@@ -99,62 +100,112 @@ size_t Improper::operator[](size_t i) const {
     return data_[i];
 }
 
-void Connectivity::recalculate() const {
-    angles_.clear();
-    dihedrals_.clear();
-    impropers_.clear();
-
-    // Generate the list of which atom is bonded to which one
-    auto bonded_to = std::vector<std::vector<size_t>>(biggest_atom_ + 1);
-    for (auto const& bond: bonds_) {
-        assert(bond[0] < bonded_to.size());
-        assert(bond[1] < bonded_to.size());
-        bonded_to[bond[0]].push_back(bond[1]);
-        bonded_to[bond[1]].push_back(bond[0]);
+/// Minimal number of bonds before using multiple threads to generate angles,
+/// dihedrals and impropers
+static constexpr size_t PARALLEL_THRESHOLD = 20000;
+
+/// Generate a sorted list of connectivity elements by calling
+/// `generate(begin, end, output)`, which should push in `output` the elements
+/// associated with the atoms in the [begin, end) range. If `parallel` is
+/// true, the atoms are split between multiple threads, and the sorted outputs
+/// of all threads are merged together.
+template <typename T, typename Function>
+static std::vector<T> generate_sorted(size_t natoms, bool parallel, Function generate) {
+    auto nthreads = parallel ? parallel_threads(natoms, 1) : 1;
+
+    auto chunks = std::vector<std::vector<T>>(nthreads);
+    parallel_for(natoms, nthreads, [&](size_t chunk, size_t begin, size_t end) {
+        generate(begin, end, chunks[chunk]);
+        std::sort(chunks[chunk].begin(), chunks[chunk].end());
+    });
+
+    auto result = std::move(chunks[0]);
+    for (size_t chunk = 1; chunk < nthreads; chunk++) {
+        auto middle = static_cast<std::ptrdiff_t>(result.size());
+        result.insert(result.end(), chunks[chunk].begin(), chunks[chunk].end());
+        std::inplace_merge(result.begin(), result.begin() + middle, result.end());
     }
 
-    // Generate the list of angles
-    for (auto const& bond: bonds_) {
-        auto i = bond[0];
-        auto j = bond[1];
-        for (auto k: bonded_to[i]) {
-            if (k != j) {
-                angles_.insert(Angle(k, i, j));
-            }
-        }
+    return result;
+}
 
-        for (auto k: bonded_to[j]) {
-            if (k != i) {
-                angles_.insert(Angle(i, j, k));
-            }
-        }
+void Connectivity::recalculate_angles() const {
+    if (!neighbors_uptodate_) {
+        recalculate_neighbors();
     }
 
-    // Generate the list of dihedrals
-    for (auto const& angle: angles_) {
-        auto i = angle[0];
-        auto j = angle[1];
-        auto k = angle[2];
-        for (auto m: bonded_to[i]) {
-            if (m != j && m != k) {
-                dihedrals_.insert(Dihedral(m, i, j, k));
+    auto natoms = neighbors_offsets_.empty() ? 0 : neighbors_offsets_.size() - 1;
+    auto parallel = bonds_.size() > PARALLEL_THRESHOLD;
+    angles_.as_mutable_vec() = generate_sorted<Angle>(natoms, parallel, [this](size_t begin, size_t end, std::vector<Angle>& angles) {
+        // all pairs of atoms bonded to the same center make an angle
+        for (size_t j = begin; j < end; j++) {
+            auto first = neighbors_offsets_[j];
+            auto last = neighbors_offsets_[j + 1];
+            for (auto a = first; a < last; a++) {
+                for (auto b = a + 1; b < last; b++) {
+                    angles.emplace_back(neighbors_[a], j, neighbors_[b]);
+                }
             }
         }
+    });
+
+    angles_uptodate_ = true;
+}
 
-        for (auto m: bonded_to[k]) {
-            if (m != i && m != j) {
-                dihedrals_.insert(Dihedral(i, j, k, m));
+void Connectivity::recalculate_dihedrals() const {
+    if (!neighbors_uptodate_) {
+        recalculate_neighbors();
+    }
+
+    auto natoms = neighbors_offsets_.empty() ? 0 : neighbors_offsets_.size() - 1;
+    auto parallel = bonds_.size() > PARALLEL_THRESHOLD;
+    dihedrals_.as_mutable_vec() = generate_sorted<Dihedral>(natoms, parallel, [this](size_t begin, size_t end, std::vector<Dihedral>& dihedrals) {
+        // each dihedral i-j-k-m is generated once, from its central j-k bond
+        for (size_t j = begin; j < end; j++) {
+            for (auto k: bonded_atoms(j)) {
+                if (k < j) {
+                    continue;
+                }
+                for (auto i: bonded_atoms(j)) {
+                    if (i == k) {
+                        continue;
+                    }
+                    for (auto m: bonded_atoms(k)) {
+                        if (m != j && m != i) {
+                            dihedrals.emplace_back(i, j, k, m);
+                        }
+                    }
+                }
             }
         }
+    });
+
+    dihedrals_uptodate_ = true;
+}
+
+void Connectivity::recalculate_impropers() const {
+    if (!neighbors_uptodate_) {
+        recalculate_neighbors();
+    }
 
-        for (auto m: bonded_to[j]) {
-            if (m != i && m != k) {
-                impropers_.insert(Improper(i, j, k, m));
+    auto natoms = neighbors_offsets_.empty() ? 0 : neighbors_offsets_.size() - 1;
+    auto parallel = bonds_.size() > PARALLEL_THRESHOLD;
+    impropers_.as_mutable_vec() = generate_sorted<Improper>(natoms, parallel, [this](size_t begin, size_t end, std::vector<Improper>& impropers) {
+        // all triplets of atoms bonded to the same center make an improper
+        for (size_t j = begin; j < end; j++) {
+            auto first = neighbors_offsets_[j];
+            auto last = neighbors_offsets_[j + 1];
+            for (auto a = first; a < last; a++) {
+                for (auto b = a + 1; b < last; b++) {
+                    for (auto c = b + 1; c < last; c++) {
+                        impropers.emplace_back(neighbors_[a], j, neighbors_[b], neighbors_[c]);
+                    }
+                }
             }
         }
-    }
+    });
 
-    uptodate_ = true;
+    impropers_uptodate_ = true;
 }
 
 const sorted_set<Bond>& Connectivity::bonds() const {
@@ -166,28 +217,75 @@ const std::vector<Bond::BondOrder>& Connectivity::bond_orders() const {
 }
 
 const sorted_set<Angle>& Connectivity::angles() const {
-    if (!uptodate_) {
-        recalculate();
+    if (!angles_uptodate_) {
+        recalculate_angles();
     }
     return angles_;
 }
 
 const sorted_set<Dihedral>& Connectivity::dihedrals() const {
-    if (!uptodate_) {
-        recalculate();
+    if (!dihedrals_uptodate_) {
+        recalculate_dihedrals();
     }
     return dihedrals_;
 }
 
 const sorted_set<Improper>& Connectivity::impropers() const {
-    if (!uptodate_) {
-        recalculate();
+    if (!impropers_uptodate_) {
+        recalculate_impropers();
     }
     return impropers_;
 }
 
+void Connectivity::invalidate_cache() {
+    angles_uptodate_ = false;
+    dihedrals_uptodate_ = false;
+    impropers_uptodate_ = false;
+    neighbors_uptodate_ = false;
+}
+
+void Connectivity::recalculate_neighbors() const {
+    auto natoms = bonds_.empty() ? 0 : biggest_atom_ + 1;
+
+    // count the number of neighbors of each atom
+    neighbors_offsets_.assign(natoms + 1, 0);
+    for (const auto& bond: bonds_) {
+        neighbors_offsets_[bond[0] + 1]++;
+        neighbors_offsets_[bond[1] + 1]++;
+    }
+
+    for (size_t i = 0; i < natoms; i++) {
+        neighbors_offsets_[i + 1] += neighbors_offsets_[i];
+    }
+
+    // the bonds are sorted, and each bond stores the smallest index first,
+    // so neighbors end up sorted for each atom
+    neighbors_.resize(2 * bonds_.size());
+    auto position = std::vector<size_t>(neighbors_offsets_.begin(), neighbors_offsets_.end() - 1);
+    for (const auto& bond: bonds_) {
+        neighbors_[position[bond[0]]++] = bond[1];
+        neighbors_[position[bond[1]]++] = bond[0];
+    }
+
+    neighbors_uptodate_ = true;
+}
+
+span<const size_t> Connectivity::bonded_atoms(size_t index) const {
+    if (!neighbors_uptodate_) {
+        recalculate_neighbors();
+    }
+
+    if (index + 1 >= neighbors_offsets_.size()) {
+        return {};
+    }
+
+    auto start = neighbors_.data() + neighbors_offsets_[index];
+    auto end = neighbors_.data() + neighbors_offsets_[index + 1];
+    return span<const size_t>(start, end);
+}
+
 void Connectivity::add_bond(size_t i, size_t j, Bond::BondOrder bond_order) {
-    uptodate_ = false;
+    invalidate_cache();
     auto result = bonds_.emplace(i, j);
     if (i > biggest_atom_) {biggest_atom_ = i;}
     if (j > biggest_atom_) {biggest_atom_ = j;}
@@ -198,47 +296,72 @@ void Connectivity::add_bond(size_t i, size_t j, Bond::BondOrder bond_order) {
     }
 }
 
-void Connectivity::remove_bond(size_t i, size_t j) {
-    auto pos = bonds_.find(Bond(i, j));
-    if (pos != bonds_.end()) {
-        uptodate_ = false;
-        auto result = bonds_.erase(pos);
-
-        auto diff = std::distance(bonds_.cbegin(), result);
-        bond_orders_.erase(bond_orders_.begin() + diff);
-        assert(bond_orders_.size() == bonds_.size());
+void Connectivity::add_bonds(const std::vector<Bond>& bonds, const std::vector<Bond::BondOrder>& bond_orders) {
+    if (!bond_orders.empty() && bond_orders.size() != bonds.size()) {
+        throw error(
+            "mismatched sizes in `Connectivity::add_bonds`: got {} bonds "
+            "and {} bond orders", bonds.size(), bond_orders.size()
+        );
     }
-}
 
-void Connectivity::atom_removed(size_t index) {
-    auto to_remove = std::vector<Bond>();
-    auto to_add = std::vector<Bond>();
-    auto bo_add = std::vector<Bond::BondOrder>();
+    if (bonds.empty()) {
+        return;
+    }
 
-    const auto& bonds = bonds_.as_vec();
-    for (size_t idx = 0; idx < bonds_.size(); idx++) {
-        const auto& bond = bonds[idx];
+    invalidate_cache();
 
-        if (bond[0] == index || bond[1] == index) {
-            throw error("can not shift atomic indexes that still have a bond");
+    // sort the new bonds, keeping duplicated bonds in insertion order
+    auto order = std::vector<size_t>(bonds.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+        biggest_atom_ = std::max(biggest_atom_, bonds[i][1]);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t i, size_t j) {
+        return bonds[i] < bonds[j];
+    });
+
+    // merge the new bonds with the existing ones. When a bond is present
+    // multiple times, we keep the first one (existing bonds come first).
+    const auto& existing = bonds_.as_vec();
+    auto merged = std::vector<Bond>();
+    auto merged_orders = std::vector<Bond::BondOrder>();
+    merged.reserve(existing.size() + bonds.size());
+    merged_orders.reserve(existing.size() + bonds.size());
+
+    size_t existing_i = 0;
+    size_t new_i = 0;
+    while (existing_i < existing.size() || new_i < order.size()) {
+        if (new_i == order.size() || (existing_i < existing.size() && existing[existing_i] <= bonds[order[new_i]])) {
+            merged.push_back(existing[existing_i]);
+            merged_orders.push_back(bond_orders_[existing_i]);
+            existing_i++;
+        } else {
+            auto index = order[new_i];
+            merged.push_back(bonds[index]);
+            merged_orders.push_back(bond_orders.empty() ? Bond::UNKNOWN : bond_orders[index]);
+            new_i++;
         }
-        if (bond[0] > index || bond[1] > index) {
-            to_remove.push_back(bond);
 
-            auto i = bond[0] > index ? bond[0] - 1 : bond[0];
-            auto j = bond[1] > index ? bond[1] - 1 : bond[1];
-            to_add.emplace_back(i, j);
-            bo_add.push_back(bond_orders_[idx]);
+        // skip duplicates of the bond we just added
+        while (new_i < order.size() && bonds[order[new_i]] == merged.back()) {
+            new_i++;
         }
     }
 
-    for (auto bond: to_remove) {
-        this->remove_bond(bond[0], bond[1]);
-    }
+    bonds_.as_mutable_vec() = std::move(merged);
+    bond_orders_ = std::move(merged_orders);
+    assert(bond_orders_.size() == bonds_.size());
+}
 
-    for (size_t idx = 0; idx < to_add.size(); idx++) {
-        const auto& bond = to_add[idx];
-        this->add_bond(bond[0], bond[1], bo_add[idx]);
+void Connectivity::remove_bond(size_t i, size_t j) {
+    auto pos = bonds_.find(Bond(i, j));
+    if (pos != bonds_.end()) {
+        invalidate_cache();
+        auto result = bonds_.erase(pos);
+
+        auto diff = std::distance(bonds_.cbegin(), result);
+        bond_orders_.erase(bond_orders_.begin() + diff);
+        assert(bond_orders_.size() == bonds_.size());
     }
 }
 
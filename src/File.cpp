@@ -1,13 +1,15 @@
 // Chemfiles, a modern library for chemistry file reading and writing
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
 
+#include <cmath>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
-#include <iterator>
+#include <utility>
 
 #include <fmt/format.h>
 
@@ -20,12 +22,64 @@
 #include "chemfiles/files/MemoryBuffer.hpp"
 
 #include "chemfiles/cpp14.hpp"
+#include "chemfiles/warnings.hpp"
 #include "chemfiles/error_fmt.hpp"
 #include "chemfiles/string_view.hpp"
 #include "chemfiles/unreachable.hpp"
 
 using namespace chemfiles;
 
+/// Size of the write buffer after which we send the data to the underlying
+/// `TextFileImpl`
+static constexpr size_t WRITE_BUFFER_SIZE = 64 * 1024;
+
+/// Powers of ten which are exactly representable as doubles, used to scale
+/// values in `TextFile::print_fixed` and `TextFile::print_general`
+static constexpr double POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10
+};
+
+/// Largest value for which all integers and halves are exactly representable
+/// as doubles
+static constexpr double MAX_EXACT_SCALED = 4503599627370496.0; // 2^52
+
+/// Round `value * scale` to the nearest integer, with ties to even (the same
+/// rounding used by fmt). The product is rounded once by the multiplication,
+/// so we use the exact remainder given by `fma` to break near-ties. `value`
+/// must be positive, `scale` an exact power of ten, and `value * scale`
+/// smaller than `MAX_EXACT_SCALED`.
+static uint64_t round_scaled(double value, double scale) {
+    auto product = value * scale;
+    auto remainder = std::fma(value, scale, -product);
+    auto integer = std::floor(product);
+    auto rounded = static_cast<uint64_t>(integer);
+    // both terms are multiples of ulp(product), so this is exact
+    auto above_half = (product - integer) - 0.5;
+    if (above_half > 0 || (above_half == 0 && (remainder > 0 || (remainder == 0 && rounded % 2 == 1)))) {
+        rounded += 1;
+    }
+    return rounded;
+}
+
+/// Write `value / 10^fraction_digits` as a decimal number with exactly
+/// `fraction_digits` digits after the decimal point, in the characters before
+/// `end`. This returns a pointer to the first character written.
+static char* write_decimal(char* end, uint64_t value, unsigned fraction_digits) {
+    auto it = end;
+    for (unsigned i = 0; i < fraction_digits; i++) {
+        *--it = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    if (fraction_digits != 0) {
+        *--it = '.';
+    }
+    do {
+        *--it = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    return it;
+}
+
 TextFile::TextFile(std::string path, File::Mode mode, File::Compression compression):
     File(std::move(path), mode, compression),
     file_(nullptr),
@@ -73,6 +127,19 @@ TextFile::TextFile(std::shared_ptr<MemoryBuffer> memory, File::Mode mode, File::
     file_ = chemfiles::make_unique<MemoryFile>(std::move(memory), mode);
 }
 
+TextFile::~TextFile() {
+    if (file_ == nullptr) {
+        // this file was moved from
+        return;
+    }
+
+    try {
+        flush();
+    } catch (const std::exception& e) {
+        warning("text file writer", "failed to write data when closing '{}': {}", path(), e.what());
+    }
+}
+
 uint64_t TextFile::tellpos() const {
     assert(line_start_ >= buffer_.data());
     auto delta = buffer_initialized() ? static_cast<uint64_t>(line_start_ - buffer_.data()) : 0;
@@ -80,6 +147,7 @@ uint64_t TextFile::tellpos() const {
 }
 
 void TextFile::seekpos(uint64_t position) {
+    flush();
     got_impl_eof_ = false;
     eof_ = false;
 
@@ -200,15 +268,188 @@ string_view TextFile::readline() {
     return line;
 }
 
+std::vector<string_view> TextFile::readlines(size_t count) {
+    // Initialize buffer if needed
+    if (!buffer_initialized()) {
+        fill_buffer(0);
+    }
+
+    // start and length of all lines, relative to line_start_ since the data
+    // can be moved inside the buffer while reading
+    auto offsets = std::vector<std::pair<size_t, size_t>>();
+    offsets.reserve(count);
+
+    size_t length = 0;
+    while (offsets.size() < count && !eof_) {
+        auto current = line_start_ + length;
+        auto remainder = static_cast<size_t>(end_ - current);
+        auto needle = std::memchr(current, '\n', remainder);
+        auto newline = reinterpret_cast<const char*>(needle);
+
+        if (newline != nullptr) {
+            auto line_length = static_cast<size_t>(newline - current);
+            // Check if we have a windows style line ending (\r\n)
+            size_t windows_line = (line_length != 0 && newline[-1] == '\r') ? 1 : 0;
+            offsets.emplace_back(length, line_length - windows_line);
+            length += line_length + 1;
+            continue;
+        } else if (got_impl_eof_) {
+            // no more data, the buffer is terminated with zeroes so we can
+            // use std::strlen to find the last line
+            eof_ = true;
+            auto line = string_view(current);
+            if (!line.empty()) {
+                offsets.emplace_back(length, line.length());
+                length += line.length();
+            }
+            break;
+        }
+
+        // get more data, keeping all the lines read until now in the buffer
+        auto used = static_cast<size_t>(end_ - line_start_);
+        if (line_start_ == buffer_.data()) {
+            // the lines fill the whole buffer, we need to increase its size
+            buffer_.resize(2 * buffer_.size(), 0);
+            end_ = buffer_.data() + buffer_.size();
+        } else {
+            position_ += static_cast<uint64_t>(line_start_ - buffer_.data());
+            std::memmove(buffer_.data(), line_start_, used);
+        }
+        line_start_ = buffer_.data();
+
+        auto missing = buffer_.size() - used;
+        auto read_count = file_->read(buffer_.data() + used, missing);
+        if (read_count < missing) {
+            got_impl_eof_ = true;
+            // Erase any remaining data in the buffer
+            std::memset(buffer_.data() + used + read_count, 0, missing - read_count);
+        }
+    }
+
+    auto lines = std::vector<string_view>();
+    lines.reserve(offsets.size());
+    for (auto& offset: offsets) {
+        lines.emplace_back(line_start_ + offset.first, offset.second);
+    }
+    line_start_ += length;
+
+    return lines;
+}
+
 void TextFile::vprint(fmt::string_view format, fmt::format_args args) {
-    std::string buffer;
-    buffer.reserve(128);
-    fmt::vformat_to(std::back_inserter(buffer), format, args);
-    if (buffer.size() == 0) {
+    auto initial_size = write_buffer_.size();
+    fmt::vformat_to(write_buffer_, format, args);
+    position_ += write_buffer_.size() - initial_size;
+
+    if (write_buffer_.size() >= WRITE_BUFFER_SIZE || this->mode() == File::READ) {
+        // in read mode, let the implementation report the error right away
+        flush();
+    }
+}
+
+void TextFile::print_fixed(double value, unsigned width, unsigned precision) {
+    auto magnitude = std::fabs(value);
+    auto max_precision = sizeof(POWERS_OF_TEN) / sizeof(double) - 1;
+    if (width > 32 || precision > max_precision || !(magnitude * POWERS_OF_TEN[precision] < MAX_EXACT_SCALED)) {
+        // large or non-finite values are handled by fmt
+        this->print("{:{}.{}f}", value, width, precision);
+        return;
+    }
+
+    // at most 16 digits before the decimal point, 10 after, and the sign
+    char buffer[64];
+    auto end = buffer + sizeof(buffer);
+    auto start = write_decimal(end, round_scaled(magnitude, POWERS_OF_TEN[precision]), precision);
+    if (std::signbit(value)) {
+        *--start = '-';
+    }
+    while (end - start < static_cast<ptrdiff_t>(width)) {
+        *--start = ' ';
+    }
+    this->print_buffered(start, static_cast<size_t>(end - start));
+}
+
+void TextFile::print_general(double value) {
+    // `{:g}` uses 6 significant digits, and fixed notation for decimal
+    // exponents between -4 and 5 (after rounding). Everything else is
+    // handled by fmt.
+    auto magnitude = std::fabs(value);
+    if (!(magnitude >= 1e-5 && magnitude < 1e6)) {
+        this->print("{:g}", value);
+        return;
+    }
+
+    // find the decimal exponent of the value, using exact comparisons for
+    // positive exponents. The multiplication is rounded for negative
+    // exponents, so the estimate can be one too large.
+    int exponent = 0;
+    if (magnitude >= 1.0) {
+        while (exponent < 5 && magnitude >= POWERS_OF_TEN[exponent + 1]) {
+            exponent++;
+        }
+    } else {
+        while (exponent > -5 && magnitude * POWERS_OF_TEN[-exponent] < 1.0) {
+            exponent--;
+        }
+    }
+    if (magnitude * POWERS_OF_TEN[5 - exponent] < 1e5) {
+        exponent--;
+    }
+
+    // round to 6 significant digits, which can increase the exponent
+    auto digits = round_scaled(magnitude, POWERS_OF_TEN[5 - exponent]);
+    if (digits == 1000000) {
+        digits = 100000;
+        exponent++;
+    }
+
+    if (exponent < -4 || exponent > 5) {
+        // this needs scientific notation
+        this->print("{:g}", value);
+        return;
+    }
+
+    // remove trailing zeros
+    auto fraction_digits = static_cast<unsigned>(5 - exponent);
+    while (fraction_digits != 0 && digits % 10 == 0) {
+        digits /= 10;
+        fraction_digits--;
+    }
+
+    char buffer[32];
+    auto end = buffer + sizeof(buffer);
+    auto start = write_decimal(end, digits, fraction_digits);
+    if (std::signbit(value)) {
+        *--start = '-';
+    }
+    this->print_buffered(start, static_cast<size_t>(end - start));
+}
+
+void TextFile::print_buffered(const char* data, size_t count) {
+    write_buffer_.append(data, data + count);
+    position_ += count;
+
+    if (write_buffer_.size() >= WRITE_BUFFER_SIZE || this->mode() == File::READ) {
+        // in read mode, let the implementation report the error right away
+        flush();
+    }
+}
+
+void TextFile::write(const char* data, size_t count) {
+    flush();
+    file_->write(data, count);
+    position_ += count;
+}
+
+void TextFile::flush() {
+    if (write_buffer_.size() == 0) {
         return;
     }
-    file_->write(buffer.data(), buffer.size());
-    position_ += buffer.size();
+    // clear the buffer before writing, to make sure we do not try to write
+    // the same data again if this fails. This does not release the memory.
+    auto size = write_buffer_.size();
+    write_buffer_.clear();
+    file_->write(write_buffer_.data(), size);
 }
 
 std::string TextFile::readall() {
@@ -65,6 +65,14 @@ void TextFormat::write_next(const Frame& /*unused*/) {
 #pragma GCC diagnostic pop
 #endif
 
+bool Format::set_atom_subset(std::vector<size_t> /*unused*/) {
+    return false;
+}
+
+bool Format::write_single_precision() const {
+    return false;
+}
+
 TextFormat::TextFormat(std::string path, File::Mode mode, File::Compression compression) :
     file_(std::move(path), mode, compression) {}
 
@@ -140,6 +148,16 @@ void TextFormat::read(Frame& frame) {
 
 void TextFormat::write(const Frame& frame) {
     write_next(frame);
+    file_.flush();
+    steps_positions_.push_back(file_.tellpos());
+}
+
+bool TextFormat::independent_steps() const {
+    return false;
+}
+
+void TextFormat::write_serialized(const char* data, size_t count) {
+    file_.write(data, count);
     steps_positions_.push_back(file_.tellpos());
 }
 
@@ -41,6 +41,8 @@
 #include "chemfiles/formats/TRR.hpp"
 #include "chemfiles/formats/XTC.hpp"
 #include "chemfiles/formats/CIF.hpp"
+#include "chemfiles/formats/BinaryCIF.hpp"
+#include "chemfiles/formats/ChemfilesBinary.hpp"
 
 #define SENTINEL_INDEX (static_cast<size_t>(-1))
 
@@ -64,6 +66,8 @@ FormatFactory::FormatFactory() {
     // add formats in alphabetic order
     this->add_format<AmberRestart>();
     this->add_format<AmberTrajectory>();
+    this->add_format<BinaryCIFFormat>();
+    this->add_format<ChemfilesBinaryFormat>();
 #ifndef CHFL_DISABLE_GEMMI
     this->add_format<CIFFormat>();
 #endif
@@ -72,7 +76,9 @@ FormatFactory::FormatFactory() {
     this->add_format<Molfile<DCD>>();
     this->add_format<GROFormat>();
     this->add_format<LAMMPSTrajectoryFormat>();
+    this->add_format<LAMMPSBinaryFormat>();
     this->add_format<LAMMPSDataFormat>();
+    this->add_format<LAMMPSMultiFileFormat>();
     this->add_format<mmCIFFormat>();
     this->add_format<MMTFFormat>();
     this->add_format<MOL2Format>();
@@ -30,35 +30,291 @@ static optional<double> guess_bonds_radius(const Atom& atom);
 Frame::Frame(UnitCell cell): cell_(std::move(cell)) {} // NOLINT: std::move for trivially copyable type
 
 size_t Frame::size() const {
-    assert(positions_.size() == topology_.size());
-    if (velocities_) {
-        assert(positions_.size() == velocities_->size());
+    if (single_precision_) {
+        assert(positions_f32_.size() == topology_.size());
+        if (velocities_f32_) {
+            assert(positions_f32_.size() == velocities_f32_->size());
+        }
+    } else {
+        assert(positions_.size() == topology_.size());
+        if (velocities_) {
+            assert(positions_.size() == velocities_->size());
+        }
+    }
+    for (const auto& column: double_columns_) {
+        assert(topology_.size() == column.second.size());
+    }
+    for (const auto& column: vector3d_columns_) {
+        assert(topology_.size() == column.second.size());
+    }
+    return topology_.size();
+}
+
+static Vector3F to_single_precision(const Vector3D& vector) {
+    return {{
+        static_cast<float>(vector[0]),
+        static_cast<float>(vector[1]),
+        static_cast<float>(vector[2]),
+    }};
+}
+
+static Vector3D to_double_precision(const Vector3F& vector) {
+    return {
+        static_cast<double>(vector[0]),
+        static_cast<double>(vector[1]),
+        static_cast<double>(vector[2]),
+    };
+}
+
+void Frame::set_single_precision(bool single) {
+    if (single == single_precision_) {
+        return;
+    }
+
+    if (single) {
+        positions_f32_.resize(positions_.size());
+        for (size_t i = 0; i < positions_.size(); i++) {
+            positions_f32_[i] = to_single_precision(positions_[i]);
+        }
+        if (velocities_) {
+            velocities_f32_ = std::vector<Vector3F>(velocities_->size());
+            for (size_t i = 0; i < velocities_->size(); i++) {
+                (*velocities_f32_)[i] = to_single_precision((*velocities_)[i]);
+            }
+        }
+        // release the memory used by the double precision data
+        positions_ = std::vector<Vector3D>();
+        velocities_ = nullopt;
+    } else {
+        // the double precision copy already contains the data
+        update_double_precision_mirror();
+        positions_ = std::move(positions_mirror_);
+        velocities_ = std::move(velocities_mirror_);
+        positions_f32_ = std::vector<Vector3F>();
+        velocities_f32_ = nullopt;
+    }
+    positions_mirror_ = std::vector<Vector3D>();
+    velocities_mirror_ = nullopt;
+    mirror_uptodate_ = false;
+    single_precision_ = single;
+}
+
+void Frame::update_double_precision_mirror() const {
+    if (mirror_uptodate_) {
+        return;
+    }
+
+    positions_mirror_.resize(positions_f32_.size());
+    for (size_t i = 0; i < positions_f32_.size(); i++) {
+        positions_mirror_[i] = to_double_precision(positions_f32_[i]);
+    }
+
+    if (velocities_f32_) {
+        if (!velocities_mirror_) {
+            velocities_mirror_ = std::vector<Vector3D>();
+        }
+        velocities_mirror_->resize(velocities_f32_->size());
+        for (size_t i = 0; i < velocities_f32_->size(); i++) {
+            (*velocities_mirror_)[i] = to_double_precision((*velocities_f32_)[i]);
+        }
+    } else {
+        velocities_mirror_ = nullopt;
+    }
+    mirror_uptodate_ = true;
+}
+
+static void check_single_precision(bool single_precision, const char* function) {
+    if (!single_precision) {
+        throw error(
+            "can not call `Frame::{}` on a frame using double precision "
+            "storage, use `Frame::set_single_precision` first", function
+        );
+    }
+}
+
+span<Vector3F> Frame::positions_f32() {
+    check_single_precision(single_precision_, "positions_f32");
+    mirror_uptodate_ = false;
+    return positions_f32_;
+}
+
+const std::vector<Vector3F>& Frame::positions_f32() const {
+    check_single_precision(single_precision_, "positions_f32");
+    return positions_f32_;
+}
+
+optional<span<Vector3F>> Frame::velocities_f32() {
+    check_single_precision(single_precision_, "velocities_f32");
+    mirror_uptodate_ = false;
+    if (velocities_f32_) {
+        return {*velocities_f32_};
+    } else {
+        return nullopt;
+    }
+}
+
+optional<const std::vector<Vector3F>&> Frame::velocities_f32() const {
+    check_single_precision(single_precision_, "velocities_f32");
+    if (velocities_f32_) {
+        return {*velocities_f32_};
+    } else {
+        return nullopt;
+    }
+}
+
+Vector3D Frame::position(size_t i) const {
+    if (single_precision_) {
+        return to_double_precision(positions_f32_[i]);
+    } else {
+        return positions_[i];
     }
-    return positions_.size();
 }
 
 void Frame::resize(size_t size) {
     topology_.resize(size);
-    positions_.resize(size);
-    if (velocities_) {
-        velocities_->resize(size);
+    if (single_precision_) {
+        mirror_uptodate_ = false;
+        positions_f32_.resize(size);
+        if (velocities_f32_) {
+            velocities_f32_->resize(size);
+        }
+    } else {
+        positions_.resize(size);
+        if (velocities_) {
+            velocities_->resize(size);
+        }
+    }
+    for (auto& column: double_columns_) {
+        column.second.resize(size);
+    }
+    for (auto& column: vector3d_columns_) {
+        column.second.resize(size);
     }
 }
 
 void Frame::reserve(size_t size) {
     topology_.reserve(size);
-    positions_.reserve(size);
-    if (velocities_) {
-        velocities_->reserve(size);
+    if (single_precision_) {
+        positions_f32_.reserve(size);
+        if (velocities_f32_) {
+            velocities_f32_->reserve(size);
+        }
+    } else {
+        positions_.reserve(size);
+        if (velocities_) {
+            velocities_->reserve(size);
+        }
+    }
+    for (auto& column: double_columns_) {
+        column.second.reserve(size);
+    }
+    for (auto& column: vector3d_columns_) {
+        column.second.reserve(size);
     }
 }
 
 void Frame::add_velocities() {
-    if (!velocities_) {
+    if (single_precision_) {
+        if (!velocities_f32_) {
+            mirror_uptodate_ = false;
+            velocities_f32_ = std::vector<Vector3F>(size());
+        }
+    } else if (!velocities_) {
         velocities_ = std::vector<Vector3D>(size());
     }
 }
 
+/// Find the column with the given `name` in `columns`
+template <typename Columns>
+static auto find_column(Columns& columns, const std::string& name) -> decltype(columns.begin()) {
+    return std::find_if(columns.begin(), columns.end(), [&](const typename Columns::value_type& column) {
+        return column.first == name;
+    });
+}
+
+template <typename T>
+span<T> Frame::add_column(const std::string& name) {
+    auto& columns = columns_storage(static_cast<T*>(nullptr));
+    auto it = find_column(columns, name);
+    if (it != columns.end()) {
+        return it->second;
+    }
+
+    if (column_kind(name)) {
+        throw error(
+            "can not add a column named '{}' to this frame: there is already "
+            "a column with this name and a different type", name
+        );
+    }
+
+    columns.emplace_back(name, std::vector<T>(size()));
+    return columns.back().second;
+}
+
+template <typename T>
+optional<span<T>> Frame::column(const std::string& name) {
+    auto& columns = columns_storage(static_cast<T*>(nullptr));
+    auto it = find_column(columns, name);
+    if (it != columns.end()) {
+        return {it->second};
+    } else {
+        return nullopt;
+    }
+}
+
+template <typename T>
+optional<const std::vector<T>&> Frame::column(const std::string& name) const {
+    const auto& columns = columns_storage(static_cast<T*>(nullptr));
+    auto it = find_column(columns, name);
+    if (it != columns.end()) {
+        return {it->second};
+    } else {
+        return nullopt;
+    }
+}
+
+template span<double> Frame::add_column<double>(const std::string& name);
+template span<Vector3D> Frame::add_column<Vector3D>(const std::string& name);
+template optional<span<double>> Frame::column<double>(const std::string& name);
+template optional<span<Vector3D>> Frame::column<Vector3D>(const std::string& name);
+template optional<const std::vector<double>&> Frame::column<double>(const std::string& name) const;
+template optional<const std::vector<Vector3D>&> Frame::column<Vector3D>(const std::string& name) const;
+
+optional<Property::Kind> Frame::column_kind(const std::string& name) const {
+    if (find_column(double_columns_, name) != double_columns_.end()) {
+        return Property::DOUBLE;
+    } else if (find_column(vector3d_columns_, name) != vector3d_columns_.end()) {
+        return Property::VECTOR3D;
+    } else {
+        return nullopt;
+    }
+}
+
+std::vector<std::string> Frame::columns() const {
+    auto names = std::vector<std::string>();
+    names.reserve(double_columns_.size() + vector3d_columns_.size());
+    for (const auto& column: double_columns_) {
+        names.push_back(column.first);
+    }
+    for (const auto& column: vector3d_columns_) {
+        names.push_back(column.first);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+void Frame::remove_column(const std::string& name) {
+    auto double_it = find_column(double_columns_, name);
+    if (double_it != double_columns_.end()) {
+        double_columns_.erase(double_it);
+    }
+
+    auto vector3d_it = find_column(vector3d_columns_, name);
+    if (vector3d_it != vector3d_columns_.end()) {
+        vector3d_columns_.erase(vector3d_it);
+    }
+}
+
 void Frame::guess_bonds() {
     topology_.clear_bonds();
     // This bond guessing algorithm comes from VMD
@@ -69,6 +325,7 @@ void Frame::guess_bonds() {
     }
     cutoff = 1.2 * cutoff;
 
+    auto bonds = std::vector<Bond>();
     for (size_t i = 0; i < size(); i++) {
         auto i_radius = guess_bonds_radius(topology_[i]);
         if (!i_radius) {
@@ -86,38 +343,33 @@ void Frame::guess_bonds() {
             auto d = distance(i, j);
             auto radii = i_radius.value() + j_radius.value();
             if (0.03 < d && d < 0.6 * radii && d < cutoff) {
-                topology_.add_bond(i, j);
+                bonds.emplace_back(i, j);
             }
         }
     }
 
-    auto bonds = topology().bonds();
-    auto to_remove = std::vector<Bond>();
     // We need to remove bonds between hydrogen atoms which are bonded more than
     // once
-    for (auto& bond : bonds) {
-        auto i = bond[0], j = bond[1];
-        if (topology_[i].type() != "H") {
-            continue;
-        }
-        if (topology_[j].type() != "H") {
-            continue;
-        }
-
-        auto nbonds = std::count_if(
-            std::begin(bonds), std::end(bonds), [=](const Bond& b) {
-                return b[0] == i || b[0] == j || b[1] == i || b[1] == j;
-            });
-        assert(nbonds >= 1);
-
-        if (nbonds != 1) {
-            to_remove.push_back(bond);
-        }
+    auto nbonds = std::vector<size_t>(size(), 0);
+    for (const auto& bond: bonds) {
+        nbonds[bond[0]]++;
+        nbonds[bond[1]]++;
     }
 
-    for (auto& bond : to_remove) {
-        topology_.remove_bond(bond[0], bond[1]);
-    }
+    auto is_bonded_hydrogens = [&](const Bond& bond) {
+        auto i = bond[0], j = bond[1];
+        if (topology_[i].type() != "H" || topology_[j].type() != "H") {
+            return false;
+        }
+        // nbonds counts this bond twice, once for each atom
+        return nbonds[i] + nbonds[j] != 2;
+    };
+    bonds.erase(
+        std::remove_if(bonds.begin(), bonds.end(), is_bonded_hydrogens),
+        bonds.end()
+    );
+
+    topology_.add_bonds(bonds);
 }
 
 void Frame::set_topology(Topology topology) {
@@ -132,9 +384,23 @@ void Frame::set_topology(Topology topology) {
 
 void Frame::add_atom(Atom atom, Vector3D position, Vector3D velocity) {
     topology_.add_atom(std::move(atom));
-    positions_.push_back(position);
-    if (velocities_) {
-        velocities_->push_back(velocity);
+    if (single_precision_) {
+        mirror_uptodate_ = false;
+        positions_f32_.push_back(to_single_precision(position));
+        if (velocities_f32_) {
+            velocities_f32_->push_back(to_single_precision(velocity));
+        }
+    } else {
+        positions_.push_back(position);
+        if (velocities_) {
+            velocities_->push_back(velocity);
+        }
+    }
+    for (auto& column: double_columns_) {
+        column.second.emplace_back();
+    }
+    for (auto& column: vector3d_columns_) {
+        column.second.emplace_back();
     }
     assert(size() == topology_.size());
 }
@@ -148,13 +414,132 @@ void Frame::remove(size_t i) {
         );
     }
     topology_.remove(i);
-    positions_.erase(positions_.begin() + static_cast<std::ptrdiff_t>(i));
-    if (velocities_) {
-        velocities_->erase(velocities_->begin() + static_cast<std::ptrdiff_t>(i));
+    if (single_precision_) {
+        mirror_uptodate_ = false;
+        positions_f32_.erase(positions_f32_.begin() + static_cast<std::ptrdiff_t>(i));
+        if (velocities_f32_) {
+            velocities_f32_->erase(velocities_f32_->begin() + static_cast<std::ptrdiff_t>(i));
+        }
+    } else {
+        positions_.erase(positions_.begin() + static_cast<std::ptrdiff_t>(i));
+        if (velocities_) {
+            velocities_->erase(velocities_->begin() + static_cast<std::ptrdiff_t>(i));
+        }
+    }
+    for (auto& column: double_columns_) {
+        column.second.erase(column.second.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+    for (auto& column: vector3d_columns_) {
+        column.second.erase(column.second.begin() + static_cast<std::ptrdiff_t>(i));
     }
     assert(size() == topology_.size());
 }
 
+/// Remove all the values marked in `removed` from `values`
+template <typename T>
+static void remove_marked(std::vector<T>& values, const std::vector<bool>& removed) {
+    size_t kept = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        if (!removed[i]) {
+            values[kept] = values[i];
+            kept++;
+        }
+    }
+    values.resize(kept);
+}
+
+void Frame::remove(const std::vector<size_t>& indices) {
+    auto removed = std::vector<bool>(size(), false);
+    for (auto i: indices) {
+        if (i >= size()) {
+            throw out_of_bounds(
+                "out of bounds atomic index in `Frame::remove`: we have {} atoms, "
+                "but the index is {}",
+                size(), i
+            );
+        }
+        removed[i] = true;
+    }
+
+    topology_.remove(indices);
+    if (single_precision_) {
+        mirror_uptodate_ = false;
+        remove_marked(positions_f32_, removed);
+        if (velocities_f32_) {
+            remove_marked(*velocities_f32_, removed);
+        }
+    } else {
+        remove_marked(positions_, removed);
+        if (velocities_) {
+            remove_marked(*velocities_, removed);
+        }
+    }
+    for (auto& column: double_columns_) {
+        remove_marked(column.second, removed);
+    }
+    for (auto& column: vector3d_columns_) {
+        remove_marked(column.second, removed);
+    }
+    assert(size() == topology_.size());
+}
+
+Frame Frame::subset(const std::vector<size_t>& indices) const {
+    auto result = Frame(cell_);
+    result.step_ = step_;
+    result.properties_ = properties_;
+    result.topology_ = topology_.subset(indices);
+
+    if (single_precision_) {
+        result.single_precision_ = true;
+        result.positions_f32_.reserve(indices.size());
+        for (auto i: indices) {
+            result.positions_f32_.push_back(positions_f32_[i]);
+        }
+
+        if (velocities_f32_) {
+            result.velocities_f32_ = std::vector<Vector3F>();
+            result.velocities_f32_->reserve(indices.size());
+            for (auto i: indices) {
+                result.velocities_f32_->push_back((*velocities_f32_)[i]);
+            }
+        }
+    } else {
+        result.positions_.reserve(indices.size());
+        for (auto i: indices) {
+            result.positions_.push_back(positions_[i]);
+        }
+
+        if (velocities_) {
+            result.velocities_ = std::vector<Vector3D>();
+            result.velocities_->reserve(indices.size());
+            for (auto i: indices) {
+                result.velocities_->push_back((*velocities_)[i]);
+            }
+        }
+    }
+
+    for (const auto& column: double_columns_) {
+        result.double_columns_.emplace_back(column.first, std::vector<double>());
+        auto& values = result.double_columns_.back().second;
+        values.reserve(indices.size());
+        for (auto i: indices) {
+            values.push_back(column.second[i]);
+        }
+    }
+
+    for (const auto& column: vector3d_columns_) {
+        result.vector3d_columns_.emplace_back(column.first, std::vector<Vector3D>());
+        auto& values = result.vector3d_columns_.back().second;
+        values.reserve(indices.size());
+        for (auto i: indices) {
+            values.push_back(column.second[i]);
+        }
+    }
+
+    assert(result.size() == result.topology_.size());
+    return result;
+}
+
 double Frame::distance(size_t i, size_t j) const {
     if (i >= size() || j >= size()) {
         throw out_of_bounds(
@@ -164,7 +549,7 @@ double Frame::distance(size_t i, size_t j) const {
         );
     }
 
-    auto rij = positions_[i] - positions_[j];
+    auto rij = position(i) - position(j);
     return cell_.wrap(rij).norm();
 }
 
@@ -177,8 +562,8 @@ double Frame::angle(size_t i, size_t j, size_t k) const {
         );
     }
 
-    auto rij = cell_.wrap(positions_[i] - positions_[j]);
-    auto rkj = cell_.wrap(positions_[k] - positions_[j]);
+    auto rij = cell_.wrap(position(i) - position(j));
+    auto rkj = cell_.wrap(position(k) - position(j));
 
     auto cos = dot(rij, rkj) / (rij.norm() * rkj.norm());
     cos = std::max(-1.0, std::min(1.0, cos));
@@ -194,9 +579,9 @@ double Frame::dihedral(size_t i, size_t j, size_t k, size_t m) const {
         );
     }
 
-    auto rij = cell_.wrap(positions_[i] - positions_[j]);
-    auto rjk = cell_.wrap(positions_[j] - positions_[k]);
-    auto rkm = cell_.wrap(positions_[k] - positions_[m]);
+    auto rij = cell_.wrap(position(i) - position(j));
+    auto rjk = cell_.wrap(position(j) - position(k));
+    auto rkm = cell_.wrap(position(k) - position(m));
 
     auto a = cross(rij, rjk);
     auto b = cross(rjk, rkm);
@@ -212,9 +597,9 @@ double Frame::out_of_plane(size_t i, size_t j, size_t k, size_t m) const {
         );
     }
 
-    auto rji = cell_.wrap(positions_[j] - positions_[i]);
-    auto rik = cell_.wrap(positions_[i] - positions_[k]);
-    auto rim = cell_.wrap(positions_[i] - positions_[m]);
+    auto rji = cell_.wrap(position(j) - position(i));
+    auto rik = cell_.wrap(position(i) - position(k));
+    auto rim = cell_.wrap(position(i) - position(m));
 
     auto n = cross(rik, rim);
     auto n_norm = n.norm();
@@ -0,0 +1,154 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <cassert>
+
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <exception>
+
+#include "chemfiles/ParallelWriter.hpp"
+#include "chemfiles/files/MemoryBuffer.hpp"
+
+#include "chemfiles/warnings.hpp"
+
+using namespace chemfiles;
+
+ParallelWriter::ParallelWriter(TextFormat& output, memory_stream_t creator, size_t threads):
+    output_(output), creator_(std::move(creator)), max_jobs_(2 * threads)
+{
+    assert(threads > 0);
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+        workers_.emplace_back([this](){ this->serialize_frames(); });
+    }
+    writer_ = std::thread([this](){ this->write_frames(); });
+}
+
+ParallelWriter::~ParallelWriter() {
+    try {
+        finish();
+    } catch (const std::exception& e) {
+        warning("parallel writer", "failed to write frames when closing: {}", e.what());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    changed_.notify_all();
+
+    for (auto& worker: workers_) {
+        worker.join();
+    }
+    writer_.join();
+}
+
+void ParallelWriter::write(Frame frame) {
+    auto new_job = std::make_shared<job>();
+    new_job->frame = std::move(frame);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this](){
+            return jobs_.size() < max_jobs_ || error_;
+        });
+        check_error();
+        jobs_.emplace_back(std::move(new_job));
+    }
+    changed_.notify_all();
+}
+
+void ParallelWriter::finish() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this](){
+        return jobs_.empty() || error_;
+    });
+    check_error();
+}
+
+void ParallelWriter::serialize_frames() {
+    while (true) {
+        std::shared_ptr<job> current;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            changed_.wait(lock, [&](){
+                if (stop_) {
+                    return true;
+                }
+                for (auto& pending: jobs_) {
+                    if (!pending->started) {
+                        current = pending;
+                        return true;
+                    }
+                }
+                return false;
+            });
+
+            if (stop_) {
+                return;
+            }
+            current->started = true;
+        }
+
+        try {
+            auto buffer = std::make_shared<MemoryBuffer>(8192);
+            {
+                auto format = creator_(buffer, File::WRITE, File::DEFAULT);
+                format->write(current->frame);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            current->data = std::move(buffer);
+            current->frame = Frame();
+            current->done = true;
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            set_error(std::current_exception());
+        }
+        changed_.notify_all();
+    }
+}
+
+void ParallelWriter::write_frames() {
+    while (true) {
+        std::shared_ptr<job> current;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            changed_.wait(lock, [this](){
+                return stop_ || (!jobs_.empty() && jobs_.front()->done);
+            });
+
+            if (stop_) {
+                return;
+            }
+            current = jobs_.front();
+        }
+
+        try {
+            output_.write_serialized(current->data->data(), current->data->size());
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.pop_front();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            set_error(std::current_exception());
+        }
+        changed_.notify_all();
+    }
+}
+
+void ParallelWriter::set_error(std::exception_ptr error) {
+    if (!error_) {
+        error_ = std::move(error);
+    }
+    stop_ = true;
+}
+
+void ParallelWriter::check_error() {
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
@@ -1,6 +1,9 @@
 // Chemfiles, a modern library for chemistry file reading and writing
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
 
+#include <cassert>
+#include <memory>
+
 #include "chemfiles/Property.hpp"
 #include "chemfiles/error_fmt.hpp"
 #include "chemfiles/warnings.hpp"
@@ -61,19 +64,110 @@ std::string Property::kind_as_string(Kind kind) {
 }
 
 
+property_map::~property_map() {
+    this->clear();
+}
+
+property_map::property_map(const property_map& other) {
+    if (other.size() == 0) {
+        return;
+    }
+
+    this->reserve(other.size());
+    auto data = this->data();
+    for (auto& property: other) {
+        new (data + storage_->size) value_type(property);
+        storage_->size++;
+    }
+}
+
+property_map& property_map::operator=(const property_map& other) {
+    if (this != &other) {
+        auto copy = other;
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+property_map::property_map(property_map&& other) noexcept {
+    *this = std::move(other);
+}
+
+property_map& property_map::operator=(property_map&& other) noexcept {
+    if (this != &other) {
+        this->clear();
+        storage_ = other.storage_;
+        other.storage_ = nullptr;
+    }
+    return *this;
+}
+
+void property_map::clear() {
+    if (storage_ == nullptr) {
+        return;
+    }
+
+    auto data = this->data();
+    for (size_t i = 0; i < storage_->size; i++) {
+        data[i].~value_type();
+    }
+
+    ::operator delete(storage_);
+    storage_ = nullptr;
+}
+
+void property_map::reserve(size_t capacity) {
+    auto size = this->size();
+    if (storage_ != nullptr && capacity <= storage_->capacity) {
+        return;
+    }
+
+    auto memory = ::operator new(DATA_OFFSET + capacity * sizeof(value_type));
+    auto header = new (memory) storage{size, capacity};
+    auto heap = static_cast<value_type*>(static_cast<void*>(static_cast<char*>(memory) + DATA_OFFSET));
+
+    auto data = this->data();
+    for (size_t i = 0; i < size; i++) {
+        new (heap + i) value_type(std::move(data[i]));
+        data[i].~value_type();
+    }
+
+    if (storage_ != nullptr) {
+        ::operator delete(storage_);
+    }
+    storage_ = header;
+}
+
+static bool compare_name(const property_map::value_type& property, const std::string& name) {
+    return property.first < name;
+}
+
 void property_map::set(std::string name, Property value) {
-    // We can not move value here, because we might need it later. C++17 solves
-    // this with insert_or_assign.
-    auto inserted = data_.emplace(std::move(name), value);
-    if (!inserted.second) {
-        inserted.first->second = std::move(value);
+    auto position = std::lower_bound(this->begin(), this->end(), name, compare_name);
+    auto index = static_cast<size_t>(position - this->begin());
+    if (position != this->end() && position->first == name) {
+        this->data()[index].second = std::move(value);
+        return;
+    }
+
+    auto size = this->size();
+    if (storage_ == nullptr) {
+        // most atoms and residues have at most one property
+        this->reserve(1);
+    } else if (size == storage_->capacity) {
+        this->reserve(std::max<size_t>(4, 2 * size));
     }
+
+    auto data = this->data();
+    new (data + size) value_type(std::move(name), std::move(value));
+    storage_->size++;
+    std::rotate(data + index, data + size, data + size + 1);
 }
 
 optional<const Property&> property_map::get(const std::string& name) const {
-    auto property = data_.find(name);
-    if (property != data_.end()) {
-        return property->second;
+    auto position = std::lower_bound(this->begin(), this->end(), name, compare_name);
+    if (position != this->end() && position->first == name) {
+        return position->second;
     } else {
         return nullopt;
     }
@@ -1,6 +1,8 @@
 // Chemfiles, a modern library for chemistry file reading and writing
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
 
+#include <algorithm>
+
 #include "chemfiles/Residue.hpp"
 #include "chemfiles/error_fmt.hpp"
 
@@ -15,22 +17,39 @@ void Residue::add_atom(size_t i) {
 }
 
 bool Residue::contains(size_t i) const {
-    return atoms_.find(i) != atoms_.end();
-}
+    if (atoms_.empty()) {
+        return false;
+    }
 
-void Residue::remove(size_t i) {
-    auto iter = atoms_.find(i);
-    if (iter == atoms_.end()) {
-        // we should only remove an atom if we know it exists in the residue
-        throw error("invalid call to Residue::remove, this is a bug");
+    // fast path for residues containing a contiguous range of atoms
+    auto first = *atoms_.begin();
+    auto last = *(atoms_.end() - 1);
+    if (last - first + 1 == atoms_.size()) {
+        return first <= i && i <= last;
     }
-    atoms_.erase(iter);
+
+    return atoms_.find(i) != atoms_.end();
 }
 
-void Residue::atom_removed(size_t i) {
-    for (auto& atom: atoms_.as_mutable_vec()) {
-        if (atom > i) {
-            atom -= 1;
+void Residue::renumber(const std::vector<size_t>& new_indices, size_t new_size) {
+    auto& atoms = atoms_.as_mutable_vec();
+    auto removed = static_cast<size_t>(-1);
+    size_t kept = 0;
+    for (auto atom: atoms) {
+        size_t new_index = 0;
+        if (atom < new_indices.size()) {
+            new_index = new_indices[atom];
+        } else {
+            // this atom is not part of the topology, keep it at the same
+            // place relative to the end of the topology
+            new_index = atom - new_indices.size() + new_size;
+        }
+
+        if (new_index != removed) {
+            atoms[kept] = new_index;
+            kept++;
         }
     }
+    atoms.resize(kept);
+    std::sort(atoms.begin(), atoms.end());
 }
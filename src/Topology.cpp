@@ -2,8 +2,9 @@
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
-#include <unordered_map>
+#include <algorithm>
 
 #include "chemfiles/Atom.hpp"
 #include "chemfiles/Connectivity.hpp"
@@ -47,6 +48,20 @@ void Topology::add_bond(size_t atom_i, size_t atom_j, Bond::BondOrder bond_order
     connect_.add_bond(atom_i, atom_j, bond_order);
 }
 
+void Topology::add_bonds(const std::vector<Bond>& bonds, const std::vector<Bond::BondOrder>& bond_orders) {
+    for (const auto& bond: bonds) {
+        // bond[0] < bond[1], no need to check both
+        if (bond[1] >= size()) {
+            throw out_of_bounds(
+                "out of bounds atomic index in `Topology::add_bonds`: "
+                "we have {} atoms, but the bond indexes are {} and {}",
+                size(), bond[0], bond[1]
+            );
+        }
+    }
+    connect_.add_bonds(bonds, bond_orders);
+}
+
 void Topology::remove_bond(size_t atom_i, size_t atom_j) {
     if (atom_i >= size() || atom_j >= size()) {
         throw out_of_bounds(
@@ -70,6 +85,33 @@ Bond::BondOrder Topology::bond_order(size_t atom_i, size_t atom_j) const {
     return connect_.bond_order(atom_i, atom_j);
 }
 
+/// Value used in the old to new indexes mapping for removed atoms
+static constexpr size_t REMOVED_ATOM = static_cast<size_t>(-1);
+/// Value used in the atom to residue mapping for atoms without residue
+static constexpr uint32_t NO_RESIDUE = UINT32_MAX;
+
+/// Get a new connectivity containing the bonds from `connectivity` between
+/// atoms which are not removed, renumbered according to `new_indices`
+static Connectivity renumber_bonds(const Connectivity& connectivity, const std::vector<size_t>& new_indices) {
+    const auto& bonds = connectivity.bonds();
+    const auto& bond_orders = connectivity.bond_orders();
+
+    auto new_bonds = std::vector<Bond>();
+    auto new_bond_orders = std::vector<Bond::BondOrder>();
+    for (size_t i = 0; i < bonds.size(); i++) {
+        auto first = new_indices[bonds[i][0]];
+        auto second = new_indices[bonds[i][1]];
+        if (first != REMOVED_ATOM && second != REMOVED_ATOM) {
+            new_bonds.emplace_back(first, second);
+            new_bond_orders.push_back(bond_orders[i]);
+        }
+    }
+
+    auto result = Connectivity();
+    result.add_bonds(new_bonds, new_bond_orders);
+    return result;
+}
+
 void Topology::remove(size_t i) {
     if (i >= size()) {
         throw out_of_bounds(
@@ -78,27 +120,86 @@ void Topology::remove(size_t i) {
             size(), i
         );
     }
-    atoms_.erase(atoms_.begin() + static_cast<std::ptrdiff_t>(i));
+    this->remove(std::vector<size_t>{i});
+}
 
-    // Remove all bonds with the removed atom
-    auto bonds = connect_.bonds();
-    for (auto& bond : bonds) {
-        if (bond[0] == i || bond[1] == i) {
-            connect_.remove_bond(bond[0], bond[1]);
+void Topology::remove(const std::vector<size_t>& indices) {
+    auto new_indices = std::vector<size_t>(size(), 0);
+    for (auto i: indices) {
+        if (i >= size()) {
+            throw out_of_bounds(
+                "out of bounds atomic index in `Topology::remove`: we have {} "
+                "atoms, but the index is {}",
+                size(), i
+            );
+        }
+        new_indices[i] = REMOVED_ATOM;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < atoms_.size(); i++) {
+        if (new_indices[i] != REMOVED_ATOM) {
+            new_indices[i] = kept;
+            if (kept != i) {
+                atoms_[kept] = std::move(atoms_[i]);
+            }
+            kept++;
+        }
+    }
+    atoms_.erase(atoms_.begin() + static_cast<std::ptrdiff_t>(kept), atoms_.end());
+
+    connect_ = renumber_bonds(connect_, new_indices);
+
+    residue_mapping_.assign(kept, NO_RESIDUE);
+    residue_mapping_overflow_.clear();
+    for (size_t res_index = 0; res_index < residues_.size(); res_index++) {
+        auto& residue = residues_[res_index];
+        residue.renumber(new_indices, kept);
+        for (auto i: residue) {
+            set_residue_index(i, static_cast<uint32_t>(res_index));
         }
     }
-    // remove the atom from the corresponding residue
-    auto it = residue_mapping_.find(i);
-    if (it != residue_mapping_.end()) {
-        residues_[it->second].remove(i);
+}
+
+Topology Topology::subset(const std::vector<size_t>& indices) const {
+    auto new_indices = std::vector<size_t>(size(), REMOVED_ATOM);
+    auto result = Topology();
+    result.atoms_.reserve(indices.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+        auto index = indices[i];
+        if (index >= size()) {
+            throw out_of_bounds(
+                "out of bounds atomic index in `Topology::subset`: we have {} "
+                "atoms, but the index is {}",
+                size(), index
+            );
+        }
+
+        if (new_indices[index] != REMOVED_ATOM) {
+            throw error(
+                "invalid indexes in `Topology::subset`: atom {} is present "
+                "multiple times", index
+            );
+        }
+
+        new_indices[index] = i;
+        result.atoms_.push_back(atoms_[index]);
     }
 
-    // shift all bonds indexes
-    connect_.atom_removed(i);
-    // shift all residue atoms
-    for (auto& res : residues_) {
-        res.atom_removed(i);
+    result.connect_ = renumber_bonds(connect_, new_indices);
+
+    for (const auto& residue: residues_) {
+        auto is_kept = [&](size_t i) {
+            return i < new_indices.size() && new_indices[i] != REMOVED_ATOM;
+        };
+        if (std::any_of(residue.begin(), residue.end(), is_kept)) {
+            auto new_residue = residue;
+            new_residue.renumber(new_indices, indices.size());
+            result.add_residue(std::move(new_residue));
+        }
     }
+
+    return result;
 }
 
 const std::vector<Bond>& Topology::bonds() const {
@@ -123,29 +224,61 @@ const std::vector<Improper>& Topology::impropers() const {
 
 void Topology::add_residue(Residue residue) {
     for (auto i: residue) {
-        auto it = residue_mapping_.find(i);
-        if (it != residue_mapping_.end()) {
+        if (residue_index(i) != NO_RESIDUE) {
             throw error(
                 "can not add this residue: atom {} is already in another residue",
                 i
             );
         }
     }
+
     auto res_index = residues_.size();
+    if (res_index >= NO_RESIDUE) {
+        throw error("can not add more than {} residues to a topology", NO_RESIDUE);
+    }
+
     residues_.emplace_back(std::move(residue));
     for (auto i: residues_.back()) {
-        residue_mapping_.insert({i, res_index});
+        set_residue_index(i, static_cast<uint32_t>(res_index));
     }
 }
 
+uint32_t Topology::residue_index(size_t index) const {
+    if (index < residue_mapping_.size() && residue_mapping_[index] != NO_RESIDUE) {
+        return residue_mapping_[index];
+    }
+
+    if (!residue_mapping_overflow_.empty()) {
+        auto it = residue_mapping_overflow_.find(index);
+        if (it != residue_mapping_overflow_.end()) {
+            return it->second;
+        }
+    }
+
+    return NO_RESIDUE;
+}
+
+void Topology::set_residue_index(size_t index, uint32_t res_index) {
+    if (index >= atoms_.size()) {
+        // this atom is past the end of the topology
+        residue_mapping_overflow_[index] = res_index;
+        return;
+    }
+
+    if (index >= residue_mapping_.size()) {
+        residue_mapping_.resize(index + 1, NO_RESIDUE);
+    }
+    residue_mapping_[index] = res_index;
+}
+
 bool Topology::are_linked(const Residue& first, const Residue& second) const {
     if (first == second) {
         return true;
     }
-    auto bonds = connect_.bonds();
+
     for (auto i: first) {
-        for (auto j: second) {
-            if (bonds.find({i, j}) != bonds.end()) {
+        for (auto j: connect_.bonded_atoms(i)) {
+            if (second.contains(j)) {
                 return true;
             }
         }
@@ -154,11 +287,11 @@ bool Topology::are_linked(const Residue& first, const Residue& second) const {
 }
 
 optional<const Residue&> Topology::residue_for_atom(size_t index) const {
-    auto it = residue_mapping_.find(index);
-    if (it == residue_mapping_.end()) {
+    auto res_index = residue_index(index);
+    if (res_index == NO_RESIDUE) {
         // This atom is not in a residue
         return nullopt;
     } else {
-        return residues_[it->second];
+        return residues_[res_index];
     }
 }
@@ -3,8 +3,10 @@
 
 #include <cassert>
 #include <functional>
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "chemfiles/Trajectory.hpp"
 
@@ -14,11 +16,15 @@
 #include "chemfiles/Frame.hpp"
 #include "chemfiles/UnitCell.hpp"
 #include "chemfiles/Topology.hpp"
+#include "chemfiles/Residue.hpp"
+#include "chemfiles/Selection.hpp"
 #include "chemfiles/FormatFactory.hpp"
 #include "chemfiles/FormatMetadata.hpp"
+#include "chemfiles/ParallelWriter.hpp"
 #include "chemfiles/files/MemoryBuffer.hpp"
 
 #include "chemfiles/misc.hpp"
+#include "chemfiles/cpp14.hpp"
 #include "chemfiles/utils.hpp"
 #include "chemfiles/error_fmt.hpp"
 #include "chemfiles/string_view.hpp"
@@ -86,6 +92,7 @@ Trajectory::Trajectory(std::string path, char mode, const std::string& format)
     auto format_creator = FormatFactory::get().by_name(info.format).creator;
 
     format_ = format_creator(path_, char_to_file_mode(mode), info.compression);
+    format_name_ = std::move(info.format);
 
     if (mode == 'r' || mode == 'a') {
         nsteps_ = format_->nsteps();
@@ -104,7 +111,9 @@ Trajectory Trajectory::memory_reader(const char* data, size_t size, const std::s
     // if in-memory I/O is not supported, this call will throw
     auto format_impl = memory_creator(buffer, File::READ, info.compression);
 
-    return Trajectory('r', std::move(format_impl), std::move(buffer));
+    auto trajectory = Trajectory('r', std::move(format_impl), std::move(buffer));
+    trajectory.format_name_ = std::move(info.format);
+    return trajectory;
 }
 
 Trajectory Trajectory::memory_writer(const std::string& format) {
@@ -119,7 +128,9 @@ Trajectory Trajectory::memory_writer(const std::string& format) {
     // if in-memory I/O is not supported, this call will throw
     auto format_impl = memory_creator(buffer, File::WRITE, info.compression);
 
-    return Trajectory('w', std::move(format_impl), std::move(buffer));
+    auto trajectory = Trajectory('w', std::move(format_impl), std::move(buffer));
+    trajectory.format_name_ = std::move(info.format);
+    return trajectory;
 }
 
 Trajectory::Trajectory(char mode, std::unique_ptr<Format> format, std::shared_ptr<MemoryBuffer> buffer)
@@ -129,7 +140,11 @@ Trajectory::Trajectory(char mode, std::unique_ptr<Format> format, std::shared_pt
     }
 }
 
-Trajectory::~Trajectory() = default;
+Trajectory::~Trajectory() {
+    // make sure all queued frames are written before destroying the format
+    parallel_writer_.reset();
+}
+
 Trajectory::Trajectory(Trajectory&&) = default;
 Trajectory& Trajectory::operator=(Trajectory&&) = default;
 
@@ -156,12 +171,42 @@ void Trajectory::pre_read(size_t step) {
 
 void Trajectory::post_read(Frame& frame) {
     if (custom_topology_) {
-        frame.set_topology(*custom_topology_);
+        if (native_atom_subset_) {
+            frame.set_topology(*custom_subset_topology_);
+        } else {
+            frame.set_topology(*custom_topology_);
+        }
     }
 
     if (custom_cell_) {
         frame.set_cell(*custom_cell_);
     }
+
+    if (atom_subset_selection_) {
+        auto indices = atom_subset_selection_->list(frame);
+        if (indices.empty()) {
+            throw selection_error(
+                "the '{}' selection used for the atom subset does not match any atom",
+                atom_subset_selection_->string()
+            );
+        }
+        atom_subset_selection_.reset();
+        use_atom_subset(std::move(indices));
+
+        // this frame was read in full, before the format knew about the subset
+        frame = frame.subset(atom_subset_);
+        return;
+    }
+
+    if (!atom_subset_.empty() && !native_atom_subset_) {
+        if (atom_subset_.back() >= frame.size()) {
+            throw out_of_bounds(
+                "out of bounds atomic index in atom subset: the frame contains "
+                "{} atoms, but the index is {}", frame.size(), atom_subset_.back()
+            );
+        }
+        frame = frame.subset(atom_subset_);
+    }
 }
 
 void Trajectory::check_opened() const {
@@ -180,9 +225,13 @@ Frame Trajectory::read() {
     pre_read(step_);
 
     Frame frame;
+    frame.set_single_precision(single_precision_);
     frame.set_step(SENTINEL_VALUE);
     format_->read(frame);
     post_read(frame);
+    // formats without single precision support convert the frame to double
+    // precision when accessing the positions
+    frame.set_single_precision(single_precision_);
 
     // Don't override the step set by a format
     if (frame.step() == SENTINEL_VALUE) {
@@ -198,6 +247,7 @@ Frame Trajectory::read_step(const size_t step) {
     pre_read(step);
 
     Frame frame;
+    frame.set_single_precision(single_precision_);
     frame.set_step(SENTINEL_VALUE);
     step_ = step;
     format_->read_step(step_, frame);
@@ -208,6 +258,7 @@ Frame Trajectory::read_step(const size_t step) {
     }
 
     post_read(frame);
+    frame.set_single_precision(single_precision_);
     return frame;
 }
 
@@ -219,15 +270,26 @@ void Trajectory::write(const Frame& frame) {
         );
     }
 
-    if (custom_topology_ || custom_cell_) {
+    // formats which can not write single precision data directly get a
+    // double precision copy of the frame
+    auto convert = frame.single_precision() && !format_->write_single_precision();
+    if (parallel_writer_ || custom_topology_ || custom_cell_ || convert) {
         Frame copy = frame.clone();
+        if (convert) {
+            copy.set_single_precision(false);
+        }
         if (custom_topology_) {
             copy.set_topology(*custom_topology_);
         }
         if (custom_cell_) {
             copy.set_cell(*custom_cell_);
         }
-        format_->write(copy);
+
+        if (parallel_writer_) {
+            parallel_writer_->write(std::move(copy));
+        } else {
+            format_->write(copy);
+        }
     } else {
         format_->write(frame);
     }
@@ -236,9 +298,46 @@ void Trajectory::write(const Frame& frame) {
     nsteps_++;
 }
 
+void Trajectory::set_write_threads(size_t threads) {
+    check_opened();
+    if (!(mode_ == File::WRITE || mode_ == File::APPEND)) {
+        throw file_error(
+            "the file at '{}' was not opened in write or append mode", path_
+        );
+    }
+
+    if (parallel_writer_) {
+        parallel_writer_->finish();
+        parallel_writer_.reset();
+    }
+
+    if (threads <= 1) {
+        return;
+    }
+
+    auto text_format = dynamic_cast<TextFormat*>(format_.get());
+    if (text_format == nullptr || !text_format->independent_steps()) {
+        // this format needs to write frames sequentially
+        return;
+    }
+
+    auto memory_creator = FormatFactory::get().by_name(format_name_).memory_stream_creator;
+    parallel_writer_ = chemfiles::make_unique<ParallelWriter>(*text_format, std::move(memory_creator), threads);
+}
+
 void Trajectory::set_topology(const Topology& topology) {
     check_opened();
+    if (!atom_subset_.empty() && atom_subset_.back() >= topology.size()) {
+        throw out_of_bounds(
+            "out of bounds atomic index in atom subset: the topology contains "
+            "{} atoms, but the index is {}", topology.size(), atom_subset_.back()
+        );
+    }
+
     custom_topology_ = topology;
+    if (native_atom_subset_) {
+        custom_subset_topology_ = topology.subset(atom_subset_);
+    }
 }
 
 void Trajectory::set_topology(const std::string& filename, const std::string& format) {
@@ -255,6 +354,53 @@ void Trajectory::set_cell(const UnitCell& cell) {
     custom_cell_ = cell;
 }
 
+void Trajectory::set_atom_subset(std::vector<size_t> indices) {
+    check_opened();
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+    if (custom_topology_ && !indices.empty() && indices.back() >= custom_topology_->size()) {
+        throw out_of_bounds(
+            "out of bounds atomic index in `Trajectory::set_atom_subset`: "
+            "the topology contains {} atoms, but the index is {}",
+            custom_topology_->size(), indices.back()
+        );
+    }
+
+    atom_subset_selection_.reset();
+    use_atom_subset(std::move(indices));
+}
+
+void Trajectory::set_atom_subset(Selection selection) {
+    check_opened();
+    if (selection.size() != 1) {
+        throw selection_error(
+            "can not use '{}' as an atom subset: this selection does not "
+            "match single atoms", selection.string()
+        );
+    }
+
+    // read all atoms until the selection is evaluated on the next frame
+    use_atom_subset({});
+    atom_subset_selection_ = chemfiles::make_unique<Selection>(std::move(selection));
+}
+
+void Trajectory::use_atom_subset(std::vector<size_t> indices) {
+    auto native = false;
+    if (mode_ == File::READ) {
+        // an empty vector resets any previous subset in the format
+        native = format_->set_atom_subset(indices);
+    }
+
+    atom_subset_ = std::move(indices);
+    native_atom_subset_ = native && !atom_subset_.empty();
+    if (native_atom_subset_ && custom_topology_) {
+        custom_subset_topology_ = custom_topology_->subset(atom_subset_);
+    } else {
+        custom_subset_topology_ = nullopt;
+    }
+}
+
 bool Trajectory::done() const {
     check_opened();
     return step_ >= nsteps_;
@@ -262,6 +408,10 @@ bool Trajectory::done() const {
 
 void Trajectory::close() {
     check_opened();
+    if (parallel_writer_) {
+        parallel_writer_->finish();
+        parallel_writer_.reset();
+    }
     // delete the format and set the pointer to nullptr
     format_.reset();
 }
@@ -271,5 +421,9 @@ optional<span<const char>> Trajectory::memory_buffer() const {
         return nullopt;
     }
 
+    if (parallel_writer_) {
+        parallel_writer_->finish();
+    }
+
     return span<const char>(buffer_->data(), buffer_->data() + buffer_->size());
 }
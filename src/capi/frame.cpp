@@ -2,6 +2,7 @@
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
 
 #include <cstdint>
+#include <cstring>
 #include <string>
 
 #include "chemfiles/capi/types.h"
@@ -129,7 +130,11 @@ extern "C" chfl_status chfl_frame_has_velocities(const CHFL_FRAME* const frame,
     CHECK_POINTER(frame);
     CHECK_POINTER(has_velocities);
     CHFL_ERROR_CATCH(
-        *has_velocities = bool(frame->velocities());
+        if (frame->single_precision()) {
+            *has_velocities = bool(frame->velocities_f32());
+        } else {
+            *has_velocities = bool(frame->velocities());
+        }
     )
 }
 
@@ -260,6 +265,102 @@ error:
     return nullptr;
 }
 
+extern "C" chfl_status chfl_frame_add_column(CHFL_FRAME* const frame, const char* name, chfl_property_kind kind) {
+    CHECK_POINTER(frame);
+    CHECK_POINTER(name);
+    CHFL_ERROR_CATCH(
+        if (kind == CHFL_PROPERTY_DOUBLE) {
+            frame->add_column<double>(name);
+        } else if (kind == CHFL_PROPERTY_VECTOR3D) {
+            frame->add_column<Vector3D>(name);
+        } else {
+            throw error(
+                "invalid kind for column '{}' in `chfl_frame_add_column`: only "
+                "CHFL_PROPERTY_DOUBLE and CHFL_PROPERTY_VECTOR3D are supported", name
+            );
+        }
+    )
+}
+
+extern "C" chfl_status chfl_frame_double_column(CHFL_FRAME* const frame, const char* name, double** data, uint64_t* size) {
+    CHECK_POINTER(frame);
+    CHECK_POINTER(name);
+    CHECK_POINTER(data);
+    CHECK_POINTER(size);
+    CHFL_ERROR_CATCH(
+        auto column = frame->column<double>(name);
+        if (!column) {
+            throw error("can not find a column named '{}' with double values in this frame", name);
+        }
+        *size = column->size();
+        *data = column->data();
+    )
+}
+
+extern "C" chfl_status chfl_frame_vector3d_column(CHFL_FRAME* const frame, const char* name, chfl_vector3d** data, uint64_t* size) {
+    CHECK_POINTER(frame);
+    CHECK_POINTER(name);
+    CHECK_POINTER(data);
+    CHECK_POINTER(size);
+    static_assert(
+        sizeof(chfl_vector3d) == sizeof(Vector3D),
+        "Wrong size for chfl_vector3d. It should match Vector3D."
+    );
+    CHFL_ERROR_CATCH(
+        auto column = frame->column<Vector3D>(name);
+        if (!column) {
+            throw error("can not find a column named '{}' with vector values in this frame", name);
+        }
+        *size = column->size();
+        *data = reinterpret_cast<chfl_vector3d*>(column->data());
+    )
+}
+
+extern "C" chfl_status chfl_frame_column_kind(const CHFL_FRAME* const frame, const char* name, chfl_property_kind* kind) {
+    CHECK_POINTER(frame);
+    CHECK_POINTER(name);
+    CHECK_POINTER(kind);
+    CHFL_ERROR_CATCH(
+        auto column_kind = frame->column_kind(name);
+        if (!column_kind) {
+            throw error("can not find a column named '{}' in this frame", name);
+        }
+        *kind = static_cast<chfl_property_kind>(*column_kind);
+    )
+}
+
+extern "C" chfl_status chfl_frame_columns_count(const CHFL_FRAME* const frame, uint64_t* count) {
+    CHECK_POINTER(frame);
+    CHECK_POINTER(count);
+    CHFL_ERROR_CATCH(
+        *count = frame->columns().size();
+    )
+}
+
+extern "C" chfl_status chfl_frame_column_name(const CHFL_FRAME* const frame, uint64_t index, char* const name, uint64_t buffsize) {
+    CHECK_POINTER(frame);
+    CHECK_POINTER(name);
+    CHFL_ERROR_CATCH(
+        auto columns = frame->columns();
+        if (index >= columns.size()) {
+            throw out_of_bounds(
+                "out of bounds index in `chfl_frame_column_name`: we have {} columns, but the index is {}",
+                columns.size(), index
+            );
+        }
+        strncpy(name, columns[checked_cast(index)].c_str(), checked_cast(buffsize) - 1);
+        name[buffsize - 1] = '\0';
+    )
+}
+
+extern "C" chfl_status chfl_frame_remove_column(CHFL_FRAME* const frame, const char* name) {
+    CHECK_POINTER(frame);
+    CHECK_POINTER(name);
+    CHFL_ERROR_CATCH(
+        frame->remove_column(name);
+    )
+}
+
 extern "C" chfl_status chfl_frame_add_bond(CHFL_FRAME* const frame, uint64_t i, uint64_t j) {
     CHECK_POINTER(frame);
     CHFL_ERROR_CATCH(
@@ -1,7 +1,217 @@
 // Chemfiles, a modern library for chemistry file reading and writing
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <array>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <cassert>
+
+#include "chemfiles/mutex.hpp"
+#include "chemfiles/error_fmt.hpp"
 #include "chemfiles/capi/shared_allocator.hpp"
 using namespace chemfiles;
 
-// define the global allocator instance
-mutex<shared_allocator> shared_allocator::instance_;
+namespace {
+/// Hash table associating pointers to their reference counting block. This
+/// uses open addressing with linear probing, so inserting and removing
+/// pointers does not allocate memory, except when growing the table.
+class pointers_table {
+public:
+    struct entry {
+        /// The pointer, or `nullptr` for unused entries
+        const void* ptr;
+        /// Reference counting block associated with this pointer
+        shared_metadata* metadata;
+        /// Number of times this pointer was given out to users, who must
+        /// release all of them
+        size_t count;
+    };
+
+    /// Find the entry for `ptr`, returning `nullptr` if there is none
+    entry* find(const void* ptr) {
+        if (entries_.empty()) {
+            return nullptr;
+        }
+        auto mask = entries_.size() - 1;
+        for (auto i = hash(ptr) & mask; ; i = (i + 1) & mask) {
+            if (entries_[i].ptr == ptr) {
+                return &entries_[i];
+            } else if (entries_[i].ptr == nullptr) {
+                return nullptr;
+            }
+        }
+    }
+
+    /// Insert an empty entry for `ptr`, which must not already be in the
+    /// table
+    entry& insert(const void* ptr) {
+        assert(find(ptr) == nullptr);
+        if (2 * (size_ + 1) > entries_.size()) {
+            grow();
+        }
+        size_++;
+        auto mask = entries_.size() - 1;
+        auto i = hash(ptr) & mask;
+        while (entries_[i].ptr != nullptr) {
+            i = (i + 1) & mask;
+        }
+        entries_[i] = entry{ptr, nullptr, 0};
+        return entries_[i];
+    }
+
+    /// Remove the `removed` entry from the table
+    void erase(entry* removed) {
+        auto mask = entries_.size() - 1;
+        auto i = static_cast<size_t>(removed - entries_.data());
+        // shift the following entries backward to fill the hole, instead of
+        // using tombstones
+        auto j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (entries_[j].ptr == nullptr) {
+                break;
+            }
+            // entries with an ideal position cyclically in (i, j] must stay
+            auto ideal = hash(entries_[j].ptr) & mask;
+            auto stays = (i <= j) ? (i < ideal && ideal <= j) : (i < ideal || ideal <= j);
+            if (!stays) {
+                entries_[i] = entries_[j];
+                i = j;
+            }
+        }
+        entries_[i].ptr = nullptr;
+        size_--;
+    }
+
+private:
+    static size_t hash(const void* ptr) {
+        // the lowest bits are used to select the shard, and are mostly
+        // zero because of alignment
+        size_t value = reinterpret_cast<uintptr_t>(ptr) >> 10;
+        value ^= value >> 16;
+        value *= 0x45d9f3b;
+        value ^= value >> 16;
+        return value;
+    }
+
+    void grow() {
+        auto old = std::move(entries_);
+        entries_ = std::vector<entry>(old.empty() ? 64 : 2 * old.size(), entry{nullptr, nullptr, 0});
+        size_ = 0;
+        for (const auto& e: old) {
+            if (e.ptr != nullptr) {
+                insert(e.ptr) = e;
+            }
+        }
+    }
+
+    /// All entries, the size of this vector is always zero or a power of two
+    std::vector<entry> entries_;
+    /// Number of used entries
+    size_t size_ = 0;
+};
+
+/// Number of independent shards for the pointers tables
+constexpr size_t SHARDS = 64;
+
+/// A part of the pointers tables, aligned to avoid false sharing between
+/// the different mutexes
+struct alignas(64) pointers_shard {
+    mutex<pointers_table> table;
+};
+
+/// Pointers managed by the shared_allocator. They are distributed between
+/// multiple tables with their own lock, so that threads working with
+/// different objects rarely wait on each other.
+std::array<pointers_shard, SHARDS> SHARED_POINTERS;
+
+/// Get the table containing `ptr`
+lock_guard<pointers_table> lock_table(const void* ptr) {
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+    return SHARED_POINTERS[(address >> 4) % SHARDS].table.lock();
+}
+}
+
+void shared_allocator::insert_new(const void* ptr, shared_metadata* metadata) {
+    auto table = lock_table(ptr);
+    if (table->find(ptr) != nullptr) {
+        throw chemfiles::memory_error(
+            "internal error: pointer at {} is already managed by "
+            "shared_allocator", ptr
+        );
+    }
+    auto& entry = table->insert(ptr);
+    entry.metadata = metadata;
+    entry.count = 1;
+}
+
+void shared_allocator::insert_shared(const void* ptr, void* element) {
+    shared_metadata* metadata = nullptr;
+    {
+        auto table = lock_table(ptr);
+        auto entry = table->find(ptr);
+        if (entry == nullptr) {
+            // the main pointer is not a shared pointer
+            throw chemfiles::memory_error(
+                "internal error: pointer at {} is not managed by "
+                "shared_allocator", ptr
+            );
+        }
+        metadata = entry->metadata;
+    }
+
+    {
+        auto table = lock_table(element);
+        auto entry = table->find(element);
+        if (entry == nullptr) {
+            entry = &table->insert(element);
+            entry->metadata = metadata;
+        } else if (entry->metadata != metadata) {
+            // the element pointer is already registered, but with a
+            // different main pointer
+            throw chemfiles::memory_error(
+                "internal error: element pointer at {} is already managed by "
+                "shared_allocator (associated with {})", element, ptr
+            );
+        }
+        entry->count++;
+    }
+
+    // the caller holds a reference to `ptr`, so the count can not reach zero
+    // concurrently
+    metadata->count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void shared_allocator::free(const void* ptr) { // NOLINT: this is the implementation of free
+    if (ptr == nullptr) {
+        return;
+    }
+
+    shared_metadata* metadata = nullptr;
+    {
+        auto table = lock_table(ptr);
+        auto entry = table->find(ptr);
+        if (entry == nullptr) {
+            throw chemfiles::memory_error(
+                "unknown pointer passed to shared_allocator::free: {}", ptr // NOLINT: this is the error message for free
+            );
+        }
+
+        metadata = entry->metadata;
+        entry->count--;
+        if (entry->count == 0) {
+            table->erase(entry);
+        }
+    }
+
+    // Run the destructor and release memory outside of the lock
+    auto count = metadata->count.fetch_sub(1, std::memory_order_acq_rel);
+    if (count == 1) {
+        metadata->destroy(metadata);
+    } else if (count <= 0) {
+        throw chemfiles::memory_error(
+            "internal error: negative reference count for {}", ptr
+        );
+    }
+}
@@ -2,7 +2,10 @@
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
 
 #include <cstdint>
+#include <limits>
+#include <string>
 #include <vector>
+#include <unordered_map>
 
 #include "chemfiles/capi/types.h"
 #include "chemfiles/capi/misc.h"
@@ -12,11 +15,57 @@
 #include "chemfiles/capi/topology.h"
 
 #include "chemfiles/Frame.hpp"
+#include "chemfiles/Property.hpp"
 #include "chemfiles/Topology.hpp"
 #include "chemfiles/Connectivity.hpp"
+#include "chemfiles/string_view.hpp"
 
 using namespace chemfiles;
 
+/// Store the value returned by `getter` for all atoms in `topology` in
+/// `values`, after checking that `natoms` matches the topology size
+template <typename Getter>
+static chfl_status atom_values(const Topology& topology, double values[], uint64_t natoms, const char* function, Getter getter) {
+    if (checked_cast(natoms) != topology.size()) {
+        set_last_error(std::string("wrong data size in function '") + function + "'.");
+        return CHFL_MEMORY_ERROR;
+    }
+
+    for (size_t i=0; i<topology.size(); i++) {
+        values[i] = getter(topology[i]);
+    }
+    return CHFL_SUCCESS;
+}
+
+/// Store the different atomic types in `topology` in `types` (of size
+/// `*ntypes`), and the index of the type of each atom in `ids`, building the
+/// table of types in a single pass
+static chfl_status atom_types(const Topology& topology, const char* types[], uint64_t* ntypes, uint64_t ids[], uint64_t natoms) {
+    if (checked_cast(natoms) != topology.size()) {
+        set_last_error("wrong data size in function 'chfl_topology_atom_types'.");
+        return CHFL_MEMORY_ERROR;
+    }
+
+    // the keys point inside the topology, which is not modified here
+    auto capacity = checked_cast(*ntypes);
+    auto table = std::unordered_map<string_view, uint64_t>();
+    for (size_t i=0; i<topology.size(); i++) {
+        const auto& type = topology[i].type();
+        auto it = table.find(type);
+        if (it == table.end()) {
+            if (table.size() == capacity) {
+                set_last_error("wrong data size in function 'chfl_topology_atom_types'.");
+                return CHFL_MEMORY_ERROR;
+            }
+            types[table.size()] = type.c_str();
+            it = table.emplace(type, table.size()).first;
+        }
+        ids[i] = it->second;
+    }
+    *ntypes = table.size();
+    return CHFL_SUCCESS;
+}
+
 extern "C" CHFL_TOPOLOGY* chfl_topology(void) {
     CHFL_TOPOLOGY* topology = nullptr;
     CHFL_ERROR_GOTO(
@@ -273,3 +322,75 @@ extern "C" chfl_status chfl_topology_bond_order( const CHFL_TOPOLOGY* const topo
         );
     )
 }
+
+extern "C" chfl_status chfl_topology_masses(const CHFL_TOPOLOGY* const topology, double masses[], uint64_t natoms) {
+    CHECK_POINTER(topology);
+    CHECK_POINTER(masses);
+    CHFL_ERROR_CATCH(
+        return atom_values(*topology, masses, natoms, "chfl_topology_masses", [](const Atom& atom) {
+            return atom.mass();
+        });
+    )
+}
+
+extern "C" chfl_status chfl_topology_charges(const CHFL_TOPOLOGY* const topology, double charges[], uint64_t natoms) {
+    CHECK_POINTER(topology);
+    CHECK_POINTER(charges);
+    CHFL_ERROR_CATCH(
+        return atom_values(*topology, charges, natoms, "chfl_topology_charges", [](const Atom& atom) {
+            return atom.charge();
+        });
+    )
+}
+
+extern "C" chfl_status chfl_topology_atom_types(const CHFL_TOPOLOGY* const topology, const char* types[], uint64_t* ntypes, uint64_t ids[], uint64_t natoms) {
+    CHECK_POINTER(topology);
+    CHECK_POINTER(types);
+    CHECK_POINTER(ntypes);
+    CHECK_POINTER(ids);
+    CHFL_ERROR_CATCH(
+        return atom_types(*topology, types, ntypes, ids, natoms);
+    )
+}
+
+extern "C" chfl_status chfl_topology_residue_ids(const CHFL_TOPOLOGY* const topology, int64_t ids[], uint64_t natoms) {
+    CHECK_POINTER(topology);
+    CHECK_POINTER(ids);
+    CHFL_ERROR_CATCH(
+        if (checked_cast(natoms) != topology->size()) {
+            set_last_error("wrong data size in function 'chfl_topology_residue_ids'.");
+            return CHFL_MEMORY_ERROR;
+        }
+
+        for (size_t i=0; i<topology->size(); i++) {
+            auto residue = topology->residue_for_atom(i);
+            if (residue && residue->id()) {
+                ids[i] = *residue->id();
+            } else {
+                ids[i] = std::numeric_limits<int64_t>::min();
+            }
+        }
+    )
+}
+
+extern "C" chfl_status chfl_topology_double_property(const CHFL_TOPOLOGY* const topology, const char* name, double values[], uint64_t natoms) {
+    CHECK_POINTER(topology);
+    CHECK_POINTER(name);
+    CHECK_POINTER(values);
+    CHFL_ERROR_CATCH(
+        if (checked_cast(natoms) != topology->size()) {
+            set_last_error("wrong data size in function 'chfl_topology_double_property'.");
+            return CHFL_MEMORY_ERROR;
+        }
+
+        auto property_name = std::string(name);
+        for (size_t i=0; i<topology->size(); i++) {
+            auto property = (*topology)[i].get(property_name);
+            if (property && property->kind() == Property::DOUBLE) {
+                values[i] = property->as_double();
+            } else {
+                values[i] = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+    )
+}
@@ -226,6 +226,46 @@ void BinaryFile::read_char(char* data, size_t count) {
 }
 
 
+string_view BinaryFile::read_all(std::string& buffer) {
+#if CHEMFILES_BINARY_FILE_USE_MMAP
+    (void)buffer;
+    offset_ = file_size_;
+    return string_view(mmap_data_, file_size_);
+#else
+    fseek64(file_, 0, SEEK_END);
+    auto size = static_cast<size_t>(ftell64(file_));
+    this->seek(0);
+
+    buffer.resize(size);
+    this->read_char(&buffer[0], size);
+    return buffer;
+#endif
+}
+
+
+string_view BinaryFile::read_view(size_t count, std::string& buffer) {
+#if CHEMFILES_BINARY_FILE_USE_MMAP
+    (void)buffer;
+    if (offset_ + count > file_size_) {
+        throw file_error(
+            "failed to read {} bytes from the file at '{}': mmap out of bounds",
+            count, this->path()
+        );
+    }
+
+    auto view = string_view(mmap_data_ + offset_, count);
+    offset_ += count;
+    return view;
+#else
+    buffer.resize(count);
+    if (count != 0) {
+        this->read_char(&buffer[0], count);
+    }
+    return buffer;
+#endif
+}
+
+
 void BinaryFile::write_char(const char* data, size_t count) {
 #if CHEMFILES_BINARY_FILE_USE_MMAP
     if (offset_ + count > file_size_) {
@@ -296,6 +336,20 @@ void BinaryFile::seek(uint64_t position) {
 }
 
 
+uint64_t BinaryFile::size() {
+#if CHEMFILES_BINARY_FILE_USE_MMAP
+    // the mapping is larger than the data when writing
+    return this->mode() == File::READ ? file_size_ : total_written_size_;
+#else
+    auto position = ftell64(file_);
+    fseek64(file_, 0, SEEK_END);
+    auto size = static_cast<uint64_t>(ftell64(file_));
+    fseek64(file_, position, SEEK_SET);
+    return size;
+#endif
+}
+
+
 /******************************************************************************/
 
 #define CHEMFILES_LITTLE_ENDIAN 0
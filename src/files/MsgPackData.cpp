@@ -0,0 +1,42 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <string>
+#include <memory>
+
+#include <msgpack.hpp>
+
+#include "chemfiles/cpp14.hpp"
+#include "chemfiles/string_view.hpp"
+
+#include "chemfiles/File.hpp"
+#include "chemfiles/files/BinaryFile.hpp"
+#include "chemfiles/files/MemoryBuffer.hpp"
+#include "chemfiles/files/MsgPackData.hpp"
+
+using namespace chemfiles;
+
+MsgPackData::MsgPackData(std::string path, File::Mode mode, File::Compression compression) {
+    if (compression == File::DEFAULT) {
+        // decode directly from the memory-mapped file
+        file_ = chemfiles::make_unique<BigEndianFile>(std::move(path), mode);
+        unpack(file_->read_all(buffer_));
+    } else {
+        buffer_ = TextFile(std::move(path), mode, compression).readall();
+        unpack(buffer_);
+    }
+}
+
+MsgPackData::MsgPackData(std::shared_ptr<MemoryBuffer> memory): memory_(std::move(memory)) {
+    unpack(string_view(memory_->data(), memory_->size()));
+}
+
+MsgPackData::~MsgPackData() = default;
+
+void MsgPackData::unpack(string_view data) {
+    // Keep references to the raw data for strings and binary arrays instead
+    // of copying them
+    msgpack::unpack(handle_, data.data(), data.size(),
+        [](msgpack::type::object_type, size_t, void*) { return true; }
+    );
+}
@@ -285,6 +285,18 @@ std::vector<size_t> Variable::shape() const {
 
 template<typename T>
 void Variable::read(size_t step, T* data, size_t count) {
+    if (count != layout_.count()) {
+        throw file_error(
+            "wrong array size in Variable::read: expected {}, got {}",
+            layout_.count(), count
+        );
+    }
+
+    this->read(step, 0, data, count);
+}
+
+template<typename T>
+void Variable::read(size_t step, size_t start, T* data, size_t count) {
     auto& file = file_.get();
 
     if (this->is_record()) {
@@ -307,15 +319,17 @@ void Variable::read(size_t step, T* data, size_t count) {
         );
     }
 
-    if (count != layout_.count()) {
+    if (start + count > layout_.count()) {
         throw file_error(
-            "wrong array size in Variable::read: expected {}, got {}",
-            layout_.count(), count
+            "out of bounds: trying to read values {} to {} in Variable::read, "
+            "but this variable only contains {} values",
+            start, start + count, layout_.count()
         );
     }
 
     auto begin = static_cast<uint64_t>(layout_.offset);
     begin += static_cast<uint64_t>(step) * file.record_size();
+    begin += static_cast<uint64_t>(start) * sizeof(T);
     file.seek(begin);
     (file.*nc_type_info<T>::reader)(data, count);
 }
@@ -324,6 +338,10 @@ template void Variable::read(size_t step, int32_t* data, size_t count);
 template void Variable::read(size_t step, float* data, size_t count);
 template void Variable::read(size_t step, double* data, size_t count);
 
+template void Variable::read(size_t step, size_t start, int32_t* data, size_t count);
+template void Variable::read(size_t step, size_t start, float* data, size_t count);
+template void Variable::read(size_t step, size_t start, double* data, size_t count);
+
 template<typename T>
 void Variable::write(size_t step, const T* data, size_t count) {
     auto& file = file_.get();
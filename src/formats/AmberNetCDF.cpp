@@ -3,6 +3,7 @@
 
 #include <cassert>
 #include <array>
+#include <type_traits>
 #include <string>
 #include <vector>
 
@@ -206,16 +207,56 @@ void AmberNetCDFBase::read_step(const size_t step, Frame& frame) {
         frame.set("name", file_title_.value());
     }
 
-    frame.resize(n_atoms_);
+    if (atom_subset_.empty()) {
+        frame.resize(n_atoms_);
 
-    if (variables_.coordinates.var) {
-        this->read_array(variables_.coordinates, frame.positions());
+        if (variables_.coordinates.var) {
+            if (frame.single_precision()) {
+                this->read_array(variables_.coordinates, frame.positions_f32());
+            } else {
+                this->read_array(variables_.coordinates, frame.positions());
+            }
+        }
+
+        if (variables_.velocities.var) {
+            frame.add_velocities();
+            if (frame.single_precision()) {
+                this->read_array(variables_.velocities, *frame.velocities_f32());
+            } else {
+                this->read_array(variables_.velocities, *frame.velocities());
+            }
+        }
+    } else {
+        frame.resize(atom_subset_.size());
+
+        if (variables_.coordinates.var) {
+            if (frame.single_precision()) {
+                this->read_array_subset(variables_.coordinates, frame.positions_f32());
+            } else {
+                this->read_array_subset(variables_.coordinates, frame.positions());
+            }
+        }
+
+        if (variables_.velocities.var) {
+            frame.add_velocities();
+            if (frame.single_precision()) {
+                this->read_array_subset(variables_.velocities, *frame.velocities_f32());
+            } else {
+                this->read_array_subset(variables_.velocities, *frame.velocities());
+            }
+        }
     }
+}
 
-    if (variables_.velocities.var) {
-        frame.add_velocities();
-        this->read_array(variables_.velocities, *frame.velocities());
+bool AmberNetCDFBase::set_atom_subset(std::vector<size_t> indices) {
+    if (!indices.empty() && indices.back() >= n_atoms_) {
+        throw format_error(
+            "can not read atom {} in this Amber NetCDF file, which contains {} atoms",
+            indices.back(), n_atoms_
+        );
     }
+    atom_subset_ = std::move(indices);
+    return true;
 }
 
 void AmberNetCDFBase::write(const Frame& frame) {
@@ -337,6 +378,81 @@ void AmberNetCDFBase::read_array(variable_scale_t& variable, span<Vector3D> arra
     }
 }
 
+void AmberNetCDFBase::read_array(variable_scale_t& variable, span<Vector3F> array) {
+    if (variable.var->type() == netcdf3::constants::NC_FLOAT) {
+        // read the data directly in the frame storage
+        auto data = reinterpret_cast<float*>(array.data());
+        variable.var->read(step_, data, 3 * array.size());
+        if (variable.scale != 1.0) {
+            for (size_t i=0; i<3 * n_atoms_; i++) {
+                data[i] = static_cast<float>(variable.scale * static_cast<double>(data[i]));
+            }
+        }
+    } else if (variable.var->type() == netcdf3::constants::NC_DOUBLE) {
+        variable.var->read(step_, buffer_f64_);
+        for (size_t i=0; i<n_atoms_; i++) {
+            array[i][0] = static_cast<float>(variable.scale * buffer_f64_[3 * i + 0]);
+            array[i][1] = static_cast<float>(variable.scale * buffer_f64_[3 * i + 1]);
+            array[i][2] = static_cast<float>(variable.scale * buffer_f64_[3 * i + 2]);
+        }
+    } else {
+        throw format_error("invalid type for variable, expected floating point");
+    }
+}
+
+// Read the values for all atoms in `subset` from `variable`, converting them
+// to `array`. Consecutive atoms in `subset` are read together, skipping the
+// data in between them when the gap is large enough. `Vector` is either
+// `Vector3D` or `Vector3F`, depending on the frame storage.
+template<typename T, typename Vector>
+static void read_subset(netcdf3::Variable& variable, size_t step, double scale, const std::vector<size_t>& subset, std::vector<T>& buffer, span<Vector> array) {
+    using value_t = typename std::remove_reference<decltype(array[0][0])>::type;
+    // reading the data for a few unused atoms is faster than seeking in the
+    // file for each atom
+    constexpr size_t MAX_ATOMS_GAP = 64;
+
+    size_t i = 0;
+    while (i < subset.size()) {
+        auto first = subset[i];
+        auto end = i + 1;
+        while (end < subset.size() && subset[end] - subset[end - 1] <= MAX_ATOMS_GAP) {
+            end++;
+        }
+        auto last = subset[end - 1];
+
+        buffer.resize(3 * (last - first + 1));
+        variable.read(step, 3 * first, buffer.data(), buffer.size());
+        for (/* no initialization */; i < end; i++) {
+            auto j = subset[i] - first;
+            array[i][0] = static_cast<value_t>(scale * static_cast<double>(buffer[3 * j + 0]));
+            array[i][1] = static_cast<value_t>(scale * static_cast<double>(buffer[3 * j + 1]));
+            array[i][2] = static_cast<value_t>(scale * static_cast<double>(buffer[3 * j + 2]));
+        }
+    }
+}
+
+void AmberNetCDFBase::read_array_subset(variable_scale_t& variable, span<Vector3D> array) {
+    assert(array.size() == atom_subset_.size());
+    if (variable.var->type() == netcdf3::constants::NC_FLOAT) {
+        read_subset(*variable.var, step_, variable.scale, atom_subset_, buffer_f32_, array);
+    } else if (variable.var->type() == netcdf3::constants::NC_DOUBLE) {
+        read_subset(*variable.var, step_, variable.scale, atom_subset_, buffer_f64_, array);
+    } else {
+        throw format_error("invalid type for variable, expected floating point");
+    }
+}
+
+void AmberNetCDFBase::read_array_subset(variable_scale_t& variable, span<Vector3F> array) {
+    assert(array.size() == atom_subset_.size());
+    if (variable.var->type() == netcdf3::constants::NC_FLOAT) {
+        read_subset(*variable.var, step_, variable.scale, atom_subset_, buffer_f32_, array);
+    } else if (variable.var->type() == netcdf3::constants::NC_DOUBLE) {
+        read_subset(*variable.var, step_, variable.scale, atom_subset_, buffer_f64_, array);
+    } else {
+        throw format_error("invalid type for variable, expected floating point");
+    }
+}
+
 /******************************************************************************/
 
 void AmberNetCDFBase::write_cell(const UnitCell& cell) {
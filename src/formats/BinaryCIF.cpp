@@ -0,0 +1,816 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <cmath>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+#include <fmt/format.h>
+#include <msgpack.hpp>
+
+#include "chemfiles/parse.hpp"
+#include "chemfiles/error_fmt.hpp"
+#include "chemfiles/string_view.hpp"
+#include "chemfiles/external/span.hpp"
+#include "chemfiles/external/optional.hpp"
+
+#include "chemfiles/File.hpp"
+#include "chemfiles/Atom.hpp"
+#include "chemfiles/Frame.hpp"
+#include "chemfiles/Property.hpp"
+#include "chemfiles/UnitCell.hpp"
+#include "chemfiles/FormatMetadata.hpp"
+
+#include "chemfiles/files/MemoryBuffer.hpp"
+#include "chemfiles/files/MsgPackData.hpp"
+
+// WARNING UGLY HACK!
+#include "chemfiles/formats/PDB.hpp"
+
+#include "chemfiles/formats/BinaryCIF.hpp"
+
+using namespace chemfiles;
+
+template<> const FormatMetadata& chemfiles::format_metadata<BinaryCIFFormat>() {
+    static FormatMetadata metadata;
+    metadata.name = "BinaryCIF";
+    metadata.extension = ".bcif";
+    metadata.description = "Binary version of mmCIF files, used by the Protein Data Bank";
+    metadata.reference = "https://github.com/molstar/BinaryCIF";
+
+    metadata.read = true;
+    metadata.write = false;
+    metadata.memory = true;
+
+    metadata.positions = true;
+    metadata.velocities = false;
+    metadata.unit_cell = true;
+    metadata.atoms = true;
+    metadata.bonds = true;
+    metadata.residues = true;
+    return metadata;
+}
+
+/// Get the value associated with `key` in a msgpack `map`, or `nullptr` if
+/// there is no such key
+static const msgpack::object* find_key(const msgpack::object& map, string_view key);
+
+/// Get the value associated with `key` in a msgpack `map`
+///
+/// @throws FormatError if there is no such key
+static const msgpack::object& get_key(const msgpack::object& map, string_view key);
+
+/// Get the values in a msgpack array
+static span<const msgpack::object> as_array(const msgpack::object& object);
+/// Get the value of a msgpack string
+static string_view as_string(const msgpack::object& object);
+/// Get the value of a msgpack binary array
+static string_view as_binary(const msgpack::object& object);
+/// Get the value of a msgpack number, either integer or floating point
+static double as_number(const msgpack::object& object);
+/// Get the value of a msgpack integer. Floating point values are truncated.
+static int64_t as_integer(const msgpack::object& object);
+
+/// Find the category with the given `name` in a BinaryCIF data `block`, or
+/// `nullptr` if there is no such category
+static const msgpack::object* find_category(const msgpack::object& block, string_view name);
+
+/// Find the column with the given `name` in a BinaryCIF `category`, and decode
+/// it. Returns `nullopt` if there is no such column.
+static optional<BinaryCIFColumn> read_column(const msgpack::object& category, string_view name);
+
+/// Decode BinaryCIF encoded `data`, i.e. a map with `data` and `encoding` keys
+static BinaryCIFColumn decode(const msgpack::object& data);
+
+/// Numbers decoded from BinaryCIF binary data. Values stay in `integers`
+/// until an encoding producing floating point values (floating point
+/// ByteArray, FixedPoint or IntervalQuantization) moves them to `floats`.
+struct DecodedNumbers {
+    bool is_integer = true;
+    std::vector<int64_t> integers;
+    std::vector<double> floats;
+};
+
+/// Decode the binary `data` into numbers, applying the `encodings` in reverse
+/// order
+static DecodedNumbers decode_numbers(string_view data, span<const msgpack::object> encodings);
+
+BinaryCIFColumn::BinaryCIFColumn(std::string data, std::vector<size_t> offsets, std::vector<int64_t> indices):
+    kind_(STRINGS), strings_(std::move(data)), offsets_(std::move(offsets)), indices_(std::move(indices))
+{
+    for (size_t i = 1; i < offsets_.size(); i++) {
+        if (offsets_[i] < offsets_[i - 1] || offsets_[i] > strings_.size()) {
+            throw format_error("invalid offsets for strings in BinaryCIF column");
+        }
+    }
+
+    for (auto index: indices_) {
+        // negative indices are used for missing values
+        if (index >= 0 && static_cast<size_t>(index) + 1 >= offsets_.size()) {
+            throw format_error(
+                "out of bounds string index in BinaryCIF column: index is {} but there are {} strings",
+                index, offsets_.empty() ? 0 : offsets_.size() - 1
+            );
+        }
+    }
+}
+
+void BinaryCIFColumn::set_mask(std::vector<uint8_t> mask) {
+    if (mask.size() != this->size()) {
+        throw format_error(
+            "invalid mask for BinaryCIF column: expected {} values, got {}",
+            this->size(), mask.size()
+        );
+    }
+    mask_ = std::move(mask);
+}
+
+double BinaryCIFColumn::number(size_t row) const {
+    if (kind_ == NUMBERS) {
+        return numbers_[row];
+    } else if (kind_ == INTEGERS) {
+        return static_cast<double>(integers_[row]);
+    }
+
+    auto value = this->string(row);
+    try {
+        return parse<double>(value);
+    } catch (const Error& e) {
+        throw format_error("invalid number '{}' in BinaryCIF column: {}", value, e.what());
+    }
+}
+
+int64_t BinaryCIFColumn::integer(size_t row) const {
+    if (kind_ == INTEGERS) {
+        return integers_[row];
+    } else if (kind_ == NUMBERS) {
+        return static_cast<int64_t>(numbers_[row]);
+    }
+
+    auto value = this->string(row);
+    try {
+        return parse<int64_t>(value);
+    } catch (const Error& e) {
+        throw format_error("invalid integer '{}' in BinaryCIF column: {}", value, e.what());
+    }
+}
+
+string_view BinaryCIFColumn::string(size_t row) const {
+    assert(kind_ == STRINGS);
+    if (!is_present(row)) {
+        return mask_[row] == UNKNOWN ? "?" : ".";
+    }
+
+    auto index = indices_[row];
+    if (index < 0) {
+        return ".";
+    }
+
+    auto start = offsets_[static_cast<size_t>(index)];
+    auto end = offsets_[static_cast<size_t>(index) + 1];
+    return string_view(strings_.data() + start, end - start);
+}
+
+void BinaryCIFColumn::to_strings() {
+    if (kind_ == STRINGS) {
+        return;
+    }
+
+    auto size = this->size();
+    offsets_.clear();
+    offsets_.reserve(size + 1);
+    offsets_.push_back(0);
+    indices_.clear();
+    indices_.reserve(size);
+    for (size_t row = 0; row < size; row++) {
+        if (kind_ == INTEGERS) {
+            strings_ += fmt::format("{}", integers_[row]);
+        } else {
+            auto value = numbers_[row];
+            if (std::trunc(value) == value && std::abs(value) < 1e15) {
+                strings_ += fmt::format("{}", static_cast<int64_t>(value));
+            } else {
+                strings_ += fmt::format("{}", value);
+            }
+        }
+        indices_.push_back(static_cast<int64_t>(offsets_.size() - 1));
+        offsets_.push_back(strings_.size());
+    }
+
+    numbers_ = std::vector<double>();
+    integers_ = std::vector<int64_t>();
+    kind_ = STRINGS;
+}
+
+BinaryCIFFormat::BinaryCIFFormat(std::string path, File::Mode mode, File::Compression compression) {
+    if (mode == File::WRITE) {
+        throw file_error("write mode ('w') is not supported for the BinaryCIF format");
+    } else if (mode == File::APPEND) {
+        throw file_error("append mode ('a') is not supported for the BinaryCIF format");
+    }
+
+    try {
+        decode(MsgPackData(path, mode, compression), path);
+    } catch (const msgpack::unpack_error& e) {
+        throw format_error("error while decoding BinaryCIF from {}: '{}'", path, e.what());
+    }
+}
+
+BinaryCIFFormat::BinaryCIFFormat(std::shared_ptr<MemoryBuffer> memory, File::Mode mode, File::Compression compression) {
+    if (mode == File::WRITE) {
+        throw format_error("the BinaryCIF format cannot write to memory");
+    }
+
+    memory->decompress(compression);
+    try {
+        decode(MsgPackData(std::move(memory)), "memory");
+    } catch (const msgpack::unpack_error& e) {
+        throw format_error("error while decoding BinaryCIF from memory: '{}'", e.what());
+    }
+}
+
+void BinaryCIFFormat::decode(const MsgPackData& data, const std::string& source) {
+    const auto& file = data.get();
+    if (file.type != msgpack::type::MAP) {
+        throw format_error("error while decoding BinaryCIF from {}: expected a map", source);
+    }
+
+    auto blocks = as_array(get_key(file, "dataBlocks"));
+    if (blocks.size() == 0) {
+        throw format_error("could not find any data block in '{}'", source);
+    }
+    // only the first block is used
+    const auto& block = blocks[0];
+
+    Vector3D lengths;
+    Vector3D angles = {90, 90, 90};
+    auto cell = find_category(block, "_cell");
+    if (cell) {
+        auto set_parameter = [&](string_view name, double& parameter) {
+            auto column = read_column(*cell, name);
+            if (column && column->size() != 0 && column->is_present(0)) {
+                parameter = column->number(0);
+            }
+        };
+        set_parameter("length_a", lengths[0]);
+        set_parameter("length_b", lengths[1]);
+        set_parameter("length_c", lengths[2]);
+        set_parameter("angle_alpha", angles[0]);
+        set_parameter("angle_beta", angles[1]);
+        set_parameter("angle_gamma", angles[2]);
+    }
+    cell_ = UnitCell(lengths, angles);
+
+    auto read_string = [&](string_view category_name, string_view name) {
+        auto category = find_category(block, category_name);
+        if (!category) {
+            return std::string();
+        }
+        auto column = read_column(*category, name);
+        if (!column || column->size() == 0 || !column->is_present(0)) {
+            return std::string();
+        }
+        column->to_strings();
+        return column->string(0).to_string();
+    };
+    pdb_idcode_ = read_string("_entry", "id");
+    name_ = read_string("_struct", "title");
+
+    auto atom_site = find_category(block, "_atom_site");
+    if (!atom_site) {
+        throw format_error("could not find _atom_site category in '{}'", source);
+    }
+    auto count = static_cast<size_t>(as_number(get_key(*atom_site, "rowCount")));
+
+    auto read_atom_site = [&](string_view name, bool string) {
+        auto column = read_column(*atom_site, name);
+        if (column) {
+            if (column->size() != count) {
+                throw format_error(
+                    "expected {} values for '{}' in _atom_site, got {} in '{}'",
+                    count, name, column->size(), source
+                );
+            }
+            if (string) {
+                column->to_strings();
+            }
+        }
+        return column;
+    };
+
+    auto type_symbol = read_atom_site("type_symbol", true);
+    if (!type_symbol) {
+        throw format_error("could not find _atom_site.type_symbol in '{}'", source);
+    }
+    columns_.type_symbol = std::move(*type_symbol);
+
+    auto cartn_x = read_atom_site("Cartn_x", false);
+    auto cartn_y = read_atom_site("Cartn_y", false);
+    auto cartn_z = read_atom_site("Cartn_z", false);
+    if (!cartn_x || !cartn_y || !cartn_z) {
+        throw format_error("could not find _atom_site.Cartn_x in '{}'", source);
+    }
+    columns_.cartn_x = std::move(*cartn_x);
+    columns_.cartn_y = std::move(*cartn_y);
+    columns_.cartn_z = std::move(*cartn_z);
+
+    columns_.label_atom_id = read_atom_site("label_atom_id", true);
+    columns_.group_pdb = read_atom_site("group_PDB", true);
+    columns_.label_alt_id = read_atom_site("label_alt_id", true);
+    columns_.formal_charge = read_atom_site("pdbx_formal_charge", false);
+    if (!columns_.formal_charge) {
+        columns_.formal_charge = read_atom_site("formal_charge", false);
+    }
+
+    columns_.label_comp_id = read_atom_site("label_comp_id", true);
+    columns_.label_asym_id = read_atom_site("label_asym_id", true);
+    columns_.auth_asym_id = read_atom_site("auth_asym_id", true);
+    columns_.label_seq_id = read_atom_site("label_seq_id", false);
+    columns_.label_entity_id = read_atom_site("label_entity_id", false);
+    columns_.model_num = read_atom_site("pdbx_PDB_model_num", false);
+
+    models_start_.push_back(0);
+    if (columns_.model_num) {
+        const auto& model_num = *columns_.model_num;
+        for (size_t row = 1; row < count; row++) {
+            if (model_num.integer(row) != model_num.integer(row - 1)) {
+                models_start_.push_back(row);
+            }
+        }
+    }
+    models_start_.push_back(count);
+}
+
+size_t BinaryCIFFormat::nsteps() {
+    return models_start_.size() - 1;
+}
+
+void BinaryCIFFormat::read_step(const size_t step, Frame& frame) {
+    assert(step < nsteps());
+    step_ = step;
+    read(frame);
+}
+
+void BinaryCIFFormat::read(Frame& frame) {
+    frame.set_cell(cell_);
+
+    if (!name_.empty()) {
+        frame.set("name", name_);
+    }
+
+    if (!pdb_idcode_.empty()) {
+        frame.set("pdb_idcode", pdb_idcode_);
+    }
+
+    const auto& columns = columns_;
+    auto first = models_start_[step_];
+    auto last = models_start_[step_ + 1];
+    step_++;
+
+    frame.resize(last - first);
+    auto positions = frame.positions();
+
+    auto residues = mmCIFResidues();
+
+    for (size_t row = first; row < last; row++) {
+        auto atom_id = row - first;
+
+        auto name = columns.label_atom_id ? columns.label_atom_id->string(row) : string_view();
+        auto atom = Atom(name.to_string(), columns.type_symbol.string(row).to_string());
+
+        if (columns.label_alt_id && columns.label_alt_id->is_present(row)) {
+            atom.set("altloc", columns.label_alt_id->string(row).to_string());
+        }
+
+        if (columns.formal_charge && columns.formal_charge->is_present(row)) {
+            atom.set_charge(columns.formal_charge->number(row));
+        }
+
+        frame[atom_id] = std::move(atom);
+        positions[atom_id][0] = columns.cartn_x.number(row);
+        positions[atom_id][1] = columns.cartn_y.number(row);
+        positions[atom_id][2] = columns.cartn_z.number(row);
+
+        if (!columns.label_comp_id || !columns.label_asym_id) {
+            continue;
+        }
+
+        if (!columns.label_comp_id->is_present(row)) {
+            // atom without residue
+            continue;
+        }
+
+        int64_t resid = 0;
+        if (columns.label_seq_id && columns.label_seq_id->is_present(row)) {
+            resid = columns.label_seq_id->integer(row);
+        } else if (columns.label_entity_id && columns.label_entity_id->is_present(row)) {
+            // In this case, we need to use the entity id
+            resid = columns.label_entity_id->integer(row);
+        } else {
+            continue;
+        }
+
+        auto chainname = optional<string_view>();
+        if (columns.auth_asym_id) {
+            chainname = columns.auth_asym_id->string(row);
+        }
+
+        auto group_pdb = optional<string_view>();
+        if (columns.group_pdb) {
+            group_pdb = columns.group_pdb->string(row);
+        }
+
+        residues.add_atom(
+            atom_id, resid, columns.label_asym_id->string(row),
+            columns.label_comp_id->string(row), chainname, group_pdb
+        );
+    }
+
+    residues.add_to(frame);
+
+    // Cross format talk! Forgive me!
+    PDBFormat::link_standard_residue_bonds(frame);
+}
+
+const msgpack::object* find_key(const msgpack::object& map, string_view key) {
+    if (map.type != msgpack::type::MAP) {
+        throw format_error("invalid BinaryCIF: expected a map while looking for '{}'", key);
+    }
+
+    for (const auto& entry: span<const msgpack::object_kv>(static_cast<const msgpack::object_kv*>(map.via.map.ptr), map.via.map.size)) {
+        if (entry.key.type == msgpack::type::STR && as_string(entry.key) == key) {
+            return &entry.val;
+        }
+    }
+    return nullptr;
+}
+
+const msgpack::object& get_key(const msgpack::object& map, string_view key) {
+    auto value = find_key(map, key);
+    if (!value) {
+        throw format_error("invalid BinaryCIF: missing '{}' entry", key);
+    }
+    return *value;
+}
+
+span<const msgpack::object> as_array(const msgpack::object& object) {
+    if (object.type != msgpack::type::ARRAY) {
+        throw format_error("invalid BinaryCIF: expected an array");
+    }
+    return {static_cast<const msgpack::object*>(object.via.array.ptr), object.via.array.size};
+}
+
+string_view as_string(const msgpack::object& object) {
+    if (object.type != msgpack::type::STR) {
+        throw format_error("invalid BinaryCIF: expected a string");
+    }
+    return {object.via.str.ptr, object.via.str.size};
+}
+
+string_view as_binary(const msgpack::object& object) {
+    if (object.type != msgpack::type::BIN) {
+        throw format_error("invalid BinaryCIF: expected binary data");
+    }
+    return {object.via.bin.ptr, object.via.bin.size};
+}
+
+double as_number(const msgpack::object& object) {
+    switch (object.type) {
+    case msgpack::type::POSITIVE_INTEGER:
+        return static_cast<double>(object.via.u64);
+    case msgpack::type::NEGATIVE_INTEGER:
+        return static_cast<double>(object.via.i64);
+    case msgpack::type::FLOAT32:
+    case msgpack::type::FLOAT64:
+        return object.via.f64;
+    default:
+        throw format_error("invalid BinaryCIF: expected a number");
+    }
+}
+
+int64_t as_integer(const msgpack::object& object) {
+    switch (object.type) {
+    case msgpack::type::POSITIVE_INTEGER:
+        if (object.via.u64 > static_cast<uint64_t>(INT64_MAX)) {
+            throw format_error("invalid BinaryCIF: integer {} is too large", object.via.u64);
+        }
+        return static_cast<int64_t>(object.via.u64);
+    case msgpack::type::NEGATIVE_INTEGER:
+        return object.via.i64;
+    case msgpack::type::FLOAT32:
+    case msgpack::type::FLOAT64:
+        return static_cast<int64_t>(object.via.f64);
+    default:
+        throw format_error("invalid BinaryCIF: expected a number");
+    }
+}
+
+const msgpack::object* find_category(const msgpack::object& block, string_view name) {
+    for (const auto& category: as_array(get_key(block, "categories"))) {
+        auto category_name = as_string(get_key(category, "name"));
+        // the leading underscore is sometimes missing
+        if (category_name == name || category_name == name.substr(1)) {
+            return &category;
+        }
+    }
+    return nullptr;
+}
+
+optional<BinaryCIFColumn> read_column(const msgpack::object& category, string_view name) {
+    for (const auto& column: as_array(get_key(category, "columns"))) {
+        if (as_string(get_key(column, "name")) != name) {
+            continue;
+        }
+
+        auto result = decode(get_key(column, "data"));
+
+        auto mask = find_key(column, "mask");
+        if (mask && mask->type != msgpack::type::NIL) {
+            auto values = decode(*mask);
+            auto mask_values = std::vector<uint8_t>(values.size());
+            for (size_t i = 0; i < values.size(); i++) {
+                mask_values[i] = static_cast<uint8_t>(values.integer(i));
+            }
+            result.set_mask(std::move(mask_values));
+        }
+
+        return result;
+    }
+    return nullopt;
+}
+
+BinaryCIFColumn decode(const msgpack::object& data) {
+    auto encodings = as_array(get_key(data, "encoding"));
+    auto binary = as_binary(get_key(data, "data"));
+
+    if (encodings.size() != 0 && as_string(get_key(encodings[0], "kind")) == "StringArray") {
+        const auto& encoding = encodings[0];
+        if (encodings.size() != 1) {
+            throw format_error("invalid BinaryCIF: StringArray encoding must be used alone");
+        }
+
+        auto offsets = decode_numbers(
+            as_binary(get_key(encoding, "offsets")),
+            as_array(get_key(encoding, "offsetEncoding"))
+        );
+        auto indices = decode_numbers(binary, as_array(get_key(encoding, "dataEncoding")));
+        if (!offsets.is_integer || !indices.is_integer) {
+            throw format_error("invalid BinaryCIF: StringArray offsets and indices must be integers");
+        }
+
+        auto offsets_integers = std::vector<size_t>();
+        offsets_integers.reserve(offsets.integers.size());
+        for (auto offset: offsets.integers) {
+            if (offset < 0) {
+                throw format_error("invalid BinaryCIF: negative string offset");
+            }
+            offsets_integers.push_back(static_cast<size_t>(offset));
+        }
+
+        return BinaryCIFColumn(
+            as_string(get_key(encoding, "stringData")).to_string(),
+            std::move(offsets_integers),
+            std::move(indices.integers)
+        );
+    }
+
+    auto values = decode_numbers(binary, encodings);
+    if (values.is_integer) {
+        return BinaryCIFColumn(std::move(values.integers));
+    } else {
+        return BinaryCIFColumn(std::move(values.floats));
+    }
+}
+
+/// Read a little-endian integer of type `T` from `data`
+template<typename T>
+static T read_little_endian(const char* data) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+    }
+    // go through the unsigned type of the same size to get the sign right
+    using unsigned_t = typename std::make_unsigned<T>::type;
+    return static_cast<T>(static_cast<unsigned_t>(value));
+}
+
+/// Decode an array of little-endian integers of type `T` from `data`
+template<typename T>
+static std::vector<int64_t> decode_integers(string_view data) {
+    if (data.size() % sizeof(T) != 0) {
+        throw format_error("invalid BinaryCIF: byte array size is not a multiple of {}", sizeof(T));
+    }
+
+    auto result = std::vector<int64_t>(data.size() / sizeof(T));
+    for (size_t i = 0; i < result.size(); i++) {
+        result[i] = static_cast<int64_t>(read_little_endian<T>(data.data() + i * sizeof(T)));
+    }
+    return result;
+}
+
+/// Decode an array of little-endian floating point values from `data`
+template<typename Float, typename Integer>
+static std::vector<double> decode_floats(string_view data) {
+    static_assert(sizeof(Float) == sizeof(Integer), "mismatched float and integer sizes");
+    if (data.size() % sizeof(Float) != 0) {
+        throw format_error("invalid BinaryCIF: byte array size is not a multiple of {}", sizeof(Float));
+    }
+
+    auto result = std::vector<double>(data.size() / sizeof(Float));
+    for (size_t i = 0; i < result.size(); i++) {
+        auto bits = read_little_endian<Integer>(data.data() + i * sizeof(Float));
+        Float value;
+        std::memcpy(&value, &bits, sizeof(Float));
+        result[i] = static_cast<double>(value);
+    }
+    return result;
+}
+
+static DecodedNumbers decode_byte_array(string_view data, const msgpack::object& encoding) {
+    auto result = DecodedNumbers();
+    auto type = static_cast<int>(as_number(get_key(encoding, "type")));
+    switch (type) {
+    case 1:
+        result.integers = decode_integers<int8_t>(data);
+        break;
+    case 2:
+        result.integers = decode_integers<int16_t>(data);
+        break;
+    case 3:
+        result.integers = decode_integers<int32_t>(data);
+        break;
+    case 4:
+        result.integers = decode_integers<uint8_t>(data);
+        break;
+    case 5:
+        result.integers = decode_integers<uint16_t>(data);
+        break;
+    case 6:
+        result.integers = decode_integers<uint32_t>(data);
+        break;
+    case 32:
+        result.is_integer = false;
+        result.floats = decode_floats<float, uint32_t>(data);
+        break;
+    case 33:
+        result.is_integer = false;
+        result.floats = decode_floats<double, uint64_t>(data);
+        break;
+    default:
+        throw format_error("invalid BinaryCIF: unknown ByteArray type {}", type);
+    }
+    return result;
+}
+
+/// Convert the integers in `values` to floating point values, if needed
+static void to_floats(DecodedNumbers& values) {
+    if (!values.is_integer) {
+        return;
+    }
+
+    values.floats.resize(values.integers.size());
+    for (size_t i = 0; i < values.integers.size(); i++) {
+        values.floats[i] = static_cast<double>(values.integers[i]);
+    }
+    values.integers = std::vector<int64_t>();
+    values.is_integer = false;
+}
+
+template<typename T>
+static std::vector<T> decode_run_length(const std::vector<T>& input, const msgpack::object& encoding) {
+    if (input.size() % 2 != 0) {
+        throw format_error("invalid BinaryCIF: run-length encoded data must have an even size");
+    }
+
+    auto size = static_cast<size_t>(as_integer(get_key(encoding, "srcSize")));
+    auto output = std::vector<T>();
+    output.reserve(size);
+    for (size_t i = 0; i < input.size(); i += 2) {
+        auto value = input[i];
+        if (input[i + 1] < 0) {
+            throw format_error("invalid BinaryCIF: negative run-length");
+        }
+        auto repeat = static_cast<size_t>(input[i + 1]);
+        if (repeat > size - output.size()) {
+            throw format_error("invalid BinaryCIF: run-length encoded data is too long");
+        }
+        output.insert(output.end(), repeat, value);
+    }
+    return output;
+}
+
+template<typename T>
+static std::vector<T> decode_integer_packing(std::vector<T> input, const msgpack::object& encoding) {
+    auto byte_count = as_integer(get_key(encoding, "byteCount"));
+    auto is_unsigned = get_key(encoding, "isUnsigned");
+    if (is_unsigned.type != msgpack::type::BOOLEAN) {
+        throw format_error("invalid BinaryCIF: expected a boolean for isUnsigned");
+    }
+
+    T upper_limit = 0;
+    T lower_limit = 0;
+    if (byte_count == 1) {
+        upper_limit = is_unsigned.via.boolean ? 0xFF : 0x7F;
+        lower_limit = is_unsigned.via.boolean ? 0 : -0x80;
+    } else if (byte_count == 2) {
+        upper_limit = is_unsigned.via.boolean ? 0xFFFF : 0x7FFF;
+        lower_limit = is_unsigned.via.boolean ? 0 : -0x8000;
+    } else {
+        // packing with 4 bytes does not change the data
+        return input;
+    }
+
+    auto size = static_cast<size_t>(as_integer(get_key(encoding, "srcSize")));
+    auto output = std::vector<T>();
+    output.reserve(size);
+    size_t i = 0;
+    while (i < input.size()) {
+        T value = 0;
+        // values at the limit continue in the next element
+        while (i < input.size() && (input[i] == upper_limit || (lower_limit != 0 && input[i] == lower_limit))) {
+            value += input[i];
+            i++;
+        }
+        if (i < input.size()) {
+            value += input[i];
+            i++;
+        }
+        output.push_back(value);
+    }
+    return output;
+}
+
+template<typename T>
+static void decode_delta(std::vector<T>& values, T origin) {
+    auto current = origin;
+    for (auto& value: values) {
+        current += value;
+        value = current;
+    }
+}
+
+DecodedNumbers decode_numbers(string_view data, span<const msgpack::object> encodings) {
+    if (encodings.size() == 0) {
+        throw format_error("invalid BinaryCIF: missing encoding for binary data");
+    }
+
+    auto last = encodings.size() - 1;
+    if (as_string(get_key(encodings[last], "kind")) != "ByteArray") {
+        throw format_error("invalid BinaryCIF: the last encoding must be ByteArray");
+    }
+    auto values = decode_byte_array(data, encodings[last]);
+
+    for (size_t i = last; i-- > 0;) {
+        const auto& encoding = encodings[i];
+        auto kind = as_string(get_key(encoding, "kind"));
+        if (kind == "FixedPoint") {
+            auto factor = as_number(get_key(encoding, "factor"));
+            to_floats(values);
+            for (auto& value: values.floats) {
+                value /= factor;
+            }
+        } else if (kind == "IntervalQuantization") {
+            auto min = as_number(get_key(encoding, "min"));
+            auto max = as_number(get_key(encoding, "max"));
+            auto steps = as_number(get_key(encoding, "numSteps"));
+            if (steps < 2) {
+                throw format_error(
+                    "invalid BinaryCIF: IntervalQuantization needs at least 2 steps, got {}", steps
+                );
+            }
+            auto delta = (max - min) / (steps - 1);
+            to_floats(values);
+            for (auto& value: values.floats) {
+                value = min + delta * value;
+            }
+        } else if (kind == "RunLength") {
+            if (values.is_integer) {
+                values.integers = decode_run_length(values.integers, encoding);
+            } else {
+                values.floats = decode_run_length(values.floats, encoding);
+            }
+        } else if (kind == "Delta") {
+            if (values.is_integer) {
+                decode_delta(values.integers, as_integer(get_key(encoding, "origin")));
+            } else {
+                decode_delta(values.floats, as_number(get_key(encoding, "origin")));
+            }
+        } else if (kind == "IntegerPacking") {
+            if (values.is_integer) {
+                values.integers = decode_integer_packing(std::move(values.integers), encoding);
+            } else {
+                values.floats = decode_integer_packing(std::move(values.floats), encoding);
+            }
+        } else {
+            throw format_error("invalid BinaryCIF: unsupported encoding '{}' for numeric data", kind);
+        }
+    }
+
+    return values;
+}
@@ -191,6 +191,7 @@ void CIFFormat::write(const Frame& frame) {
         );
     }
 
+    file_.flush();
     current_step_++;
 }
 
@@ -0,0 +1,1137 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+#include <lzma.h>
+
+#include "chemfiles/error_fmt.hpp"
+#include "chemfiles/parallel.hpp"
+#include "chemfiles/string_view.hpp"
+#include "chemfiles/types.hpp"
+#include "chemfiles/warnings.hpp"
+#include "chemfiles/external/optional.hpp"
+
+#include "chemfiles/Atom.hpp"
+#include "chemfiles/Connectivity.hpp"
+#include "chemfiles/File.hpp"
+#include "chemfiles/FormatMetadata.hpp"
+#include "chemfiles/Frame.hpp"
+#include "chemfiles/Property.hpp"
+#include "chemfiles/Residue.hpp"
+#include "chemfiles/Topology.hpp"
+#include "chemfiles/UnitCell.hpp"
+
+#include "chemfiles/files/BinaryFile.hpp"
+#include "chemfiles/formats/ChemfilesBinary.hpp"
+
+using namespace chemfiles;
+
+template<> const FormatMetadata& chemfiles::format_metadata<ChemfilesBinaryFormat>() {
+    static FormatMetadata metadata;
+    metadata.name = "Chemfiles Binary";
+    metadata.extension = ".chfl";
+    metadata.description = "Chemfiles native binary trajectory format";
+    metadata.reference = "https://chemfiles.org/chemfiles/latest/formats.html";
+
+    metadata.read = true;
+    metadata.write = true;
+    metadata.memory = false;
+
+    metadata.positions = true;
+    metadata.velocities = true;
+    metadata.unit_cell = true;
+    metadata.atoms = true;
+    metadata.bonds = true;
+    metadata.residues = true;
+    return metadata;
+}
+
+// The file contains a header, followed by blocks and a trailer pointing to
+// the index block:
+//
+//     header:  "CHFLTRAJ" (8 bytes), version (u32), reserved (u32)
+//     block:   kind (4 bytes, "TOPO", "FRAM" or "INDX"), size (u64), content
+//     trailer: offset of the index block (u64), "CHFLINDX" (8 bytes)
+//
+// All numbers are stored in little-endian order.
+static const char FILE_MAGIC[8] = {'C', 'H', 'F', 'L', 'T', 'R', 'A', 'J'};
+static const char INDEX_MAGIC[8] = {'C', 'H', 'F', 'L', 'I', 'N', 'D', 'X'};
+static const uint32_t FILE_VERSION = 1;
+static const uint64_t HEADER_SIZE = 16;
+static const uint64_t TRAILER_SIZE = 16;
+/// Size of the kind and size of a block
+static const uint64_t BLOCK_HEADER_SIZE = 12;
+
+/// Uncompressed size of the blocks of values in a column
+static const size_t BLOCK_BYTES = 1 << 20;
+
+/// Convert `value` to `T`, checking that it fits in `T`. This is a template
+/// to not trigger -Wuseless-cast when both types are the same, for example
+/// `uint64_t` and `size_t` on 64-bit platforms.
+template <typename T, typename U>
+static T checked_cast(U value) {
+    if (value > std::numeric_limits<T>::max()) {
+        throw format_error("{} is too big for this platform in Chemfiles Binary format", value);
+    }
+    return static_cast<T>(value);
+}
+
+namespace {
+    /// Compression used for a block of values
+    enum Codec: uint8_t {
+        NONE = 0,
+        ZLIB = 1,
+        LZMA = 2,
+    };
+
+    /// Type of the values in a column
+    enum ValueType: uint8_t {
+        F64 = 0,
+        F32 = 1,
+    };
+
+    /// What the data in a column corresponds to
+    enum ColumnRole: uint8_t {
+        POSITIONS = 0,
+        VELOCITIES = 1,
+        /// A per-atom column of the frame, see `Frame::add_column`
+        COLUMN = 2,
+    };
+
+    /// Description of a column of per-atom values in a frame block
+    struct Column {
+        ColumnRole role;
+        /// Name of the column, only used for per-atom columns
+        std::string name;
+        ValueType type;
+        /// Number of values per atom (1 or 3)
+        uint8_t width;
+        Codec codec;
+        /// Maximal number of values in each block
+        uint64_t block_values;
+        /// Size of each block in the file
+        std::vector<uint64_t> block_sizes;
+    };
+
+    /// Serialize data to a buffer in memory, in little-endian order
+    class BufferWriter {
+    public:
+        void write_u8(uint8_t value) {
+            data_.push_back(static_cast<char>(value));
+        }
+
+        void write_u64(uint64_t value) {
+            for (size_t i = 0; i < 8; i++) {
+                data_.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+            }
+        }
+
+        void write_i64(int64_t value) {
+            uint64_t unsigned_value;
+            std::memcpy(&unsigned_value, &value, sizeof(value));
+            write_u64(unsigned_value);
+        }
+
+        void write_f64(double value) {
+            uint64_t unsigned_value;
+            std::memcpy(&unsigned_value, &value, sizeof(value));
+            write_u64(unsigned_value);
+        }
+
+        void write_string(const std::string& value) {
+            write_u64(value.size());
+            data_.append(value);
+        }
+
+        void write_properties(const property_map& properties);
+
+        const std::string& data() const {
+            return data_;
+        }
+
+    private:
+        std::string data_;
+    };
+
+    /// Deserialize data written by `BufferWriter`
+    class BufferReader {
+    public:
+        explicit BufferReader(string_view data): data_(data) {}
+
+        uint8_t read_u8() {
+            check_size(1);
+            auto value = static_cast<uint8_t>(data_[position_]);
+            position_ += 1;
+            return value;
+        }
+
+        uint64_t read_u64() {
+            check_size(8);
+            uint64_t value = 0;
+            for (size_t i = 0; i < 8; i++) {
+                auto byte = static_cast<uint8_t>(data_[position_ + i]);
+                value |= static_cast<uint64_t>(byte) << (8 * i);
+            }
+            position_ += 8;
+            return value;
+        }
+
+        int64_t read_i64() {
+            auto unsigned_value = read_u64();
+            int64_t value;
+            std::memcpy(&value, &unsigned_value, sizeof(value));
+            return value;
+        }
+
+        double read_f64() {
+            auto unsigned_value = read_u64();
+            double value;
+            std::memcpy(&value, &unsigned_value, sizeof(value));
+            return value;
+        }
+
+        std::string read_string() {
+            auto size = read_size(1);
+            auto value = data_.substr(position_, size).to_string();
+            position_ += size;
+            return value;
+        }
+
+        /// Read the number of elements in an array, checking that there is
+        /// enough data left for this many elements of at least `element_size`
+        /// bytes
+        size_t read_size(size_t element_size) {
+            auto size = read_u64();
+            if (size > (data_.size() - position_) / element_size) {
+                throw format_error("unexpected end of data in Chemfiles Binary file");
+            }
+            return checked_cast<size_t>(size);
+        }
+
+        property_map read_properties();
+
+    private:
+        void check_size(size_t size) const {
+            if (position_ + size > data_.size()) {
+                throw format_error("unexpected end of data in Chemfiles Binary file");
+            }
+        }
+
+        string_view data_;
+        size_t position_ = 0;
+    };
+}
+
+void BufferWriter::write_properties(const property_map& properties) {
+    write_u64(properties.size());
+    for (const auto& it: properties) {
+        write_string(it.first);
+        const auto& property = it.second;
+        write_u8(static_cast<uint8_t>(property.kind()));
+        switch (property.kind()) {
+        case Property::BOOL:
+            write_u8(property.as_bool() ? 1 : 0);
+            break;
+        case Property::DOUBLE:
+            write_f64(property.as_double());
+            break;
+        case Property::STRING:
+            write_string(property.as_string());
+            break;
+        case Property::VECTOR3D: {
+            auto vector = property.as_vector3d();
+            write_f64(vector[0]);
+            write_f64(vector[1]);
+            write_f64(vector[2]);
+            break;
+        }
+        }
+    }
+}
+
+property_map BufferReader::read_properties() {
+    auto properties = property_map();
+    auto count = read_size(10);
+    for (size_t i = 0; i < count; i++) {
+        auto name = read_string();
+        auto kind = read_u8();
+        switch (kind) {
+        case Property::BOOL:
+            properties.set(std::move(name), read_u8() != 0);
+            break;
+        case Property::DOUBLE:
+            properties.set(std::move(name), read_f64());
+            break;
+        case Property::STRING:
+            properties.set(std::move(name), read_string());
+            break;
+        case Property::VECTOR3D: {
+            auto x = read_f64();
+            auto y = read_f64();
+            auto z = read_f64();
+            properties.set(std::move(name), Vector3D(x, y, z));
+            break;
+        }
+        default:
+            throw format_error("unknown property kind {} in Chemfiles Binary file", kind);
+        }
+    }
+    return properties;
+}
+
+static bool host_is_little_endian() {
+    uint16_t value = 1;
+    char first_byte;
+    std::memcpy(&first_byte, &value, 1);
+    return first_byte == 1;
+}
+
+/// Reverse the bytes of the `count` values of `size` bytes in `data`
+static void swap_bytes(char* data, size_t count, size_t size) {
+    for (size_t i = 0; i < count; i++) {
+        std::reverse(data + i * size, data + (i + 1) * size);
+    }
+}
+
+/// Compress the `count` values of `size` bytes in `data` with `codec`. The
+/// bytes of the values are first shuffled (all the first bytes, then all the
+/// second bytes, ...), since bytes at the same position in different values
+/// are much more similar than consecutive bytes in a single value.
+static std::string encode_block(Codec codec, const char* data, size_t count, size_t size) {
+    auto bytes = count * size;
+    auto shuffled = std::string(bytes, '\0');
+    if (codec == NONE) {
+        std::memcpy(&shuffled[0], data, bytes);
+        if (!host_is_little_endian()) {
+            swap_bytes(&shuffled[0], count, size);
+        }
+        return shuffled;
+    }
+
+    bool little_endian = host_is_little_endian();
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < size; j++) {
+            auto byte = little_endian ? j : size - 1 - j;
+            shuffled[j * count + i] = data[i * size + byte];
+        }
+    }
+
+    auto output = std::string();
+    if (codec == ZLIB) {
+        // use the same compression level as the GZ files
+        auto output_size = compressBound(checked_cast<uLong>(bytes));
+        output.resize(output_size);
+        auto status = compress2(
+            reinterpret_cast<Bytef*>(&output[0]), &output_size,
+            reinterpret_cast<const Bytef*>(shuffled.data()), checked_cast<uLong>(bytes), 7
+        );
+        if (status != Z_OK) {
+            throw format_error("zlib compression failed in Chemfiles Binary format: {}", zError(status));
+        }
+        output.resize(output_size);
+    } else {
+        assert(codec == LZMA);
+        // use the same preset as the XZ files, but with a dictionary matching
+        // the size of the blocks to reduce the memory used by each thread
+        lzma_options_lzma options;
+        lzma_lzma_preset(&options, 6);
+        options.dict_size = static_cast<uint32_t>(std::max<size_t>(bytes, LZMA_DICT_SIZE_MIN));
+        lzma_filter filters[] = {
+            {LZMA_FILTER_LZMA2, &options},
+            {LZMA_VLI_UNKNOWN, nullptr},
+        };
+
+        output.resize(lzma_stream_buffer_bound(bytes));
+        size_t output_size = 0;
+        auto status = lzma_stream_buffer_encode(
+            filters, LZMA_CHECK_NONE, nullptr,
+            reinterpret_cast<const uint8_t*>(shuffled.data()), bytes,
+            reinterpret_cast<uint8_t*>(&output[0]), &output_size, output.size()
+        );
+        if (status != LZMA_OK) {
+            throw format_error("lzma compression failed in Chemfiles Binary format (error code {})", status);
+        }
+        output.resize(output_size);
+    }
+    return output;
+}
+
+/// Get the maximal size of the data in a block of `stored_size` bytes
+/// compressed with `codec`. zlib can not compress more than 1032:1, and lzma
+/// compresses long runs of identical bytes around 7000:1.
+static uint64_t max_decoded_size(Codec codec, uint64_t stored_size) {
+    switch (codec) {
+    case NONE:
+        return stored_size;
+    case ZLIB:
+        return stored_size * 1032;
+    case LZMA:
+        return stored_size * (1 << 14);
+    }
+    // unknown codec, decode_block will report the error
+    return stored_size;
+}
+
+/// Decompress the `count` values of `size` bytes in `block` to `output`,
+/// using `buffer` as scratch space
+static void decode_block(Codec codec, string_view block, char* output, size_t count, size_t size, std::string& buffer) {
+    auto bytes = count * size;
+    if (codec == NONE) {
+        if (block.size() != bytes) {
+            throw format_error(
+                "invalid block in Chemfiles Binary file: expected {} bytes, got {}",
+                bytes, block.size()
+            );
+        }
+        std::memcpy(output, block.data(), bytes);
+        if (!host_is_little_endian()) {
+            swap_bytes(output, count, size);
+        }
+        return;
+    }
+
+    buffer.resize(bytes);
+    if (codec == ZLIB) {
+        auto output_size = checked_cast<uLongf>(bytes);
+        auto status = uncompress(
+            reinterpret_cast<Bytef*>(&buffer[0]), &output_size,
+            reinterpret_cast<const Bytef*>(block.data()), checked_cast<uLong>(block.size())
+        );
+        if (status != Z_OK || output_size != bytes) {
+            throw format_error("invalid zlib compressed block in Chemfiles Binary file");
+        }
+    } else if (codec == LZMA) {
+        auto memory_limit = std::numeric_limits<uint64_t>::max();
+        size_t input_position = 0;
+        size_t output_size = 0;
+        auto status = lzma_stream_buffer_decode(
+            &memory_limit, 0, nullptr,
+            reinterpret_cast<const uint8_t*>(block.data()), &input_position, block.size(),
+            reinterpret_cast<uint8_t*>(&buffer[0]), &output_size, bytes
+        );
+        if (status != LZMA_OK || output_size != bytes) {
+            throw format_error("invalid lzma compressed block in Chemfiles Binary file");
+        }
+    } else {
+        throw format_error("unknown compression codec {} in Chemfiles Binary file", codec);
+    }
+
+    bool little_endian = host_is_little_endian();
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < size; j++) {
+            auto byte = little_endian ? j : size - 1 - j;
+            output[i * size + byte] = buffer[j * count + i];
+        }
+    }
+}
+
+static size_t value_size(ValueType type) {
+    return type == F64 ? sizeof(double) : sizeof(float);
+}
+
+static void write_topology(BufferWriter& writer, const Topology& topology) {
+    writer.write_u64(topology.size());
+    for (const auto& atom: topology) {
+        writer.write_string(atom.name());
+        writer.write_string(atom.type());
+        writer.write_f64(atom.mass());
+        writer.write_f64(atom.charge());
+        writer.write_properties(atom.properties());
+    }
+
+    const auto& bonds = topology.bonds();
+    const auto& bond_orders = topology.bond_orders();
+    writer.write_u64(bonds.size());
+    for (size_t i = 0; i < bonds.size(); i++) {
+        writer.write_u64(bonds[i][0]);
+        writer.write_u64(bonds[i][1]);
+        writer.write_u8(static_cast<uint8_t>(bond_orders[i]));
+    }
+
+    writer.write_u64(topology.residues().size());
+    for (const auto& residue: topology.residues()) {
+        writer.write_string(residue.name());
+        auto id = residue.id();
+        writer.write_u8(id ? 1 : 0);
+        writer.write_i64(id.value_or(0));
+        writer.write_u64(residue.size());
+        for (auto atom: residue) {
+            writer.write_u64(atom);
+        }
+        writer.write_properties(residue.properties());
+    }
+}
+
+static Topology read_topology(BufferReader& reader) {
+    auto topology = Topology();
+    auto natoms = reader.read_size(42);
+    topology.reserve(natoms);
+    for (size_t i = 0; i < natoms; i++) {
+        auto name = reader.read_string();
+        auto type = reader.read_string();
+        auto atom = Atom(std::move(name), std::move(type));
+        atom.set_mass(reader.read_f64());
+        atom.set_charge(reader.read_f64());
+        for (auto& property: reader.read_properties()) {
+            atom.set(property.first, property.second);
+        }
+        topology.add_atom(std::move(atom));
+    }
+
+    auto nbonds = reader.read_size(17);
+    auto bonds = std::vector<Bond>();
+    auto bond_orders = std::vector<Bond::BondOrder>();
+    bonds.reserve(nbonds);
+    bond_orders.reserve(nbonds);
+    for (size_t i = 0; i < nbonds; i++) {
+        auto first = reader.read_u64();
+        auto second = reader.read_u64();
+        if (first >= natoms || second >= natoms || first == second) {
+            throw format_error("invalid bond between atoms {} and {} in Chemfiles Binary file", first, second);
+        }
+        bonds.emplace_back(checked_cast<size_t>(first), checked_cast<size_t>(second));
+        bond_orders.push_back(static_cast<Bond::BondOrder>(reader.read_u8()));
+    }
+    topology.add_bonds(bonds, bond_orders);
+
+    auto nresidues = reader.read_size(33);
+    for (size_t i = 0; i < nresidues; i++) {
+        auto name = reader.read_string();
+        auto has_id = reader.read_u8() != 0;
+        auto id = reader.read_i64();
+        auto residue = has_id ? Residue(std::move(name), id) : Residue(std::move(name));
+        auto size = reader.read_size(8);
+        for (size_t j = 0; j < size; j++) {
+            auto atom = reader.read_u64();
+            if (atom >= natoms) {
+                throw format_error("invalid atom {} in residue in Chemfiles Binary file", atom);
+            }
+            residue.add_atom(checked_cast<size_t>(atom));
+        }
+        for (auto& property: reader.read_properties()) {
+            residue.set(property.first, property.second);
+        }
+        topology.add_residue(std::move(residue));
+    }
+
+    return topology;
+}
+
+/// Check if the two topologies contain the same atoms, bonds and residues
+static bool same_topology(const Topology& lhs, const Topology& rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin()) &&
+           lhs.bonds() == rhs.bonds() &&
+           lhs.bond_orders() == rhs.bond_orders() &&
+           lhs.residues() == rhs.residues();
+}
+
+ChemfilesBinaryFormat::ChemfilesBinaryFormat(std::string path, File::Mode mode, File::Compression compression)
+    : file_(std::move(path), mode) {
+    // the compression only applies to the data written to the file, each
+    // block records the codec used to compress it
+    switch (compression) {
+    case File::DEFAULT:
+        codec_ = NONE;
+        break;
+    case File::GZIP:
+        codec_ = ZLIB;
+        break;
+    case File::LZMA:
+        codec_ = LZMA;
+        break;
+    case File::BZIP2:
+        throw format_error(
+            "bzip2 compression is not supported by Chemfiles Binary format, use GZ or XZ instead"
+        );
+    }
+
+    if (mode == File::WRITE || (mode == File::APPEND && file_.size() == 0)) {
+        file_.write_char(FILE_MAGIC, 8);
+        file_.write_single_u32(FILE_VERSION);
+        file_.write_single_u32(0);
+        return;
+    }
+
+    char magic[8] = {0};
+    try {
+        // files opened in append mode start at the end
+        file_.seek(0);
+        file_.read_char(magic, 8);
+    } catch (const FileError&) {
+        // handled below
+    }
+    if (std::memcmp(magic, FILE_MAGIC, 8) != 0) {
+        throw format_error("'{}' is not a Chemfiles Binary file", file_.path());
+    }
+    auto version = file_.read_single_u32();
+    if (version != FILE_VERSION) {
+        throw format_error(
+            "unsupported version {} in Chemfiles Binary file '{}', only version {} is supported",
+            version, file_.path(), FILE_VERSION
+        );
+    }
+    file_.read_single_u32();
+
+    auto data_end = read_index();
+    if (!data_end) {
+        data_end = scan_blocks();
+    }
+
+    if (mode == File::APPEND) {
+        // new blocks overwrite the index, which is written again at the end
+        file_.seek(*data_end);
+    }
+}
+
+ChemfilesBinaryFormat::~ChemfilesBinaryFormat() {
+    if (file_.mode() != File::READ) {
+        try {
+            write_index();
+        } catch (const std::exception& e) {
+            warning("Chemfiles Binary writer", "error while writing the index of '{}': {}", file_.path(), e.what());
+        } catch (...) {
+            // ignore exceptions in destructor
+        }
+    }
+}
+
+optional<uint64_t> ChemfilesBinaryFormat::read_index() {
+    auto size = file_.size();
+    if (size < HEADER_SIZE + BLOCK_HEADER_SIZE + TRAILER_SIZE) {
+        return nullopt;
+    }
+
+    file_.seek(size - TRAILER_SIZE);
+    auto offset = file_.read_single_u64();
+    char magic[8];
+    file_.read_char(magic, 8);
+    if (std::memcmp(magic, INDEX_MAGIC, 8) != 0) {
+        return nullopt;
+    }
+    if (offset < HEADER_SIZE || offset > size - TRAILER_SIZE - BLOCK_HEADER_SIZE) {
+        return nullopt;
+    }
+
+    file_.seek(offset);
+    char kind[4];
+    file_.read_char(kind, 4);
+    auto block_size = file_.read_single_u64();
+    if (std::memcmp(kind, "INDX", 4) != 0 || block_size != size - TRAILER_SIZE - BLOCK_HEADER_SIZE - offset) {
+        return nullopt;
+    }
+
+    auto buffer = std::string();
+    auto reader = BufferReader(file_.read_view(checked_cast<size_t>(block_size), buffer));
+    auto read_offsets = [&](std::vector<uint64_t>& offsets) {
+        auto count = reader.read_size(8);
+        offsets.resize(count);
+        for (auto& value: offsets) {
+            value = reader.read_u64();
+            if (value < HEADER_SIZE || value >= offset) {
+                throw format_error("invalid index in Chemfiles Binary file '{}'", file_.path());
+            }
+        }
+    };
+    read_offsets(topologies_);
+    read_offsets(frames_);
+
+    return offset;
+}
+
+uint64_t ChemfilesBinaryFormat::scan_blocks() {
+    topologies_.clear();
+    frames_.clear();
+
+    auto size = file_.size();
+    auto offset = HEADER_SIZE;
+    while (size - offset >= BLOCK_HEADER_SIZE) {
+        file_.seek(offset);
+        char kind[4];
+        file_.read_char(kind, 4);
+        auto block_size = file_.read_single_u64();
+        if (block_size > size - offset - BLOCK_HEADER_SIZE) {
+            break;
+        }
+
+        if (std::memcmp(kind, "TOPO", 4) == 0) {
+            topologies_.push_back(offset);
+        } else if (std::memcmp(kind, "FRAM", 4) == 0) {
+            frames_.push_back(offset);
+        } else if (std::memcmp(kind, "INDX", 4) == 0) {
+            // the index is always the last block
+            return offset;
+        } else {
+            throw format_error(
+                "unknown block kind '{}' in Chemfiles Binary file '{}'",
+                string_view(kind, 4), file_.path()
+            );
+        }
+        offset += BLOCK_HEADER_SIZE + block_size;
+    }
+
+    if (offset != size) {
+        // the file was not closed properly, for example if the simulation
+        // writing it is still running
+        warning("Chemfiles Binary reader",
+            "ignoring incomplete block at the end of '{}'", file_.path()
+        );
+    }
+    return offset;
+}
+
+void ChemfilesBinaryFormat::write_index() {
+    auto offset = file_.tell();
+    file_.write_char("INDX", 4);
+    file_.write_single_u64(16 + 8 * (topologies_.size() + frames_.size()));
+    file_.write_single_u64(topologies_.size());
+    if (!topologies_.empty()) {
+        file_.write_u64(topologies_.data(), topologies_.size());
+    }
+    file_.write_single_u64(frames_.size());
+    if (!frames_.empty()) {
+        file_.write_u64(frames_.data(), frames_.size());
+    }
+
+    file_.write_single_u64(offset);
+    file_.write_char(INDEX_MAGIC, 8);
+}
+
+size_t ChemfilesBinaryFormat::nsteps() {
+    return frames_.size();
+}
+
+bool ChemfilesBinaryFormat::write_single_precision() const {
+    return true;
+}
+
+const Topology& ChemfilesBinaryFormat::topology(size_t index) {
+    if (last_topology_index_ && *last_topology_index_ == index) {
+        return last_topology_;
+    }
+
+    if (index >= topologies_.size()) {
+        throw format_error(
+            "invalid topology index {} in Chemfiles Binary file '{}': there are only {} topologies",
+            index, file_.path(), topologies_.size()
+        );
+    }
+
+    auto offset = topologies_[index];
+    auto size = file_.size();
+    if (offset > size - BLOCK_HEADER_SIZE) {
+        throw format_error("invalid topology offset in Chemfiles Binary file '{}'", file_.path());
+    }
+    file_.seek(offset);
+    char kind[4];
+    file_.read_char(kind, 4);
+    auto block_size = file_.read_single_u64();
+    // the content starts with the codec (u8), the raw and stored size (u64)
+    if (std::memcmp(kind, "TOPO", 4) != 0 || block_size > size - offset - BLOCK_HEADER_SIZE || block_size < 17) {
+        throw format_error("expected a topology block in Chemfiles Binary file '{}'", file_.path());
+    }
+
+    auto codec = static_cast<Codec>(file_.read_single_u8());
+    auto raw_size = file_.read_single_u64();
+    auto stored_size = file_.read_single_u64();
+    if (stored_size != block_size - 17) {
+        throw format_error(
+            "invalid topology block in Chemfiles Binary file '{}': expected {} bytes of data, got {}",
+            file_.path(), block_size - 17, stored_size
+        );
+    }
+    // check the size of the decompressed data before allocating memory for it
+    if (raw_size > max_decoded_size(codec, stored_size)) {
+        throw format_error(
+            "invalid topology block in Chemfiles Binary file '{}': {} bytes can not be decompressed to {} bytes",
+            file_.path(), stored_size, raw_size
+        );
+    }
+
+    auto buffer = std::string();
+    auto block = file_.read_view(checked_cast<size_t>(stored_size), buffer);
+    auto content = std::string(checked_cast<size_t>(raw_size), '\0');
+    auto scratch = std::string();
+    decode_block(codec, block, &content[0], content.size(), 1, scratch);
+
+    auto reader = BufferReader(content);
+    last_topology_ = read_topology(reader);
+    last_topology_index_ = index;
+    return last_topology_;
+}
+
+void ChemfilesBinaryFormat::read_step(const size_t step, Frame& frame) {
+    assert(step < frames_.size());
+    step_ = step;
+    read(frame);
+}
+
+void ChemfilesBinaryFormat::read(Frame& frame) {
+    file_.seek(frames_[step_]);
+    step_++;
+
+    char kind[4];
+    file_.read_char(kind, 4);
+    if (std::memcmp(kind, "FRAM", 4) != 0) {
+        throw format_error("expected a frame block in Chemfiles Binary file '{}'", file_.path());
+    }
+    auto block_size = file_.read_single_u64();
+
+    auto header_size = file_.read_single_u64();
+    auto reader = BufferReader(file_.read_view(checked_cast<size_t>(header_size), buffer_));
+    auto data_offset = file_.tell();
+
+    auto step = reader.read_u64();
+    auto topology_index = checked_cast<size_t>(reader.read_u64());
+    auto natoms = checked_cast<size_t>(reader.read_u64());
+
+    // this might read another block from the file. The number of atoms is
+    // checked against the topology before allocating any memory for them.
+    const auto& topology = this->topology(topology_index);
+    if (natoms != topology.size()) {
+        throw format_error(
+            "invalid frame block in Chemfiles Binary file '{}': expected {} atoms from the topology, got {}",
+            file_.path(), topology.size(), natoms
+        );
+    }
+
+    auto shape = reader.read_u8();
+    auto matrix = Matrix3D::zero();
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < 3; j++) {
+            matrix[i][j] = reader.read_f64();
+        }
+    }
+    if (shape > UnitCell::INFINITE) {
+        throw format_error("invalid cell shape {} in Chemfiles Binary file", shape);
+    }
+    auto cell = UnitCell(matrix);
+    if (cell.shape() != shape) {
+        cell.set_shape(static_cast<UnitCell::CellShape>(shape));
+    }
+
+    auto properties = reader.read_properties();
+
+    auto columns = std::vector<Column>(reader.read_size(12));
+    uint64_t data_size = 0;
+    for (auto& column: columns) {
+        column.role = static_cast<ColumnRole>(reader.read_u8());
+        column.name = reader.read_string();
+        column.type = static_cast<ValueType>(reader.read_u8());
+        column.width = reader.read_u8();
+        column.codec = static_cast<Codec>(reader.read_u8());
+        column.block_values = reader.read_u64();
+        column.block_sizes.resize(reader.read_size(8));
+        for (auto& size: column.block_sizes) {
+            size = reader.read_u64();
+            if (size > block_size - data_size) {
+                throw format_error(
+                    "invalid frame block in Chemfiles Binary file '{}': data blocks are larger than the frame block",
+                    file_.path()
+                );
+            }
+            data_size += size;
+        }
+
+        if (column.role > COLUMN || column.type > F32 || !(column.width == 1 || column.width == 3)) {
+            throw format_error("invalid column description in Chemfiles Binary file '{}'", file_.path());
+        }
+        if (column.role != COLUMN && column.width != 3) {
+            throw format_error("invalid column description in Chemfiles Binary file '{}'", file_.path());
+        }
+        auto values = natoms * column.width;
+        if (values != 0) {
+            if (column.block_values == 0 || column.block_sizes.size() != (values + column.block_values - 1) / column.block_values) {
+                throw format_error("invalid column description in Chemfiles Binary file '{}'", file_.path());
+            }
+        }
+
+        // check the size of the decompressed data before allocating memory
+        // for it
+        auto size = value_size(column.type);
+        for (size_t j = 0; j < column.block_sizes.size(); j++) {
+            auto count = std::min<uint64_t>(column.block_values, values - j * column.block_values);
+            if (count * size > max_decoded_size(column.codec, column.block_sizes[j])) {
+                throw format_error(
+                    "invalid frame block in Chemfiles Binary file '{}': {} bytes can not be decompressed to {} bytes",
+                    file_.path(), column.block_sizes[j], count * size
+                );
+            }
+        }
+    }
+    if (8 + header_size + data_size != block_size) {
+        throw format_error(
+            "invalid frame block in Chemfiles Binary file '{}': expected {} bytes, got {}",
+            file_.path(), 8 + header_size + data_size, block_size
+        );
+    }
+
+    frame.resize(natoms);
+    frame.set_topology(topology);
+    frame.set_step(checked_cast<size_t>(step));
+    frame.set_cell(cell);
+    for (const auto& property: properties) {
+        frame.set(property.first, property.second);
+    }
+
+    // Create the storage for all the columns first, since adding a column
+    // might invalidate pointers to other columns
+    for (const auto& column: columns) {
+        if (column.role == VELOCITIES) {
+            frame.add_velocities();
+        } else if (column.role == COLUMN) {
+            if (column.width == 1) {
+                frame.add_column<double>(column.name);
+            } else {
+                frame.add_column<Vector3D>(column.name);
+            }
+        }
+    }
+
+    // Find where to decode each column. Values are decoded directly in the
+    // frame if their type matches the frame storage, and converted after
+    // decoding otherwise.
+    auto outputs = std::vector<char*>(columns.size(), nullptr);
+    // use double storage to ensure the alignment is correct for both double
+    // and float values
+    auto conversions = std::vector<std::vector<double>>(columns.size());
+    for (size_t i = 0; i < columns.size(); i++) {
+        const auto& column = columns[i];
+        bool single = column.role != COLUMN && frame.single_precision();
+        if ((column.type == F32) == single) {
+            switch (column.role) {
+            case POSITIONS:
+                outputs[i] = single ? reinterpret_cast<char*>(frame.positions_f32().data())
+                                    : reinterpret_cast<char*>(frame.positions().data());
+                break;
+            case VELOCITIES:
+                outputs[i] = single ? reinterpret_cast<char*>(frame.velocities_f32()->data())
+                                    : reinterpret_cast<char*>(frame.velocities()->data());
+                break;
+            case COLUMN:
+                outputs[i] = column.width == 1 ? reinterpret_cast<char*>(frame.column<double>(column.name)->data())
+                                               : reinterpret_cast<char*>(frame.column<Vector3D>(column.name)->data());
+                break;
+            }
+        } else {
+            conversions[i].resize(natoms * column.width);
+            outputs[i] = reinterpret_cast<char*>(conversions[i].data());
+        }
+    }
+
+    struct Block {
+        Codec codec;
+        string_view data;
+        char* output;
+        size_t count;
+        size_t size;
+    };
+    file_.seek(data_offset);
+    auto data = file_.read_view(checked_cast<size_t>(data_size), buffer_);
+    auto blocks = std::vector<Block>();
+    size_t raw_size = 0;
+    size_t position = 0;
+    for (size_t i = 0; i < columns.size(); i++) {
+        const auto& column = columns[i];
+        auto values = natoms * column.width;
+        auto size = value_size(column.type);
+        for (size_t j = 0; j < column.block_sizes.size(); j++) {
+            auto start = j * column.block_values;
+            auto count = std::min<size_t>(column.block_values, values - start);
+            auto stored = static_cast<size_t>(column.block_sizes[j]);
+            blocks.push_back({column.codec, data.substr(position, stored), outputs[i] + start * size, count, size});
+            position += stored;
+            raw_size += count * size;
+        }
+    }
+
+    auto nthreads = parallel_threads(raw_size, BLOCK_BYTES);
+    parallel_for(blocks.size(), nthreads, [&](size_t, size_t begin, size_t end) {
+        auto scratch = std::string();
+        for (size_t i = begin; i < end; i++) {
+            const auto& block = blocks[i];
+            decode_block(block.codec, block.data, block.output, block.count, block.size, scratch);
+        }
+    });
+
+    for (size_t i = 0; i < columns.size(); i++) {
+        if (conversions[i].empty()) {
+            continue;
+        }
+
+        const auto& column = columns[i];
+        auto values = natoms * column.width;
+        if (column.type == F64) {
+            // F64 data in a single precision frame
+            const auto* input = conversions[i].data();
+            auto output = column.role == POSITIONS ? frame.positions_f32().data() : frame.velocities_f32()->data();
+            auto output_data = reinterpret_cast<float*>(output);
+            for (size_t j = 0; j < values; j++) {
+                output_data[j] = static_cast<float>(input[j]);
+            }
+        } else {
+            const auto* input = reinterpret_cast<const float*>(conversions[i].data());
+            double* output = nullptr;
+            switch (column.role) {
+            case POSITIONS:
+                output = reinterpret_cast<double*>(frame.positions().data());
+                break;
+            case VELOCITIES:
+                output = reinterpret_cast<double*>(frame.velocities()->data());
+                break;
+            case COLUMN:
+                output = column.width == 1 ? frame.column<double>(column.name)->data()
+                                           : reinterpret_cast<double*>(frame.column<Vector3D>(column.name)->data());
+                break;
+            }
+            for (size_t j = 0; j < values; j++) {
+                output[j] = static_cast<double>(input[j]);
+            }
+        }
+    }
+}
+
+void ChemfilesBinaryFormat::write(const Frame& frame) {
+    const auto& topology = frame.topology();
+    if (!last_topology_index_ || !same_topology(topology, last_topology_)) {
+        auto writer = BufferWriter();
+        write_topology(writer, topology);
+        const auto& content = writer.data();
+        auto block = encode_block(static_cast<Codec>(codec_), content.data(), content.size(), 1);
+
+        topologies_.push_back(file_.tell());
+        file_.write_char("TOPO", 4);
+        file_.write_single_u64(17 + block.size());
+        file_.write_single_u8(codec_);
+        file_.write_single_u64(content.size());
+        file_.write_single_u64(block.size());
+        file_.write_char(block.data(), block.size());
+
+        last_topology_ = topology;
+        last_topology_index_ = topologies_.size() - 1;
+    }
+
+    auto natoms = frame.size();
+    auto codec = static_cast<Codec>(codec_);
+
+    // gather all the per-atom data in the frame
+    auto columns = std::vector<Column>();
+    auto inputs = std::vector<const char*>();
+    auto add_column = [&](ColumnRole role, std::string name, ValueType type, uint8_t width, const void* data) {
+        uint64_t block_values = BLOCK_BYTES / value_size(type);
+        columns.push_back({role, std::move(name), type, width, codec, block_values, {}});
+        inputs.push_back(static_cast<const char*>(data));
+    };
+
+    if (frame.single_precision()) {
+        add_column(POSITIONS, "", F32, 3, frame.positions_f32().data());
+        auto velocities = frame.velocities_f32();
+        if (velocities) {
+            add_column(VELOCITIES, "", F32, 3, velocities->data());
+        }
+    } else {
+        add_column(POSITIONS, "", F64, 3, frame.positions().data());
+        auto velocities = frame.velocities();
+        if (velocities) {
+            add_column(VELOCITIES, "", F64, 3, velocities->data());
+        }
+    }
+    for (const auto& name: frame.columns()) {
+        if (frame.column_kind(name).value() == Property::DOUBLE) {
+            add_column(COLUMN, name, F64, 1, frame.column<double>(name)->data());
+        } else {
+            add_column(COLUMN, name, F64, 3, frame.column<Vector3D>(name)->data());
+        }
+    }
+
+    // compress all the blocks, in parallel if there are enough of them
+    struct Block {
+        size_t column;
+        const char* input;
+        size_t count;
+        size_t size;
+        std::string output;
+    };
+    auto blocks = std::vector<Block>();
+    for (size_t i = 0; i < columns.size(); i++) {
+        const auto& column = columns[i];
+        auto values = natoms * column.width;
+        auto size = value_size(column.type);
+        for (size_t start = 0; start < values; start += column.block_values) {
+            auto count = std::min<size_t>(column.block_values, values - start);
+            blocks.push_back({i, inputs[i] + start * size, count, size, std::string()});
+        }
+    }
+
+    // uncompressed data from little-endian hosts can be written directly
+    bool direct = codec == NONE && host_is_little_endian();
+    if (!direct) {
+        auto nthreads = parallel_threads(natoms * 3 * sizeof(double), BLOCK_BYTES);
+        parallel_for(blocks.size(), nthreads, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                auto& block = blocks[i];
+                block.output = encode_block(codec, block.input, block.count, block.size);
+            }
+        });
+    }
+
+    uint64_t data_size = 0;
+    for (const auto& block: blocks) {
+        auto size = direct ? block.count * block.size : block.output.size();
+        columns[block.column].block_sizes.push_back(size);
+        data_size += size;
+    }
+
+    auto header = BufferWriter();
+    header.write_u64(frame.step());
+    header.write_u64(*last_topology_index_);
+    header.write_u64(natoms);
+
+    const auto& cell = frame.cell();
+    header.write_u8(static_cast<uint8_t>(cell.shape()));
+    auto matrix = cell.matrix();
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < 3; j++) {
+            header.write_f64(matrix[i][j]);
+        }
+    }
+
+    header.write_properties(frame.properties());
+
+    header.write_u64(columns.size());
+    for (const auto& column: columns) {
+        header.write_u8(column.role);
+        header.write_string(column.name);
+        header.write_u8(column.type);
+        header.write_u8(column.width);
+        header.write_u8(column.codec);
+        header.write_u64(column.block_values);
+        header.write_u64(column.block_sizes.size());
+        for (auto size: column.block_sizes) {
+            header.write_u64(size);
+        }
+    }
+
+    frames_.push_back(file_.tell());
+    file_.write_char("FRAM", 4);
+    file_.write_single_u64(8 + header.data().size() + data_size);
+    file_.write_single_u64(header.data().size());
+    file_.write_char(header.data().data(), header.data().size());
+    for (const auto& block: blocks) {
+        if (direct) {
+            file_.write_char(block.input, block.count * block.size);
+        } else {
+            file_.write_char(block.output.data(), block.output.size());
+        }
+    }
+}
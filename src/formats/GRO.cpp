@@ -13,6 +13,8 @@
 #include "chemfiles/types.hpp"
 #include "chemfiles/utils.hpp"
 #include "chemfiles/parse.hpp"
+#include "chemfiles/parallel.hpp"
+#include "chemfiles/atom_cache.hpp"
 #include "chemfiles/warnings.hpp"
 #include "chemfiles/error_fmt.hpp"
 #include "chemfiles/string_view.hpp"
@@ -75,24 +77,31 @@ void GROFormat::read_next(Frame& frame) {
     }
 
     frame.add_velocities();
-    frame.reserve(natoms);
-
-    for (size_t i=0; i<natoms; i++) {
-        auto line = file_.readline();
+    frame.resize(natoms);
+    auto positions = frame.positions();
+    auto velocities = *frame.velocities();
+
+    // residue id and name of all atoms, residues are created after parsing
+    // all the lines
+    auto resids = std::vector<optional<int64_t>>(natoms);
+    auto resnames = std::vector<std::string>(natoms);
+
+    // each thread gets its own copy of the cache
+    auto cache = AtomCache();
+    parallel_lines(file_, natoms, [&, cache](size_t i, string_view line) mutable {
         if (line.length() < 44) {
             throw format_error("GRO Atom line is too small: '{}'", line);
         }
 
-        optional<int64_t> resid = nullopt;
         try {
-            resid = parse<int64_t>(line.substr(0, 5));
+            resids[i] = parse<int64_t>(line.substr(0, 5));
         } catch (const Error&) {
             // Invalid residue, we'll skip it
             warning("GRO Reader", "skiping invalid residue with resid '{}'", line.substr(0, 5));
         }
 
-        auto resname = trim(line.substr(5, 5)).to_string();
-        auto name = trim(line.substr(10, 5)).to_string();
+        resnames[i] = trim(line.substr(5, 5)).to_string();
+        auto name = trim(line.substr(10, 5));
 
         // GRO files store atoms in nanometer, we need to convert to Angstroms
         auto x = parse<double>(line.substr(20, 8)) * 10;
@@ -105,20 +114,27 @@ void GROFormat::read_next(Frame& frame) {
             vy = parse<double>(line.substr(52, 8)) * 10;
             vz = parse<double>(line.substr(60, 8)) * 10;
         }
-        frame.add_atom(Atom(name), {x, y, z}, {vx, vy, vz});
 
+        frame[i] = cache.get(name);
+        positions[i] = Vector3D(x, y, z);
+        velocities[i] = Vector3D(vx, vy, vz);
+    });
+
+    for (size_t i=0; i<natoms; i++) {
+        auto resid = resids[i];
         if (!resid) {
             continue;
         }
 
-        if (residues_.find(*resid) == residues_.end()) {
-            Residue residue(resname, *resid);
-            residue.add_atom(frame.size() - 1);
+        auto it = residues_.find(*resid);
+        if (it == residues_.end()) {
+            Residue residue(std::move(resnames[i]), *resid);
+            residue.add_atom(i);
 
             residues_.insert({*resid, residue});
         } else {
             // Just add this atom to the residue
-            residues_.at(*resid).add_atom(frame.size() - 1);
+            it->second.add_atom(i);
         }
     }
 
@@ -229,19 +245,22 @@ void GROFormat::write_next(const Frame& frame) {
         auto pos = positions[i] / 10;
         check_values_size(pos, 8, "atomic position");
 
+        auto vel = Vector3D();
         if (frame.velocities()) {
-            auto vel = (*frame.velocities())[i] / 10;
+            vel = (*frame.velocities())[i] / 10;
             check_values_size(vel, 8, "atomic velocity");
-            file_.print(
-                "{: >5}{: <5}{: >5}{: >5}{:8.3f}{:8.3f}{:8.3f}{:8.4f}{:8.4f}{:8.4f}\n",
-                resid, resname, frame[i].name(), to_gro_index(i), pos[0], pos[1], pos[2], vel[0], vel[1], vel[2]
-            );
-        } else {
-            file_.print(
-                "{: >5}{: <5}{: >5}{: >5}{:8.3f}{:8.3f}{:8.3f}\n",
-                resid, resname, frame[i].name(), to_gro_index(i), pos[0], pos[1], pos[2]
-            );
         }
+
+        file_.print("{: >5}{: <5}{: >5}{: >5}", resid, resname, frame[i].name(), to_gro_index(i));
+        file_.print_fixed(pos[0], 8, 3);
+        file_.print_fixed(pos[1], 8, 3);
+        file_.print_fixed(pos[2], 8, 3);
+        if (frame.velocities()) {
+            file_.print_fixed(vel[0], 8, 4);
+            file_.print_fixed(vel[1], 8, 4);
+            file_.print_fixed(vel[2], 8, 4);
+        }
+        file_.print("\n");
     }
 
     const auto& cell = frame.cell();
@@ -16,6 +16,7 @@
 #include "chemfiles/types.hpp"
 #include "chemfiles/utils.hpp"
 #include "chemfiles/parse.hpp"
+#include "chemfiles/atom_cache.hpp"
 #include "chemfiles/warnings.hpp"
 #include "chemfiles/error_fmt.hpp"
 #include "chemfiles/sorted_set.hpp"
@@ -223,7 +224,10 @@ void LAMMPSDataFormat::read_next(Frame& frame) {
     auto it = comment.find("atom_style");
     if (it != std::string::npos) {
         auto style = comment.substr(it + 10);
-        atom_style_name_ = trim(split(style, ' ')[0]).to_string();
+        auto tokens = FieldSplitter();
+        if (tokens.split(style) != 0) {
+            atom_style_name_ = tokens[0].to_string();
+        }
     }
 
     while(!file_.eof()) {
@@ -259,6 +263,7 @@ void LAMMPSDataFormat::read_header(Frame& frame) {
     assert(current_section_ == HEADER);
     auto matrix = Matrix3D::unit();
     auto shape = UnitCell::ORTHORHOMBIC;
+    auto tokens = FieldSplitter();
 
     while (!file_.eof()) {
         auto line = file_.readline();
@@ -279,15 +284,14 @@ void LAMMPSDataFormat::read_header(Frame& frame) {
         } else if (content.find("zlo zhi") != std::string::npos) {
             matrix[2][2] = read_header_box_bounds(content, "zlo zhi");
         } else if (content.find("xy xz yz") != std::string::npos) {
-            auto splitted = split(content, ' ');
-            if (splitted.size() != 6) {
+            if (tokens.split(content) != 6) {
                 throw format_error(
                     "invalid header value: expected '<xy> <xz> <yz> xy xz yz', got '{}'", content
                 );
             }
-            matrix[0][1] = parse<double>(splitted[0]);
-            matrix[0][2] = parse<double>(splitted[1]);
-            matrix[1][2] = parse<double>(splitted[2]);
+            matrix[0][1] = parse<double>(tokens[0]);
+            matrix[0][2] = parse<double>(tokens[1]);
+            matrix[1][2] = parse<double>(tokens[2]);
             // Even if all parameters are 0, set shape to TRICLINIC
             shape = UnitCell::TRICLINIC;
         } else {
@@ -303,24 +307,24 @@ void LAMMPSDataFormat::read_header(Frame& frame) {
 }
 
 size_t LAMMPSDataFormat::read_header_integer(string_view line, const std::string& context) {
-    auto splitted = split(line, ' ');
-    if (splitted.size() < 2) {
+    auto tokens = FieldSplitter();
+    if (tokens.split(line) < 2) {
         throw format_error(
             "invalid header value: expected '<n> {}', got '{}'", context, line
         );
     }
-    return parse<size_t>(splitted[0]);
+    return parse<size_t>(tokens[0]);
 }
 
 double LAMMPSDataFormat::read_header_box_bounds(string_view line, const std::string& context) {
-    auto splitted = split(line, ' ');
-    if (splitted.size() < 4) {
+    auto tokens = FieldSplitter();
+    if (tokens.split(line) < 4) {
         throw format_error(
             "invalid header value: expected '<lo> <hi> {}', got '{}'", context, line
         );
     }
-    auto low = parse<double>(splitted[0]);
-    auto high = parse<double>(splitted[1]);
+    auto low = parse<double>(tokens[0]);
+    auto high = parse<double>(tokens[1]);
     return high - low;
 }
 
@@ -369,6 +373,8 @@ void LAMMPSDataFormat::read_atoms(Frame& frame) {
     frame.resize(natoms_);
     auto positions = frame.positions();
     auto residues = std::unordered_map<size_t, Residue>();
+    auto tokens = FieldSplitter();
+    auto cache = AtomCache();
 
     size_t n = 0;
     while (n < natoms_ && !file_.eof()) {
@@ -384,16 +390,15 @@ void LAMMPSDataFormat::read_atoms(Frame& frame) {
             );
         }
 
-        if (!comment.empty()) {
+        if (tokens.split(comment) != 0) {
             // Read the first string after the comment, and use it as atom name
-            auto name = split(comment, ' ')[0];
             if (names_.empty()) {
                 names_.resize(natoms_);
             }
-            names_[data.index] = name.to_string();
+            names_[data.index] = tokens[0].to_string();
         }
 
-        auto atom = Atom(std::to_string(data.type));
+        auto atom = cache.get(std::to_string(data.type));
         if (!std::isnan(data.charge)) {
             atom.set_charge(data.charge);
         }
@@ -431,19 +436,19 @@ void LAMMPSDataFormat::read_masses() {
     if (natom_types_ == 0) {
         throw format_error("missing atom types count in header");
     }
+    auto tokens = FieldSplitter();
     size_t n = 0;
     while (n < natom_types_ && !file_.eof()) {
         auto line = file_.readline();
         split_comment(line);
         if (line.empty()) {continue;}
 
-        auto splitted = split(line, ' ');
-        if (splitted.size() != 2) {
+        if (tokens.split(line) != 2) {
             throw format_error("bad mass specification '{}'", line);
         }
 
-        auto type = splitted[0];
-        auto mass = parse<double>(splitted[1]);
+        auto type = tokens[0];
+        auto mass = parse<double>(tokens[1]);
         masses_.emplace(type.to_string(), mass);
         n++;
     }
@@ -456,26 +461,27 @@ void LAMMPSDataFormat::read_bonds(Frame& frame) {
     if (nbonds_ == 0) {
         throw format_error("missing bonds count in header");
     }
-    size_t n = 0;
-    while (n < nbonds_ && !file_.eof()) {
+    auto bonds = std::vector<Bond>();
+    bonds.reserve(nbonds_);
+    auto tokens = FieldSplitter();
+    while (bonds.size() < nbonds_ && !file_.eof()) {
         auto line = file_.readline();
         split_comment(line);
         if (line.empty()) {continue;}
 
-        auto splitted = split(line, ' ');
-        if (splitted.size() != 4) {
+        if (tokens.split(line) != 4) {
             throw format_error("bad bond specification '{}'", line);
         }
         // LAMMPS use 1-based indexing
-        auto i = parse<size_t>(splitted[2]) - 1;
-        auto j = parse<size_t>(splitted[3]) - 1;
-        frame.add_bond(i, j);
-        n++;
+        auto i = parse<size_t>(tokens[2]) - 1;
+        auto j = parse<size_t>(tokens[3]) - 1;
+        bonds.emplace_back(i, j);
     }
 
-    if (file_.eof() && n < nbonds_) {
+    if (file_.eof() && bonds.size() < nbonds_) {
         throw format_error("end of file found before getting all bonds");
     }
+    frame.add_bonds(bonds);
 
     get_next_section();
 }
@@ -488,20 +494,20 @@ void LAMMPSDataFormat::read_velocities(Frame& frame) {
     size_t n = 0;
     frame.add_velocities();
     auto velocities = *frame.velocities();
+    auto tokens = FieldSplitter();
     while (n < natoms_ && !file_.eof()) {
         auto line = file_.readline();
         split_comment(line);
         if (line.empty()) {continue;}
 
-        auto splitted = split(line, ' ');
-        if (splitted.size() < 4) {
+        if (tokens.split(line) < 4) {
             throw format_error("bad velocity specification '{}'", line);
         }
         // LAMMPS use 1-based indexing
-        auto id = parse<size_t>(splitted[0]) - 1;
-        auto vx = parse<double>(splitted[1]);
-        auto vy = parse<double>(splitted[2]);
-        auto vz = parse<double>(splitted[3]);
+        auto id = parse<size_t>(tokens[0]) - 1;
+        auto vx = parse<double>(tokens[1]);
+        auto vy = parse<double>(tokens[2]);
+        auto vz = parse<double>(tokens[3]);
         velocities[id] = Vector3D(vx, vy, vz);
         n++;
     }
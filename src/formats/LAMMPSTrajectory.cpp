@@ -5,12 +5,16 @@
 #include <cmath>
 #include <cstdint>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <string>
 #include <vector>
 
+#include "chemfiles/cpp14.hpp"
 #include "chemfiles/error_fmt.hpp"
 #include "chemfiles/external/optional.hpp"
+#include "chemfiles/parallel.hpp"
 #include "chemfiles/parse.hpp"
 #include "chemfiles/string_view.hpp"
 #include "chemfiles/types.hpp"
@@ -46,6 +50,26 @@ template <> const FormatMetadata& chemfiles::format_metadata<LAMMPSTrajectoryFor
     return metadata;
 }
 
+template <> const FormatMetadata& chemfiles::format_metadata<LAMMPSBinaryFormat>() {
+    static FormatMetadata metadata;
+    metadata.name = "LAMMPS Binary";
+    metadata.extension = ".bin";
+    metadata.description = "LAMMPS binary trajectory format";
+    metadata.reference = "https://lammps.sandia.gov/doc/dump_modify.html";
+
+    metadata.read = true;
+    metadata.write = false;
+    metadata.memory = false;
+
+    metadata.positions = true;
+    metadata.velocities = true;
+    metadata.unit_cell = true;
+    metadata.atoms = true;
+    metadata.bonds = false;
+    metadata.residues = false;
+    return metadata;
+}
+
 using chemfiles::private_details::is_upper_triangular;
 
 static optional<string_view> get_item(string_view line) {
@@ -63,63 +87,64 @@ std::array<double, 3> LAMMPSTrajectoryFormat::read_cell(Frame& frame) {
         if (!item) {
             throw format_error("expected an ITEM entry in LAMMPS format, got '{}'", line);
         }
-        auto splitted = split(*item, ' ');
-        if (splitted[0] == "BOX" && splitted[1] == "BOUNDS") {
+        auto tokens = FieldSplitter();
+        tokens.split(*item);
+        if (tokens[0] == "BOX" && tokens[1] == "BOUNDS") {
             auto matrix = Matrix3D::unit();
             std::array<double, 3> origin;
             auto shape = UnitCell::ORTHORHOMBIC;
-            if (splitted.size() >= 5 && (*item).find("xy xz yz") != string_view::npos) {
+            if (tokens.size() >= 5 && (*item).find("xy xz yz") != string_view::npos) {
                 shape = UnitCell::TRICLINIC;
             }
             line = file_.readline();
-            splitted = split(line, ' ');
-            if ((shape == UnitCell::ORTHORHOMBIC && splitted.size() != 2) ||
-                (shape == UnitCell::TRICLINIC && splitted.size() != 3)) {
+            tokens.split(line);
+            if ((shape == UnitCell::ORTHORHOMBIC && tokens.size() != 2) ||
+                (shape == UnitCell::TRICLINIC && tokens.size() != 3)) {
                 size_t expected_dims = (shape == UnitCell::ORTHORHOMBIC) ? 2 : 3;
                 throw format_error(
                     "incomplete box dimensions in LAMMPS format, expected {} but got {}",
-                    expected_dims, splitted.size());
+                    expected_dims, tokens.size());
             }
-            double xlo = parse<double>(splitted[0]);
-            double xhi = parse<double>(splitted[1]);
+            double xlo = parse<double>(tokens[0]);
+            double xhi = parse<double>(tokens[1]);
             matrix[0][0] = xhi - xlo;
             origin[0] = xlo;
             if (shape == UnitCell::TRICLINIC) {
-                matrix[0][1] = parse<double>(splitted[2]);
+                matrix[0][1] = parse<double>(tokens[2]);
             }
 
             line = file_.readline();
-            splitted = split(line, ' ');
-            if ((shape == UnitCell::ORTHORHOMBIC && splitted.size() != 2) ||
-                (shape == UnitCell::TRICLINIC && splitted.size() != 3)) {
+            tokens.split(line);
+            if ((shape == UnitCell::ORTHORHOMBIC && tokens.size() != 2) ||
+                (shape == UnitCell::TRICLINIC && tokens.size() != 3)) {
                 size_t expected_dims = (shape == UnitCell::ORTHORHOMBIC) ? 2 : 3;
                 throw format_error(
                     "incomplete box dimensions in LAMMPS format, expected {} but got {}",
-                    expected_dims, splitted.size());
+                    expected_dims, tokens.size());
             }
-            double ylo = parse<double>(splitted[0]);
-            double yhi = parse<double>(splitted[1]);
+            double ylo = parse<double>(tokens[0]);
+            double yhi = parse<double>(tokens[1]);
             matrix[1][1] = yhi - ylo;
             origin[1] = ylo;
             if (shape == UnitCell::TRICLINIC) {
-                matrix[0][2] = parse<double>(splitted[2]);
+                matrix[0][2] = parse<double>(tokens[2]);
             }
 
             line = file_.readline();
-            splitted = split(line, ' ');
-            if ((shape == UnitCell::ORTHORHOMBIC && splitted.size() != 2) ||
-                (shape == UnitCell::TRICLINIC && splitted.size() != 3)) {
+            tokens.split(line);
+            if ((shape == UnitCell::ORTHORHOMBIC && tokens.size() != 2) ||
+                (shape == UnitCell::TRICLINIC && tokens.size() != 3)) {
                 size_t expected_dims = (shape == UnitCell::ORTHORHOMBIC) ? 2 : 3;
                 throw format_error(
                     "incomplete box dimensions in LAMMPS format, expected {} but got {}",
-                    expected_dims, splitted.size());
+                    expected_dims, tokens.size());
             }
-            double zlo = parse<double>(splitted[0]);
-            double zhi = parse<double>(splitted[1]);
+            double zlo = parse<double>(tokens[0]);
+            double zhi = parse<double>(tokens[1]);
             matrix[2][2] = zhi - zlo;
             origin[2] = zlo;
             if (shape == UnitCell::TRICLINIC) {
-                matrix[1][2] = parse<double>(splitted[2]);
+                matrix[1][2] = parse<double>(tokens[2]);
             }
 
             auto cell = UnitCell(matrix);
@@ -305,6 +330,46 @@ static void unwrap(Vector3D& position, std::array<int, 3>& image, Matrix3D& matr
     position[2] += image[2] * matrix[2][2];
 }
 
+/// Convert the positions in `frame` to unwrapped cartesian coordinates, using
+/// the representation used in the file, the `origin` of the box and
+/// (optionally) the box `images` for all atoms
+static void convert_positions(Frame& frame, const std::array<double, 3>& origin,
+                              lammps_position_representation_t use_pos_repr,
+                              optional<std::vector<std::array<int, 3>>>& images) {
+    auto natoms = frame.size();
+    auto positions = frame.positions();
+    if (use_pos_repr == SCALED || use_pos_repr == SCALED_UNWRAPPED) {
+        // all atoms currently know their scales position
+        // transform the scaled coordinates to a non-scaled representation
+        auto matrix = frame.cell().matrix();
+        for (size_t i = 0; i < natoms; ++i) {
+            // x = xlo + xs * (xhi - xlo) + ys * xy + zs * xz
+            positions[i][0] = origin[0] + positions[i][0] * matrix[0][0] +
+                              positions[i][1] * matrix[0][1] + positions[i][2] * matrix[0][2];
+            // y = ylo + ys * (yhi - ylo) + z * yz
+            positions[i][1] =
+                origin[1] + positions[i][1] * matrix[1][1] + positions[i][2] * matrix[1][2];
+            // z = zlo + zs * (zhi - zlo)
+            positions[i][2] = origin[2] + positions[i][2] * matrix[2][2];
+            if (images && use_pos_repr != SCALED_UNWRAPPED) {
+                // unwrap coordinates by using image data
+                unwrap(positions[i], (*images)[i], matrix);
+            }
+        }
+    } else if (images && use_pos_repr != UNWRAPPED) {
+        // unwrap coordinates by using image data
+        auto matrix = frame.cell().matrix();
+        for (size_t i = 0; i < natoms; ++i) {
+            unwrap(positions[i], (*images)[i], matrix);
+        }
+    }
+}
+
+void LAMMPSTrajectoryFormat::read_at(uint64_t position, Frame& frame) {
+    file_.seekpos(position);
+    read_next(frame);
+}
+
 void LAMMPSTrajectoryFormat::read_next(Frame& frame) {
     auto item = get_item(file_.readline());
     if (!item) {
@@ -352,21 +417,20 @@ void LAMMPSTrajectoryFormat::read_next(Frame& frame) {
     if (!item) {
         throw format_error("can not read next step as LAMMPS format: expected an ITEM entry");
     }
-    auto atoms_item = split(*item, ' ');
-    if (atoms_item.empty() || atoms_item[0] != "ATOMS") {
+    auto atoms_item = FieldSplitter();
+    atoms_item.split(*item);
+    if (atoms_item.size() == 0 || atoms_item[0] != "ATOMS") {
         throw format_error("can not read next step as LAMMPS format: expected 'ATOMS' got '{}'",
                            *item);
     }
     std::vector<AtomField> fields;
     fields.reserve(atoms_item.size() - 1);
     optional<size_t> atomid_column = nullopt;
-    std::vector<bool> duplicate_check;
     optional<std::vector<std::array<int, 3>>> images = nullopt;
     for (size_t i = 1; i < atoms_item.size(); ++i) {
         auto attr = attribute_from_str(atoms_item[i]);
         if (attr == ATOMID) {
             atomid_column = i - 1;
-            duplicate_check = std::vector<bool>(natoms, false);
         }
         if (attr == VELX || attr == VELY || attr == VELZ) {
             frame.add_velocities();
@@ -382,133 +446,160 @@ void LAMMPSTrajectoryFormat::read_next(Frame& frame) {
     auto positions = frame.positions();
     auto velocities = frame.velocities();
 
-    for (size_t i = 0; i < natoms; ++i) {
-        auto line = file_.readline();
-        auto splitted = split(line, ' ');
-        if (splitted.size() != fields.size()) {
+    // custom fields are stored in per-atom columns of the frame
+    for (const auto& field: fields) {
+        if (field.kind == CUSTOM) {
+            frame.add_column<double>(field.name);
+        }
+    }
+    auto custom_columns = std::vector<double*>(fields.size(), nullptr);
+    for (size_t j = 0; j < fields.size(); ++j) {
+        if (fields[j].kind == CUSTOM) {
+            custom_columns[j] = frame.column<double>(fields[j].name)->data();
+        }
+    }
+
+    // Lines can be in any order when using atom IDs, so parsing them in
+    // parallel is fine as long as no two lines use the same ID. Only the
+    // thread setting the flag for an ID can write to the corresponding atom.
+    auto seen_atomids = std::vector<std::atomic<bool>>(atomid_column && !keep_file_order_ ? natoms : 0);
+    if (keep_file_order_) {
+        atom_ids_.assign(atomid_column ? natoms : 0, 0);
+    }
+    auto custom_is_numeric = std::vector<std::atomic<bool>>(fields.size());
+    auto tokens = FieldSplitter();
+    parallel_lines(file_, natoms, [&, tokens](size_t i, string_view line) mutable {
+        tokens.split(line);
+        if (tokens.size() != fields.size()) {
             throw format_error(
                 "LAMMPS atom line has wrong number of fields: expected {} got {}",
-                fields.size(), splitted.size()
+                fields.size(), tokens.size()
             );
         }
 
         size_t atomid = i;
-        if (atomid_column) {
+        if (atomid_column && keep_file_order_) {
+            // the IDs are checked when merging multiple files
+            atom_ids_[i] = parse<size_t>(tokens[*atomid_column]);
+        } else if (atomid_column) {
             // LAMMPS uses atom IDs that start with 1
-            atomid = parse<size_t>(splitted[*atomid_column]);
-            assert(atomid > 0);
+            atomid = parse<size_t>(tokens[*atomid_column]);
+            if (atomid == 0 || atomid > natoms) {
+                throw format_error(
+                    "invalid atom ID in LAMMPS format: expected a value between 1 and {}, got {}",
+                    natoms, atomid
+                );
+            }
             --atomid; // the frame uses zero-based indices
-            assert(duplicate_check.size() == natoms);
-            if (duplicate_check[atomid]) {
+            if (seen_atomids[atomid].exchange(true)) {
                 throw format_error(
                     "found atoms with the same ID in LAMMPS format: {} is already present",
                     atomid + 1);
             }
-            duplicate_check[atomid] = true;
         }
 
         auto& atom = frame[atomid];
         for (size_t j = 0; j < fields.size(); ++j) {
             switch (fields[j].kind) {
             case TYPE:
-                atom.set_type(splitted[j].to_string());
+                atom.set_type(tokens[j].to_string());
                 break;
             case ELEMENT:
-                atom.set_name(splitted[j].to_string());
+                atom.set_name(tokens[j].to_string());
                 break;
             case MASS:
-                atom.set_mass(parse<double>(splitted[j]));
+                atom.set_mass(parse<double>(tokens[j]));
                 break;
             case POSX:
                 if (use_pos_repr == WRAPPED) {
-                    positions[atomid][0] = parse<double>(splitted[j]);
+                    positions[atomid][0] = parse<double>(tokens[j]);
                 }
                 break;
             case POSY:
                 if (use_pos_repr == WRAPPED) {
-                    positions[atomid][1] = parse<double>(splitted[j]);
+                    positions[atomid][1] = parse<double>(tokens[j]);
                 }
                 break;
             case POSZ:
                 if (use_pos_repr == WRAPPED) {
-                    positions[atomid][2] = parse<double>(splitted[j]);
+                    positions[atomid][2] = parse<double>(tokens[j]);
                 }
                 break;
             case POSXS:
                 if (use_pos_repr == SCALED) {
                     // store scaled position (same for POSYS and POSZS)
                     // transform at the end when all three coordinates are known
-                    positions[atomid][0] = parse<double>(splitted[j]);
+                    positions[atomid][0] = parse<double>(tokens[j]);
                 }
                 break;
             case POSYS:
                 if (use_pos_repr == SCALED) {
-                    positions[atomid][1] = parse<double>(splitted[j]);
+                    positions[atomid][1] = parse<double>(tokens[j]);
                 }
                 break;
             case POSZS:
                 if (use_pos_repr == SCALED) {
-                    positions[atomid][2] = parse<double>(splitted[j]);
+                    positions[atomid][2] = parse<double>(tokens[j]);
                 }
                 break;
             case POSXU:
                 if (use_pos_repr == UNWRAPPED) {
-                    positions[atomid][0] = parse<double>(splitted[j]);
+                    positions[atomid][0] = parse<double>(tokens[j]);
                 }
                 break;
             case POSYU:
                 if (use_pos_repr == UNWRAPPED) {
-                    positions[atomid][1] = parse<double>(splitted[j]);
+                    positions[atomid][1] = parse<double>(tokens[j]);
                 }
                 break;
             case POSZU:
                 if (use_pos_repr == UNWRAPPED) {
-                    positions[atomid][2] = parse<double>(splitted[j]);
+                    positions[atomid][2] = parse<double>(tokens[j]);
                 }
                 break;
             case POSXSU:
                 if (use_pos_repr == SCALED_UNWRAPPED) {
                     // store scaled position (same for POSYSU and POSZSU)
                     // transform at the end when all three coordinates are known
-                    positions[atomid][0] = parse<double>(splitted[j]);
+                    positions[atomid][0] = parse<double>(tokens[j]);
                 }
                 break;
             case POSYSU:
                 if (use_pos_repr == SCALED_UNWRAPPED) {
-                    positions[atomid][1] = parse<double>(splitted[j]);
+                    positions[atomid][1] = parse<double>(tokens[j]);
                 }
                 break;
             case POSZSU:
                 if (use_pos_repr == SCALED_UNWRAPPED) {
-                    positions[atomid][2] = parse<double>(splitted[j]);
+                    positions[atomid][2] = parse<double>(tokens[j]);
                 }
                 break;
             case IMGX:
                 assert(images);
-                (*images)[atomid][0] = parse<int>(splitted[j]);
+                (*images)[atomid][0] = parse<int>(tokens[j]);
                 break;
             case IMGY:
                 assert(images);
-                (*images)[atomid][1] = parse<int>(splitted[j]);
+                (*images)[atomid][1] = parse<int>(tokens[j]);
                 break;
             case IMGZ:
                 assert(images);
-                (*images)[atomid][2] = parse<int>(splitted[j]);
+                (*images)[atomid][2] = parse<int>(tokens[j]);
                 break;
             case VELX:
                 assert(velocities);
-                (*velocities)[atomid][0] = parse<double>(splitted[j]);
+                (*velocities)[atomid][0] = parse<double>(tokens[j]);
                 break;
             case VELY:
                 assert(velocities);
-                (*velocities)[atomid][1] = parse<double>(splitted[j]);
+                (*velocities)[atomid][1] = parse<double>(tokens[j]);
                 break;
             case VELZ:
                 assert(velocities);
-                (*velocities)[atomid][2] = parse<double>(splitted[j]);
+                (*velocities)[atomid][2] = parse<double>(tokens[j]);
                 break;
             case CHARGE: {
-                double charge = parse<double>(splitted[j]);
+                double charge = parse<double>(tokens[j]);
                 atom.set_charge(charge);
             } break;
             case ATOMID:
@@ -516,45 +607,30 @@ void LAMMPSTrajectoryFormat::read_next(Frame& frame) {
             case CUSTOM:
                 try {
                     // LAMMPS should always write double values
-                    atom.set(fields[j].name, parse<double>(splitted[j]));
+                    custom_columns[j][atomid] = parse<double>(tokens[j]);
+                    custom_is_numeric[j].store(true, std::memory_order_relaxed);
                 } catch (const Error&) {
-                    // use the string value as fallback
-                    atom.set(fields[j].name, splitted[j].to_string());
+                    // use a string atomic property as fallback
+                    atom.set(fields[j].name, tokens[j].to_string());
                 }
                 break;
             }
         }
-    }
+    });
 
-    if (use_pos_repr == SCALED || use_pos_repr == SCALED_UNWRAPPED) {
-        // all atoms currently know their scales position
-        // transform the scaled coordinates to a non-scaled representation
-        auto matrix = frame.cell().matrix();
-        for (size_t i = 0; i < natoms; ++i) {
-            // x = xlo + xs * (xhi - xlo) + ys * xy + zs * xz
-            positions[i][0] = origin[0] + positions[i][0] * matrix[0][0] +
-                              positions[i][1] * matrix[0][1] + positions[i][2] * matrix[0][2];
-            // y = ylo + ys * (yhi - ylo) + z * yz
-            positions[i][1] =
-                origin[1] + positions[i][1] * matrix[1][1] + positions[i][2] * matrix[1][2];
-            // z = zlo + zs * (zhi - zlo)
-            positions[i][2] = origin[2] + positions[i][2] * matrix[2][2];
-            if (images && use_pos_repr != SCALED_UNWRAPPED) {
-                // unwrap coordinates by using image data
-                unwrap(positions[i], (*images)[i], matrix);
-            }
-        }
-    } else if (images && use_pos_repr != UNWRAPPED) {
-        // unwrap coordinates by using image data
-        auto matrix = frame.cell().matrix();
-        for (size_t i = 0; i < natoms; ++i) {
-            unwrap(positions[i], (*images)[i], matrix);
+    for (size_t j = 0; j < fields.size(); ++j) {
+        if (fields[j].kind == CUSTOM && !custom_is_numeric[j]) {
+            frame.remove_column(fields[j].name);
         }
     }
+
+    convert_positions(frame, origin, use_pos_repr, images);
 }
 
 static optional<size_t> parse_lammps_type(const std::string& type_str) {
-    if (type_str.empty())
+    // names such as 'C' or 'Zn' are never numeric types, check this before
+    // paying for the parsing exception
+    if (type_str.empty() || is_ascii_letter(type_str[0]))
         return nullopt;
     try {
         int type = parse<int>(type_str);
@@ -606,7 +682,7 @@ void LAMMPSTrajectoryFormat::write_next(const Frame& frame) {
         }
     }
 
-    auto positions = frame.positions();
+    const auto& positions = frame.positions();
     auto velocities = frame.velocities();
     file_.print("ITEM: ATOMS id xu yu zu type"); // write unwrapped positions
     if (has_names) {
@@ -620,8 +696,11 @@ void LAMMPSTrajectoryFormat::write_next(const Frame& frame) {
     for (size_t i = 0; i < frame.size(); ++i) {
         auto& atom = frame[i];
         // LAMMPS uses atom IDs that start with 1
-        file_.print("{:d} {:g} {:g} {:g}", i + 1, positions[i][0], positions[i][1],
-                    positions[i][2]);
+        file_.print("{:d}", i + 1);
+        for (size_t k = 0; k < 3; k++) {
+            file_.print(" ");
+            file_.print_general(positions[i][k]);
+        }
         auto type = parse_lammps_type(atom.type());
         if (type && (min_numeric_type_ == 0 || *type <= min_numeric_type_)) {
             // a valid numeric type and no other invalid types encountered previously
@@ -648,10 +727,15 @@ void LAMMPSTrajectoryFormat::write_next(const Frame& frame) {
         if (has_names) {
             file_.print(" {:s}", atom.name());
         }
-        file_.print(" {:g} {:g}", atom.mass(), atom.charge());
+        file_.print(" ");
+        file_.print_general(atom.mass());
+        file_.print(" ");
+        file_.print_general(atom.charge());
         if (velocities) {
-            auto& v = (*velocities)[i];
-            file_.print(" {:g} {:g} {:g}", v[0], v[1], v[2]);
+            for (size_t k = 0; k < 3; k++) {
+                file_.print(" ");
+                file_.print_general((*velocities)[i][k]);
+            }
         }
         file_.print("\n");
     }
@@ -727,3 +811,718 @@ optional<uint64_t> LAMMPSTrajectoryFormat::forward() {
 
     return position;
 }
+
+/// Header of a single step in a LAMMPS binary dump
+struct LAMMPSBinaryHeader {
+    int64_t timestep = 0;
+    size_t natoms = 0;
+    /// Box bounds, as xlo, xhi, ylo, yhi, zlo, zhi
+    std::array<double, 6> bounds = {{0, 0, 0, 0, 0, 0}};
+    /// Tilt factors for triclinic boxes, as xy, xz, yz
+    std::array<double, 3> tilts = {{0, 0, 0}};
+    /// Number of values for each atom
+    size_t size_one = 0;
+    std::string units;
+    optional<double> time;
+    /// Names of the per-atom columns, separated by spaces
+    std::string columns;
+    /// Number of chunks of per-atom values after the header
+    size_t nchunks = 0;
+};
+
+/// Read the header of the next step in a LAMMPS binary dump `file`
+static LAMMPSBinaryHeader read_binary_header(BinaryFile& file) {
+    // Files created by LAMMPS since 29Oct2020 start each step with the
+    // negative length of a magic string, followed by the string itself
+    auto marker = file.read_single_i64();
+    if (marker >= 0) {
+        throw format_error(
+            "unsupported LAMMPS binary dump, created by a version of LAMMPS "
+            "older than 29Oct2020 which does not store column names"
+        );
+    }
+    if (marker < -64) {
+        throw format_error("invalid magic string length ({}) in LAMMPS binary dump", -marker);
+    }
+
+    auto magic = std::string(static_cast<size_t>(-marker), '\0');
+    file.read_char(&magic[0], magic.size());
+    if (magic != "DUMPATOM" && magic != "DUMPCUSTOM") {
+        throw format_error("unsupported LAMMPS binary dump style '{}'", magic);
+    }
+
+    auto endian = file.read_single_i32();
+    if (endian != 0x0001) {
+        throw format_error("unsupported big-endian LAMMPS binary dump");
+    }
+
+    auto revision = file.read_single_i32();
+    if (revision < 0x0002) {
+        throw format_error(
+            "unsupported LAMMPS binary dump revision {}, which does not store column names",
+            revision
+        );
+    }
+
+    LAMMPSBinaryHeader header;
+    header.timestep = file.read_single_i64();
+    auto natoms = file.read_single_i64();
+    if (natoms < 0) {
+        throw format_error("invalid number of atoms ({}) in LAMMPS binary dump", natoms);
+    }
+    header.natoms = static_cast<size_t>(natoms);
+
+    auto triclinic = file.read_single_i32();
+    // skip the boundary conditions
+    int32_t boundary[6];
+    file.read_i32(boundary, 6);
+
+    file.read_f64(header.bounds.data(), 6);
+    if (triclinic != 0) {
+        file.read_f64(header.tilts.data(), 3);
+    }
+
+    auto size_one = file.read_single_i32();
+    if (size_one <= 0) {
+        throw format_error("invalid number of values per atom ({}) in LAMMPS binary dump", size_one);
+    }
+    header.size_one = static_cast<size_t>(size_one);
+
+    auto read_string = [&file]() {
+        auto length = file.read_single_i32();
+        if (length < 0) {
+            throw format_error("invalid string length ({}) in LAMMPS binary dump", length);
+        }
+        auto string = std::string(static_cast<size_t>(length), '\0');
+        if (length > 0) {
+            file.read_char(&string[0], string.size());
+        }
+        return string;
+    };
+
+    header.units = read_string();
+    if (file.read_single_char() != 0) {
+        header.time = file.read_single_f64();
+    }
+    header.columns = read_string();
+
+    auto nchunks = file.read_single_i32();
+    if (nchunks < 0) {
+        throw format_error("invalid number of chunks ({}) in LAMMPS binary dump", nchunks);
+    }
+    header.nchunks = static_cast<size_t>(nchunks);
+
+    return header;
+}
+
+LAMMPSBinaryFormat::LAMMPSBinaryFormat(std::string path, File::Mode mode, File::Compression compression)
+    : file_(std::move(path), mode) {
+    if (mode != File::READ) {
+        throw format_error("LAMMPS binary format only supports reading");
+    }
+    if (compression != File::DEFAULT) {
+        throw format_error("LAMMPS binary format does not support compression");
+    }
+
+    // Build the index of all steps. The per-atom values are stored in chunks
+    // (one for each MPI rank), and each chunk starts with its size, so only
+    // the headers need to be read.
+    auto size = file_.size();
+    while (file_.tell() < size) {
+        auto offset = file_.tell();
+        try {
+            auto header = read_binary_header(file_);
+            if (units_.empty()) {
+                units_ = std::move(header.units);
+            }
+
+            size_t count = 0;
+            for (size_t i = 0; i < header.nchunks; i++) {
+                auto n = file_.read_single_i32();
+                if (n < 0) {
+                    throw format_error("invalid chunk size ({}) in LAMMPS binary dump", n);
+                }
+                count += static_cast<size_t>(n);
+                file_.seek(file_.tell() + static_cast<uint64_t>(n) * sizeof(double));
+            }
+
+            if (count != header.natoms * header.size_one) {
+                throw format_error(
+                    "invalid LAMMPS binary dump: expected {} values for {} atoms, got {}",
+                    header.natoms * header.size_one, header.natoms, count
+                );
+            }
+        } catch (const FileError&) {
+            // reading past the end of the file
+            file_.seek(size + 1);
+        }
+
+        if (file_.tell() > size) {
+            // the simulation might still be running
+            warning("LAMMPS binary reader",
+                "ignoring incomplete step {} at the end of '{}'",
+                offsets_.size(), file_.path()
+            );
+            break;
+        }
+        offsets_.push_back(offset);
+    }
+}
+
+LAMMPSBinaryFormat::LAMMPSBinaryFormat(std::string path, std::vector<uint64_t> offsets, std::string units)
+    : file_(std::move(path), File::READ), offsets_(std::move(offsets)), units_(std::move(units)) {}
+
+size_t LAMMPSBinaryFormat::nsteps() {
+    return offsets_.size();
+}
+
+void LAMMPSBinaryFormat::read_step(const size_t step, Frame& frame) {
+    assert(step < offsets_.size());
+    step_ = step;
+    read(frame);
+}
+
+void LAMMPSBinaryFormat::read(Frame& frame) {
+    file_.seek(offsets_[step_]);
+    step_++;
+
+    auto header = read_binary_header(file_);
+    auto natoms = header.natoms;
+    auto size_one = header.size_one;
+
+    frame.set_step(static_cast<size_t>(header.timestep));
+    if (!units_.empty()) {
+        frame.set("lammps_units", units_);
+    }
+    if (header.time) {
+        frame.set("time", *header.time);
+    }
+
+    const auto& bounds = header.bounds;
+    auto matrix = Matrix3D::unit();
+    matrix[0][0] = bounds[1] - bounds[0];
+    matrix[1][1] = bounds[3] - bounds[2];
+    matrix[2][2] = bounds[5] - bounds[4];
+    matrix[0][1] = header.tilts[0];
+    matrix[0][2] = header.tilts[1];
+    matrix[1][2] = header.tilts[2];
+    frame.set_cell(UnitCell(matrix));
+    // LAMMPS can have boxes that do not use (0,0,0) as origin
+    auto origin = std::array<double, 3>{{bounds[0], bounds[2], bounds[4]}};
+
+    auto names = FieldSplitter();
+    names.split(header.columns);
+    if (names.size() != size_one) {
+        throw format_error(
+            "invalid LAMMPS binary dump: got {} column names for {} values per atom",
+            names.size(), size_one
+        );
+    }
+
+    frame.resize(natoms);
+
+    std::vector<AtomField> fields;
+    fields.reserve(size_one);
+    optional<size_t> atomid_column = nullopt;
+    optional<std::vector<std::array<int, 3>>> images = nullopt;
+    for (size_t j = 0; j < names.size(); ++j) {
+        auto attr = attribute_from_str(names[j]);
+        if (attr == ATOMID) {
+            atomid_column = j;
+        }
+        if (attr == VELX || attr == VELY || attr == VELZ) {
+            frame.add_velocities();
+        }
+        if (attr == IMGX || attr == IMGY || attr == IMGZ) {
+            images = std::vector<std::array<int, 3>>(natoms, {0, 0, 0});
+        }
+        fields.push_back({names[j].to_string(), attr});
+    }
+    auto use_pos_repr = detect_best_pos_representation(fields);
+
+    // all values are numeric in binary dumps, so custom fields are always
+    // stored in per-atom columns
+    for (const auto& field: fields) {
+        if (field.kind == CUSTOM) {
+            frame.add_column<double>(field.name);
+        }
+    }
+    auto custom_columns = std::vector<double*>(fields.size(), nullptr);
+    for (size_t j = 0; j < fields.size(); ++j) {
+        if (fields[j].kind == CUSTOM) {
+            custom_columns[j] = frame.column<double>(fields[j].name)->data();
+        }
+    }
+
+    values_.resize(natoms * size_one);
+    size_t count = 0;
+    for (size_t i = 0; i < header.nchunks; i++) {
+        auto n = static_cast<size_t>(file_.read_single_i32());
+        if (count + n > values_.size()) {
+            throw format_error(
+                "invalid LAMMPS binary dump: expected {} values for {} atoms, got more",
+                values_.size(), natoms
+            );
+        }
+        file_.read_f64(values_.data() + count, n);
+        count += n;
+    }
+    if (count != values_.size()) {
+        throw format_error(
+            "invalid LAMMPS binary dump: expected {} values for {} atoms, got {}",
+            values_.size(), natoms, count
+        );
+    }
+
+    auto positions = frame.positions();
+    auto velocities = frame.velocities();
+    auto seen_atomids = std::vector<bool>(atomid_column && !keep_file_order_ ? natoms : 0, false);
+    if (keep_file_order_) {
+        atom_ids_.assign(atomid_column ? natoms : 0, 0);
+    }
+    for (size_t i = 0; i < natoms; ++i) {
+        const auto* row = values_.data() + i * size_one;
+
+        size_t atomid = i;
+        if (atomid_column && keep_file_order_) {
+            // the IDs are checked when merging multiple files
+            auto id = row[*atomid_column];
+            atom_ids_[i] = id >= 1 ? static_cast<size_t>(id) : 0;
+        } else if (atomid_column) {
+            // LAMMPS uses atom IDs that start with 1
+            auto id = row[*atomid_column];
+            if (!(id >= 1 && id <= static_cast<double>(natoms))) {
+                throw format_error(
+                    "invalid atom ID in LAMMPS format: expected a value between 1 and {}, got {}",
+                    natoms, id
+                );
+            }
+            atomid = static_cast<size_t>(id) - 1;
+            if (seen_atomids[atomid]) {
+                throw format_error(
+                    "found atoms with the same ID in LAMMPS format: {} is already present",
+                    atomid + 1);
+            }
+            seen_atomids[atomid] = true;
+        }
+
+        auto& atom = frame[atomid];
+        for (size_t j = 0; j < size_one; ++j) {
+            auto value = row[j];
+            switch (fields[j].kind) {
+            case TYPE:
+                atom.set_type(std::to_string(static_cast<int64_t>(value)));
+                break;
+            case ELEMENT:
+                // binary dumps store the atom type instead of the element name
+                break;
+            case MASS:
+                atom.set_mass(value);
+                break;
+            case POSX:
+            case POSY:
+            case POSZ:
+                if (use_pos_repr == WRAPPED) {
+                    positions[atomid][static_cast<size_t>(fields[j].kind - POSX)] = value;
+                }
+                break;
+            case POSXS:
+            case POSYS:
+            case POSZS:
+                if (use_pos_repr == SCALED) {
+                    positions[atomid][static_cast<size_t>(fields[j].kind - POSXS)] = value;
+                }
+                break;
+            case POSXU:
+            case POSYU:
+            case POSZU:
+                if (use_pos_repr == UNWRAPPED) {
+                    positions[atomid][static_cast<size_t>(fields[j].kind - POSXU)] = value;
+                }
+                break;
+            case POSXSU:
+            case POSYSU:
+            case POSZSU:
+                if (use_pos_repr == SCALED_UNWRAPPED) {
+                    positions[atomid][static_cast<size_t>(fields[j].kind - POSXSU)] = value;
+                }
+                break;
+            case IMGX:
+            case IMGY:
+            case IMGZ:
+                assert(images);
+                (*images)[atomid][static_cast<size_t>(fields[j].kind - IMGX)] = static_cast<int>(value);
+                break;
+            case VELX:
+            case VELY:
+            case VELZ:
+                assert(velocities);
+                (*velocities)[atomid][static_cast<size_t>(fields[j].kind - VELX)] = value;
+                break;
+            case CHARGE:
+                atom.set_charge(value);
+                break;
+            case ATOMID:
+                break;
+            case CUSTOM:
+                custom_columns[j][atomid] = value;
+                break;
+            }
+        }
+    }
+
+    convert_positions(frame, origin, use_pos_repr, images);
+}
+
+template <> const FormatMetadata& chemfiles::format_metadata<LAMMPSMultiFileFormat>() {
+    static FormatMetadata metadata;
+    metadata.name = "LAMMPS Multi";
+    metadata.extension = nullopt;
+    metadata.description = "LAMMPS dumps split over multiple files";
+    metadata.reference = "https://lammps.sandia.gov/doc/dump.html";
+
+    metadata.read = true;
+    metadata.write = false;
+    metadata.memory = false;
+
+    metadata.positions = true;
+    metadata.velocities = true;
+    metadata.unit_cell = true;
+    metadata.atoms = true;
+    metadata.bonds = false;
+    metadata.residues = false;
+    return metadata;
+}
+
+/// Check if `name` matches the LAMMPS dump file name `pattern`, where `*`
+/// stands for any non-empty string (the timestep) and `%` for a non-empty
+/// sequence of digits (the processor). The values of the wildcards are
+/// stored in `timestep` and `processor`.
+static bool match_pattern(string_view pattern, string_view name, string_view& timestep, string_view& processor) {
+    if (pattern.empty()) {
+        return name.empty();
+    }
+
+    auto wildcard = pattern[0];
+    if (wildcard == '*' || wildcard == '%') {
+        // try all the possible lengths for this wildcard
+        for (size_t length = 1; length <= name.size(); length++) {
+            if (wildcard == '%' && !is_ascii_digit(name[length - 1])) {
+                return false;
+            }
+            if (match_pattern(pattern.substr(1), name.substr(length), timestep, processor)) {
+                if (wildcard == '*') {
+                    timestep = name.substr(0, length);
+                } else {
+                    processor = name.substr(0, length);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    if (name.empty() || name[0] != wildcard) {
+        return false;
+    }
+    return match_pattern(pattern.substr(1), name.substr(1), timestep, processor);
+}
+
+namespace {
+    /// Sort key for the value of a wildcard in a file name. Numbers are
+    /// sorted by value (`dump.10` comes after `dump.9`), and everything else
+    /// in lexicographic order.
+    struct WildcardKey {
+        explicit WildcardKey(string_view value) {
+            numeric = std::all_of(value.begin(), value.end(), is_ascii_digit);
+            if (numeric) {
+                // remove leading zeros, numbers can then be compared by
+                // length first and then lexicographically
+                while (value.size() > 1 && value[0] == '0') {
+                    value.remove_prefix(1);
+                }
+            }
+            this->value = value.to_string();
+        }
+
+        bool numeric;
+        std::string value;
+
+        bool operator<(const WildcardKey& other) const {
+            if (numeric && other.numeric) {
+                if (value.size() != other.value.size()) {
+                    return value.size() < other.value.size();
+                }
+                return value < other.value;
+            } else if (numeric != other.numeric) {
+                // numbers first
+                return numeric;
+            }
+            return value < other.value;
+        }
+
+        bool operator==(const WildcardKey& other) const {
+            return numeric == other.numeric && value == other.value;
+        }
+    };
+}
+
+LAMMPSMultiFileFormat::LAMMPSMultiFileFormat(std::string path, File::Mode mode, File::Compression compression) {
+    if (mode != File::READ) {
+        throw file_error("LAMMPS multiple files format only supports reading");
+    }
+
+    auto separator = path.find_last_of("/\\");
+    auto directory = std::string(".");
+    auto prefix = std::string();
+    auto pattern = path;
+    if (separator != std::string::npos) {
+        directory = path.substr(0, separator + 1);
+        prefix = directory;
+        pattern = path.substr(separator + 1);
+    }
+
+    if (directory.find_first_of("*%") != std::string::npos) {
+        throw format_error(
+            "wildcards are only supported in the file name for LAMMPS multiple files, got '{}'", path
+        );
+    }
+    auto timesteps = std::count(pattern.begin(), pattern.end(), '*');
+    auto processors = std::count(pattern.begin(), pattern.end(), '%');
+    if (timesteps > 1 || processors > 1 || timesteps + processors == 0) {
+        throw format_error(
+            "expected one '*' and/or one '%' wildcard in the file name for LAMMPS multiple files, got '{}'", path
+        );
+    }
+    binary_ = string_view(pattern).ends_with(".bin");
+    per_processor_ = processors != 0;
+
+    struct Match {
+        std::string path;
+        WildcardKey timestep;
+        WildcardKey processor;
+    };
+    auto matches = std::vector<Match>();
+    for (auto& name: list_directory(directory)) {
+        string_view timestep;
+        string_view processor;
+        if (match_pattern(pattern, name, timestep, processor)) {
+            matches.push_back({prefix + name, WildcardKey(timestep), WildcardKey(processor)});
+        }
+    }
+    if (matches.empty()) {
+        throw file_error("could not find any file matching '{}'", path);
+    }
+
+    std::sort(matches.begin(), matches.end(), [](const Match& lhs, const Match& rhs) {
+        if (lhs.timestep == rhs.timestep) {
+            return lhs.processor < rhs.processor;
+        }
+        return lhs.timestep < rhs.timestep;
+    });
+
+    // Build the index of all the files in parallel, closing each file once
+    // done. For text files, this is where all the time goes since the whole
+    // file must be scanned.
+    compression_ = compression;
+    files_.resize(matches.size());
+    auto units = std::vector<std::string>(matches.size());
+    auto count = matches.size();
+    parallel_for(count, parallel_threads(count, 1), [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            files_[i].path = matches[i].path;
+            if (binary_) {
+                LAMMPSBinaryFormat file(matches[i].path, mode, compression);
+                files_[i].positions = file.offsets();
+                units[i] = file.units();
+            } else {
+                LAMMPSTrajectoryFormat file(matches[i].path, mode, compression);
+                while (auto position = file.forward()) {
+                    files_[i].positions.push_back(*position);
+                }
+            }
+        }
+    });
+    for (auto& file_units: units) {
+        if (!file_units.empty()) {
+            units_ = std::move(file_units);
+            break;
+        }
+    }
+
+    // Group the files written at the same timestep, and create the list of
+    // pieces for every step in the trajectory
+    size_t group_start = 0;
+    while (group_start < count) {
+        auto group_end = group_start + 1;
+        while (group_end < count && matches[group_end].timestep == matches[group_start].timestep) {
+            group_end++;
+        }
+
+        auto group_nsteps = files_[group_start].positions.size();
+        for (size_t i = group_start; i < group_end; i++) {
+            if (files_[i].positions.size() != group_nsteps) {
+                throw format_error(
+                    "all files for the same timestep must contain the same number "
+                    "of steps in LAMMPS multiple files: '{}' contains {} steps, "
+                    "but '{}' contains {}",
+                    matches[group_start].path, group_nsteps, matches[i].path, files_[i].positions.size()
+                );
+            }
+        }
+
+        for (size_t step = 0; step < group_nsteps; step++) {
+            auto pieces = std::vector<Piece>();
+            pieces.reserve(group_end - group_start);
+            for (size_t i = group_start; i < group_end; i++) {
+                pieces.push_back({i, step});
+            }
+            steps_.emplace_back(std::move(pieces));
+        }
+        group_start = group_end;
+    }
+}
+
+size_t LAMMPSMultiFileFormat::nsteps() {
+    return steps_.size();
+}
+
+std::unique_ptr<Format> LAMMPSMultiFileFormat::open(size_t index) const {
+    const auto& file = files_[index];
+    if (binary_) {
+        auto format = chemfiles::make_unique<LAMMPSBinaryFormat>(file.path, file.positions, units_);
+        if (per_processor_) {
+            format->keep_file_order();
+        }
+        return std::unique_ptr<Format>(std::move(format));
+    } else {
+        auto format = chemfiles::make_unique<LAMMPSTrajectoryFormat>(file.path, File::READ, compression_);
+        if (per_processor_) {
+            format->keep_file_order();
+        }
+        return std::unique_ptr<Format>(std::move(format));
+    }
+}
+
+void LAMMPSMultiFileFormat::read_piece(Format& format, Piece piece, Frame& frame) const {
+    if (binary_) {
+        format.read_step(piece.step, frame);
+    } else {
+        auto position = files_[piece.file].positions[piece.step];
+        static_cast<LAMMPSTrajectoryFormat&>(format).read_at(position, frame);
+    }
+}
+
+void LAMMPSMultiFileFormat::read_step(const size_t step, Frame& frame) {
+    assert(step < steps_.size());
+    step_ = step;
+    read(frame);
+}
+
+void LAMMPSMultiFileFormat::read(Frame& frame) {
+    const auto& pieces = steps_[step_];
+    step_++;
+
+    if (!per_processor_) {
+        assert(pieces.size() == 1);
+        auto piece = pieces[0];
+        if (!current_ || current_file_ != piece.file) {
+            // close the previous file before opening the next one
+            current_.reset();
+            current_ = open(piece.file);
+            current_file_ = piece.file;
+        }
+        read_piece(*current_, piece, frame);
+        return;
+    }
+
+    // Read all the pieces in parallel. Each file is closed as soon as its
+    // piece has been read, so there are never more open files than threads.
+    auto frames = std::vector<Frame>(pieces.size());
+    auto ids = std::vector<std::vector<size_t>>(pieces.size());
+    auto count = pieces.size();
+    parallel_for(count, parallel_threads(count, 1), [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            auto format = open(pieces[i].file);
+            read_piece(*format, pieces[i], frames[i]);
+            if (binary_) {
+                ids[i] = static_cast<const LAMMPSBinaryFormat&>(*format).atom_ids();
+            } else {
+                ids[i] = static_cast<const LAMMPSTrajectoryFormat&>(*format).atom_ids();
+            }
+        }
+    });
+
+    // the header of all the pieces should be the same, use the first one
+    const auto& first = frames[0];
+    frame.set_step(first.step());
+    frame.set_cell(first.cell());
+    for (const auto& property: first.properties()) {
+        frame.set(property.first, property.second);
+    }
+
+    size_t natoms = 0;
+    bool velocities = false;
+    for (const auto& piece: frames) {
+        natoms += piece.size();
+        velocities = velocities || piece.velocities();
+    }
+    frame.resize(natoms);
+    if (velocities) {
+        frame.add_velocities();
+    }
+
+    auto columns = first.columns();
+    for (const auto& name: columns) {
+        frame.add_column<double>(name);
+    }
+    auto columns_data = std::vector<double*>();
+    for (const auto& name: columns) {
+        columns_data.push_back(frame.column<double>(name)->data());
+    }
+
+    auto positions = frame.positions();
+    auto merged_velocities = frame.velocities();
+    auto seen_atomids = std::vector<bool>(natoms, false);
+    size_t offset = 0;
+    for (size_t i = 0; i < frames.size(); i++) {
+        auto& piece = frames[i];
+        const auto& piece_ids = ids[i];
+        auto piece_positions = piece.positions();
+        auto piece_velocities = piece.velocities();
+
+        for (size_t j = 0; j < piece.size(); j++) {
+            size_t atomid = offset + j;
+            if (!piece_ids.empty()) {
+                // LAMMPS uses atom IDs that start with 1
+                atomid = piece_ids[j];
+                if (atomid == 0 || atomid > natoms) {
+                    throw format_error(
+                        "invalid atom ID in LAMMPS format: expected a value between 1 and {}, got {}",
+                        natoms, atomid
+                    );
+                }
+                --atomid; // the frame uses zero-based indices
+                if (seen_atomids[atomid]) {
+                    throw format_error(
+                        "found atoms with the same ID in LAMMPS format: {} is already present",
+                        atomid + 1);
+                }
+                seen_atomids[atomid] = true;
+            }
+
+            frame[atomid] = std::move(piece[j]);
+            positions[atomid] = piece_positions[j];
+            if (piece_velocities) {
+                (*merged_velocities)[atomid] = (*piece_velocities)[j];
+            }
+            for (size_t k = 0; k < columns.size(); k++) {
+                auto column = piece.column<double>(columns[k]);
+                if (column) {
+                    columns_data[k][atomid] = (*column)[j];
+                }
+            }
+        }
+        offset += piece.size();
+    }
+}
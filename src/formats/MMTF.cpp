@@ -17,6 +17,7 @@
 #include <mmtf/export_helpers.hpp>
 
 #include "chemfiles/types.hpp"
+#include "chemfiles/cpp14.hpp"
 #include "chemfiles/warnings.hpp"
 #include "chemfiles/error_fmt.hpp"
 #include "chemfiles/unreachable.hpp"
@@ -34,6 +35,7 @@
 #include "chemfiles/FormatMetadata.hpp"
 
 #include "chemfiles/files/MemoryBuffer.hpp"
+#include "chemfiles/files/MsgPackData.hpp"
 
 #include "chemfiles/formats/MMTF.hpp"
 
@@ -65,9 +67,14 @@ template<> const FormatMetadata& chemfiles::format_metadata<MMTFFormat>() {
 
 MMTFFormat::MMTFFormat(std::string path, File::Mode mode, File::Compression compression) {
     if (mode == File::READ) {
-        auto file = TextFile(std::move(path), mode, compression);
-        auto buffer = file.readall();
-        decode(buffer.data(), buffer.size(), file.path());
+        source_ = path;
+        try {
+            msgpack_ = chemfiles::make_unique<MsgPackData>(std::move(path), mode, compression);
+        } catch (const msgpack::unpack_error& e) {
+            throw format_error("error while decoding MMTF from {}: '{}'", source_, e.what());
+        }
+        decode();
+
         if (!mmtf::isDefaultValue(structure_.atomIdList)) {
             // If ids are not ordered or are missing consecutive values the atoms
             // have to be re-ordered.
@@ -96,18 +103,84 @@ MMTFFormat::MMTFFormat(std::shared_ptr<MemoryBuffer> memory, File::Mode mode, Fi
     }
 
     memory->decompress(compression);
-    decode(memory->data(), memory->size(), "memory");
+    source_ = "memory";
+    try {
+        msgpack_ = chemfiles::make_unique<MsgPackData>(std::move(memory));
+    } catch (const msgpack::unpack_error& e) {
+        throw format_error("error while decoding MMTF from {}: '{}'", source_, e.what());
+    }
+    decode();
 }
 
-void MMTFFormat::decode(const char* data, size_t size, const std::string& source) {
+void MMTFFormat::decode() {
     try {
-        mmtf::decodeFromBuffer(structure_, data, size);
+        const auto& object = msgpack_->get();
+        if (object.type == msgpack::type::MAP) {
+            // Move the coordinates out of the map, replacing them with empty
+            // arrays. They will be decoded in `decode_coordinates`.
+            auto empty = msgpack::object();
+            empty.type = msgpack::type::ARRAY;
+            empty.via.array.size = 0;
+            empty.via.array.ptr = nullptr;
+
+            for (uint32_t i = 0; i < object.via.map.size; i++) {
+                auto& entry = object.via.map.ptr[i];
+                if (entry.key.type != msgpack::type::STR) {
+                    continue;
+                }
+
+                auto key = std::string(entry.key.via.str.ptr, entry.key.via.str.size);
+                if (key == "xCoordList" || key == "yCoordList" || key == "zCoordList") {
+                    coordinates_[key] = entry.val;
+                    entry.val = empty;
+                }
+            }
+        }
+
+        auto decoder = mmtf::MapDecoder(object);
+        mmtf::decodeFromMapDecoder(structure_, decoder);
     } catch (const mmtf::DecodeError& e) { // rethrow as a chemfiles error
-        throw format_error("error while decoding MMTF from {}: '{}'", source, e.what());
+        throw format_error("error while decoding MMTF from {}: '{}'", source_, e.what());
+    }
+}
+
+void MMTFFormat::decode_coordinates() {
+    if (coordinates_.empty()) {
+        return;
+    }
+
+    try {
+        auto decoder = mmtf::MapDecoder(coordinates_);
+        decoder.decode("xCoordList", true, structure_.xCoordList);
+        decoder.decode("yCoordList", true, structure_.yCoordList);
+        decoder.decode("zCoordList", true, structure_.zCoordList);
+    } catch (const mmtf::DecodeError& e) { // rethrow as a chemfiles error
+        throw format_error("error while decoding MMTF from {}: '{}'", source_, e.what());
     }
 
     if (!structure_.hasConsistentData()) {
-        throw format_error("issue with data from '{}', please ensure it is valid MMTF file", source);
+        throw format_error("issue with data from '{}', please ensure it is valid MMTF file", source_);
+    }
+
+    create_group_templates();
+
+    // we don't need the raw data anymore
+    coordinates_.clear();
+    msgpack_.reset();
+}
+
+void MMTFFormat::create_group_templates() {
+    group_atoms_.clear();
+    group_atoms_.reserve(structure_.groupList.size());
+    for (const auto& group: structure_.groupList) {
+        auto atoms = std::vector<Atom>();
+        atoms.reserve(group.atomNameList.size());
+        for (size_t i = 0; i < group.atomNameList.size(); i++) {
+            auto atom = Atom(group.atomNameList[i], group.elementList[i]);
+            atom.set_charge(static_cast<double>(group.formalChargeList[i]));
+            atoms.emplace_back(std::move(atom));
+        }
+        group_atoms_.emplace_back(std::move(atoms));
     }
 }
 
@@ -129,6 +202,8 @@ size_t MMTFFormat::nsteps() {
 }
 
 void MMTFFormat::read_step(const size_t step, Frame& frame) {
+    decode_coordinates();
+
     modelIndex_ = 0;
     chainIndex_ = 0;
     groupIndex_ = 0;
@@ -173,6 +248,8 @@ void MMTFFormat::read_step(const size_t step, Frame& frame) {
 }
 
 void MMTFFormat::read(Frame& frame) {
+    decode_coordinates();
+
     const auto& cell = structure_.unitCell;
     if (structure_.unitCell.size() == 6) {
         Vector3D lengths = {static_cast<double>(cell[0]), static_cast<double>(cell[1]), static_cast<double>(cell[2])};
@@ -219,6 +296,9 @@ void MMTFFormat::read_model(Frame& frame) {
     frame.resize(natoms);
     auto positions = frame.positions();
 
+    bonds_.clear();
+    bond_orders_.clear();
+
     // Read the structure iterating over the chains in the model, then the
     // residues/groups in the chain and finally the atoms in the residue/group
     for (size_t j = 0; j < modelChainCount; j++) {
@@ -235,13 +315,15 @@ void MMTFFormat::read_model(Frame& frame) {
             read_group(frame, group_type, residue, positions);
             frame.add_residue(std::move(residue));
 
-            add_inter_residue_bonds(frame);
+            add_inter_residue_bonds();
 
             groupIndex_++;
         }
         chainIndex_++;
     }
     modelIndex_++;
+
+    frame.add_bonds(bonds_, bond_orders_);
 }
 
 std::string MMTFFormat::find_assembly() {
@@ -294,26 +376,22 @@ Residue MMTFFormat::create_residue(const std::string& current_assembly, size_t g
 void MMTFFormat::read_group(Frame& frame, size_t group_type, Residue& residue, span<Vector3D> positions) {
 
     const auto& group = structure_.groupList[group_type];
+    const auto& atoms = group_atoms_[group_type];
 
-    // map between the index of the atom in this group and the global
-    // index in the frame. This is needed to add bonds from this group
-    std::vector<size_t> global_indexes;
-    global_indexes.reserve(group.atomNameList.size());
+    // index of the first atom of this group in the MMTF lists
+    auto first_atom = atomIndex_;
 
-    for (size_t l = 0; l < group.atomNameList.size(); l++) {
-        auto atom = Atom(group.atomNameList[l], group.elementList[l]);
-        atom.set_charge(static_cast<double>(group.formalChargeList[l]));
+    for (size_t l = 0; l < atoms.size(); l++) {
+        auto id = atom_id(atomIndex_);
+        frame[id] = atoms[l];
 
         const auto& altLocList = structure_.altLocList;
         if (!mmtf::isDefaultValue(altLocList) && !(
             altLocList[atomIndex_] == ' ' ||
             altLocList[atomIndex_] == 0x00)) {
-            atom.set("altloc", std::string(1, altLocList[atomIndex_]));
+            frame[id].set("altloc", std::string(1, altLocList[atomIndex_]));
         }
 
-        auto id = atom_id(atomIndex_);
-        global_indexes.emplace_back(id);
-        frame[id] = std::move(atom);
         residue.add_atom(id);
 
         positions[id][0] = static_cast<double>(structure_.xCoordList[atomIndex_]);
@@ -329,15 +407,12 @@ void MMTFFormat::read_group(Frame& frame, size_t group_type, Residue& residue, s
         auto atom1 = static_cast<size_t>(group.bondAtomList[l * 2]);
         auto atom2 = static_cast<size_t>(group.bondAtomList[l * 2 + 1]);
 
-        frame.add_bond(
-            global_indexes[atom1],
-            global_indexes[atom2],
-            bond_order_to_chemfiles(group.bondOrderList[l])
-        );
+        bonds_.emplace_back(atom_id(first_atom + atom1), atom_id(first_atom + atom2));
+        bond_orders_.emplace_back(bond_order_to_chemfiles(group.bondOrderList[l]));
     }
 }
 
-void MMTFFormat::add_inter_residue_bonds(Frame& frame) {
+void MMTFFormat::add_inter_residue_bonds() {
     auto inter_residue_bond_count = structure_.bondAtomList.size() / 2;
 
     // Add additional global (not by group) bonds
@@ -350,7 +425,8 @@ void MMTFFormat::add_inter_residue_bonds(Frame& frame) {
             break;
         }
 
-        frame.add_bond(atom_id(atom1), atom_id(atom2));
+        bonds_.emplace_back(atom_id(atom1), atom_id(atom2));
+        bond_orders_.emplace_back(Bond::UNKNOWN);
         interBondIndex_++;
     }
 }
@@ -359,8 +435,8 @@ void MMTFFormat::apply_symmetry(Frame& frame) {
     const auto original_size = frame.size();
     const auto original_bond_size = frame.topology().bonds().size();
 
-    using bond_w_order = std::pair<Bond, Bond::BondOrder>;
-    std::vector<bond_w_order> bonds_to_add;
+    bonds_.clear();
+    bond_orders_.clear();
 
     for (const auto& assembly : structure_.bioAssemblyList) {
 
@@ -453,14 +529,13 @@ void MMTFFormat::apply_symmetry(Frame& frame) {
                     continue;
                 }
 
-                bonds_to_add.push_back({ {new_bond_0, new_bond_1}, frame.topology().bond_orders()[i] });
+                bonds_.emplace_back(new_bond_0, new_bond_1);
+                bond_orders_.emplace_back(frame.topology().bond_orders()[i]);
             }
         }
     }
 
-    for (auto& bond : bonds_to_add) {
-        frame.add_bond(bond.first[0], bond.first[1], bond.second);
-    }
+    frame.add_bonds(bonds_, bond_orders_);
 }
 
 void MMTFFormat::write(const Frame& frame) {
@@ -12,6 +12,7 @@ extern "C" {
 #include <array>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <unordered_map>
 
 #include "chemfiles/types.hpp"
@@ -278,6 +279,19 @@ void Molfile<F>::molfile_to_frame(const molfile_timestep_t& timestep, Frame& fra
     frame.set_cell({lengths, angles});
 
     frame.resize(static_cast<size_t>(natoms_));
+    if (frame.single_precision()) {
+        // molfile uses single precision, the data can be copied as-is
+        auto natoms = static_cast<size_t>(natoms_);
+        auto positions = frame.positions_f32();
+        std::copy(timestep.coords, timestep.coords + 3 * natoms, reinterpret_cast<float*>(positions.data()));
+        if (plugin_data_.have_velocities()) {
+            frame.add_velocities();
+            auto velocities = *frame.velocities_f32();
+            std::copy(timestep.velocities, timestep.velocities + 3 * natoms, reinterpret_cast<float*>(velocities.data()));
+        }
+        return;
+    }
+
     auto positions = frame.positions();
     for (size_t i = 0; i < static_cast<size_t>(natoms_); i++) {
         positions[i][0] = static_cast<double>(timestep.coords[3 * i + 0]);
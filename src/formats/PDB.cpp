@@ -120,8 +120,62 @@ enum class Record {
 static Record get_record(string_view line);
 
 void PDBFormat::read_next(Frame& frame) {
+    if (last_topology_ && current_secinfo_ == last_secinfo_before_) {
+        // Try to re-use the topology of the last frame, only reading the
+        // positions of the atoms
+        auto position = file_.tellpos();
+        auto models = models_;
+        auto model = Frame();
+        if (read_records(model, true)) {
+            model.resize(positions_.size());
+            model.set_topology(*last_topology_);
+            auto model_positions = model.positions();
+            std::copy(positions_.begin(), positions_.end(), model_positions.begin());
+            model.set_step(frame.step());
+            frame = std::move(model);
+            current_secinfo_ = last_secinfo_after_;
+            return;
+        }
+
+        // the topology changed, read this frame again from the start
+        file_.seekpos(position);
+        models_ = models;
+    }
+
+    last_topology_ = nullopt;
+    last_records_.clear();
+    last_secinfo_before_ = current_secinfo_;
+    read_records(frame, false);
+
+    // there is no need to keep the topology around if this was the last frame
+    if (!file_.eof()) {
+        last_topology_ = frame.topology();
+        last_secinfo_after_ = current_secinfo_;
+    }
+}
+
+bool PDBFormat::check_record(string_view record, bool reuse_topology) {
+    if (reuse_topology) {
+        auto offset = last_records_offset_;
+        if (last_records_.size() - offset < record.size() ||
+            last_records_.compare(offset, record.size(), record.data(), record.size()) != 0) {
+            return false;
+        }
+        last_records_offset_ += record.size();
+    } else {
+        last_records_.append(record.data(), record.size());
+    }
+    return true;
+}
+
+bool PDBFormat::read_records(Frame& frame, bool reuse_topology) {
     residues_.clear();
     atom_offsets_.clear();
+    positions_.clear();
+    last_records_offset_ = 0;
+
+    // bonds from CONECT records, added all at once at the end
+    auto conect_bonds = std::vector<Bond>();
 
     uint64_t position;
     bool got_end = false;
@@ -153,13 +207,39 @@ void PDBFormat::read_next(Frame& frame) {
             read_CRYST1(frame, line);
             continue;
         case Record::ATOM:
-            read_ATOM(frame, line, false);
-            continue;
         case Record::HETATM:
-            read_ATOM(frame, line, true);
+            if (line.length() < 54) {
+                throw format_error(
+                    "{} record is too small: '{}'", line.substr(0, 6), line
+                );
+            }
+            // everything except the positions defines the topology
+            if (!check_record(line.substr(0, 30), reuse_topology) ||
+                !check_record(line.substr(54), reuse_topology) ||
+                !check_record("\n", reuse_topology)) {
+                return false;
+            }
+            if (reuse_topology) {
+                try {
+                    positions_.emplace_back(
+                        parse<double>(line.substr(30, 8)),
+                        parse<double>(line.substr(38, 8)),
+                        parse<double>(line.substr(46, 8))
+                    );
+                } catch (const Error&) {
+                    throw format_error("could not read positions in '{}'", line);
+                }
+            } else {
+                read_ATOM(frame, line, record == Record::HETATM);
+            }
             continue;
         case Record::CONECT:
-            read_CONECT(frame, line);
+            if (!check_record(line, reuse_topology) || !check_record("\n", reuse_topology)) {
+                return false;
+            }
+            if (!reuse_topology) {
+                read_CONECT(frame, line, conect_bonds);
+            }
             continue;
         case Record::MODEL:
             models_++;
@@ -179,15 +259,30 @@ void PDBFormat::read_next(Frame& frame) {
             got_end = true;
             continue;
         case Record::HELIX:
+            if (reuse_topology) {
+                return false;
+            }
             read_HELIX(line);
             continue;
         case Record::SHEET:
+            if (reuse_topology) {
+                return false;
+            }
             read_secondary(line, 17, 28, "SHEET");
             continue;
         case Record::TURN:
+            if (reuse_topology) {
+                return false;
+            }
             read_secondary(line, 15, 26, "TURN");
             continue;
         case Record::TER:
+            if (!check_record(line, reuse_topology) || !check_record("\n", reuse_topology)) {
+                return false;
+            }
+            if (reuse_topology) {
+                continue;
+            }
             if (line.size() >= 12) {
                 try {
                     auto ter_serial = decode_hybrid36(5, line.substr(6, 5));
@@ -214,12 +309,23 @@ void PDBFormat::read_next(Frame& frame) {
         }
     }
 
+    if (reuse_topology) {
+        // all the records must be there, in the same order
+        if (last_records_offset_ != last_records_.size()) {
+            return false;
+        }
+    }
+
     if (!got_end) {
         warning("PDB reader", "missing END record in file");
     }
 
-    chain_ended(frame);
-    link_standard_residue_bonds(frame);
+    if (!reuse_topology) {
+        frame.add_bonds(conect_bonds);
+        chain_ended(frame);
+        link_standard_residue_bonds(frame);
+    }
+    return true;
 }
 
 void PDBFormat::read_CRYST1(Frame& frame, string_view line) {
@@ -354,12 +460,7 @@ void PDBFormat::read_secondary(string_view line, size_t i_start, size_t i_end, s
 
 void PDBFormat::read_ATOM(Frame& frame, string_view line, bool is_hetatm) {
     assert(line.substr(0, 6) == "ATOM  " || line.substr(0, 6) == "HETATM");
-
-    if (line.length() < 54) {
-        throw format_error(
-            "{} record is too small: '{}'", line.substr(0, 6), line
-        );
-    }
+    assert(line.length() >= 54);
 
     if (atom_offsets_.empty()) {
         try {
@@ -382,10 +483,10 @@ void PDBFormat::read_ATOM(Frame& frame, string_view line, bool is_hetatm) {
     if (line.length() >= 78) {
         auto type = line.substr(76, 2);
         // Read both atom name and atom type
-        atom = Atom(trim(name).to_string(), trim(type).to_string());
+        atom = atom_cache_.get(trim(name), trim(type));
     } else {
         // Read just the atom name and hope for the best.
-        atom = Atom(trim(name).to_string());
+        atom = atom_cache_.get(trim(name));
     }
 
     auto altloc = line.substr(16, 1);
@@ -465,12 +566,12 @@ void PDBFormat::read_ATOM(Frame& frame, string_view line, bool is_hetatm) {
     }
 }
 
-void PDBFormat::read_CONECT(Frame& frame, string_view line) {
+void PDBFormat::read_CONECT(const Frame& frame, string_view line, std::vector<Bond>& bonds) {
     assert(line.substr(0, 6) == "CONECT");
     auto line_length = trim(line).length();
 
     // Helper lambdas
-    auto add_bond = [&frame, &line](size_t i, size_t j) {
+    auto add_bond = [&frame, &line, &bonds](size_t i, size_t j) {
         if (i >= frame.size() || j >= frame.size()) {
             warning("PDB reader",
                 "ignoring CONECT ('{}') with atomic indexes bigger than frame size ({})",
@@ -478,7 +579,7 @@ void PDBFormat::read_CONECT(Frame& frame, string_view line) {
             );
             return;
         }
-        frame.add_bond(i, j);
+        bonds.emplace_back(i, j);
     };
 
     auto read_index = [&line,this](size_t initial) -> size_t {
@@ -536,25 +637,60 @@ void PDBFormat::chain_ended(Frame& frame) {
     residues_.clear();
 }
 
+/// Should we warn when the atom with the given name is missing in a standard
+/// residue? Hydrogen, phosphate and terminal oxygen atoms are often missing.
+static bool warn_missing_atom(string_view name) {
+    return name[0] != 'H' && name != "OXT" && name[0] != 'P' && name.substr(0, 2) != "OP";
+}
+
 void PDBFormat::link_standard_residue_bonds(Frame& frame) {
     bool link_previous_peptide = false;
     bool link_previous_nucleic = false;
     int64_t previous_residue_id = 0;
     size_t previous_carboxylic_id = 0;
 
+    // index of the atom corresponding to each atom in the residue template,
+    // or NO_ATOM if there is no such atom
+    constexpr auto NO_ATOM = static_cast<size_t>(-1);
+    auto template_atoms = std::vector<size_t>();
+    // all the bonds are added at once at the end, since adding them one by
+    // one is quadratic in the number of bonds
+    auto bonds = std::vector<Bond>();
+
     for (const auto& residue: frame.topology().residues()) {
-        auto residue_table = PDBConnectivity::find(residue.name());
-        if (!residue_table) {
+        auto residue_template = PDBConnectivity::find(residue.name());
+        if (residue_template == nullptr) {
             continue;
         }
 
-        std::map<std::string, size_t> atom_name_to_index;
+        template_atoms.assign(residue_template->atoms_count, NO_ATOM);
+        optional<size_t> amide_nitrogen;
+        optional<size_t> amide_carbon;
+        optional<size_t> three_prime_oxygen;
+        optional<size_t> five_prime_phosphorus;
+        optional<size_t> five_prime_oxygen;
+        optional<size_t> five_prime_hydrogen;
         for (size_t atom : residue) {
-            atom_name_to_index[frame[atom].name()] =  atom;
-        }
+            const auto& name = frame[atom].name();
+            auto index = residue_template->atom_index(name);
+            if (index) {
+                template_atoms[*index] = atom;
+            }
 
-        const auto& amide_nitrogen = atom_name_to_index.find("N");
-        const auto& amide_carbon = atom_name_to_index.find("C");
+            if (name == "N") {
+                amide_nitrogen = atom;
+            } else if (name == "C") {
+                amide_carbon = atom;
+            } else if (name == "O3'") {
+                three_prime_oxygen = atom;
+            } else if (name == "P") {
+                five_prime_phosphorus = atom;
+            } else if (name == "O5'") {
+                five_prime_oxygen = atom;
+            } else if (name == "HO5'") {
+                five_prime_hydrogen = atom;
+            }
+        }
 
         if (!residue.id()) {
             warning("PDB reader", "got a residues without id, this should not happen");
@@ -562,73 +698,53 @@ void PDBFormat::link_standard_residue_bonds(Frame& frame) {
         }
 
         auto resid = *residue.id();
-        if (link_previous_peptide &&
-            amide_nitrogen != atom_name_to_index.end() &&
-            resid == previous_residue_id + 1 )
-        {
+        if (link_previous_peptide && amide_nitrogen && resid == previous_residue_id + 1) {
             link_previous_peptide = false;
-            frame.add_bond(previous_carboxylic_id, amide_nitrogen->second);
+            bonds.emplace_back(previous_carboxylic_id, *amide_nitrogen);
         }
 
-        if (amide_carbon != atom_name_to_index.end() ) {
+        if (amide_carbon) {
             link_previous_peptide = true;
-            previous_carboxylic_id = amide_carbon->second;
+            previous_carboxylic_id = *amide_carbon;
             previous_residue_id = resid;
         }
 
-        const auto& three_prime_oxygen = atom_name_to_index.find("O3'");
-        const auto& five_prime_phosphorus = atom_name_to_index.find("P");
-
-        if (link_previous_nucleic &&
-            five_prime_phosphorus != atom_name_to_index.end() &&
-            resid == previous_residue_id + 1 )
-        {
+        if (link_previous_nucleic && five_prime_phosphorus && resid == previous_residue_id + 1) {
             link_previous_nucleic = false;
-            frame.add_bond(previous_carboxylic_id, three_prime_oxygen->second);
+            bonds.emplace_back(previous_carboxylic_id, *five_prime_phosphorus);
         }
 
-        if (three_prime_oxygen != atom_name_to_index.end() ) {
+        if (three_prime_oxygen) {
             link_previous_nucleic = true;
-            previous_carboxylic_id = three_prime_oxygen->second;
+            previous_carboxylic_id = *three_prime_oxygen;
             previous_residue_id = resid;
         }
 
         // A special case missed by the standards committee????
-        if (atom_name_to_index.count("HO5'") != 0) {
-            frame.add_bond(atom_name_to_index["HO5'"], atom_name_to_index["O5'"]);
+        if (five_prime_hydrogen && five_prime_oxygen) {
+            bonds.emplace_back(*five_prime_hydrogen, *five_prime_oxygen);
         }
 
-        for (const auto& link: *residue_table) {
-            const auto& first_atom = atom_name_to_index.find(link.first);
-            const auto& second_atom = atom_name_to_index.find(link.second);
-
-            if (first_atom == atom_name_to_index.end()) {
-                const auto& first_name = link.first.string();
-                if (first_name[0] != 'H' && first_name != "OXT" &&
-                    first_name[0] != 'P' && first_name.substr(0, 2) != "OP" ) {
-                    warning("PDB reader",
-                        "found unexpected, non-standard atom '{}' in residue '{}' (resid {})",
-                        first_name, residue.name(), resid
-                    );
-                }
-                continue;
+        for (size_t i = 0; i < residue_template->atoms_count; i++) {
+            if (template_atoms[i] == NO_ATOM && warn_missing_atom(residue_template->atoms[i])) {
+                warning("PDB reader",
+                    "found unexpected, non-standard atom '{}' in residue '{}' (resid {})",
+                    residue_template->atoms[i], residue.name(), resid
+                );
             }
+        }
 
-            if (second_atom == atom_name_to_index.end()) {
-                const auto& second_name = link.second.string();
-                if (second_name[0] != 'H' && second_name != "OXT" &&
-                    second_name[0] != 'P' && second_name.substr(0, 2) != "OP" ) {
-                        warning("PDB reader",
-                            "found unexpected, non-standard atom '{}' in residue '{}' (resid {})",
-                            second_name, residue.name(), resid
-                        );
-                }
-                continue;
+        for (size_t i = 0; i < residue_template->bonds_count; i++) {
+            auto bond = residue_template->bonds[i];
+            auto first = template_atoms[bond.first];
+            auto second = template_atoms[bond.second];
+            if (first != NO_ATOM && second != NO_ATOM) {
+                bonds.emplace_back(first, second);
             }
-
-            frame.add_bond(first_atom->second, second_atom->second);
         }
     }
+
+    frame.add_bonds(bonds);
 }
 
 Record get_record(string_view line) {
@@ -844,11 +960,15 @@ void PDBFormat::write_next(const Frame& frame) {
         auto& pos = positions[i];
         check_values_size(pos, 8, "atomic position");
         file_.print(
-            "{: <6}{: >5} {: <4s}{:1}{:3} {:1}{: >4s}{:1}   {:8.3f}{:8.3f}{:8.3f}{:6.2f}{:6.2f}      {: <4s}{: >2s}\n",
+            "{: <6}{: >5} {: <4s}{:1}{:3} {:1}{: >4s}{:1}   ",
             resinfo.atom_hetatm, to_pdb_index(static_cast<int64_t>(i + ter_count), 5), frame[i].name(), altloc,
-            resinfo.resname, resinfo.chainid, resinfo.resid, resinfo.insertion_code,
-            pos[0], pos[1], pos[2], 1.0, 0.0, resinfo.segment, frame[i].type()
+            resinfo.resname, resinfo.chainid, resinfo.resid, resinfo.insertion_code
         );
+        file_.print_fixed(pos[0], 8, 3);
+        file_.print_fixed(pos[1], 8, 3);
+        file_.print_fixed(pos[2], 8, 3);
+        // occupancy and temperature factor are always 1.00 and 0.00
+        file_.print("  1.00  0.00      {: <4s}{: >2s}\n", resinfo.segment, frame[i].type());
 
         if (residue) {
             last_residue = std::move(resinfo);
@@ -7,6 +7,7 @@
 #include <array>
 #include <string>
 #include <vector>
+#include <type_traits>
 #include <cassert>
 
 #include <tng/tng_io.h>
@@ -150,6 +151,19 @@ void TNGFormat::read(Frame& frame) {
     step_++;
 }
 
+// Convert the `buffer` of vectors read by TNG to `vectors`, multiplying them
+// by `scale`. `Vector` is either `Vector3D` or `Vector3F`, depending on the
+// frame storage.
+template <typename Vector>
+static void convert_vectors(const TngBuffer<float>& buffer, double scale, span<Vector> vectors) {
+    using value_t = typename std::remove_reference<decltype(vectors[0][0])>::type;
+    for (size_t i=0; i<vectors.size(); i++) {
+        vectors[i][0] = static_cast<value_t>(static_cast<double>(buffer[3 * i + 0]) * scale);
+        vectors[i][1] = static_cast<value_t>(static_cast<double>(buffer[3 * i + 1]) * scale);
+        vectors[i][2] = static_cast<value_t>(static_cast<double>(buffer[3 * i + 2]) * scale);
+    }
+}
+
 void TNGFormat::read_positions(Frame& frame) {
     TngBuffer<float> buffer;
     int64_t unused = 0;
@@ -158,11 +172,11 @@ void TNGFormat::read_positions(Frame& frame) {
         tng_, tng_steps_[step_], tng_steps_[step_], buffer.ptr(), &unused
     ));
 
-    auto positions = frame.positions();
-    for (size_t i=0; i<static_cast<size_t>(natoms_); i++) {
-        positions[i][0] = static_cast<double>(buffer[3 * i + 0]) * distance_scale_factor_;
-        positions[i][1] = static_cast<double>(buffer[3 * i + 1]) * distance_scale_factor_;
-        positions[i][2] = static_cast<double>(buffer[3 * i + 2]) * distance_scale_factor_;
+    assert(frame.size() == static_cast<size_t>(natoms_));
+    if (frame.single_precision()) {
+        convert_vectors(buffer, distance_scale_factor_, frame.positions_f32());
+    } else {
+        convert_vectors(buffer, distance_scale_factor_, frame.positions());
     }
 }
 
@@ -188,11 +202,10 @@ void TNGFormat::read_velocities(Frame& frame) {
     }
 
     frame.add_velocities();
-    auto velocities = *frame.velocities();
-    for (size_t i=0; i<static_cast<size_t>(natoms_); i++) {
-        velocities[i][0] = static_cast<double>(buffer[3 * i + 0]) * distance_scale_factor_;
-        velocities[i][1] = static_cast<double>(buffer[3 * i + 1]) * distance_scale_factor_;
-        velocities[i][2] = static_cast<double>(buffer[3 * i + 2]) * distance_scale_factor_;
+    if (frame.single_precision()) {
+        convert_vectors(buffer, distance_scale_factor_, *frame.velocities_f32());
+    } else {
+        convert_vectors(buffer, distance_scale_factor_, *frame.velocities());
     }
 }
 
@@ -6,6 +6,7 @@
 #include <cstdint>
 
 #include <array>
+#include <type_traits>
 #include <string>
 #include <vector>
 
@@ -51,9 +52,9 @@ template<> const FormatMetadata& chemfiles::format_metadata<TRRFormat>() {
 #define STRING(x) STRING_0(x)
 #define CHECK(x) check_xdr_error((x), (STRING(x)))
 
-static void set_positions(const std::vector<float>& x, Frame& frame);
+static void set_positions(const std::vector<float>& x, const std::vector<size_t>& subset, Frame& frame);
 static void get_positions(std::vector<float>& x, const Frame& frame);
-static void set_velocities(const std::vector<float>& v, Frame& frame);
+static void set_velocities(const std::vector<float>& v, const std::vector<size_t>& subset, Frame& frame);
 static void get_velocities(std::vector<float>& v, const Frame& frame);
 static void get_cell(matrix box, const Frame& frame);
 
@@ -66,6 +67,23 @@ TRRFormat::TRRFormat(std::string path, File::Mode mode, File::Compression compre
 
 size_t TRRFormat::nsteps() { return static_cast<size_t>(file_.nframes()); }
 
+bool TRRFormat::set_atom_subset(std::vector<size_t> indices) {
+    if (!indices.empty() && indices.back() >= static_cast<size_t>(file_.natoms())) {
+        throw format_error(
+            "can not read atom {} in this TRR file, which contains {} atoms",
+            indices.back(), file_.natoms()
+        );
+    }
+    // the whole step still needs to be decoded by xdrfile, but only the
+    // requested atoms are converted and stored in the frame
+    atom_subset_ = std::move(indices);
+    return true;
+}
+
+bool TRRFormat::write_single_precision() const {
+    return true;
+}
+
 void TRRFormat::read_step(size_t step, Frame& frame) {
     step_ = step;
     CHECK(xdr_seek(file_, file_.offset(step_), SEEK_SET));
@@ -78,12 +96,28 @@ void TRRFormat::read(Frame& frame) {
     float time = 0;
     float lambda = 0;
     matrix box;
-    std::vector<float> x(static_cast<size_t>(natoms) * 3);
     std::vector<float> v(static_cast<size_t>(natoms) * 3);
     uint8_t has_prop = 0;
 
+    if (atom_subset_.empty()) {
+        frame.resize(static_cast<size_t>(natoms));
+    } else {
+        frame.resize(atom_subset_.size());
+    }
+
+    // decode the positions directly in the frame storage if possible
+    bool direct_positions = frame.single_precision() && atom_subset_.empty();
+    std::vector<float> x;
+    float* x_data = nullptr;
+    if (direct_positions) {
+        x_data = reinterpret_cast<float*>(frame.positions_f32().data());
+    } else {
+        x.resize(static_cast<size_t>(natoms) * 3);
+        x_data = x.data();
+    }
+
     CHECK(read_trr(file_, natoms, &md_step, &time, &lambda, box,
-                   reinterpret_cast<float(*)[3]>(x.data()), reinterpret_cast<float(*)[3]>(v.data()),
+                   reinterpret_cast<float(*)[3]>(x_data), reinterpret_cast<float(*)[3]>(v.data()),
                    nullptr /* ignore forces */, &has_prop));
 
     bool has_box = bool(has_prop & TRR_HAS_BOX);
@@ -94,7 +128,6 @@ void TRRFormat::read(Frame& frame) {
     frame.set("time", static_cast<double>(time));         // time in pico seconds
     frame.set("trr_lambda", static_cast<double>(lambda)); // coupling parameter for free energy methods
     frame.set("has_positions", false);
-    frame.resize(static_cast<size_t>(natoms));
 
     if (has_box) {
         auto matrix = Matrix3D(
@@ -108,10 +141,20 @@ void TRRFormat::read(Frame& frame) {
 
     if (has_positions) {
         frame.set("has_positions", true);
-        set_positions(x, frame);
+        if (direct_positions) {
+            auto positions = frame.positions_f32();
+            for (size_t i = 0; i < positions.size(); i++) {
+                // Factor 10 because the lengths are in nm in the TRR format
+                positions[i][0] *= 10;
+                positions[i][1] *= 10;
+                positions[i][2] *= 10;
+            }
+        } else {
+            set_positions(x, atom_subset_, frame);
+        }
     }
     if (has_velocities) {
-        set_velocities(v, frame);
+        set_velocities(v, atom_subset_, frame);
     }
 
     step_++;
@@ -142,7 +185,9 @@ void TRRFormat::write(const Frame& frame) {
         x.resize(static_cast<size_t>(natoms) * 3);
         get_positions(x, frame);
     }
-    if (frame.velocities()) {
+    // check for velocities without converting single precision frames
+    bool has_velocities = frame.single_precision() ? bool(frame.velocities_f32()) : bool(frame.velocities());
+    if (has_velocities) {
         v.resize(static_cast<size_t>(natoms) * 3);
         get_velocities(v, frame);
     }
@@ -156,48 +201,61 @@ void TRRFormat::write(const Frame& frame) {
     step_++;
 }
 
-void set_positions(const std::vector<float>& x, Frame& frame) {
-    auto positions = frame.positions();
-    assert(x.size() == 3 * positions.size());
-    for (size_t i = 0; i < frame.size(); i++) {
-        // Factor 10 because the cell lengths are in nm in the TRR format
-        positions[i][0] = static_cast<double>(x[i * 3]) * 10;
-        positions[i][1] = static_cast<double>(x[i * 3 + 1]) * 10;
-        positions[i][2] = static_cast<double>(x[i * 3 + 2]) * 10;
+// `Vector` is either `Vector3D` or `Vector3F`, depending on the frame storage
+template <typename Vector>
+static void set_vectors(const std::vector<float>& x, const std::vector<size_t>& subset, span<Vector> vectors) {
+    using value_t = typename std::remove_reference<decltype(vectors[0][0])>::type;
+    assert(subset.empty() ? x.size() == 3 * vectors.size() : subset.size() == vectors.size());
+    for (size_t i = 0; i < vectors.size(); i++) {
+        auto j = subset.empty() ? i : subset[i];
+        // Factor 10 because the lengths are in nm in the TRR format
+        vectors[i][0] = static_cast<value_t>(x[j * 3]) * 10;
+        vectors[i][1] = static_cast<value_t>(x[j * 3 + 1]) * 10;
+        vectors[i][2] = static_cast<value_t>(x[j * 3 + 2]) * 10;
     }
 }
 
-void get_positions(std::vector<float>& x, const Frame& frame) {
-    auto positions = frame.positions();
-    assert(x.size() == 3 * positions.size());
-    for (size_t i = 0; i < frame.size(); i++) {
+template <typename Vector>
+static void get_vectors(std::vector<float>& x, const std::vector<Vector>& vectors) {
+    assert(x.size() == 3 * vectors.size());
+    for (size_t i = 0; i < vectors.size(); i++) {
         // Factor 10 because the lengths are in nm in the TRR format
-        x[i * 3] = static_cast<float>(positions[i][0] / 10.0);
-        x[i * 3 + 1] = static_cast<float>(positions[i][1] / 10.0);
-        x[i * 3 + 2] = static_cast<float>(positions[i][2] / 10.0);
+        x[i * 3] = static_cast<float>(vectors[i][0] / 10.0);
+        x[i * 3 + 1] = static_cast<float>(vectors[i][1] / 10.0);
+        x[i * 3 + 2] = static_cast<float>(vectors[i][2] / 10.0);
+    }
+}
+
+void set_positions(const std::vector<float>& x, const std::vector<size_t>& subset, Frame& frame) {
+    if (frame.single_precision()) {
+        set_vectors(x, subset, frame.positions_f32());
+    } else {
+        set_vectors(x, subset, frame.positions());
     }
 }
 
-void set_velocities(const std::vector<float>& v, Frame& frame) {
+void get_positions(std::vector<float>& x, const Frame& frame) {
+    if (frame.single_precision()) {
+        get_vectors(x, frame.positions_f32());
+    } else {
+        get_vectors(x, frame.positions());
+    }
+}
+
+void set_velocities(const std::vector<float>& v, const std::vector<size_t>& subset, Frame& frame) {
     frame.add_velocities();
-    auto velocities = *frame.velocities();
-    assert(v.size() == 3 * velocities.size());
-    for (size_t i = 0; i < frame.size(); i++) {
-        // Factor 10 because the lengths are in nm in the TRR format
-        velocities[i][0] = static_cast<double>(v[i * 3]) * 10;
-        velocities[i][1] = static_cast<double>(v[i * 3 + 1]) * 10;
-        velocities[i][2] = static_cast<double>(v[i * 3 + 2]) * 10;
+    if (frame.single_precision()) {
+        set_vectors(v, subset, *frame.velocities_f32());
+    } else {
+        set_vectors(v, subset, *frame.velocities());
     }
 }
 
 void get_velocities(std::vector<float>& v, const Frame& frame) {
-    auto velocities = *frame.velocities();
-    assert(v.size() == 3 * velocities.size());
-    for (size_t i = 0; i < frame.size(); i++) {
-        // Factor 10 because the lengths are in nm in the TRR format
-        v[i * 3] = static_cast<float>(velocities[i][0] / 10.0);
-        v[i * 3 + 1] = static_cast<float>(velocities[i][1] / 10.0);
-        v[i * 3 + 2] = static_cast<float>(velocities[i][2] / 10.0);
+    if (frame.single_precision()) {
+        get_vectors(v, *frame.velocities_f32());
+    } else {
+        get_vectors(v, *frame.velocities());
     }
 }
 
@@ -4,6 +4,7 @@
 #include <cstdio>
 #include <cassert>
 #include <array>
+#include <type_traits>
 #include <string>
 #include <vector>
 
@@ -49,7 +50,7 @@ template<> const FormatMetadata& chemfiles::format_metadata<XTCFormat>() {
 #define STRING(x) STRING_0(x)
 #define CHECK(x) check_xdr_error((x), (STRING(x)))
 
-static void set_positions(const std::vector<float>& x, Frame& frame);
+static void set_positions(const std::vector<float>& x, const std::vector<size_t>& subset, Frame& frame);
 static void get_positions(std::vector<float>& x, const Frame& frame);
 static void get_cell(matrix box, const Frame& frame);
 
@@ -62,6 +63,23 @@ XTCFormat::XTCFormat(std::string path, File::Mode mode, File::Compression compre
 
 size_t XTCFormat::nsteps() { return static_cast<size_t>(file_.nframes()); }
 
+bool XTCFormat::set_atom_subset(std::vector<size_t> indices) {
+    if (!indices.empty() && indices.back() >= static_cast<size_t>(file_.natoms())) {
+        throw format_error(
+            "can not read atom {} in this XTC file, which contains {} atoms",
+            indices.back(), file_.natoms()
+        );
+    }
+    // the whole step still needs to be decoded by xdrfile, but only the
+    // requested atoms are converted and stored in the frame
+    atom_subset_ = std::move(indices);
+    return true;
+}
+
+bool XTCFormat::write_single_precision() const {
+    return true;
+}
+
 void XTCFormat::read_step(size_t step, Frame& frame) {
     step_ = step;
     CHECK(xdr_seek(file_, file_.offset(step_), SEEK_SET));
@@ -73,18 +91,35 @@ void XTCFormat::read(Frame& frame) {
     int md_step = 0;
     float time = 0;
     matrix box;
-    std::vector<float> x(static_cast<size_t>(natoms) * 3);
     float precision = 0;
 
-    CHECK(read_xtc(file_, natoms, &md_step, &time, box, reinterpret_cast<float(*)[3]>(x.data()),
-                   &precision));
+    if (atom_subset_.empty()) {
+        frame.resize(static_cast<size_t>(natoms));
+    } else {
+        frame.resize(atom_subset_.size());
+    }
+
+    if (frame.single_precision() && atom_subset_.empty()) {
+        // decode the positions directly in the frame storage
+        auto positions = frame.positions_f32();
+        CHECK(read_xtc(file_, natoms, &md_step, &time, box, reinterpret_cast<float(*)[3]>(positions.data()),
+                       &precision));
+        for (size_t i = 0; i < positions.size(); i++) {
+            // Factor 10 because the lengths are in nm in the XTC format
+            positions[i][0] *= 10;
+            positions[i][1] *= 10;
+            positions[i][2] *= 10;
+        }
+    } else {
+        std::vector<float> x(static_cast<size_t>(natoms) * 3);
+        CHECK(read_xtc(file_, natoms, &md_step, &time, box, reinterpret_cast<float(*)[3]>(x.data()),
+                       &precision));
+        set_positions(x, atom_subset_, frame);
+    }
 
     frame.set_step(static_cast<size_t>(md_step));  // actual step of MD Simulation
     frame.set("time", static_cast<double>(time));  // time in pico seconds
     frame.set("xtc_precision", static_cast<double>(precision));
-    frame.resize(static_cast<size_t>(natoms));
-
-    set_positions(x, frame);
 
     auto matrix = Matrix3D(
         static_cast<double>(box[0][0]), static_cast<double>(box[1][0]), static_cast<double>(box[2][0]),
@@ -123,21 +158,32 @@ void XTCFormat::write(const Frame& frame) {
     step_++;
 }
 
-void set_positions(const std::vector<float>& x, Frame& frame) {
-    auto positions = frame.positions();
-    assert(x.size() == 3 * positions.size());
-    for (size_t i = 0; i < frame.size(); i++) {
+// `Vector` is either `Vector3D` or `Vector3F`, depending on the frame storage
+template <typename Vector>
+static void set_positions(const std::vector<float>& x, const std::vector<size_t>& subset, span<Vector> positions) {
+    using value_t = typename std::remove_reference<decltype(positions[0][0])>::type;
+    assert(subset.empty() ? x.size() == 3 * positions.size() : subset.size() == positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        auto j = subset.empty() ? i : subset[i];
         // Factor 10 because the cell lengths are in nm in the XTC format
-        positions[i][0] = static_cast<double>(x[i * 3]) * 10;
-        positions[i][1] = static_cast<double>(x[i * 3 + 1]) * 10;
-        positions[i][2] = static_cast<double>(x[i * 3 + 2]) * 10;
+        positions[i][0] = static_cast<value_t>(x[j * 3]) * 10;
+        positions[i][1] = static_cast<value_t>(x[j * 3 + 1]) * 10;
+        positions[i][2] = static_cast<value_t>(x[j * 3 + 2]) * 10;
     }
 }
 
-void get_positions(std::vector<float>& x, const Frame& frame) {
-    auto positions = frame.positions();
+void set_positions(const std::vector<float>& x, const std::vector<size_t>& subset, Frame& frame) {
+    if (frame.single_precision()) {
+        set_positions(x, subset, frame.positions_f32());
+    } else {
+        set_positions(x, subset, frame.positions());
+    }
+}
+
+template <typename Vector>
+static void get_positions(std::vector<float>& x, const std::vector<Vector>& positions) {
     assert(x.size() == 3 * positions.size());
-    for (size_t i = 0; i < frame.size(); i++) {
+    for (size_t i = 0; i < positions.size(); i++) {
         // Factor 10 because the cell lengths are in nm in the XTC format
         x[i * 3] = static_cast<float>(positions[i][0] / 10.0);
         x[i * 3 + 1] = static_cast<float>(positions[i][1] / 10.0);
@@ -145,6 +191,14 @@ void get_positions(std::vector<float>& x, const Frame& frame) {
     }
 }
 
+void get_positions(std::vector<float>& x, const Frame& frame) {
+    if (frame.single_precision()) {
+        get_positions(x, frame.positions_f32());
+    } else {
+        get_positions(x, frame.positions());
+    }
+}
+
 void get_cell(matrix box, const Frame& frame) {
     // Factor 10 because the cell lengths are in nm in the XTC format
     auto matrix = frame.cell().matrix() / 10.0;
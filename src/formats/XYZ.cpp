@@ -17,6 +17,8 @@
 #include "chemfiles/types.hpp"
 #include "chemfiles/parse.hpp"
 #include "chemfiles/utils.hpp"
+#include "chemfiles/parallel.hpp"
+#include "chemfiles/atom_cache.hpp"
 #include "chemfiles/warnings.hpp"
 #include "chemfiles/error_fmt.hpp"
 #include "chemfiles/string_view.hpp"
@@ -41,17 +43,36 @@ static UnitCell parse_cell(string_view lattice);
 struct extended_property {
     std::string name;
     Property::Kind type;
+    /// Is this property stored in a per-atom column of the frame instead of
+    /// the atoms properties?
+    bool column;
 };
 
 /// Type for a list of additional atomic properties in extended XYZ
 using properties_list_t = std::vector<extended_property>;
 
+/// Storage for the values of a single atomic property in the frame columns.
+/// Only one of the pointers is set for properties stored in columns, and both
+/// are `nullptr` for properties stored in the atoms.
+struct property_column {
+    double* doubles;
+    Vector3D* vectors;
+};
+
 /// Read the extended XYZ properties from the line, set frame properties
 /// directly and return the list of atomic properties to read
 static properties_list_t read_extended_comment_line(string_view line, Frame& frame);
 
-/// Read the properties in the list form the line and set them on the atom
-static void read_atomic_properties(const properties_list_t& properties, string_view line, Atom& atom);
+/// Add the columns for numeric properties in the list to the frame, and get
+/// the corresponding storage, in the same order as `properties`
+static std::vector<property_column> add_property_columns(const properties_list_t& properties, Frame& frame);
+
+/// Read the properties in the list from the line, and set them on the atom at
+/// index `i` or in the corresponding `columns`
+static void read_atomic_properties(
+    const properties_list_t& properties, const std::vector<property_column>& columns,
+    string_view line, size_t i, Atom& atom
+);
 
 /// Get the list of atoms properties defined for all atoms in the frame
 static properties_list_t get_atom_properties(const Frame& frame);
@@ -59,6 +80,9 @@ static properties_list_t get_atom_properties(const Frame& frame);
 /// Generate the extended XYZ comment line for the given frame
 static std::string write_extended_comment_line(const Frame& frame, properties_list_t properties);
 
+/// Write the three components of `vector` to `file`, each preceded by a space
+static void print_vector(TextFile& file, const Vector3D& vector);
+
 template<> const FormatMetadata& chemfiles::format_metadata<XYZFormat>() {
     static FormatMetadata metadata;
     metadata.name = "XYZ";
@@ -84,22 +108,41 @@ void XYZFormat::read_next(Frame& frame) {
 
     auto properties = read_extended_comment_line(file_.readline(), frame);
 
-    frame.reserve(n_atoms);
-    for (size_t i=0; i<n_atoms; i++) {
-        auto line = file_.readline();
+    frame.resize(n_atoms);
+    auto positions = frame.positions();
+    auto columns = add_property_columns(properties, frame);
+    // atomic lines are independent from one another, and can be parsed in
+    // parallel. Each thread gets its own copy of the cache.
+    auto cache = AtomCache();
+    parallel_lines(file_, n_atoms, [&, cache](size_t i, string_view line) mutable {
         double x = 0, y = 0, z = 0;
-        std::string name;
+        string_view name;
         auto count = scan(line, name, x, y, z);
-        auto atom = Atom(std::move(name));
-        read_atomic_properties(properties, line.substr(count), atom);
-        frame.add_atom(std::move(atom), Vector3D(x, y, z));
-    }
+        auto atom = cache.get(name);
+        read_atomic_properties(properties, columns, line.substr(count), i, atom);
+        frame[i] = std::move(atom);
+        positions[i] = Vector3D(x, y, z);
+    });
 }
 
 void XYZFormat::write_next(const Frame& frame) {
     auto& positions = frame.positions();
     auto properties = get_atom_properties(frame);
 
+    auto double_columns = std::vector<const double*>(properties.size(), nullptr);
+    auto vector3d_columns = std::vector<const Vector3D*>(properties.size(), nullptr);
+    for (size_t j = 0; j < properties.size(); j++) {
+        if (!properties[j].column) {
+            continue;
+        }
+        if (properties[j].type == Property::DOUBLE) {
+            double_columns[j] = frame.column<double>(properties[j].name)->data();
+        } else {
+            assert(properties[j].type == Property::VECTOR3D);
+            vector3d_columns[j] = frame.column<Vector3D>(properties[j].name)->data();
+        }
+    }
+
     file_.print("{}\n", frame.size());
     file_.print("{}\n", write_extended_comment_line(frame, properties));
 
@@ -111,13 +154,21 @@ void XYZFormat::write_next(const Frame& frame) {
             name = "X";
         }
 
-        file_.print("{} {:g} {:g} {:g}",
-            name, positions[i][0], positions[i][1], positions[i][2]
-        );
+        file_.print("{}", name);
+        print_vector(file_, positions[i]);
 
-        for (const auto& property: properties) {
-            const auto& value = atom.get(property.name).value();
+        for (size_t j = 0; j < properties.size(); j++) {
+            const auto& property = properties[j];
+            if (double_columns[j] != nullptr) {
+                file_.print(" ");
+                file_.print_general(double_columns[j][i]);
+                continue;
+            } else if (vector3d_columns[j] != nullptr) {
+                print_vector(file_, vector3d_columns[j][i]);
+                continue;
+            }
 
+            const auto& value = atom.get(property.name).value();
             if (property.type == Property::STRING) {
                 file_.print(" {}", value.as_string());
             } else if (property.type == Property::BOOL) {
@@ -127,10 +178,10 @@ void XYZFormat::write_next(const Frame& frame) {
                     file_.print(" F");
                 }
             } else if (property.type == Property::DOUBLE) {
-                file_.print(" {:g}", value.as_double());
+                file_.print(" ");
+                file_.print_general(value.as_double());
             } else if (property.type == Property::VECTOR3D) {
-                const auto& vector = value.as_vector3d();
-                file_.print(" {:g} {:g} {:g}", vector[0], vector[1], vector[2]);
+                print_vector(file_, value.as_vector3d());
             }
         }
 
@@ -138,6 +189,13 @@ void XYZFormat::write_next(const Frame& frame) {
     }
 }
 
+static void print_vector(TextFile& file, const Vector3D& vector) {
+    for (size_t k = 0; k < 3; k++) {
+        file.print(" ");
+        file.print_general(vector[k]);
+    }
+}
+
 optional<uint64_t> XYZFormat::forward() {
     auto position = file_.tellpos();
 
@@ -327,11 +385,29 @@ properties_list_t get_atom_properties(const Frame& frame) {
         return {};
     }
 
+    // columns are defined for all atoms, and take precedence over atomic
+    // properties with the same name
+    auto columns = std::set<std::string>();
+    for (auto& name: frame.columns()) {
+        if (!is_valid_property_name(name)) {
+            warning(
+                "Extended XYZ", "'{}' is not a valid property name for extended "
+                "XYZ, is will not be saved", name
+            );
+            continue;
+        }
+        columns.insert(std::move(name));
+    }
+
     auto all_properties = std::map<std::string, Property::Kind>();
     auto partially_defined_already_warned = std::set<std::string>();
 
     const auto& first_atom = frame[0];
     for (const auto& property: first_atom.properties()) {
+        if (columns.count(property.first) != 0) {
+            continue;
+        }
+
         if (!is_valid_property_name(property.first)) {
             warning(
                 "Extended XYZ", "'{}' is not a valid property name for extended "
@@ -390,7 +466,7 @@ properties_list_t get_atom_properties(const Frame& frame) {
         if (atom.properties().size() > all_properties.size()) {
             // warn for properties defined on this atom but not on others
             for (const auto& property: atom.properties()) {
-                if (all_properties.count(property.first) == 0) {
+                if (all_properties.count(property.first) == 0 && columns.count(property.first) == 0) {
                     if (partially_defined_already_warned.count(property.first) == 0) {
                         warning(
                             "Extended XYZ",
@@ -408,10 +484,15 @@ properties_list_t get_atom_properties(const Frame& frame) {
         }
     }
 
+    for (const auto& name: columns) {
+        all_properties[name] = frame.column_kind(name).value();
+    }
+
     auto results = properties_list_t();
     results.reserve(all_properties.size());
     for (auto property: std::move(all_properties)) {
-        results.push_back({std::move(property.first), std::move(property.second)});
+        auto column = columns.count(property.first) != 0;
+        results.push_back({std::move(property.first), std::move(property.second), column});
     }
     return results;
 }
@@ -567,6 +648,8 @@ static UnitCell parse_cell(string_view lattice) {
 /// - Properties of type R:3 and I:3 are maped to Vector3D values
 /// - Properties of type R:N and I:N are maped to to N separate double
 ///   properties, named `$name_$i`
+/// - all the numeric (double and Vector3D) properties are stored in per-atom
+///   columns of the frame instead of the atoms
 ///
 /// - Properties of type S:1 are maped to string values
 /// - Properties of type S:N are maped to N separate string properties,
@@ -616,9 +699,10 @@ static properties_list_t parse_property_list(string_view input) {
             continue;
         }
 
+        auto column = type == Property::DOUBLE;
         if (repeat == 3 && type == Property::DOUBLE) {
             type = Property::VECTOR3D;
-            properties.emplace_back(extended_property{name, type});
+            properties.emplace_back(extended_property{name, type, column});
             continue;
         }
 
@@ -626,11 +710,11 @@ static properties_list_t parse_property_list(string_view input) {
             warning("Extended XYZ", "invalid type repeat for {} in Properties='{}'", name, input);
             continue;
         } else if (repeat == 1) {
-            properties.emplace_back(extended_property{name, type});
+            properties.emplace_back(extended_property{name, type, column});
         } else {
             for (size_t j=0; j<repeat; j++) {
                 properties.emplace_back(extended_property{
-                    fmt::format("{}_{}", name, j), type
+                    fmt::format("{}_{}", name, j), type, column
                 });
             }
         }
@@ -669,9 +753,49 @@ properties_list_t read_extended_comment_line(string_view line, Frame& frame) {
 // the expected type. If the files contains a valid `Properties=...`
 // description,throwing errors if the rest of the files does not follow the
 // description is fair game.
-void read_atomic_properties(const properties_list_t& properties, string_view line, Atom& atom) {
+std::vector<property_column> add_property_columns(const properties_list_t& properties, Frame& frame) {
+    for (const auto& property: properties) {
+        if (!property.column) {
+            continue;
+        }
+        if (property.type == Property::DOUBLE) {
+            frame.add_column<double>(property.name);
+        } else {
+            assert(property.type == Property::VECTOR3D);
+            frame.add_column<Vector3D>(property.name);
+        }
+    }
+
+    // get the pointers after adding all the columns, since adding a column
+    // can move the other ones
+    auto columns = std::vector<property_column>();
+    columns.reserve(properties.size());
     for (const auto& property: properties) {
-        if (property.type == Property::STRING) {
+        auto column = property_column{nullptr, nullptr};
+        if (property.column && property.type == Property::DOUBLE) {
+            column.doubles = frame.column<double>(property.name)->data();
+        } else if (property.column) {
+            column.vectors = frame.column<Vector3D>(property.name)->data();
+        }
+        columns.push_back(column);
+    }
+    return columns;
+}
+
+void read_atomic_properties(
+    const properties_list_t& properties, const std::vector<property_column>& columns,
+    string_view line, size_t i, Atom& atom
+) {
+    for (size_t j = 0; j < properties.size(); j++) {
+        const auto& property = properties[j];
+        if (columns[j].doubles != nullptr) {
+            auto count = scan(line, columns[j].doubles[i]);
+            line.remove_prefix(count);
+        } else if (columns[j].vectors != nullptr) {
+            auto& value = columns[j].vectors[i];
+            auto count = scan(line, value[0], value[1], value[2]);
+            line.remove_prefix(count);
+        } else if (property.type == Property::STRING) {
             std::string value;
             auto count = scan(line, value);
             line.remove_prefix(count);
@@ -688,17 +812,8 @@ void read_atomic_properties(const properties_list_t& properties, string_view lin
             } else {
                 throw error("invalid value for boolean '{}'", value);
             }
-        } else if (property.type == Property::DOUBLE) {
-            double value;
-            auto count = scan(line, value);
-            line.remove_prefix(count);
-            atom.set(property.name, value);
-        }  else if (property.type == Property::VECTOR3D) {
-            Vector3D value;
-            auto count = scan(line, value[0], value[1], value[2]);
-            line.remove_prefix(count);
-            atom.set(property.name, std::move(value));
         } else {
+            // numeric properties are always stored in columns
             unreachable();
         }
     }
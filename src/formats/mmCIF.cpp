@@ -53,8 +53,68 @@ template<> const FormatMetadata& chemfiles::format_metadata<mmCIFFormat>() {
     return metadata;
 }
 
-/// CIF files store which digits are insignificant, we need to remove this
-static double cif_to_double(std::string line);
+/// Parse a number in a CIF file, ignoring the uncertainty on the last digits
+static double cif_to_double(string_view value);
+
+/// Split a row of a CIF loop into `fields`, removing the quotes around quoted
+/// values. The fields point inside `line`.
+static void split_cif_row(string_view line, std::vector<string_view>& fields);
+
+/// Get the last field in a row of a CIF loop, which must not be quoted
+static string_view last_cif_field(string_view line);
+
+void mmCIFResidues::add_atom(
+    size_t atom, int64_t resid, string_view chainid, string_view name,
+    optional<string_view> chainname, optional<string_view> group_pdb
+) {
+    if (last_residue_ && resid == last_resid_ && chainid == last_chainid_) {
+        residues_[*last_residue_].add_atom(atom);
+        return;
+    }
+
+    last_chainid_ = chainid.to_string();
+    last_resid_ = resid;
+
+    auto it = indexes_.find({last_chainid_, resid});
+    if (it == indexes_.end()) {
+        auto residue = Residue(name.to_string(), resid);
+        residue.add_atom(atom);
+
+        // This will be saved as a string on purpose to match MMTF
+        residue.set("chainid", last_chainid_);
+
+        if (chainname) {
+            residue.set("chainname", chainname->to_string());
+        }
+
+        if (group_pdb) {
+            residue.set("is_standard_pdb", *group_pdb == "ATOM");
+        }
+
+        last_residue_ = residues_.size();
+        indexes_.emplace(std::make_pair(last_chainid_, resid), residues_.size());
+        residues_.emplace_back(std::move(residue));
+    } else {
+        // Just add this atom to the residue
+        last_residue_ = it->second;
+        residues_[it->second].add_atom(atom);
+    }
+}
+
+void mmCIFResidues::add_to(Frame& frame) {
+    for (auto& residue: residues_) {
+        frame.add_residue(std::move(residue));
+    }
+    clear();
+}
+
+void mmCIFResidues::clear() {
+    residues_.clear();
+    indexes_.clear();
+    last_residue_ = nullopt;
+    last_chainid_.clear();
+    last_resid_ = 0;
+}
 
 void mmCIFFormat::init_() {
     if (file_.mode() == File::WRITE) {
@@ -68,6 +128,9 @@ void mmCIFFormat::init_() {
     Vector3D lengths;
     Vector3D angles = {90, 90, 90};
 
+    // Map of STAR records to their index
+    auto atom_site_map = std::map<std::string, size_t>();
+    auto line_split = FieldSplitter();
     bool in_loop = false;
     size_t current_index = 0;
     while (!file_.eof()) {
@@ -83,33 +146,36 @@ void mmCIFFormat::init_() {
             continue;
         }
 
-        auto line_split = split(line, ' ');
+        if (line_split.split(line) == 0) {
+            continue;
+        }
+
         if (line_split.size() > 1 && line[0] == '_') {
             in_loop = false;
         }
 
         if (line_split[0] == "_cell_length_a" || line_split[0] == "_cell.length_a") {
-            lengths[0] = cif_to_double(line_split[1].to_string());
+            lengths[0] = cif_to_double(line_split[1]);
         }
 
         if (line_split[0] == "_cell_length_b" || line_split[0] == "_cell.length_b") {
-            lengths[1] = cif_to_double(line_split[1].to_string());
+            lengths[1] = cif_to_double(line_split[1]);
         }
 
         if (line_split[0] == "_cell_length_c" || line_split[0] == "_cell.length_c") {
-            lengths[2] = cif_to_double(line_split[1].to_string());
+            lengths[2] = cif_to_double(line_split[1]);
         }
 
         if (line_split[0] == "_cell_angle_alpha" || line_split[0] == "_cell.angle_alpha") {
-            angles[0] = cif_to_double(line_split[1].to_string());
+            angles[0] = cif_to_double(line_split[1]);
         }
 
         if (line_split[0] == "_cell_angle_beta" || line_split[0] == "_cell.angle_beta") {
-            angles[1] = cif_to_double(line_split[1].to_string());
+            angles[1] = cif_to_double(line_split[1]);
         }
 
         if (line_split[0] == "_cell_angle_gamma" || line_split[0] == "_cell.angle_gamma") {
-            angles[2] = cif_to_double(line_split[1].to_string());
+            angles[2] = cif_to_double(line_split[1]);
         }
 
         if (line_split[0] == "_entry.id") {
@@ -124,7 +190,7 @@ void mmCIFFormat::init_() {
 
         if (in_loop && line_split[0].find("_atom_site.") != std::string::npos) {
             auto atom_label = line_split[0].substr(11).to_string();
-            atom_site_map_[atom_label] = current_index++;
+            atom_site_map[atom_label] = current_index++;
             break;
         }
     }
@@ -141,7 +207,7 @@ void mmCIFFormat::init_() {
     do {
         if (line.find("_atom_site") != std::string::npos) {
             auto atom_label = trim(line).substr(11).to_string();
-            atom_site_map_[atom_label] = current_index++;
+            atom_site_map[atom_label] = current_index++;
 
             position = file_.tellpos();
             line = file_.readline();
@@ -156,40 +222,87 @@ void mmCIFFormat::init_() {
     // After this block ends, we have the start of coordinates
     steps_positions_.push_back(position);
 
-    if (atom_site_map_.find("type_symbol") == atom_site_map_.end()) {
+    // get the index of all the columns once, instead of looking them up for
+    // every frame
+    auto find_column = [&atom_site_map](const std::string& name) -> optional<size_t> {
+        auto it = atom_site_map.find(name);
+        if (it == atom_site_map.end()) {
+            return nullopt;
+        }
+        return it->second;
+    };
+
+    columns_count_ = atom_site_map.size();
+
+    auto type_symbol = find_column("type_symbol");
+    if (!type_symbol) {
         throw format_error("could not find _atom_site.type_symbol in '{}'", file_.path());
     }
+    columns_.type_symbol = *type_symbol;
 
-    if (atom_site_map_.find("Cartn_x") == atom_site_map_.end()) {
+    auto cartn_x = find_column("Cartn_x");
+    auto cartn_y = find_column("Cartn_y");
+    auto cartn_z = find_column("Cartn_z");
+    if (!cartn_x || !cartn_y || !cartn_z) {
         throw format_error("could not find _atom_site.Cartn_x in '{}'", file_.path());
     }
+    columns_.cartn_x = *cartn_x;
+    columns_.cartn_y = *cartn_y;
+    columns_.cartn_z = *cartn_z;
+
+    // This has two names...
+    columns_.label_atom_id = find_column("label_atom_id");
+    if (!columns_.label_atom_id) {
+        columns_.label_atom_id = find_column("label");
+    }
+
+    // Other atom properties
+    columns_.group_pdb = find_column("group_PDB");
+    columns_.label_alt_id = find_column("label_alt_id");
+    columns_.formal_charge = find_column("formal_charge");
+
+    // Residue properties
+    columns_.label_comp_id = find_column("label_comp_id");
+    columns_.label_asym_id = find_column("label_asym_id");
+    columns_.auth_asym_id = find_column("auth_asym_id");
+    columns_.label_seq_id = find_column("label_seq_id");
+    columns_.label_entity_id = find_column("label_entity_id");
 
-    auto model_position = atom_site_map_.find("pdbx_PDB_model_num");
     // Do we have a special extension for multiple modes?
-    if (model_position == atom_site_map_.end()) {
+    columns_.model_num = find_column("pdbx_PDB_model_num");
+    if (!columns_.model_num) {
         // If not, we are done
         file_.seekpos(steps_positions_[0]);
         return;
     }
 
-    // Ok, let's look at the sites now to note where models start
-    auto last_position = parse<size_t>(split(line, ' ')[model_position->second]);
+    // Ok, let's look at the sites now to note where models start. This only
+    // needs the model number, which is usually in the last column and can be
+    // found without splitting the whole line.
+    auto model_num = *columns_.model_num;
+    auto model_field = [&](string_view current) {
+        if (model_num + 1 == columns_count_) {
+            return last_cif_field(current);
+        }
+        split_cif_row(current, fields_);
+        return model_num < fields_.size() ? fields_[model_num] : string_view();
+    };
+
+    auto last_model = model_field(line).to_string();
 
     do {
         position = file_.tellpos();
         line = file_.readline();
 
         // a break in the text ends the models
-        if (line.empty() || line == "line_" || line[0] == '#') {
+        if (line.empty() || line == "loop_" || line[0] == '#') {
             break;
         }
 
-        auto line_split = split(line, ' ');
-        size_t current_position = parse<size_t>(line_split[model_position->second]);
-
-        if (current_position != last_position) {
+        auto current_model = model_field(line);
+        if (current_model != last_model) {
             steps_positions_.push_back(position);
-            last_position = current_position;
+            last_model = current_model.to_string();
         }
     } while (!file_.eof());
 
@@ -207,7 +320,6 @@ void mmCIFFormat::read_step(const size_t step, Frame& frame) {
 }
 
 void mmCIFFormat::read(Frame& frame) {
-    map_residues_indexes.clear();
     residues_.clear();
     frame.set_cell(cell_);
 
@@ -219,147 +331,103 @@ void mmCIFFormat::read(Frame& frame) {
         frame.set("pdb_idcode", pdb_idcode_);
     }
 
-    // The following map operations can be moved to the constructor
-    // and stored with optional. I don't know which solution is better.
-
-    // These are required for atoms
-    auto type_symbol = atom_site_map_.at("type_symbol");
-
-    // This has two names...
-    auto label_atom_id = atom_site_map_.find("label_atom_id");
-    if (label_atom_id == atom_site_map_.end()) {
-        label_atom_id = atom_site_map_.find("label");
-    }
-
-    // Other atom properties
-    auto group_pdb = atom_site_map_.find("group_PDB");
-    auto label_alt_id = atom_site_map_.find("label_alt_id");
-    auto formal_charge = atom_site_map_.find("formal_charge");
-
-    // Positions
-    auto cartn_x = atom_site_map_.at("Cartn_x");
-    auto cartn_y = atom_site_map_.at("Cartn_y");
-    auto cartn_z = atom_site_map_.at("Cartn_z");
-
-    // Residue properties
-    auto label_comp_id = atom_site_map_.find("label_comp_id");
-    auto label_asym_id = atom_site_map_.find("label_asym_id");
-    auto auth_asym_id = atom_site_map_.find("auth_asym_id");
-    auto label_seq_id = atom_site_map_.find("label_seq_id");
-    auto label_entity_id = atom_site_map_.find("label_entity_id");
-
-    auto model_position = atom_site_map_.find("pdbx_PDB_model_num");
-
+    const auto& columns = columns_;
     auto position = file_.tellpos();
 
-    size_t last_position = 0;
-    if (model_position != atom_site_map_.end()) {
-        auto line = file_.readline();
-        last_position = parse<size_t>(split(line, ' ')[model_position->second]);
-        // Reset file position so that the loop below can start by reading the
-        // first line
-        file_.seekpos(position);
-    }
+    // model number of this frame, taken from the first line
+    std::string model;
+    bool first_line = true;
 
     while (!file_.eof()) {
         auto line = file_.readline();
-        auto line_split = split(line, ' ');
         if (line.empty() || line == "loop_" || line[0] == '#') {
             break;
         }
 
-        if (line_split.size() != atom_site_map_.size()) {
+        split_cif_row(line, fields_);
+        if (fields_.size() != columns_count_) {
             throw format_error("line '{}' has {} items not {}",
-                line, line_split.size(), atom_site_map_.size()
+                line, fields_.size(), columns_count_
             );
         }
 
-        size_t current_position = 0;
-        if (model_position != atom_site_map_.end()) {
-            current_position = parse<size_t>(line_split[model_position->second]);
-        }
-
-        if (current_position != last_position) {
-            break;
+        if (columns.model_num) {
+            auto current_model = fields_[*columns.model_num];
+            if (first_line) {
+                model = current_model.to_string();
+            } else if (current_model != model) {
+                break;
+            }
         }
+        first_line = false;
 
-        Atom atom(
-            line_split[label_atom_id->second].to_string(),
-            line_split[type_symbol].to_string()
-        );
+        auto name = columns.label_atom_id ? fields_[*columns.label_atom_id] : string_view();
+        Atom atom(name.to_string(), fields_[columns.type_symbol].to_string());
 
-        if (label_alt_id != atom_site_map_.end() &&
-            line_split[label_alt_id->second] != ".") {
-            atom.set("altloc", line_split[label_alt_id->second].to_string());
+        if (columns.label_alt_id && fields_[*columns.label_alt_id] != ".") {
+            atom.set("altloc", fields_[*columns.label_alt_id].to_string());
         }
 
-        if (formal_charge != atom_site_map_.end()) {
-            atom.set_charge(cif_to_double(line_split[formal_charge->second].to_string()));
+        if (columns.formal_charge) {
+            atom.set_charge(cif_to_double(fields_[*columns.formal_charge]));
         }
 
-        auto x = cif_to_double(line_split[cartn_x].to_string());
-        auto y = cif_to_double(line_split[cartn_y].to_string());
-        auto z = cif_to_double(line_split[cartn_z].to_string());
+        auto x = cif_to_double(fields_[columns.cartn_x]);
+        auto y = cif_to_double(fields_[columns.cartn_y]);
+        auto z = cif_to_double(fields_[columns.cartn_z]);
         frame.add_atom(std::move(atom), Vector3D(x, y, z));
 
         position = file_.tellpos();
 
-        if (label_comp_id == atom_site_map_.end() || label_asym_id == atom_site_map_.end()) {
+        if (!columns.label_comp_id || !columns.label_asym_id) {
             continue;
         }
 
-        auto atom_id = frame.size() - 1;
-        int64_t resid = 0;
-        auto resid_text = line_split[label_seq_id->second];
+        auto resname = fields_[*columns.label_comp_id];
+        if (resname == ".") {
+            // atom without residue
+            continue;
+        }
 
-        try {
-            if (resid_text == ".") { // In this case, we need to use the entity id
-                resid = parse<int64_t>(line_split[label_entity_id->second]);
-            } else {
-                resid = parse<int64_t>(line_split[label_seq_id->second]);
+        auto resid_text = columns.label_seq_id ? fields_[*columns.label_seq_id] : string_view(".");
+        if (resid_text == ".") {
+            // In this case, we need to use the entity id
+            if (!columns.label_entity_id) {
+                continue;
             }
+            resid_text = fields_[*columns.label_entity_id];
+        }
+
+        int64_t resid = 0;
+        try {
+            resid = parse<int64_t>(resid_text);
         } catch (const Error& e) {
             throw format_error("invalid CIF residue or entity numeric: {}", e.what());
         }
 
-        auto chainid = line_split[label_asym_id->second].to_string();
-
-        if (map_residues_indexes.find({chainid, resid}) == map_residues_indexes.end()) {
-
-            auto name = line_split[label_comp_id->second];
-            Residue residue(name.to_string(), resid);
-            residue.add_atom(atom_id);
-
-            // This will be saved as a string on purpose to match MMTF
-            if (label_asym_id != atom_site_map_.end()) {
-                residue.set("chainid", chainid);
-            }
-
-            if (auth_asym_id != atom_site_map_.end()) {
-                residue.set("chainname", line_split[auth_asym_id->second].to_string());
-            }
-
-            if (group_pdb != atom_site_map_.end()) {
-                residue.set("is_standard_pdb", line_split[group_pdb->second] == "ATOM");
-            }
+        auto chainname = optional<string_view>();
+        if (columns.auth_asym_id) {
+            chainname = fields_[*columns.auth_asym_id];
+        }
 
-            map_residues_indexes.emplace(std::make_pair(chainid, resid), residues_.size());
-            residues_.emplace_back(std::move(residue));
-        } else {
-            // Just add this atom to the residue
-            residues_[map_residues_indexes.at({ chainid, resid })].add_atom(atom_id);
+        auto group_pdb = optional<string_view>();
+        if (columns.group_pdb) {
+            group_pdb = fields_[*columns.group_pdb];
         }
+
+        residues_.add_atom(
+            frame.size() - 1, resid, fields_[*columns.label_asym_id], resname,
+            chainname, group_pdb
+        );
     }
 
     // Reset state to previous line
     file_.seekpos(position);
 
-    for (const auto& residue: residues_) {
-        frame.add_residue(residue);
-    }
+    residues_.add_to(frame);
 
     // Only link if we are reading mmCIF
-    if (model_position != atom_site_map_.end()) {
+    if (columns.model_num) {
         // Cross format talk! Forgive me!
         PDBFormat::link_standard_residue_bonds(frame);
     }
@@ -434,10 +502,55 @@ void mmCIFFormat::write(const Frame& frame) {
         );
     }
 
+    file_.flush();
+}
+
+double cif_to_double(string_view value) {
+    // the standard uncertainty is given in parenthesis after the value, as
+    // in `1.234(5)`
+    return parse<double>(value.substr(0, value.find('(')));
+}
+
+void split_cif_row(string_view line, std::vector<string_view>& fields) {
+    fields.clear();
+    auto size = line.size();
+    size_t i = 0;
+    while (true) {
+        while (i < size && is_ascii_whitespace(line[i])) {
+            i++;
+        }
+        if (i == size) {
+            break;
+        }
+
+        auto quote = line[i];
+        if (quote == '\'' || quote == '"') {
+            // quoted values end with the same quote followed by whitespace
+            auto start = i + 1;
+            auto end = start;
+            while (end < size && !(line[end] == quote && (end + 1 == size || is_ascii_whitespace(line[end + 1])))) {
+                end++;
+            }
+            fields.emplace_back(line.substr(start, end - start));
+            i = std::min(end + 1, size);
+        } else {
+            auto start = i;
+            while (i < size && !is_ascii_whitespace(line[i])) {
+                i++;
+            }
+            fields.emplace_back(line.substr(start, i - start));
+        }
+    }
 }
 
-double cif_to_double(std::string line) {
-    line.erase(std::remove(line.begin(), line.end(), '('), line.end());
-    line.erase(std::remove(line.begin(), line.end(), ')'), line.end());
-    return parse<double>(line);
+string_view last_cif_field(string_view line) {
+    auto end = line.size();
+    while (end > 0 && is_ascii_whitespace(line[end - 1])) {
+        end--;
+    }
+    auto start = end;
+    while (start > 0 && !is_ascii_whitespace(line[start - 1])) {
+        start--;
+    }
+    return line.substr(start, end - start);
 }
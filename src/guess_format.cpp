@@ -19,6 +19,10 @@ using namespace chemfiles;
 /// `.cif` extension
 static optional<std::string> distinguish_cif_variants(const std::string& path, const std::string& compression);
 
+/// check if the file name in `path` uses the `*` or `%` wildcards from the
+/// LAMMPS dump command, describing a trajectory split over multiple files
+static bool is_lammps_multiple_files(const std::string& path);
+
 static bool contains(string_view haystack, string_view needle) {
     return haystack.find(needle) != haystack.npos;
 }
@@ -63,8 +67,13 @@ std::string chemfiles::guess_format(std::string path, char mode) {
         extension = distinguish_cif_variants(path, compression).value_or(extension);
     }
 
-    auto registered_format = FormatFactory::get().by_extension(extension);
-    auto format = std::string(registered_format.metadata.name);
+    auto format = std::string();
+    if ((extension == ".lammpstrj" || extension == ".bin") && mode == 'r' && is_lammps_multiple_files(path)) {
+        format = "LAMMPS Multi";
+    } else {
+        auto registered_format = FormatFactory::get().by_extension(extension);
+        format = std::string(registered_format.metadata.name);
+    }
 
     if (!compression.empty()) {
         format += " / " + compression;
@@ -118,3 +127,9 @@ static optional<std::string> distinguish_cif_variants(
         return nullopt;
     }
 }
+
+static bool is_lammps_multiple_files(const std::string& path) {
+    auto separator = path.find_last_of("/\\");
+    auto name = separator == std::string::npos ? path : path.substr(separator + 1);
+    return name.find_first_of("*%") != std::string::npos;
+}
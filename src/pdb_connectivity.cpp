@@ -12,256 +12,348 @@ using namespace chemfiles;
 // A, ALA, ARG, ASN, ASP, C, CYS, DA, DC, DG, DT, G, GLN, GLU, GLY, HIS, 
 // ILE, LEU, LYS, MET, PHE, PRO, SER, THR, TRP, TYR, U, VAL, 
 
-const std::vector<std::string> InternedName::INTERNER_ = {
-    "P", "HOP3", "OP3", "OP1", "OP2", "O5'", "HOP2", "C5'", "C4'", "H5'", 
-    "H5''", "O4'", "C3'", "H4'", "C1'", "O3'", "C2'", "H3'", "HO3'", "O2'", 
-    "H2'", "HO2'", "N9", "H1'", "C8", "C4", "N7", "H8", "C5", "C6", "N6", 
-    "N1", "H61", "H62", "C2", "N3", "H2", "CA", "H", "N", "C", "CB", "HA", 
-    "O", "OXT", "HB1", "HB2", "HB3", "HXT", "CG", "CD", "HG2", "HG3", "NE", 
-    "HD2", "HD3", "CZ", "HE", "NH1", "NH2", "HH11", "HH12", "HH21", "HH22", 
-    "OD1", "ND2", "HD21", "HD22", "OD2", "O2", "N4", "H41", "H42", "H5", 
-    "H6", "SG", "HG", "H2''", "O6", "H1", "N2", "H21", "H22", "H3", "O4", 
-    "C7", "H71", "H72", "H73", "OE1", "NE2", "HE21", "HE22", "OE2", "HE2", 
-    "HA2", "HA3", "ND1", "CD2", "CE1", "HD1", "HE1", "CG1", "CG2", "HB", 
-    "CD1", "HG12", "HG13", "HG21", "HG22", "HG23", "HD11", "HD12", "HD13", 
-    "HD23", "CE", "NZ", "HE3", "HZ1", "HZ2", "HZ3", "SD", "CE2", "HZ", "OG", 
-    "OG1", "HG1", "NE1", "CE3", "CZ2", "CZ3", "CH2", "HH2", "OH", "HH", "HG11", 
-};
-
-
-const PDBConnectivity::PDBConnectMap PDBConnectivity::PDB_CONNECTIVITY_MAP_ = {
-    {"A", {
-        {0, 2}, {0, 3}, {0, 4}, {0, 5}, {1, 2}, {2, 0}, {2, 1}, {3, 0}, {4, 0}, 
-        {4, 6}, {5, 0}, {5, 7}, {6, 4}, {7, 5}, {7, 8}, {7, 9}, {7, 10}, 
-        {8, 7}, {8, 11}, {8, 12}, {8, 13}, {9, 7}, {10, 7}, {11, 8}, {11, 14}, 
-        {12, 8}, {12, 15}, {12, 16}, {12, 17}, {13, 8}, {14, 11}, {14, 16}, 
-        {14, 22}, {14, 23}, {15, 12}, {15, 18}, {16, 12}, {16, 19}, {16, 14}, 
-        {16, 20}, {17, 12}, {18, 15}, {19, 16}, {19, 21}, {20, 16}, {21, 19}, 
-        {22, 14}, {22, 24}, {22, 25}, {23, 14}, {24, 22}, {24, 26}, {24, 27}, 
-        {25, 22}, {25, 28}, {25, 35}, {26, 24}, {26, 28}, {27, 24}, {28, 26}, 
-        {28, 29}, {28, 25}, {29, 28}, {29, 30}, {29, 31}, {30, 29}, {30, 32}, 
-        {30, 33}, {31, 29}, {31, 34}, {32, 30}, {33, 30}, {34, 31}, {34, 35}, 
-        {34, 36}, {35, 34}, {35, 25}, {36, 34},     }},
-    {"ALA", {
-        {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, {39, 37}, 
-        {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, {41, 45}, 
-        {41, 46}, {41, 47}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, {45, 41}, 
-        {46, 41}, {47, 41}, {48, 44},     }},
-    {"ARG", {
-        {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, {39, 37}, 
-        {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, {41, 49}, 
-        {41, 46}, {41, 47}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, {46, 41}, 
-        {47, 41}, {48, 44}, {49, 41}, {49, 50}, {49, 51}, {49, 52}, {50, 49}, 
-        {50, 53}, {50, 54}, {50, 55}, {51, 49}, {52, 49}, {53, 50}, {53, 56}, 
-        {53, 57}, {54, 50}, {55, 50}, {56, 53}, {56, 58}, {56, 59}, {57, 53}, 
-        {58, 56}, {58, 60}, {58, 61}, {59, 56}, {59, 62}, {59, 63}, {60, 58}, 
-        {61, 58}, {62, 59}, {63, 59},     }},
-    {"ASN", {
-        {64, 49}, {65, 49}, {65, 66}, {65, 67}, {66, 65}, {67, 65}, {36, 39}, 
-        {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, {39, 37}, {39, 38}, 
-        {39, 36}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, {41, 49}, {41, 46}, 
-        {41, 47}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, {46, 41}, {47, 41}, 
-        {48, 44}, {49, 41}, {49, 64}, {49, 65},     }},
-    {"ASP", {
-        {64, 49}, {68, 49}, {68, 54}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, 
-        {38, 39}, {39, 37}, {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, 
-        {41, 37}, {41, 49}, {41, 46}, {41, 47}, {42, 37}, {43, 40}, {44, 40}, 
-        {44, 48}, {46, 41}, {47, 41}, {48, 44}, {49, 41}, {49, 64}, {49, 68}, 
-        {54, 68}, {36, 39},     }},
-    {"C", {
-        {0, 2}, {0, 3}, {0, 4}, {0, 5}, {1, 2}, {2, 0}, {2, 1}, {3, 0}, {4, 0}, 
-        {4, 6}, {5, 0}, {5, 7}, {6, 4}, {7, 5}, {7, 8}, {7, 9}, {7, 10}, 
-        {8, 7}, {8, 11}, {8, 12}, {8, 13}, {9, 7}, {10, 7}, {11, 8}, {11, 14}, 
-        {12, 8}, {12, 15}, {12, 16}, {12, 17}, {13, 8}, {14, 11}, {14, 16}, 
-        {14, 31}, {14, 23}, {15, 12}, {15, 18}, {16, 12}, {16, 19}, {16, 14}, 
-        {16, 20}, {17, 12}, {18, 15}, {19, 16}, {19, 21}, {20, 16}, {21, 19}, 
-        {23, 14}, {25, 35}, {25, 70}, {25, 28}, {28, 25}, {28, 29}, {28, 73}, 
-        {29, 31}, {29, 28}, {29, 74}, {31, 14}, {31, 34}, {31, 29}, {34, 31}, 
-        {34, 69}, {34, 35}, {35, 34}, {35, 25}, {69, 34}, {70, 25}, {70, 71}, 
-        {70, 72}, {71, 70}, {72, 70}, {73, 28}, {74, 29},     }},
-    {"CYS", {
-        {48, 44}, {43, 40}, {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, 
-        {38, 39}, {39, 37}, {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, 
-        {41, 37}, {41, 75}, {41, 46}, {41, 47}, {42, 37}, {75, 41}, {75, 76}, 
-        {44, 40}, {44, 48}, {46, 41}, {47, 41}, {76, 75},     }},
-    {"DA", {
-        {0, 2}, {0, 3}, {0, 4}, {0, 5}, {1, 2}, {2, 0}, {2, 1}, {3, 0}, {4, 0}, 
-        {4, 6}, {5, 0}, {5, 7}, {6, 4}, {7, 5}, {7, 8}, {7, 9}, {7, 10}, 
-        {8, 7}, {8, 11}, {8, 12}, {8, 13}, {9, 7}, {10, 7}, {11, 8}, {11, 14}, 
-        {12, 8}, {12, 15}, {12, 16}, {12, 17}, {13, 8}, {14, 11}, {14, 16}, 
-        {14, 22}, {14, 23}, {15, 12}, {15, 18}, {16, 12}, {16, 14}, {16, 20}, 
-        {16, 77}, {17, 12}, {18, 15}, {20, 16}, {22, 14}, {22, 24}, {22, 25}, 
-        {23, 14}, {24, 22}, {24, 26}, {24, 27}, {25, 22}, {25, 28}, {25, 35}, 
-        {26, 24}, {26, 28}, {27, 24}, {28, 26}, {28, 29}, {28, 25}, {29, 28}, 
-        {29, 30}, {29, 31}, {30, 29}, {30, 32}, {30, 33}, {31, 29}, {31, 34}, 
-        {32, 30}, {33, 30}, {34, 31}, {34, 35}, {34, 36}, {35, 34}, {35, 25}, 
-        {36, 34}, {77, 16},     }},
-    {"DC", {
-        {0, 2}, {0, 3}, {0, 4}, {0, 5}, {1, 2}, {2, 0}, {2, 1}, {3, 0}, {4, 0}, 
-        {4, 6}, {5, 0}, {5, 7}, {6, 4}, {7, 5}, {7, 8}, {7, 9}, {7, 10}, 
-        {8, 7}, {8, 11}, {8, 12}, {8, 13}, {9, 7}, {10, 7}, {11, 8}, {11, 14}, 
-        {12, 8}, {12, 15}, {12, 16}, {12, 17}, {13, 8}, {14, 11}, {14, 16}, 
-        {14, 31}, {14, 23}, {15, 12}, {15, 18}, {16, 12}, {16, 14}, {16, 20}, 
-        {16, 77}, {17, 12}, {18, 15}, {20, 16}, {23, 14}, {25, 35}, {25, 70}, 
-        {25, 28}, {28, 25}, {28, 29}, {28, 73}, {29, 31}, {29, 28}, {29, 74}, 
-        {31, 14}, {31, 34}, {31, 29}, {34, 31}, {34, 69}, {34, 35}, {35, 34}, 
-        {35, 25}, {69, 34}, {70, 25}, {70, 71}, {70, 72}, {71, 70}, {72, 70}, 
-        {73, 28}, {74, 29}, {77, 16},     }},
-    {"DG", {
-        {0, 2}, {0, 3}, {0, 4}, {0, 5}, {1, 2}, {2, 0}, {2, 1}, {3, 0}, {4, 0}, 
-        {4, 6}, {5, 0}, {5, 7}, {6, 4}, {7, 5}, {7, 8}, {7, 9}, {7, 10}, 
-        {8, 7}, {8, 11}, {8, 12}, {8, 13}, {9, 7}, {10, 7}, {11, 8}, {11, 14}, 
-        {12, 8}, {12, 15}, {12, 16}, {12, 17}, {13, 8}, {14, 11}, {14, 16}, 
-        {14, 22}, {14, 23}, {15, 12}, {15, 18}, {16, 12}, {16, 14}, {16, 20}, 
-        {16, 77}, {17, 12}, {18, 15}, {20, 16}, {22, 14}, {22, 24}, {22, 25}, 
-        {23, 14}, {24, 22}, {24, 26}, {24, 27}, {25, 22}, {25, 28}, {25, 35}, 
-        {26, 24}, {26, 28}, {27, 24}, {28, 26}, {28, 29}, {28, 25}, {29, 28}, 
-        {29, 78}, {29, 31}, {31, 29}, {31, 34}, {31, 79}, {34, 31}, {34, 80}, 
-        {34, 35}, {35, 34}, {35, 25}, {77, 16}, {78, 29}, {79, 31}, {80, 34}, 
-        {80, 81}, {80, 82}, {81, 80}, {82, 80},     }},
-    {"DT", {
-        {0, 2}, {0, 3}, {0, 4}, {0, 5}, {1, 2}, {2, 0}, {2, 1}, {3, 0}, {4, 0}, 
-        {4, 6}, {5, 0}, {5, 7}, {6, 4}, {7, 5}, {7, 8}, {7, 9}, {7, 10}, 
-        {8, 7}, {8, 11}, {8, 12}, {8, 13}, {9, 7}, {10, 7}, {11, 8}, {11, 14}, 
-        {12, 8}, {12, 15}, {12, 16}, {12, 17}, {13, 8}, {14, 11}, {14, 16}, 
-        {14, 31}, {14, 23}, {15, 12}, {15, 18}, {16, 12}, {16, 14}, {16, 20}, 
-        {16, 77}, {17, 12}, {18, 15}, {20, 16}, {23, 14}, {25, 35}, {25, 84}, 
-        {25, 28}, {28, 25}, {28, 85}, {28, 29}, {29, 31}, {29, 28}, {29, 74}, 
-        {31, 14}, {31, 34}, {31, 29}, {34, 31}, {34, 69}, {34, 35}, {35, 34}, 
-        {35, 25}, {35, 83}, {69, 34}, {74, 29}, {77, 16}, {83, 35}, {84, 25}, 
-        {85, 28}, {85, 86}, {85, 87}, {85, 88}, {86, 85}, {87, 85}, {88, 85}, 
-    }},
-    {"G", {
-        {0, 2}, {0, 3}, {0, 4}, {0, 5}, {1, 2}, {2, 0}, {2, 1}, {3, 0}, {4, 0}, 
-        {4, 6}, {5, 0}, {5, 7}, {6, 4}, {7, 5}, {7, 8}, {7, 9}, {7, 10}, 
-        {8, 7}, {8, 11}, {8, 12}, {8, 13}, {9, 7}, {10, 7}, {11, 8}, {11, 14}, 
-        {12, 8}, {12, 15}, {12, 16}, {12, 17}, {13, 8}, {14, 11}, {14, 16}, 
-        {14, 22}, {14, 23}, {15, 12}, {15, 18}, {16, 12}, {16, 19}, {16, 14}, 
-        {16, 20}, {17, 12}, {18, 15}, {19, 16}, {19, 21}, {20, 16}, {21, 19}, 
-        {22, 14}, {22, 24}, {22, 25}, {23, 14}, {24, 22}, {24, 26}, {24, 27}, 
-        {25, 22}, {25, 28}, {25, 35}, {26, 24}, {26, 28}, {27, 24}, {28, 26}, 
-        {28, 29}, {28, 25}, {29, 28}, {29, 78}, {29, 31}, {31, 29}, {31, 34}, 
-        {31, 79}, {34, 31}, {34, 80}, {34, 35}, {35, 34}, {35, 25}, {78, 29}, 
-        {79, 31}, {80, 34}, {80, 81}, {80, 82}, {81, 80}, {82, 80},     }},
-    {"GLN", {
-        {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, {39, 37}, 
-        {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, {41, 49}, 
-        {41, 46}, {41, 47}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, {46, 41}, 
-        {47, 41}, {48, 44}, {49, 41}, {49, 50}, {49, 51}, {49, 52}, {50, 49}, 
-        {50, 89}, {50, 90}, {51, 49}, {52, 49}, {89, 50}, {90, 50}, {90, 91}, 
-        {90, 92}, {91, 90}, {92, 90},     }},
-    {"GLU", {
-        {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, {39, 37}, 
-        {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, {41, 49}, 
-        {41, 46}, {41, 47}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, {46, 41}, 
-        {47, 41}, {48, 44}, {49, 41}, {49, 50}, {49, 51}, {49, 52}, {50, 49}, 
-        {50, 89}, {50, 93}, {51, 49}, {52, 49}, {89, 50}, {93, 50}, {93, 94}, 
-        {94, 93},     }},
-    {"GLY", {
-        {96, 37}, {36, 39}, {37, 39}, {37, 40}, {37, 95}, {37, 96}, {38, 39}, 
-        {39, 37}, {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, {43, 40}, 
-        {44, 40}, {44, 48}, {48, 44}, {95, 37},     }},
-    {"HIS", {
-        {97, 49}, {97, 99}, {97, 100}, {98, 49}, {98, 90}, {98, 54}, {99, 97}, 
-        {99, 90}, {99, 101}, {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, 
-        {38, 39}, {39, 37}, {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, 
-        {41, 37}, {41, 49}, {41, 46}, {41, 47}, {42, 37}, {43, 40}, {44, 40}, 
-        {44, 48}, {46, 41}, {47, 41}, {48, 44}, {49, 41}, {49, 97}, {49, 98}, 
-        {54, 98}, {100, 97}, {90, 98}, {90, 99}, {90, 94}, {94, 90}, {101, 99}, 
-    }},
-    {"ILE", {
-        {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, {39, 37}, 
-        {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, {41, 102}, 
-        {41, 103}, {41, 104}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, {48, 44}, 
-        {102, 41}, {102, 105}, {102, 106}, {102, 107}, {103, 41}, {103, 108}, 
-        {103, 109}, {103, 110}, {104, 41}, {105, 102}, {105, 111}, {105, 112}, 
-        {105, 113}, {106, 102}, {107, 102}, {108, 103}, {109, 103}, {110, 103}, 
-        {111, 105}, {112, 105}, {113, 105},     }},
-    {"LEU", {
-        {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, {39, 37}, 
-        {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, {41, 49}, 
-        {41, 46}, {41, 47}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, {46, 41}, 
-        {47, 41}, {48, 44}, {49, 41}, {49, 105}, {49, 98}, {49, 76}, {66, 98}, 
-        {67, 98}, {76, 49}, {98, 49}, {98, 66}, {98, 67}, {98, 114}, {105, 49}, 
-        {105, 111}, {105, 112}, {105, 113}, {111, 105}, {112, 105}, {113, 105}, 
-        {114, 98},     }},
-    {"LYS", {
-        {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, {39, 37}, 
-        {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, {41, 49}, 
-        {41, 46}, {41, 47}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, {46, 41}, 
-        {47, 41}, {48, 44}, {49, 41}, {49, 50}, {49, 51}, {49, 52}, {50, 49}, 
-        {50, 115}, {50, 54}, {50, 55}, {51, 49}, {52, 49}, {54, 50}, {55, 50}, 
-        {94, 115}, {115, 50}, {115, 116}, {115, 94}, {115, 117}, {116, 115}, 
-        {116, 118}, {116, 119}, {116, 120}, {117, 115}, {118, 116}, {119, 116}, 
-        {120, 116},     }},
-    {"MET", {
-        {51, 49}, {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, 
-        {39, 37}, {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, 
-        {41, 49}, {41, 46}, {41, 47}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, 
-        {46, 41}, {47, 41}, {48, 44}, {49, 41}, {49, 121}, {49, 51}, {49, 52}, 
-        {115, 121}, {115, 101}, {115, 94}, {115, 117}, {52, 49}, {117, 115}, 
-        {121, 49}, {121, 115}, {94, 115}, {101, 115},     }},
-    {"PHE", {
-        {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, {39, 37}, 
-        {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, {41, 49}, 
-        {41, 46}, {41, 47}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, {46, 41}, 
-        {47, 41}, {48, 44}, {49, 41}, {49, 105}, {49, 98}, {54, 98}, {56, 99}, 
-        {56, 122}, {56, 123}, {94, 122}, {98, 49}, {98, 122}, {98, 54}, {99, 105}, 
-        {99, 56}, {99, 101}, {100, 105}, {101, 99}, {105, 49}, {105, 99}, 
-        {105, 100}, {122, 98}, {122, 56}, {122, 94}, {123, 56},     }},
-    {"PRO", {
-        {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, {39, 37}, {39, 50}, 
-        {39, 38}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, {41, 49}, {41, 46}, 
-        {41, 47}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, {46, 41}, {47, 41}, 
-        {48, 44}, {49, 41}, {49, 50}, {49, 51}, {49, 52}, {50, 39}, {50, 49}, 
-        {50, 54}, {50, 55}, {51, 49}, {52, 49}, {54, 50}, {55, 50},     }},
-    {"SER", {
-        {48, 44}, {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, 
-        {39, 37}, {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, 
-        {41, 124}, {41, 46}, {41, 47}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, 
-        {46, 41}, {47, 41}, {76, 124}, {124, 41}, {124, 76},     }},
-    {"THR", {
-        {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, {39, 37}, 
-        {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, {41, 125}, 
-        {41, 103}, {41, 104}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, {109, 103}, 
-        {110, 103}, {48, 44}, {104, 41}, {108, 103}, {103, 41}, {103, 108}, 
-        {103, 109}, {103, 110}, {125, 41}, {125, 126}, {126, 125},     }},
-    {"TRP", {
-        {128, 98}, {128, 130}, {128, 117}, {129, 122}, {129, 131}, {129, 119}, 
-        {130, 128}, {130, 131}, {130, 120}, {131, 129}, {131, 130}, {131, 132}, 
-        {132, 131}, {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, {38, 39}, 
-        {39, 37}, {39, 38}, {39, 36}, {40, 37}, {40, 43}, {40, 44}, {41, 37}, 
-        {41, 49}, {41, 46}, {41, 47}, {42, 37}, {43, 40}, {44, 40}, {44, 48}, 
-        {46, 41}, {47, 41}, {48, 44}, {49, 41}, {49, 105}, {49, 98}, {98, 49}, 
-        {98, 122}, {98, 128}, {100, 105}, {101, 127}, {105, 49}, {105, 127}, 
-        {105, 100}, {117, 128}, {119, 129}, {120, 130}, {122, 98}, {122, 127}, 
-        {122, 129}, {127, 105}, {127, 122}, {127, 101},     }},
-    {"TYR", {
-        {133, 56}, {133, 134}, {134, 133}, {36, 39}, {37, 39}, {37, 40}, 
-        {37, 41}, {37, 42}, {38, 39}, {39, 37}, {39, 38}, {39, 36}, {40, 37}, 
-        {40, 43}, {40, 44}, {41, 37}, {41, 49}, {41, 46}, {41, 47}, {42, 37}, 
-        {43, 40}, {44, 40}, {44, 48}, {46, 41}, {47, 41}, {48, 44}, {49, 41}, 
-        {49, 105}, {49, 98}, {54, 98}, {56, 99}, {56, 122}, {56, 133}, {94, 122}, 
-        {98, 49}, {98, 122}, {98, 54}, {99, 105}, {99, 56}, {99, 101}, {100, 105}, 
-        {101, 99}, {105, 49}, {105, 99}, {105, 100}, {122, 98}, {122, 56}, 
-        {122, 94},     }},
-    {"U", {
-        {0, 2}, {0, 3}, {0, 4}, {0, 5}, {1, 2}, {2, 0}, {2, 1}, {3, 0}, {4, 0}, 
-        {4, 6}, {5, 0}, {5, 7}, {6, 4}, {7, 5}, {7, 8}, {7, 9}, {7, 10}, 
-        {8, 7}, {8, 11}, {8, 12}, {8, 13}, {9, 7}, {10, 7}, {11, 8}, {11, 14}, 
-        {12, 8}, {12, 15}, {12, 16}, {12, 17}, {13, 8}, {14, 11}, {14, 16}, 
-        {14, 31}, {14, 23}, {15, 12}, {15, 18}, {16, 12}, {16, 19}, {16, 14}, 
-        {16, 20}, {17, 12}, {18, 15}, {19, 16}, {19, 21}, {20, 16}, {21, 19}, 
-        {23, 14}, {25, 35}, {25, 84}, {25, 28}, {28, 25}, {28, 29}, {28, 73}, 
-        {29, 31}, {29, 28}, {29, 74}, {31, 14}, {31, 34}, {31, 29}, {34, 31}, 
-        {34, 69}, {34, 35}, {35, 34}, {35, 25}, {35, 83}, {69, 34}, {73, 28}, 
-        {74, 29}, {83, 35}, {84, 25},     }},
-    {"VAL", {
-        {107, 102}, {36, 39}, {37, 39}, {37, 40}, {37, 41}, {37, 42}, {102, 41}, 
-        {102, 135}, {102, 106}, {102, 107}, {39, 37}, {39, 38}, {39, 36}, 
-        {40, 37}, {40, 43}, {40, 44}, {41, 37}, {41, 102}, {41, 103}, {41, 104}, 
-        {42, 37}, {43, 40}, {44, 40}, {44, 48}, {109, 103}, {38, 39}, {48, 44}, 
-        {104, 41}, {110, 103}, {108, 103}, {103, 41}, {103, 108}, {103, 109}, 
-        {103, 110}, {135, 102}, {106, 102},     }},
+namespace {
+const char* const ATOMS_A[] = {
+    "C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C8", "H1'", 
+    "H2", "H2'", "H3'", "H4'", "H5'", "H5''", "H61", "H62", "H8", "HO2'", 
+    "HO3'", "HOP2", "HOP3", "N1", "N3", "N6", "N7", "N9", "O2'", "O3'", "O4'", 
+    "O5'", "OP1", "OP2", "OP3", "P", 
+};
+const ResidueTemplate::Bond BONDS_A[] = {
+    {0, 2}, {0, 10}, {0, 28}, {0, 31}, {1, 11}, {1, 24}, {1, 25}, {2, 3}, 
+    {2, 12}, {2, 29}, {3, 5}, {3, 13}, {3, 30}, {4, 6}, {4, 25}, {4, 28}, 
+    {5, 7}, {5, 14}, {5, 31}, {6, 8}, {6, 27}, {7, 15}, {7, 16}, {7, 32}, 
+    {8, 24}, {8, 26}, {9, 19}, {9, 27}, {9, 28}, {17, 26}, {18, 26}, {20, 29}, 
+    {21, 30}, {22, 34}, {23, 35}, {32, 36}, {33, 36}, {34, 36}, {35, 36}, 
+};
+
+const char* const ATOMS_ALA[] = {
+    "C", "CA", "CB", "H", "H2", "HA", "HB1", "HB2", "HB3", "HXT", "N", "O", 
+    "OXT", 
+};
+const ResidueTemplate::Bond BONDS_ALA[] = {
+    {0, 1}, {0, 11}, {0, 12}, {1, 2}, {1, 5}, {1, 10}, {2, 6}, {2, 7}, {2, 8}, 
+    {3, 10}, {4, 10}, {9, 12}, 
+};
+
+const char* const ATOMS_ARG[] = {
+    "C", "CA", "CB", "CD", "CG", "CZ", "H", "H2", "HA", "HB2", "HB3", "HD2", 
+    "HD3", "HE", "HG2", "HG3", "HH11", "HH12", "HH21", "HH22", "HXT", "N", 
+    "NE", "NH1", "NH2", "O", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_ARG[] = {
+    {0, 1}, {0, 25}, {0, 26}, {1, 2}, {1, 8}, {1, 21}, {2, 4}, {2, 9}, {2, 10}, 
+    {3, 4}, {3, 11}, {3, 12}, {3, 22}, {4, 14}, {4, 15}, {5, 22}, {5, 23}, 
+    {5, 24}, {6, 21}, {7, 21}, {13, 22}, {16, 23}, {17, 23}, {18, 24}, {19, 24}, 
+    {20, 26}, 
+};
+
+const char* const ATOMS_ASN[] = {
+    "C", "CA", "CB", "CG", "H", "H2", "HA", "HB2", "HB3", "HD21", "HD22", 
+    "HXT", "N", "ND2", "O", "OD1", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_ASN[] = {
+    {0, 1}, {0, 14}, {0, 16}, {1, 2}, {1, 6}, {1, 12}, {2, 3}, {2, 7}, {2, 8}, 
+    {3, 13}, {3, 15}, {4, 12}, {5, 12}, {9, 13}, {10, 13}, {11, 16}, 
+};
+
+const char* const ATOMS_ASP[] = {
+    "C", "CA", "CB", "CG", "H", "H2", "HA", "HB2", "HB3", "HD2", "HXT", "N", 
+    "O", "OD1", "OD2", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_ASP[] = {
+    {0, 1}, {0, 12}, {0, 15}, {1, 2}, {1, 6}, {1, 11}, {2, 3}, {2, 7}, {2, 8}, 
+    {3, 13}, {3, 14}, {4, 11}, {5, 11}, {9, 14}, {10, 15}, 
+};
+
+const char* const ATOMS_C[] = {
+    "C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "H1'", "H2'", 
+    "H3'", "H4'", "H41", "H42", "H5", "H5'", "H5''", "H6", "HO2'", "HO3'", 
+    "HOP2", "HOP3", "N1", "N3", "N4", "O2", "O2'", "O3'", "O4'", "O5'", "OP1", 
+    "OP2", "OP3", "P", 
+};
+const ResidueTemplate::Bond BONDS_C[] = {
+    {0, 2}, {0, 9}, {0, 23}, {0, 29}, {1, 23}, {1, 24}, {1, 26}, {2, 3}, 
+    {2, 10}, {2, 27}, {3, 5}, {3, 11}, {3, 28}, {4, 6}, {4, 24}, {4, 25}, 
+    {5, 7}, {5, 12}, {5, 29}, {6, 8}, {6, 15}, {7, 16}, {7, 17}, {7, 30}, 
+    {8, 18}, {8, 23}, {13, 25}, {14, 25}, {19, 27}, {20, 28}, {21, 32}, {22, 33}, 
+    {30, 34}, {31, 34}, {32, 34}, {33, 34}, 
+};
+
+const char* const ATOMS_CYS[] = {
+    "C", "CA", "CB", "H", "H2", "HA", "HB2", "HB3", "HG", "HXT", "N", "O", 
+    "OXT", "SG", 
+};
+const ResidueTemplate::Bond BONDS_CYS[] = {
+    {0, 1}, {0, 11}, {0, 12}, {1, 2}, {1, 5}, {1, 10}, {2, 6}, {2, 7}, {2, 13}, 
+    {3, 10}, {4, 10}, {8, 13}, {9, 12}, 
+};
+
+const char* const ATOMS_DA[] = {
+    "C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C8", "H1'", 
+    "H2", "H2'", "H2''", "H3'", "H4'", "H5'", "H5''", "H61", "H62", "H8", 
+    "HO3'", "HOP2", "HOP3", "N1", "N3", "N6", "N7", "N9", "O3'", "O4'", "O5'", 
+    "OP1", "OP2", "OP3", "P", 
+};
+const ResidueTemplate::Bond BONDS_DA[] = {
+    {0, 2}, {0, 10}, {0, 28}, {0, 30}, {1, 11}, {1, 24}, {1, 25}, {2, 3}, 
+    {2, 12}, {2, 13}, {3, 5}, {3, 14}, {3, 29}, {4, 6}, {4, 25}, {4, 28}, 
+    {5, 7}, {5, 15}, {5, 30}, {6, 8}, {6, 27}, {7, 16}, {7, 17}, {7, 31}, 
+    {8, 24}, {8, 26}, {9, 20}, {9, 27}, {9, 28}, {18, 26}, {19, 26}, {21, 29}, 
+    {22, 33}, {23, 34}, {31, 35}, {32, 35}, {33, 35}, {34, 35}, 
+};
+
+const char* const ATOMS_DC[] = {
+    "C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "H1'", "H2'", 
+    "H2''", "H3'", "H4'", "H41", "H42", "H5", "H5'", "H5''", "H6", "HO3'", 
+    "HOP2", "HOP3", "N1", "N3", "N4", "O2", "O3'", "O4'", "O5'", "OP1", "OP2", 
+    "OP3", "P", 
+};
+const ResidueTemplate::Bond BONDS_DC[] = {
+    {0, 2}, {0, 9}, {0, 23}, {0, 28}, {1, 23}, {1, 24}, {1, 26}, {2, 3}, 
+    {2, 10}, {2, 11}, {3, 5}, {3, 12}, {3, 27}, {4, 6}, {4, 24}, {4, 25}, 
+    {5, 7}, {5, 13}, {5, 28}, {6, 8}, {6, 16}, {7, 17}, {7, 18}, {7, 29}, 
+    {8, 19}, {8, 23}, {14, 25}, {15, 25}, {20, 27}, {21, 31}, {22, 32}, {29, 33}, 
+    {30, 33}, {31, 33}, {32, 33}, 
+};
+
+const char* const ATOMS_DG[] = {
+    "C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C8", "H1", 
+    "H1'", "H2'", "H2''", "H21", "H22", "H3'", "H4'", "H5'", "H5''", "H8", 
+    "HO3'", "HOP2", "HOP3", "N1", "N2", "N3", "N7", "N9", "O3'", "O4'", "O5'", 
+    "O6", "OP1", "OP2", "OP3", "P", 
+};
+const ResidueTemplate::Bond BONDS_DG[] = {
+    {0, 2}, {0, 11}, {0, 28}, {0, 30}, {1, 24}, {1, 25}, {1, 26}, {2, 3}, 
+    {2, 12}, {2, 13}, {3, 5}, {3, 16}, {3, 29}, {4, 6}, {4, 26}, {4, 28}, 
+    {5, 7}, {5, 17}, {5, 30}, {6, 8}, {6, 27}, {7, 18}, {7, 19}, {7, 31}, 
+    {8, 24}, {8, 32}, {9, 20}, {9, 27}, {9, 28}, {10, 24}, {14, 25}, {15, 25}, 
+    {21, 29}, {22, 34}, {23, 35}, {31, 36}, {33, 36}, {34, 36}, {35, 36}, 
+};
+
+const char* const ATOMS_DT[] = {
+    "C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C7", "H1'", 
+    "H2'", "H2''", "H3", "H3'", "H4'", "H5'", "H5''", "H6", "H71", "H72", 
+    "H73", "HO3'", "HOP2", "HOP3", "N1", "N3", "O2", "O3'", "O4", "O4'", 
+    "O5'", "OP1", "OP2", "OP3", "P", 
+};
+const ResidueTemplate::Bond BONDS_DT[] = {
+    {0, 2}, {0, 10}, {0, 25}, {0, 30}, {1, 25}, {1, 26}, {1, 27}, {2, 3}, 
+    {2, 11}, {2, 12}, {3, 5}, {3, 14}, {3, 28}, {4, 6}, {4, 26}, {4, 29}, 
+    {5, 7}, {5, 15}, {5, 30}, {6, 8}, {6, 9}, {7, 16}, {7, 17}, {7, 31}, 
+    {8, 18}, {8, 25}, {9, 19}, {9, 20}, {9, 21}, {13, 26}, {22, 28}, {23, 33}, 
+    {24, 34}, {31, 35}, {32, 35}, {33, 35}, {34, 35}, 
+};
+
+const char* const ATOMS_G[] = {
+    "C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C8", "H1", 
+    "H1'", "H2'", "H21", "H22", "H3'", "H4'", "H5'", "H5''", "H8", "HO2'", 
+    "HO3'", "HOP2", "HOP3", "N1", "N2", "N3", "N7", "N9", "O2'", "O3'", "O4'", 
+    "O5'", "O6", "OP1", "OP2", "OP3", "P", 
+};
+const ResidueTemplate::Bond BONDS_G[] = {
+    {0, 2}, {0, 11}, {0, 28}, {0, 31}, {1, 24}, {1, 25}, {1, 26}, {2, 3}, 
+    {2, 12}, {2, 29}, {3, 5}, {3, 15}, {3, 30}, {4, 6}, {4, 26}, {4, 28}, 
+    {5, 7}, {5, 16}, {5, 31}, {6, 8}, {6, 27}, {7, 17}, {7, 18}, {7, 32}, 
+    {8, 24}, {8, 33}, {9, 19}, {9, 27}, {9, 28}, {10, 24}, {13, 25}, {14, 25}, 
+    {20, 29}, {21, 30}, {22, 35}, {23, 36}, {32, 37}, {34, 37}, {35, 37}, 
+    {36, 37}, 
+};
+
+const char* const ATOMS_GLN[] = {
+    "C", "CA", "CB", "CD", "CG", "H", "H2", "HA", "HB2", "HB3", "HE21", "HE22", 
+    "HG2", "HG3", "HXT", "N", "NE2", "O", "OE1", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_GLN[] = {
+    {0, 1}, {0, 17}, {0, 19}, {1, 2}, {1, 7}, {1, 15}, {2, 4}, {2, 8}, {2, 9}, 
+    {3, 4}, {3, 16}, {3, 18}, {4, 12}, {4, 13}, {5, 15}, {6, 15}, {10, 16}, 
+    {11, 16}, {14, 19}, 
+};
+
+const char* const ATOMS_GLU[] = {
+    "C", "CA", "CB", "CD", "CG", "H", "H2", "HA", "HB2", "HB3", "HE2", "HG2", 
+    "HG3", "HXT", "N", "O", "OE1", "OE2", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_GLU[] = {
+    {0, 1}, {0, 15}, {0, 18}, {1, 2}, {1, 7}, {1, 14}, {2, 4}, {2, 8}, {2, 9}, 
+    {3, 4}, {3, 16}, {3, 17}, {4, 11}, {4, 12}, {5, 14}, {6, 14}, {10, 17}, 
+    {13, 18}, 
+};
+
+const char* const ATOMS_GLY[] = {
+    "C", "CA", "H", "H2", "HA2", "HA3", "HXT", "N", "O", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_GLY[] = {
+    {0, 1}, {0, 8}, {0, 9}, {1, 4}, {1, 5}, {1, 7}, {2, 7}, {3, 7}, {6, 9}, 
+};
+
+const char* const ATOMS_HIS[] = {
+    "C", "CA", "CB", "CD2", "CE1", "CG", "H", "H2", "HA", "HB2", "HB3", "HD1", 
+    "HD2", "HE1", "HE2", "HXT", "N", "ND1", "NE2", "O", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_HIS[] = {
+    {0, 1}, {0, 19}, {0, 20}, {1, 2}, {1, 8}, {1, 16}, {2, 5}, {2, 9}, {2, 10}, 
+    {3, 5}, {3, 12}, {3, 18}, {4, 13}, {4, 17}, {4, 18}, {5, 17}, {6, 16}, 
+    {7, 16}, {11, 17}, {14, 18}, {15, 20}, 
+};
+
+const char* const ATOMS_ILE[] = {
+    "C", "CA", "CB", "CD1", "CG1", "CG2", "H", "H2", "HA", "HB", "HD11", 
+    "HD12", "HD13", "HG12", "HG13", "HG21", "HG22", "HG23", "HXT", "N", "O", 
+    "OXT", 
+};
+const ResidueTemplate::Bond BONDS_ILE[] = {
+    {0, 1}, {0, 20}, {0, 21}, {1, 2}, {1, 8}, {1, 19}, {2, 4}, {2, 5}, {2, 9}, 
+    {3, 4}, {3, 10}, {3, 11}, {3, 12}, {4, 13}, {4, 14}, {5, 15}, {5, 16}, 
+    {5, 17}, {6, 19}, {7, 19}, {18, 21}, 
+};
+
+const char* const ATOMS_LEU[] = {
+    "C", "CA", "CB", "CD1", "CD2", "CG", "H", "H2", "HA", "HB2", "HB3", "HD11", 
+    "HD12", "HD13", "HD21", "HD22", "HD23", "HG", "HXT", "N", "O", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_LEU[] = {
+    {0, 1}, {0, 20}, {0, 21}, {1, 2}, {1, 8}, {1, 19}, {2, 5}, {2, 9}, {2, 10}, 
+    {3, 5}, {3, 11}, {3, 12}, {3, 13}, {4, 5}, {4, 14}, {4, 15}, {4, 16}, 
+    {5, 17}, {6, 19}, {7, 19}, {18, 21}, 
+};
+
+const char* const ATOMS_LYS[] = {
+    "C", "CA", "CB", "CD", "CE", "CG", "H", "H2", "HA", "HB2", "HB3", "HD2", 
+    "HD3", "HE2", "HE3", "HG2", "HG3", "HXT", "HZ1", "HZ2", "HZ3", "N", "NZ", 
+    "O", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_LYS[] = {
+    {0, 1}, {0, 23}, {0, 24}, {1, 2}, {1, 8}, {1, 21}, {2, 5}, {2, 9}, {2, 10}, 
+    {3, 4}, {3, 5}, {3, 11}, {3, 12}, {4, 13}, {4, 14}, {4, 22}, {5, 15}, 
+    {5, 16}, {6, 21}, {7, 21}, {17, 24}, {18, 22}, {19, 22}, {20, 22}, 
+};
+
+const char* const ATOMS_MET[] = {
+    "C", "CA", "CB", "CE", "CG", "H", "H2", "HA", "HB2", "HB3", "HE1", "HE2", 
+    "HE3", "HG2", "HG3", "HXT", "N", "O", "OXT", "SD", 
+};
+const ResidueTemplate::Bond BONDS_MET[] = {
+    {0, 1}, {0, 17}, {0, 18}, {1, 2}, {1, 7}, {1, 16}, {2, 4}, {2, 8}, {2, 9}, 
+    {3, 10}, {3, 11}, {3, 12}, {3, 19}, {4, 13}, {4, 14}, {4, 19}, {5, 16}, 
+    {6, 16}, {15, 18}, 
+};
+
+const char* const ATOMS_PHE[] = {
+    "C", "CA", "CB", "CD1", "CD2", "CE1", "CE2", "CG", "CZ", "H", "H2", "HA", 
+    "HB2", "HB3", "HD1", "HD2", "HE1", "HE2", "HXT", "HZ", "N", "O", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_PHE[] = {
+    {0, 1}, {0, 21}, {0, 22}, {1, 2}, {1, 11}, {1, 20}, {2, 7}, {2, 12}, 
+    {2, 13}, {3, 5}, {3, 7}, {3, 14}, {4, 6}, {4, 7}, {4, 15}, {5, 8}, {5, 16}, 
+    {6, 8}, {6, 17}, {8, 19}, {9, 20}, {10, 20}, {18, 22}, 
+};
+
+const char* const ATOMS_PRO[] = {
+    "C", "CA", "CB", "CD", "CG", "H", "HA", "HB2", "HB3", "HD2", "HD3", "HG2", 
+    "HG3", "HXT", "N", "O", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_PRO[] = {
+    {0, 1}, {0, 15}, {0, 16}, {1, 2}, {1, 6}, {1, 14}, {2, 4}, {2, 7}, {2, 8}, 
+    {3, 4}, {3, 9}, {3, 10}, {3, 14}, {4, 11}, {4, 12}, {5, 14}, {13, 16}, 
+};
+
+const char* const ATOMS_SER[] = {
+    "C", "CA", "CB", "H", "H2", "HA", "HB2", "HB3", "HG", "HXT", "N", "O", 
+    "OG", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_SER[] = {
+    {0, 1}, {0, 11}, {0, 13}, {1, 2}, {1, 5}, {1, 10}, {2, 6}, {2, 7}, {2, 12}, 
+    {3, 10}, {4, 10}, {8, 12}, {9, 13}, 
+};
+
+const char* const ATOMS_THR[] = {
+    "C", "CA", "CB", "CG2", "H", "H2", "HA", "HB", "HG1", "HG21", "HG22", 
+    "HG23", "HXT", "N", "O", "OG1", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_THR[] = {
+    {0, 1}, {0, 14}, {0, 16}, {1, 2}, {1, 6}, {1, 13}, {2, 3}, {2, 7}, {2, 15}, 
+    {3, 9}, {3, 10}, {3, 11}, {4, 13}, {5, 13}, {8, 15}, {12, 16}, 
+};
+
+const char* const ATOMS_TRP[] = {
+    "C", "CA", "CB", "CD1", "CD2", "CE2", "CE3", "CG", "CH2", "CZ2", "CZ3", 
+    "H", "H2", "HA", "HB2", "HB3", "HD1", "HE1", "HE3", "HH2", "HXT", "HZ2", 
+    "HZ3", "N", "NE1", "O", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_TRP[] = {
+    {0, 1}, {0, 25}, {0, 26}, {1, 2}, {1, 13}, {1, 23}, {2, 7}, {2, 14}, 
+    {2, 15}, {3, 7}, {3, 16}, {3, 24}, {4, 5}, {4, 6}, {4, 7}, {5, 9}, {5, 24}, 
+    {6, 10}, {6, 18}, {8, 9}, {8, 10}, {8, 19}, {9, 21}, {10, 22}, {11, 23}, 
+    {12, 23}, {17, 24}, {20, 26}, 
+};
+
+const char* const ATOMS_TYR[] = {
+    "C", "CA", "CB", "CD1", "CD2", "CE1", "CE2", "CG", "CZ", "H", "H2", "HA", 
+    "HB2", "HB3", "HD1", "HD2", "HE1", "HE2", "HH", "HXT", "N", "O", "OH", 
+    "OXT", 
+};
+const ResidueTemplate::Bond BONDS_TYR[] = {
+    {0, 1}, {0, 21}, {0, 23}, {1, 2}, {1, 11}, {1, 20}, {2, 7}, {2, 12}, 
+    {2, 13}, {3, 5}, {3, 7}, {3, 14}, {4, 6}, {4, 7}, {4, 15}, {5, 8}, {5, 16}, 
+    {6, 8}, {6, 17}, {8, 22}, {9, 20}, {10, 20}, {18, 22}, {19, 23}, 
+};
+
+const char* const ATOMS_U[] = {
+    "C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "H1'", "H2'", 
+    "H3", "H3'", "H4'", "H5", "H5'", "H5''", "H6", "HO2'", "HO3'", "HOP2", 
+    "HOP3", "N1", "N3", "O2", "O2'", "O3'", "O4", "O4'", "O5'", "OP1", "OP2", 
+    "OP3", "P", 
+};
+const ResidueTemplate::Bond BONDS_U[] = {
+    {0, 2}, {0, 9}, {0, 22}, {0, 28}, {1, 22}, {1, 23}, {1, 24}, {2, 3}, 
+    {2, 10}, {2, 25}, {3, 5}, {3, 12}, {3, 26}, {4, 6}, {4, 23}, {4, 27}, 
+    {5, 7}, {5, 13}, {5, 28}, {6, 8}, {6, 14}, {7, 15}, {7, 16}, {7, 29}, 
+    {8, 17}, {8, 22}, {11, 23}, {18, 25}, {19, 26}, {20, 31}, {21, 32}, {29, 33}, 
+    {30, 33}, {31, 33}, {32, 33}, 
+};
+
+const char* const ATOMS_VAL[] = {
+    "C", "CA", "CB", "CG1", "CG2", "H", "H2", "HA", "HB", "HG11", "HG12", 
+    "HG13", "HG21", "HG22", "HG23", "HXT", "N", "O", "OXT", 
+};
+const ResidueTemplate::Bond BONDS_VAL[] = {
+    {0, 1}, {0, 17}, {0, 18}, {1, 2}, {1, 7}, {1, 16}, {2, 3}, {2, 4}, {2, 8}, 
+    {3, 9}, {3, 10}, {3, 11}, {4, 12}, {4, 13}, {4, 14}, {5, 16}, {6, 16}, 
+    {15, 18}, 
+};
+
+}
+
+const ResidueTemplate PDBConnectivity::TEMPLATES_[] = {
+    {"A", ATOMS_A, 37, BONDS_A, 39},
+    {"ALA", ATOMS_ALA, 13, BONDS_ALA, 12},
+    {"ARG", ATOMS_ARG, 27, BONDS_ARG, 26},
+    {"ASN", ATOMS_ASN, 17, BONDS_ASN, 16},
+    {"ASP", ATOMS_ASP, 16, BONDS_ASP, 15},
+    {"C", ATOMS_C, 35, BONDS_C, 36},
+    {"CYS", ATOMS_CYS, 14, BONDS_CYS, 13},
+    {"DA", ATOMS_DA, 36, BONDS_DA, 38},
+    {"DC", ATOMS_DC, 34, BONDS_DC, 35},
+    {"DG", ATOMS_DG, 37, BONDS_DG, 39},
+    {"DT", ATOMS_DT, 36, BONDS_DT, 37},
+    {"G", ATOMS_G, 38, BONDS_G, 40},
+    {"GLN", ATOMS_GLN, 20, BONDS_GLN, 19},
+    {"GLU", ATOMS_GLU, 19, BONDS_GLU, 18},
+    {"GLY", ATOMS_GLY, 10, BONDS_GLY, 9},
+    {"HIS", ATOMS_HIS, 21, BONDS_HIS, 21},
+    {"ILE", ATOMS_ILE, 22, BONDS_ILE, 21},
+    {"LEU", ATOMS_LEU, 22, BONDS_LEU, 21},
+    {"LYS", ATOMS_LYS, 25, BONDS_LYS, 24},
+    {"MET", ATOMS_MET, 20, BONDS_MET, 19},
+    {"PHE", ATOMS_PHE, 23, BONDS_PHE, 23},
+    {"PRO", ATOMS_PRO, 17, BONDS_PRO, 17},
+    {"SER", ATOMS_SER, 14, BONDS_SER, 13},
+    {"THR", ATOMS_THR, 17, BONDS_THR, 16},
+    {"TRP", ATOMS_TRP, 27, BONDS_TRP, 28},
+    {"TYR", ATOMS_TYR, 24, BONDS_TYR, 24},
+    {"U", ATOMS_U, 34, BONDS_U, 35},
+    {"VAL", ATOMS_VAL, 19, BONDS_VAL, 18},
 };
 
+const size_t PDBConnectivity::TEMPLATES_COUNT_ = 28;
@@ -865,6 +865,11 @@ double NumericProperty::value(const Frame& frame, size_t i) const {
             );
         }
     } else {
+        auto column = frame.column<double>(property_);
+        if (column) {
+            return (*column)[i];
+        }
+
         auto residue = frame.topology().residue_for_atom(i);
         if (residue) {
             const auto& resProperty = residue->get(property_);
@@ -928,6 +933,9 @@ std::string Position::name() const {
 }
 
 double Position::value(const Frame& frame, size_t i) const {
+    if (frame.single_precision()) {
+        return static_cast<double>(frame.positions_f32()[i][static_cast<size_t>(coordinate_)]);
+    }
     return frame.positions()[i][static_cast<size_t>(coordinate_)];
 }
 
@@ -944,6 +952,15 @@ std::string Velocity::name() const {
 }
 
 double Velocity::value(const Frame& frame, size_t i) const {
+    if (frame.single_precision()) {
+        if (frame.velocities_f32()) {
+            const auto& velocities = *frame.velocities_f32();
+            return static_cast<double>(velocities[i][static_cast<size_t>(coordinate_)]);
+        } else {
+            return std::nan("");
+        }
+    }
+
     if (frame.velocities()) {
         auto& velocities = *frame.velocities();
         return velocities[i][static_cast<size_t>(coordinate_)];
@@ -2,19 +2,22 @@
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
 
 #include <cerrno>
+#include <cstring>
 #include <string>
 #include <vector>
 
 #include "chemfiles/config.h"  // IWYU pragma: keep
 #include "chemfiles/utils.hpp"
+#include "chemfiles/error_fmt.hpp"
 
 #ifdef CHEMFILES_WINDOWS
-#include <windows.h>  // GetUserName & GetComputerNameEx
+#include <windows.h>  // GetUserName & GetComputerNameEx & FindFirstFile
 #include <direct.h>  // _getcwd
 #define getcwd _getcwd
 #else
 #include <unistd.h>
 #include <limits.h>
+#include <dirent.h>
 #endif
 
 std::string chemfiles::user_name() {
@@ -79,3 +82,36 @@ std::string chemfiles::current_directory() {
         return std::string(buffer.data());
     }
 }
+
+std::vector<std::string> chemfiles::list_directory(const std::string& path) {
+    auto entries = std::vector<std::string>();
+#ifdef CHEMFILES_WINDOWS
+    WIN32_FIND_DATAA data;
+    auto handle = FindFirstFileA((path + "\\*").c_str(), &data);
+    if (handle == INVALID_HANDLE_VALUE) {
+        throw file_error("could not open the directory at '{}'", path);
+    }
+    do {
+        auto name = std::string(data.cFileName);
+        if (name != "." && name != "..") {
+            entries.emplace_back(std::move(name));
+        }
+    } while (FindNextFileA(handle, &data));
+    FindClose(handle);
+#else
+    auto directory = opendir(path.c_str());
+    if (directory == nullptr) {
+        throw file_error(
+            "could not open the directory at '{}': {}", path, std::strerror(errno)
+        );
+    }
+    while (auto entry = readdir(directory)) {
+        auto name = std::string(entry->d_name);
+        if (name != "." && name != "..") {
+            entries.emplace_back(std::move(name));
+        }
+    }
+    closedir(directory);
+#endif
+    return entries;
+}
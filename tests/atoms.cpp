@@ -1,8 +1,11 @@
 // Chemfiles, a modern library for chemistry file reading and writing
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
 
+#include <string>
+
 #include <catch.hpp>
 #include "chemfiles.hpp"
+#include "chemfiles/atom_cache.hpp"
 using namespace chemfiles;
 
 TEST_CASE("Use the Atom type") {
@@ -99,6 +102,17 @@ TEST_CASE("Use the Atom type") {
         CHECK(atom.full_name().value() == "Carbon");
         CHECK(atom.covalent_radius().value() == 0.77);
         CHECK(atom.vdw_radius().value() == 1.7);
+
+        // two letters which are not an element
+        atom = Atom("Cx");
+        CHECK_FALSE(atom.atomic_number());
+        CHECK(atom.mass() == 0);
+
+        // names with more than two letters are not normalized
+        atom = Atom("Uuo");
+        CHECK(atom.atomic_number().value() == 118);
+        atom = Atom("UUO");
+        CHECK_FALSE(atom.atomic_number());
     }
 
     SECTION("Properties") {
@@ -152,3 +166,37 @@ TEST_CASE("Use the Atom type") {
         CHECK_FALSE(atom.get<Property::DOUBLE>("fizz"));
     }
 }
+
+TEST_CASE("Atom cache") {
+    auto cache = AtomCache();
+
+    for (size_t repeat = 0; repeat < 3; repeat++) {
+        // more names than slots in the cache, to check replacement
+        for (size_t i = 0; i < 200; i++) {
+            auto name = "C" + std::to_string(i);
+            auto& atom = cache.get(name);
+            CHECK(atom.name() == name);
+            CHECK(atom.type() == name);
+            CHECK(atom.mass() == 0);
+        }
+
+        auto& hydrogen = cache.get("HW1", "H");
+        CHECK(hydrogen.name() == "HW1");
+        CHECK(hydrogen.type() == "H");
+        CHECK(hydrogen.mass() == Atom("HW1", "H").mass());
+
+        auto& oxygen = cache.get("HW1", "O");
+        CHECK(oxygen.name() == "HW1");
+        CHECK(oxygen.type() == "O");
+        CHECK(oxygen.mass() == Atom("HW1", "O").mass());
+
+        auto& zinc = cache.get("Zn");
+        CHECK(zinc.name() == "Zn");
+        CHECK(zinc.type() == "Zn");
+        CHECK(zinc.mass() == Atom("Zn").mass());
+
+        auto& empty = cache.get("");
+        CHECK(empty.name() == "");
+        CHECK(empty.type() == "");
+    }
+}
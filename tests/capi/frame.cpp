@@ -144,6 +144,65 @@ TEST_CASE("chfl_frame") {
         chfl_free(frame);
     }
 
+    SECTION("Columns") {
+        CHFL_FRAME* frame = chfl_frame();
+        REQUIRE(frame);
+        CHECK_STATUS(chfl_frame_resize(frame, 3));
+
+        uint64_t count = 42;
+        CHECK_STATUS(chfl_frame_columns_count(frame, &count));
+        CHECK(count == 0);
+
+        CHECK_STATUS(chfl_frame_add_column(frame, "force", CHFL_PROPERTY_VECTOR3D));
+        CHECK_STATUS(chfl_frame_add_column(frame, "charge", CHFL_PROPERTY_DOUBLE));
+        CHECK(chfl_frame_add_column(frame, "charge", CHFL_PROPERTY_VECTOR3D) == CHFL_GENERIC_ERROR);
+        CHECK(chfl_frame_add_column(frame, "name", CHFL_PROPERTY_STRING) == CHFL_GENERIC_ERROR);
+
+        CHECK_STATUS(chfl_frame_columns_count(frame, &count));
+        CHECK(count == 2);
+
+        char name[32] = {0};
+        CHECK_STATUS(chfl_frame_column_name(frame, 0, name, sizeof(name)));
+        CHECK(name == std::string("charge"));
+        CHECK_STATUS(chfl_frame_column_name(frame, 1, name, sizeof(name)));
+        CHECK(name == std::string("force"));
+        CHECK(chfl_frame_column_name(frame, 2, name, sizeof(name)) == CHFL_OUT_OF_BOUNDS);
+
+        chfl_property_kind kind = CHFL_PROPERTY_BOOL;
+        CHECK_STATUS(chfl_frame_column_kind(frame, "force", &kind));
+        CHECK(kind == CHFL_PROPERTY_VECTOR3D);
+        CHECK_STATUS(chfl_frame_column_kind(frame, "charge", &kind));
+        CHECK(kind == CHFL_PROPERTY_DOUBLE);
+        CHECK(chfl_frame_column_kind(frame, "bar", &kind) == CHFL_GENERIC_ERROR);
+
+        double* charges = nullptr;
+        uint64_t natoms = 0;
+        CHECK_STATUS(chfl_frame_double_column(frame, "charge", &charges, &natoms));
+        CHECK(natoms == 3);
+        charges[2] = -0.5;
+
+        chfl_vector3d* forces = nullptr;
+        CHECK_STATUS(chfl_frame_vector3d_column(frame, "force", &forces, &natoms));
+        CHECK(natoms == 3);
+        forces[1][2] = 4.0;
+
+        CHECK(chfl_frame_double_column(frame, "force", &charges, &natoms) == CHFL_GENERIC_ERROR);
+        CHECK(chfl_frame_vector3d_column(frame, "charge", &forces, &natoms) == CHFL_GENERIC_ERROR);
+
+        CHECK_STATUS(chfl_frame_remove(frame, 0));
+        CHECK_STATUS(chfl_frame_double_column(frame, "charge", &charges, &natoms));
+        CHECK(natoms == 2);
+        CHECK(charges[1] == -0.5);
+        CHECK_STATUS(chfl_frame_vector3d_column(frame, "force", &forces, &natoms));
+        CHECK(forces[0][2] == 4.0);
+
+        CHECK_STATUS(chfl_frame_remove_column(frame, "charge"));
+        CHECK_STATUS(chfl_frame_columns_count(frame, &count));
+        CHECK(count == 1);
+
+        chfl_free(frame);
+    }
+
     SECTION("Unit cell") {
         CHFL_FRAME* frame = chfl_frame();
         REQUIRE(frame);
@@ -1,5 +1,9 @@
 // Chemfiles, a modern library for chemistry file reading and writing
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include <catch.hpp>
 
 #include "chemfiles/capi/shared_allocator.hpp"
@@ -98,7 +102,93 @@ TEST_CASE("Shared allocator") {
         shared_allocator::free(ptr);
     }
 
+    SECTION("Many pointers") {
+        auto pointers = std::vector<Dummy*>();
+        for (int i = 0; i < 10000; i++) {
+            auto ptr = shared_allocator::make_shared<Dummy>();
+            ptr->data.push_back(i);
+            pointers.push_back(ptr);
+        }
+
+        // release half of the pointers, keeping the others alive through a
+        // shared pointer
+        auto shared = std::vector<int*>();
+        for (size_t i = 0; i < pointers.size(); i++) {
+            if (i % 2 == 0) {
+                shared.push_back(shared_allocator::shared_ptr(pointers[i], &pointers[i]->data[0]));
+            }
+            shared_allocator::free(pointers[i]);
+        }
+
+        auto values = std::vector<int>();
+        for (auto ptr: shared) {
+            values.push_back(*ptr);
+            shared_allocator::free(ptr);
+        }
+        CHECK(values.size() == 5000);
+        CHECK(values[0] == 0);
+        CHECK(values[4999] == 9998);
+        CHECK_THROWS_AS(shared_allocator::free(shared[0]), MemoryError);
+    }
+
+    SECTION("Multiple threads") {
+        auto ptr = shared_allocator::make_shared<Dummy>();
+        ptr->data.resize(4, 0);
+
+        auto threads = std::vector<std::thread>();
+        for (size_t t = 0; t < 4; t++) {
+            threads.emplace_back([ptr, t]() {
+                for (size_t i = 0; i < 1000; i++) {
+                    auto own = shared_allocator::make_shared<Dummy>();
+                    auto shared = shared_allocator::shared_ptr(ptr, &ptr->data[t]);
+                    *shared += 1;
+                    shared_allocator::free(own);
+                    shared_allocator::free(shared);
+                }
+            });
+        }
+        for (auto& thread: threads) {
+            thread.join();
+        }
+
+        CHECK(ptr->data == std::vector<int>{1000, 1000, 1000, 1000});
+        shared_allocator::free(ptr);
+    }
+
     SECTION("Errors") {
         CHECK_THROWS_AS(shared_allocator::free(reinterpret_cast<void*>(0x1)), MemoryError);
     }
 }
+
+// This is a benchmark for the contention between threads in the shared
+// allocator, hidden by default. Run it with `c-shared_allocator "[.benchmark]"`
+TEST_CASE("Shared allocator contention", "[.benchmark]") {
+    const size_t iterations = 200000;
+    auto shared = shared_allocator::make_shared<Dummy>();
+    shared->data.resize(64, 0);
+
+    for (size_t n_threads: {1, 2, 4, 8}) {
+        auto start = std::chrono::steady_clock::now();
+        auto threads = std::vector<std::thread>();
+        for (size_t t = 0; t < n_threads; t++) {
+            threads.emplace_back([shared, t, iterations]() {
+                for (size_t i = 0; i < iterations; i++) {
+                    // one new pointer, and one pointer inside a shared value
+                    auto own = shared_allocator::make_shared<Dummy>();
+                    auto element = shared_allocator::shared_ptr(shared, &shared->data[t]);
+                    shared_allocator::free(own);
+                    shared_allocator::free(element);
+                }
+            });
+        }
+        for (auto& thread: threads) {
+            thread.join();
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+
+        auto handles = static_cast<double>(2 * iterations * n_threads);
+        WARN(n_threads << " thread(s): " << elapsed.count() / handles << " ns per handle");
+    }
+
+    shared_allocator::free(shared);
+}
@@ -1,6 +1,9 @@
 // Chemfiles, a modern library for chemistry file reading and writing
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
 
+#include <cmath>
+#include <string>
+
 #include "catch.hpp"
 #include "helpers.hpp"
 #include "chemfiles.h"
@@ -238,6 +241,101 @@ TEST_CASE("chfl_topology") {
         chfl_free(second);
         chfl_free(topology);
     }
+
+    SECTION("Bulk atomic data") {
+        CHFL_TOPOLOGY* topology = testing_topology();
+        REQUIRE(topology);
+
+        CHFL_ATOM* atom = chfl_atom("Zn");
+        REQUIRE(atom);
+        CHECK_STATUS(chfl_atom_set_charge(atom, 2.0));
+        CHECK_STATUS(chfl_atom_set_type(atom, "H"));
+        CHFL_PROPERTY* property = chfl_property_double(3.5);
+        REQUIRE(property);
+        CHECK_STATUS(chfl_atom_set_property(atom, "foo", property));
+        chfl_free(property);
+        CHECK_STATUS(chfl_topology_add_atom(topology, atom));
+
+        property = chfl_property_string("bar");
+        REQUIRE(property);
+        CHECK_STATUS(chfl_atom_set_property(atom, "foo", property));
+        chfl_free(property);
+        CHECK_STATUS(chfl_topology_add_atom(topology, atom));
+        chfl_free(atom);
+
+        double masses[6] = {0};
+        CHECK_STATUS(chfl_topology_masses(topology, masses, 6));
+        CHECK(approx_eq(masses[0], 1.008));
+        CHECK(approx_eq(masses[1], 15.999));
+        CHECK(approx_eq(masses[2], 15.999));
+        CHECK(approx_eq(masses[3], 1.008));
+        CHECK(approx_eq(masses[4], 65.38));
+        CHECK(approx_eq(masses[5], 65.38));
+        CHECK(chfl_topology_masses(topology, masses, 3) == CHFL_MEMORY_ERROR);
+
+        double charges[6] = {0};
+        CHECK_STATUS(chfl_topology_charges(topology, charges, 6));
+        CHECK(charges[0] == 0.0);
+        CHECK(charges[3] == 0.0);
+        CHECK(charges[4] == 2.0);
+        CHECK(charges[5] == 2.0);
+        CHECK(chfl_topology_charges(topology, charges, 12) == CHFL_MEMORY_ERROR);
+
+        // the number of atoms is always enough space for the types
+        const char* types[6] = {nullptr};
+        uint64_t ntypes = 6;
+        uint64_t ids[6] = {0};
+        CHECK_STATUS(chfl_topology_atom_types(topology, types, &ntypes, ids, 6));
+        CHECK(ntypes == 2);
+        CHECK(types[0] == std::string("H"));
+        CHECK(types[1] == std::string("O"));
+        CHECK(ids[0] == 0);
+        CHECK(ids[1] == 1);
+        CHECK(ids[2] == 1);
+        CHECK(ids[3] == 0);
+        CHECK(ids[4] == 0);
+        CHECK(ids[5] == 0);
+        ntypes = 2;
+        CHECK_STATUS(chfl_topology_atom_types(topology, types, &ntypes, ids, 6));
+        CHECK(ntypes == 2);
+        ntypes = 1;
+        CHECK(chfl_topology_atom_types(topology, types, &ntypes, ids, 6) == CHFL_MEMORY_ERROR);
+        ntypes = 2;
+        CHECK(chfl_topology_atom_types(topology, types, &ntypes, ids, 4) == CHFL_MEMORY_ERROR);
+
+        CHFL_RESIDUE* residue = chfl_residue_with_id("ZN", 42);
+        REQUIRE(residue);
+        CHECK_STATUS(chfl_residue_add_atom(residue, 4));
+        CHECK_STATUS(chfl_topology_add_residue(topology, residue));
+        chfl_free(residue);
+
+        residue = chfl_residue("HOH");
+        REQUIRE(residue);
+        CHECK_STATUS(chfl_residue_add_atom(residue, 0));
+        CHECK_STATUS(chfl_residue_add_atom(residue, 1));
+        CHECK_STATUS(chfl_topology_add_residue(topology, residue));
+        chfl_free(residue);
+
+        int64_t resids[6] = {0};
+        CHECK_STATUS(chfl_topology_residue_ids(topology, resids, 6));
+        CHECK(resids[0] == INT64_MIN);
+        CHECK(resids[1] == INT64_MIN);
+        CHECK(resids[2] == INT64_MIN);
+        CHECK(resids[3] == INT64_MIN);
+        CHECK(resids[4] == 42);
+        CHECK(resids[5] == INT64_MIN);
+        CHECK(chfl_topology_residue_ids(topology, resids, 0) == CHFL_MEMORY_ERROR);
+
+        double values[6] = {0};
+        CHECK_STATUS(chfl_topology_double_property(topology, "foo", values, 6));
+        CHECK(std::isnan(values[0]));
+        CHECK(std::isnan(values[3]));
+        CHECK(values[4] == 3.5);
+        CHECK(std::isnan(values[5]));
+        CHECK(chfl_topology_double_property(topology, "foo", values, 5) == CHFL_MEMORY_ERROR);
+
+        chfl_free(topology);
+    }
 }
 
 static CHFL_TOPOLOGY* testing_topology() {
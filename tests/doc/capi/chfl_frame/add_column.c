@@ -0,0 +1,18 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <chemfiles.h>
+#include <stdlib.h>
+
+int main() {
+    // [example]
+    CHFL_FRAME* frame = chfl_frame();
+    chfl_frame_resize(frame, 10);
+
+    chfl_frame_add_column(frame, "charge", CHFL_PROPERTY_DOUBLE);
+    chfl_frame_add_column(frame, "force", CHFL_PROPERTY_VECTOR3D);
+
+    chfl_free(frame);
+    // [example]
+    return 0;
+}
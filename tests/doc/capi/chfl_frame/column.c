@@ -0,0 +1,34 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <chemfiles.h>
+#include <assert.h>
+#include <stdlib.h>
+
+int main() {
+    // [example]
+    CHFL_FRAME* frame = chfl_frame();
+    chfl_frame_resize(frame, 10);
+    chfl_frame_add_column(frame, "charge", CHFL_PROPERTY_DOUBLE);
+    chfl_frame_add_column(frame, "force", CHFL_PROPERTY_VECTOR3D);
+
+    chfl_property_kind kind;
+    chfl_frame_column_kind(frame, "force", &kind);
+    assert(kind == CHFL_PROPERTY_VECTOR3D);
+
+    double* charges = NULL;
+    uint64_t natoms = 0;
+    chfl_frame_double_column(frame, "charge", &charges, &natoms);
+    assert(natoms == 10);
+
+    chfl_vector3d* forces = NULL;
+    chfl_frame_vector3d_column(frame, "force", &forces, &natoms);
+
+    for (uint64_t i=0; i<natoms; i++) {
+        // use charges[i] and forces[i] here
+    }
+
+    chfl_free(frame);
+    // [example]
+    return 0;
+}
@@ -0,0 +1,31 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <chemfiles.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main() {
+    // [example]
+    CHFL_FRAME* frame = chfl_frame();
+    chfl_frame_add_column(frame, "force", CHFL_PROPERTY_VECTOR3D);
+    chfl_frame_add_column(frame, "charge", CHFL_PROPERTY_DOUBLE);
+
+    uint64_t count = 0;
+    chfl_frame_columns_count(frame, &count);
+    assert(count == 2);
+
+    // columns are sorted by name
+    char name[64] = {0};
+    chfl_frame_column_name(frame, 0, name, sizeof(name));
+    assert(strcmp(name, "charge") == 0);
+
+    chfl_frame_remove_column(frame, "charge");
+    chfl_frame_columns_count(frame, &count);
+    assert(count == 1);
+
+    chfl_free(frame);
+    // [example]
+    return 0;
+}
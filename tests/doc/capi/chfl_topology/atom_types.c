@@ -0,0 +1,37 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <chemfiles.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+int main() {
+    // [example]
+    CHFL_TOPOLOGY* topology = chfl_topology();
+
+    CHFL_ATOM* oxygen = chfl_atom("O");
+    CHFL_ATOM* hydrogen = chfl_atom("H");
+    chfl_topology_add_atom(topology, oxygen);
+    chfl_topology_add_atom(topology, hydrogen);
+    chfl_topology_add_atom(topology, hydrogen);
+    chfl_free(oxygen);
+    chfl_free(hydrogen);
+
+    // there can not be more types than atoms
+    const char* types[3] = {NULL};
+    uint64_t ntypes = 3;
+    uint64_t ids[3] = {0};
+    chfl_topology_atom_types(topology, types, &ntypes, ids, 3);
+    assert(ntypes == 2);
+    assert(strcmp(types[0], "O") == 0);
+    assert(strcmp(types[1], "H") == 0);
+
+    assert(ids[0] == 0);
+    assert(ids[1] == 1);
+    assert(ids[2] == 1);
+
+    chfl_free(topology);
+    // [example]
+    return 0;
+}
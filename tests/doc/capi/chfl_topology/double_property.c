@@ -0,0 +1,32 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <chemfiles.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+int main() {
+    // [example]
+    CHFL_TOPOLOGY* topology = chfl_topology();
+
+    CHFL_ATOM* atom = chfl_atom("Zn");
+    chfl_topology_add_atom(topology, atom);
+
+    CHFL_PROPERTY* property = chfl_property_double(1.5);
+    chfl_atom_set_property(atom, "occupancy", property);
+    chfl_free(property);
+
+    chfl_topology_add_atom(topology, atom);
+    chfl_free(atom);
+
+    double occupancy[2] = {0};
+    chfl_topology_double_property(topology, "occupancy", occupancy, 2);
+    // the first atom does not have this property
+    assert(isnan(occupancy[0]));
+    assert(occupancy[1] == 1.5);
+
+    chfl_free(topology);
+    // [example]
+    return 0;
+}
@@ -0,0 +1,36 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <chemfiles.h>
+#include <stdlib.h>
+#include <assert.h>
+
+int main() {
+    // [example]
+    CHFL_TOPOLOGY* topology = chfl_topology();
+
+    CHFL_ATOM* atom = chfl_atom("O");
+    chfl_atom_set_charge(atom, -0.8);
+    chfl_topology_add_atom(topology, atom);
+    chfl_free(atom);
+
+    atom = chfl_atom("H");
+    chfl_atom_set_charge(atom, 0.4);
+    chfl_topology_add_atom(topology, atom);
+    chfl_topology_add_atom(topology, atom);
+    chfl_free(atom);
+
+    double masses[3] = {0};
+    chfl_topology_masses(topology, masses, 3);
+    assert(masses[0] == 15.999);
+    assert(masses[1] == 1.008);
+
+    double charges[3] = {0};
+    chfl_topology_charges(topology, charges, 3);
+    assert(charges[0] == -0.8);
+    assert(charges[2] == 0.4);
+
+    chfl_free(topology);
+    // [example]
+    return 0;
+}
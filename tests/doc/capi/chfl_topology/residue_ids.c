@@ -0,0 +1,29 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <chemfiles.h>
+#include <stdlib.h>
+#include <assert.h>
+
+int main() {
+    // [example]
+    CHFL_TOPOLOGY* topology = chfl_topology();
+    chfl_topology_resize(topology, 3);
+
+    CHFL_RESIDUE* residue = chfl_residue_with_id("res", 33);
+    chfl_residue_add_atom(residue, 0);
+    chfl_residue_add_atom(residue, 1);
+    chfl_topology_add_residue(topology, residue);
+    chfl_free(residue);
+
+    int64_t ids[3] = {0};
+    chfl_topology_residue_ids(topology, ids, 3);
+    assert(ids[0] == 33);
+    assert(ids[1] == 33);
+    // the last atom is not in any residue
+    assert(ids[2] == INT64_MIN);
+
+    chfl_free(topology);
+    // [example]
+    return 0;
+}
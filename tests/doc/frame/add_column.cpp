@@ -0,0 +1,26 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+#include <catch.hpp>
+#include <chemfiles.hpp>
+using namespace chemfiles;
+
+#undef assert
+#define assert CHECK
+
+TEST_CASE() {
+    // [example]
+    auto frame = Frame();
+    frame.resize(3);
+
+    auto charges = frame.add_column<double>("charge");
+    assert(charges.size() == 3);
+    charges[0] = -0.8;
+
+    auto forces = frame.add_column<Vector3D>("force");
+    forces[2] = Vector3D(1.0, 0.0, -2.0);
+
+    // columns are resized together with the frame
+    frame.add_atom(Atom("H"), Vector3D(0, 0, 0));
+    assert(frame.column<double>("charge")->size() == 4);
+    // [example]
+}
@@ -0,0 +1,26 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+#include <catch.hpp>
+#include <chemfiles.hpp>
+using namespace chemfiles;
+
+#undef assert
+#define assert CHECK
+
+TEST_CASE() {
+    // [example]
+    auto frame = Frame();
+    frame.resize(3);
+    frame.add_column<double>("charge")[1] = 0.4;
+
+    auto charges = frame.column<double>("charge");
+    assert(charges);
+    assert((*charges)[1] == 0.4);
+
+    assert(frame.column_kind("charge") == Property::DOUBLE);
+
+    // the column exists, but contains double values
+    assert(!frame.column<Vector3D>("charge"));
+    assert(!frame.column_kind("force"));
+    // [example]
+}
@@ -0,0 +1,24 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+#include <catch.hpp>
+#include <chemfiles.hpp>
+using namespace chemfiles;
+
+#undef assert
+#define assert CHECK
+
+TEST_CASE() {
+    // [example]
+    auto frame = Frame();
+    frame.add_column<Vector3D>("force");
+    frame.add_column<double>("charge");
+
+    auto names = frame.columns();
+    assert(names.size() == 2);
+    assert(names[0] == "charge");
+    assert(names[1] == "force");
+
+    frame.remove_column("force");
+    assert(frame.columns().size() == 1);
+    // [example]
+}
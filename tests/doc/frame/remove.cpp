@@ -24,5 +24,9 @@ TEST_CASE() {
     // Removing an atom changes the indexes of atoms after the one removed
     assert(frame.topology()[1].name() == "H");
     assert(frame.positions()[1] == Vector3D(0.0, 0.0, 1.0));
+
+    // multiple atoms can be removed at once
+    frame.remove(std::vector<size_t>{0, 1});
+    assert(frame.size() == 0);
     // [example]
 }
@@ -0,0 +1,34 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+#include <catch.hpp>
+#include <chemfiles.hpp>
+using namespace chemfiles;
+
+#undef assert
+#define assert CHECK
+
+TEST_CASE() {
+    // [example]
+    auto frame = Frame();
+    frame.add_atom(Atom("H"), Vector3D(1.0, 2.0, 3.0));
+    assert(!frame.single_precision());
+
+    frame.set_single_precision(true);
+    assert(frame.single_precision());
+
+    auto positions = frame.positions_f32();
+    assert(positions[0] == (Vector3F{{1.0f, 2.0f, 3.0f}}));
+    positions[0][0] = 4.0f;
+
+    // const access in double precision returns a copy of the data
+    const auto& const_frame = frame;
+    assert(const_frame.positions_f32()[0] == (Vector3F{{4.0f, 2.0f, 3.0f}}));
+    assert(const_frame.positions()[0] == Vector3D(4.0, 2.0, 3.0));
+    assert(frame.single_precision());
+
+    // frames are converted back to double precision when modifying the
+    // positions in double precision
+    frame.positions()[0] = Vector3D(5.0, 2.0, 3.0);
+    assert(!frame.single_precision());
+    // [example]
+}
@@ -0,0 +1,25 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+#include <catch.hpp>
+#include <chemfiles.hpp>
+using namespace chemfiles;
+
+#undef assert
+#define assert CHECK
+
+TEST_CASE() {
+    // [example]
+    auto frame = Frame();
+    frame.add_atom(Atom("H"), {1.0, 0.0, 0.0});
+    frame.add_atom(Atom("O"), {0.0, 1.0, 0.0});
+    frame.add_atom(Atom("H"), {0.0, 0.0, 1.0});
+
+    auto subset = frame.subset({0, 2});
+    assert(subset.size() == 2);
+    assert(subset.topology()[1].name() == "H");
+    assert(subset.positions()[1] == Vector3D(0.0, 0.0, 1.0));
+
+    // the original frame is not modified
+    assert(frame.size() == 3);
+    // [example]
+}
@@ -20,5 +20,13 @@ TEST_CASE() {
 
     // atomic indexes are shifted by remove
     assert(topology[1].name() == "Rd");
+
+    // multiple atoms can be removed at once
+    topology.add_atom(Atom("Cu"));
+    topology.add_atom(Atom("Ag"));
+    topology.remove(std::vector<size_t>{0, 2});
+    assert(topology.size() == 2);
+    assert(topology[0].name() == "Rd");
+    assert(topology[1].name() == "Ag");
     // [example]
 }
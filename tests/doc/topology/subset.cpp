@@ -0,0 +1,28 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+#include <catch.hpp>
+#include <chemfiles.hpp>
+using namespace chemfiles;
+
+#undef assert
+#define assert CHECK
+
+TEST_CASE() {
+    // [example]
+    auto topology = Topology();
+    topology.add_atom(Atom("H"));
+    topology.add_atom(Atom("O"));
+    topology.add_atom(Atom("H"));
+    topology.add_atom(Atom("Na"));
+    topology.add_bond(0, 1);
+    topology.add_bond(1, 2);
+
+    auto subset = topology.subset({2, 1});
+    assert(subset.size() == 2);
+    assert(subset[0].name() == "H");
+    assert(subset[1].name() == "O");
+
+    // bonds between the atoms in the subset are kept and renumbered
+    assert(subset.bonds() == std::vector<Bond>({{0, 1}}));
+    // [example]
+}
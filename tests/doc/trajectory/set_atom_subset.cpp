@@ -0,0 +1,24 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <catch.hpp>
+#include <chemfiles.hpp>
+using namespace chemfiles;
+
+TEST_CASE() {
+    // [no-run]
+    // [example]
+    auto trajectory = Trajectory("solvated-protein.xtc");
+    trajectory.set_topology("solvated-protein.pdb");
+
+    // only read the first three atoms from the file
+    trajectory.set_atom_subset(std::vector<size_t>{0, 1, 2});
+    auto frame = trajectory.read();
+    assert(frame.size() == 3);
+
+    // only read the protein atoms from the file. The selection is evaluated
+    // on the next frame, and then used for all the other frames.
+    trajectory.set_atom_subset(Selection("not resname WAT"));
+    frame = trajectory.read();
+    // [example]
+}
@@ -0,0 +1,19 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <catch.hpp>
+#include <chemfiles.hpp>
+using namespace chemfiles;
+
+TEST_CASE() {
+    // [no-run]
+    // [example]
+    auto trajectory = Trajectory("water.xtc");
+    trajectory.set_single_precision(true);
+
+    // the positions are decoded directly in single precision
+    auto frame = trajectory.read();
+    assert(frame.single_precision());
+    auto positions = frame.positions_f32();
+    // [example]
+}
@@ -0,0 +1,24 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <catch.hpp>
+#include <chemfiles.hpp>
+using namespace chemfiles;
+
+TEST_CASE() {
+    // [no-run]
+    // [example]
+    auto input = Trajectory("trajectory.xtc");
+    input.set_topology("topology.pdb");
+
+    auto output = Trajectory("trajectory.xyz", 'w');
+    // convert frames to text using 4 threads
+    output.set_write_threads(4);
+
+    while (!input.done()) {
+        output.write(input.read());
+    }
+    // wait for all the frames to be written
+    output.close();
+    // [example]
+}
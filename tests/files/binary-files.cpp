@@ -159,6 +159,39 @@ TEST_CASE("Write binary files") {
             auto content = read_binary_file(filename);
             CHECK(content == expected);
         }
+
+        SECTION("read everything") {
+            auto filename = NamedTempPath(".data");
+            {
+                auto file = BigEndianFile(filename, File::Mode::WRITE);
+                write_binary_file(file);
+            }
+
+            auto file = BigEndianFile(filename, File::Mode::READ);
+            CHECK(file.size() == expected.size());
+            auto buffer = std::string();
+            auto content = file.read_all(buffer);
+            CHECK(std::vector<uint8_t>(content.begin(), content.end()) == expected);
+        }
+
+        SECTION("read views") {
+            auto filename = NamedTempPath(".data");
+            {
+                auto file = BigEndianFile(filename, File::Mode::WRITE);
+                write_binary_file(file);
+            }
+
+            auto file = BigEndianFile(filename, File::Mode::READ);
+            auto buffer = std::string();
+            auto content = file.read_view(4, buffer);
+            CHECK(content == "ABCD");
+            CHECK(file.tell() == 4);
+            CHECK(file.read_single_i16() == -42);
+
+            file.seek(expected.size() - 8);
+            CHECK(file.read_view(8, buffer).size() == 8);
+            CHECK_THROWS(file.read_view(1, buffer));
+        }
     }
 
     SECTION("little endian") {
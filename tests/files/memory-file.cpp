@@ -1,6 +1,14 @@
 // Chemfiles, a modern library for chemistry file reading and writing
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
 
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
 #include "catch.hpp"
 #include "helpers.hpp"
 #include "chemfiles/files/MemoryFile.hpp"
@@ -78,6 +86,51 @@ TEST_CASE("Reading from files in memory") {
         // This way, we can be sure the file works with buffers greater than
         // 8192 in size
     }
+
+    SECTION("Reading multiple lines") {
+        auto buffer = std::make_shared<MemoryBuffer>(TEST_DATA.data(), TEST_DATA.size());
+        auto file = TextFile(buffer, File::READ, File::DEFAULT);
+
+        CHECK(file.readline() == "This is");
+        auto lines = file.readlines(2);
+        REQUIRE(lines.size() == 2);
+        CHECK(lines[0] == "a test");
+        CHECK(lines[1] == "for the memory file");
+        CHECK(file.tellpos() == 35);
+        CHECK(file.readline() == "class!");
+
+        file.rewind();
+        lines = file.readlines(10);
+        REQUIRE(lines.size() == 4);
+        CHECK(lines[3] == "class!");
+        CHECK(file.eof());
+    }
+
+    SECTION("Reading many lines") {
+        auto content = std::string();
+        for (size_t i=0; i<5000; i++) {
+            content += "line " + std::to_string(i) + "\r\n";
+        }
+        content += "last line";
+
+        auto buffer = std::make_shared<MemoryBuffer>(content.data(), content.size());
+        auto file = TextFile(buffer, File::READ, File::DEFAULT);
+
+        CHECK(file.readline() == "line 0");
+        auto lines = file.readlines(4000);
+        REQUIRE(lines.size() == 4000);
+        CHECK(lines[0] == "line 1");
+        CHECK(lines[3999] == "line 4000");
+        CHECK(file.tellpos() == content.find("line 4001"));
+        CHECK(file.readline() == "line 4001");
+
+        lines = file.readlines(2000);
+        REQUIRE(lines.size() == 999);
+        CHECK(lines[0] == "line 4002");
+        CHECK(lines[997] == "line 4999");
+        CHECK(lines[998] == "last line");
+        CHECK(file.eof());
+    }
 }
 
 TEST_CASE("Write to files in memory") {
@@ -90,6 +143,10 @@ TEST_CASE("Write to files in memory") {
         CHECK(buffer->capacity() == 6);
 
         file.print("Test\n");
+        // data is only written to the buffer when flushing
+        CHECK(buffer->size() == 0);
+        CHECK(file.tellpos() == 5);
+        file.flush();
         CHECK(std::string(buffer->data(), buffer->size()) == "Test\n");
         CHECK(std::strlen(buffer->data()) == buffer->size());
         CHECK(file.tellpos() == buffer->size());
@@ -98,6 +155,7 @@ TEST_CASE("Write to files in memory") {
 
         // Check reallocation (more than twice the previous size)
         file.print("JUNKJUNKJUNKJUNKJUNK");
+        file.flush();
         CHECK(std::string(buffer->data(), buffer->size()) == "Test\nJUNKJUNKJUNKJUNKJUNK");
         CHECK(std::strlen(buffer->data()) == buffer->size());
         CHECK(file.tellpos() == buffer->size());
@@ -143,3 +201,47 @@ TEST_CASE("Write to files in memory") {
         );
     }
 }
+
+TEST_CASE("Formatting numbers in text files") {
+    auto values = std::vector<double>{
+        0.0, -0.0, 1.0, -1.0, 0.5, 0.125, 0.375, -0.125, 0.0625, 2.5, 1.0005,
+        0.0005, 12.3456, 999.9995, 99999.95, 999999.4, 999999.5, 1e6, 1e-4,
+        0.000099999, 0.0000999995, 0.0000999999, -0.0000999996, 37925.863248,
+        1e-5, 123456789.123, 1e15, 1e300, -1e-300,
+        std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::quiet_NaN(),
+    };
+
+    auto rng = std::mt19937(42);
+    auto exponent = std::uniform_real_distribution<double>(-7, 8);
+    for (size_t i = 0; i < 10000; i++) {
+        auto value = std::pow(10.0, exponent(rng));
+        if (i % 2 == 0) {
+            value = -value;
+        }
+        if (i % 3 == 0) {
+            // ties and near-ties
+            value = std::round(value * 2000) / 2000;
+        }
+        values.push_back(value);
+    }
+
+    auto buffer = std::make_shared<MemoryBuffer>(8192);
+    auto file = TextFile(buffer, File::WRITE, File::DEFAULT);
+
+    for (auto value: values) {
+        auto start = buffer->size();
+        file.print_fixed(value, 8, 3);
+        file.print_fixed(value, 10, 5);
+        file.print_fixed(value, 0, 2);
+        file.print_fixed(value, 6, 1);
+        file.print(" ");
+        file.print_general(value);
+        file.flush();
+
+        auto expected = fmt::format("{:8.3f}{:10.5f}{:.2f}{:6.1f} {:g}", value, value, value, value, value);
+        CHECK(std::string(buffer->data() + start, buffer->size() - start) == expected);
+        CHECK(file.tellpos() == buffer->size());
+    }
+}
@@ -0,0 +1,425 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <map>
+#include <cstring>
+#include <fstream>
+#include <functional>
+
+#include <msgpack.hpp>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+#include "chemfiles.hpp"
+using namespace chemfiles;
+
+using Packer = msgpack::packer<msgpack::sbuffer>;
+using PackEncoding = std::function<void(Packer&)>;
+
+static void pack_byte_array(Packer& packer, int type) {
+    packer.pack_map(2);
+    packer.pack("kind"); packer.pack("ByteArray");
+    packer.pack("type"); packer.pack(type);
+}
+
+/// Get the little-endian representation of `values`
+template<typename T>
+static std::string little_endian(const std::vector<T>& values) {
+    auto result = std::string();
+    for (auto value: values) {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(T));
+        for (size_t i = 0; i < sizeof(T); i++) {
+            result.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+        }
+    }
+    return result;
+}
+
+/// Pack encoded data, with the given `encodings` and raw `data`
+static void pack_data(Packer& packer, const std::vector<PackEncoding>& encodings, const std::string& data) {
+    packer.pack_map(2);
+    packer.pack("encoding");
+    packer.pack_array(static_cast<uint32_t>(encodings.size()));
+    for (const auto& encoding: encodings) {
+        encoding(packer);
+    }
+    packer.pack("data");
+    packer.pack_bin(static_cast<uint32_t>(data.size()));
+    packer.pack_bin_body(data.data(), static_cast<uint32_t>(data.size()));
+}
+
+/// Pack a column with the given `name`, using `data` to pack the values and
+/// an optional `mask`
+static void pack_column(Packer& packer, const std::string& name, std::function<void(Packer&)> data, std::vector<int32_t> mask = {}) {
+    packer.pack_map(3);
+    packer.pack("name"); packer.pack(name);
+    packer.pack("data"); data(packer);
+    packer.pack("mask");
+    if (mask.empty()) {
+        packer.pack_nil();
+    } else {
+        pack_data(packer, {[](Packer& p) { pack_byte_array(p, 3); }}, little_endian(mask));
+    }
+}
+
+/// Pack `values` as a StringArray encoded column
+static void pack_strings(Packer& packer, const std::vector<std::string>& values) {
+    auto strings = std::string();
+    auto offsets = std::vector<int32_t>{0};
+    auto indices = std::vector<int32_t>();
+    auto unique = std::map<std::string, int32_t>();
+    for (const auto& value: values) {
+        auto it = unique.find(value);
+        if (it == unique.end()) {
+            it = unique.emplace(value, static_cast<int32_t>(offsets.size() - 1)).first;
+            strings += value;
+            offsets.push_back(static_cast<int32_t>(strings.size()));
+        }
+        indices.push_back(it->second);
+    }
+
+    auto string_array = [&](Packer& p) {
+        auto offsets_data = little_endian(offsets);
+        p.pack_map(6);
+        p.pack("kind"); p.pack("StringArray");
+        p.pack("dataEncoding"); p.pack_array(1); pack_byte_array(p, 3);
+        p.pack("stringData"); p.pack(strings);
+        p.pack("offsetEncoding"); p.pack_array(1); pack_byte_array(p, 3);
+        p.pack("offsets");
+        p.pack_bin(static_cast<uint32_t>(offsets_data.size()));
+        p.pack_bin_body(offsets_data.data(), static_cast<uint32_t>(offsets_data.size()));
+        p.pack("srcType"); p.pack(3);
+    };
+    pack_data(packer, {string_array}, little_endian(indices));
+}
+
+/// Pack `values` as 64-bit floating point values
+static void pack_f64(Packer& packer, const std::vector<double>& values) {
+    pack_data(packer, {[](Packer& p) { pack_byte_array(p, 33); }}, little_endian(values));
+}
+
+/// Create a BinaryCIF file with two models, containing a glycine and a water
+/// molecule each, using most of the encodings from the specification.
+static std::vector<char> create_bcif() {
+    msgpack::sbuffer buffer;
+    Packer packer(&buffer);
+
+    packer.pack_map(3);
+    packer.pack("version"); packer.pack("0.3.0");
+    packer.pack("encoder"); packer.pack("chemfiles tests");
+    packer.pack("dataBlocks");
+    packer.pack_array(1);
+    packer.pack_map(2);
+    packer.pack("header"); packer.pack("TEST");
+    packer.pack("categories");
+    packer.pack_array(3);
+
+    // The category name does not always start with an underscore
+    packer.pack_map(3);
+    packer.pack("name"); packer.pack("entry");
+    packer.pack("rowCount"); packer.pack(1);
+    packer.pack("columns"); packer.pack_array(1);
+    pack_column(packer, "id", [](Packer& p) { pack_strings(p, {"1ABC"}); });
+
+    packer.pack_map(3);
+    packer.pack("name"); packer.pack("_cell");
+    packer.pack("rowCount"); packer.pack(1);
+    packer.pack("columns"); packer.pack_array(4);
+    pack_column(packer, "length_a", [](Packer& p) { pack_f64(p, {10.0}); });
+    pack_column(packer, "length_b", [](Packer& p) { pack_f64(p, {20.0}); });
+    pack_column(packer, "length_c", [](Packer& p) { pack_f64(p, {30.0}); });
+    pack_column(packer, "angle_beta", [](Packer& p) { pack_f64(p, {100.0}); });
+
+    packer.pack_map(3);
+    packer.pack("name"); packer.pack("_atom_site");
+    packer.pack("rowCount"); packer.pack(6);
+    packer.pack("columns"); packer.pack_array(14);
+    pack_column(packer, "group_PDB", [](Packer& p) {
+        pack_strings(p, {"ATOM", "ATOM", "HETATM", "ATOM", "ATOM", "HETATM"});
+    });
+    pack_column(packer, "type_symbol", [](Packer& p) {
+        pack_strings(p, {"N", "C", "O", "N", "C", "O"});
+    });
+    pack_column(packer, "label_atom_id", [](Packer& p) {
+        pack_strings(p, {"N", "CA", "O", "N", "CA", "O"});
+    });
+    pack_column(packer, "label_alt_id", [](Packer& p) {
+        pack_strings(p, {"", "A", "", "", "B", ""});
+    }, {1, 0, 1, 1, 0, 1});
+    pack_column(packer, "label_comp_id", [](Packer& p) {
+        pack_strings(p, {"GLY", "GLY", "HOH", "GLY", "GLY", "HOH"});
+    });
+    pack_column(packer, "label_asym_id", [](Packer& p) {
+        pack_strings(p, {"A", "A", "B", "A", "A", "B"});
+    });
+    pack_column(packer, "auth_asym_id", [](Packer& p) {
+        pack_strings(p, {"A", "A", "C", "A", "A", "C"});
+    });
+
+    // RunLength of Int32
+    pack_column(packer, "label_seq_id", [](Packer& p) {
+        auto run_length = [](Packer& pk) {
+            pk.pack_map(3);
+            pk.pack("kind"); pk.pack("RunLength");
+            pk.pack("srcType"); pk.pack(3);
+            pk.pack("srcSize"); pk.pack(6);
+        };
+        pack_data(p, {run_length, [](Packer& pk) { pack_byte_array(pk, 3); }},
+            little_endian(std::vector<int32_t>{1, 2, 0, 1, 1, 2, 0, 1})
+        );
+    }, {0, 0, 1, 0, 0, 1});
+
+    // Delta and IntegerPacking of Int8
+    pack_column(packer, "label_entity_id", [](Packer& p) {
+        auto delta = [](Packer& pk) {
+            pk.pack_map(3);
+            pk.pack("kind"); pk.pack("Delta");
+            pk.pack("origin"); pk.pack(1);
+            pk.pack("srcType"); pk.pack(3);
+        };
+        auto integer_packing = [](Packer& pk) {
+            pk.pack_map(4);
+            pk.pack("kind"); pk.pack("IntegerPacking");
+            pk.pack("byteCount"); pk.pack(1);
+            pk.pack("isUnsigned"); pk.pack(false);
+            pk.pack("srcSize"); pk.pack(6);
+        };
+        // delta values are {0, 0, 1, -1, 0, 1}
+        pack_data(p, {delta, integer_packing, [](Packer& pk) { pack_byte_array(pk, 1); }},
+            little_endian(std::vector<int8_t>{0, 0, 1, -1, 0, 1})
+        );
+    });
+
+    // FixedPoint of Int32
+    pack_column(packer, "Cartn_x", [](Packer& p) {
+        auto fixed_point = [](Packer& pk) {
+            pk.pack_map(3);
+            pk.pack("kind"); pk.pack("FixedPoint");
+            pk.pack("factor"); pk.pack(1000.0);
+            pk.pack("srcType"); pk.pack(33);
+        };
+        pack_data(p, {fixed_point, [](Packer& pk) { pack_byte_array(pk, 3); }},
+            little_endian(std::vector<int32_t>{1000, 2500, -3125, 1100, 2600, -3025})
+        );
+    });
+
+    // Float32
+    pack_column(packer, "Cartn_y", [](Packer& p) {
+        pack_data(p, {[](Packer& pk) { pack_byte_array(pk, 32); }},
+            little_endian(std::vector<float>{0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f})
+        );
+    });
+
+    // IntervalQuantization of Uint8, with a IntegerPacking of large values
+    pack_column(packer, "Cartn_z", [](Packer& p) {
+        auto interval = [](Packer& pk) {
+            pk.pack_map(5);
+            pk.pack("kind"); pk.pack("IntervalQuantization");
+            pk.pack("min"); pk.pack(0.0);
+            pk.pack("max"); pk.pack(10.0);
+            pk.pack("numSteps"); pk.pack(1001);
+            pk.pack("srcType"); pk.pack(33);
+        };
+        auto integer_packing = [](Packer& pk) {
+            pk.pack_map(4);
+            pk.pack("kind"); pk.pack("IntegerPacking");
+            pk.pack("byteCount"); pk.pack(1);
+            pk.pack("isUnsigned"); pk.pack(true);
+            pk.pack("srcSize"); pk.pack(6);
+        };
+        // values are {0, 255, 300, 5, 1000, 42}
+        pack_data(p, {interval, integer_packing, [](Packer& pk) { pack_byte_array(pk, 4); }},
+            little_endian(std::vector<uint8_t>{0, 255, 0, 255, 45, 5, 255, 255, 255, 235, 42})
+        );
+    });
+
+    pack_column(packer, "pdbx_formal_charge", [](Packer& p) {
+        pack_data(p, {[](Packer& pk) { pack_byte_array(pk, 1); }},
+            little_endian(std::vector<int8_t>{0, 0, -1, 0, 0, -1})
+        );
+    }, {1, 1, 0, 1, 1, 0});
+
+    pack_column(packer, "pdbx_PDB_model_num", [](Packer& p) {
+        pack_data(p, {[](Packer& pk) { pack_byte_array(pk, 6); }},
+            little_endian(std::vector<uint32_t>{1, 1, 1, 2, 2, 2})
+        );
+    });
+
+    return std::vector<char>(buffer.data(), buffer.data() + buffer.size());
+}
+
+TEST_CASE("Read files in BinaryCIF format") {
+    auto content = create_bcif();
+
+    SECTION("Read all steps") {
+        auto file = Trajectory::memory_reader(content.data(), content.size(), "BinaryCIF");
+        REQUIRE(file.nsteps() == 2);
+
+        auto frame = file.read();
+        CHECK(frame.size() == 3);
+        CHECK(frame.get("pdb_idcode")->as_string() == "1ABC");
+        CHECK(approx_eq(frame.cell().lengths(), {10.0, 20.0, 30.0}, 1e-12));
+        CHECK(approx_eq(frame.cell().angles(), {90.0, 100.0, 90.0}, 1e-12));
+
+        auto positions = frame.positions();
+        CHECK(approx_eq(positions[0], Vector3D(1.0, 0.5, 0.0), 1e-12));
+        CHECK(approx_eq(positions[1], Vector3D(2.5, 1.5, 2.55), 1e-12));
+        CHECK(approx_eq(positions[2], Vector3D(-3.125, 2.5, 3.0), 1e-12));
+
+        CHECK(frame[0].name() == "N");
+        CHECK(frame[0].type() == "N");
+        CHECK(frame[1].name() == "CA");
+        CHECK(frame[1].type() == "C");
+        CHECK(frame[2].charge() == -1);
+        CHECK(frame[0].charge() == 0);
+
+        CHECK_FALSE(frame[0].get("altloc"));
+        CHECK(frame[1].get("altloc")->as_string() == "A");
+
+        const auto& residues = frame.topology().residues();
+        REQUIRE(residues.size() == 2);
+        CHECK(residues[0].name() == "GLY");
+        CHECK(*residues[0].id() == 1);
+        CHECK(residues[0].size() == 2);
+        CHECK(residues[0].get("chainid")->as_string() == "A");
+        CHECK(residues[0].get("chainname")->as_string() == "A");
+        CHECK(residues[0].get("is_standard_pdb")->as_bool() == true);
+
+        // the water does not have a label_seq_id, and uses the entity id
+        CHECK(residues[1].name() == "HOH");
+        CHECK(*residues[1].id() == 2);
+        CHECK(residues[1].get("chainid")->as_string() == "B");
+        CHECK(residues[1].get("chainname")->as_string() == "C");
+        CHECK(residues[1].get("is_standard_pdb")->as_bool() == false);
+
+        // bonds from the standard residues templates
+        const auto& bonds = frame.topology().bonds();
+        REQUIRE(bonds.size() == 1);
+        CHECK(bonds[0] == Bond(0, 1));
+
+        frame = file.read();
+        CHECK(frame.size() == 3);
+        positions = frame.positions();
+        CHECK(approx_eq(positions[0], Vector3D(1.1, 3.5, 0.05), 1e-12));
+        CHECK(approx_eq(positions[1], Vector3D(2.6, 4.5, 10.0), 1e-12));
+        CHECK(approx_eq(positions[2], Vector3D(-3.025, 5.5, 0.42), 1e-12));
+        CHECK(frame[1].get("altloc")->as_string() == "B");
+    }
+
+    SECTION("Read a specific step") {
+        auto file = Trajectory::memory_reader(content.data(), content.size(), "BinaryCIF");
+        auto frame = file.read_step(1);
+        CHECK(frame.size() == 3);
+        CHECK(approx_eq(frame.positions()[2], Vector3D(-3.025, 5.5, 0.42), 1e-12));
+
+        frame = file.read_step(0);
+        CHECK(approx_eq(frame.positions()[2], Vector3D(-3.125, 2.5, 3.0), 1e-12));
+    }
+
+    SECTION("Read from a file") {
+        auto filename = NamedTempPath(".bcif");
+        {
+            std::ofstream file(filename, std::ios::binary);
+            file.write(content.data(), static_cast<std::streamsize>(content.size()));
+        }
+
+        auto file = Trajectory(filename);
+        CHECK(file.nsteps() == 2);
+        auto frame = file.read();
+        CHECK(frame.size() == 3);
+        CHECK(frame.topology().residues().size() == 2);
+    }
+}
+
+TEST_CASE("Errors in BinaryCIF format") {
+    CHECK_THROWS_WITH(
+        Trajectory::memory_writer("BinaryCIF"),
+        "the BinaryCIF format cannot write to memory"
+    );
+
+    CHECK_THROWS_WITH(
+        Trajectory::memory_reader("JUNK", 5, "BinaryCIF"),
+        "error while decoding BinaryCIF from memory: expected a map"
+    );
+
+    msgpack::sbuffer buffer;
+    Packer packer(&buffer);
+    packer.pack_map(1);
+    packer.pack("dataBlocks");
+    packer.pack_array(1);
+    packer.pack_map(1);
+    packer.pack("categories");
+    packer.pack_array(0);
+
+    CHECK_THROWS_WITH(
+        Trajectory::memory_reader(buffer.data(), buffer.size(), "BinaryCIF"),
+        "could not find _atom_site category in 'memory'"
+    );
+
+    buffer.clear();
+    packer.pack_map(1);
+    packer.pack("dataBlocks");
+    packer.pack_array(1);
+    packer.pack_map(1);
+    packer.pack("categories");
+    packer.pack_array(1);
+    packer.pack_map(3);
+    packer.pack("name"); packer.pack("_atom_site");
+    packer.pack("rowCount"); packer.pack(1);
+    packer.pack("columns"); packer.pack_array(4);
+    pack_column(packer, "type_symbol", [](Packer& p) { pack_strings(p, {"C"}); });
+    pack_column(packer, "Cartn_x", [](Packer& p) { pack_f64(p, {0.0}); });
+    pack_column(packer, "Cartn_y", [](Packer& p) { pack_f64(p, {0.0}); });
+    // IntervalQuantization with a single step
+    pack_column(packer, "Cartn_z", [](Packer& p) {
+        auto interval = [](Packer& pk) {
+            pk.pack_map(5);
+            pk.pack("kind"); pk.pack("IntervalQuantization");
+            pk.pack("min"); pk.pack(0.0);
+            pk.pack("max"); pk.pack(10.0);
+            pk.pack("numSteps"); pk.pack(1);
+            pk.pack("srcType"); pk.pack(33);
+        };
+        pack_data(p, {interval, [](Packer& pk) { pack_byte_array(pk, 4); }},
+            little_endian(std::vector<uint8_t>{0})
+        );
+    });
+
+    CHECK_THROWS_WITH(
+        Trajectory::memory_reader(buffer.data(), buffer.size(), "BinaryCIF"),
+        "invalid BinaryCIF: IntervalQuantization needs at least 2 steps, got 1"
+    );
+
+    buffer.clear();
+    packer.pack_map(1);
+    packer.pack("dataBlocks");
+    packer.pack_array(1);
+    packer.pack_map(1);
+    packer.pack("categories");
+    packer.pack_array(1);
+    packer.pack_map(3);
+    packer.pack("name"); packer.pack("_atom_site");
+    packer.pack("rowCount"); packer.pack(1);
+    packer.pack("columns"); packer.pack_array(1);
+    // StringArray with floating point indices
+    pack_column(packer, "type_symbol", [](Packer& p) {
+        auto string_array = [](Packer& pk) {
+            auto offsets = little_endian(std::vector<int32_t>{0, 1});
+            pk.pack_map(5);
+            pk.pack("kind"); pk.pack("StringArray");
+            pk.pack("dataEncoding"); pk.pack_array(1); pack_byte_array(pk, 33);
+            pk.pack("stringData"); pk.pack("C");
+            pk.pack("offsetEncoding"); pk.pack_array(1); pack_byte_array(pk, 3);
+            pk.pack("offsets");
+            pk.pack_bin(static_cast<uint32_t>(offsets.size()));
+            pk.pack_bin_body(offsets.data(), static_cast<uint32_t>(offsets.size()));
+        };
+        pack_data(p, {string_array}, little_endian(std::vector<double>{0.0}));
+    });
+
+    CHECK_THROWS_WITH(
+        Trajectory::memory_reader(buffer.data(), buffer.size(), "BinaryCIF"),
+        "invalid BinaryCIF: StringArray offsets and indices must be integers"
+    );
+}
@@ -0,0 +1,323 @@
+// Chemfiles, a modern library for chemistry file reading and writing
+// Copyright (C) Guillaume Fraux and contributors -- BSD license
+
+#include <fstream>
+#include <algorithm>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+#include "chemfiles.hpp"
+using namespace chemfiles;
+
+static Frame test_frame(size_t step, size_t natoms) {
+    auto frame = Frame(UnitCell({10, 11, 12}, {90, 80, 120}));
+    frame.set_step(step);
+    frame.set("name", "test frame");
+    frame.set("time", 0.5 * static_cast<double>(step));
+    frame.set("direction", Vector3D(1, 0, -1));
+    frame.set("is_test", true);
+    frame.add_velocities();
+
+    for (size_t i = 0; i < natoms; i++) {
+        auto atom = Atom(i % 2 ? "H" : "O");
+        atom.set_mass(static_cast<double>(i) + 0.25);
+        atom.set_charge(-0.5 * static_cast<double>(i));
+        if (i == 1) {
+            atom.set("special", "yes");
+            atom.set("dipole", Vector3D(1, 2, 3));
+        }
+        auto value = static_cast<double>(i + step);
+        frame.add_atom(std::move(atom), Vector3D(value, value / 3.0, -value), Vector3D(0.1, value, 1e-8 * value));
+    }
+
+    frame.add_bond(0, 1);
+    frame.add_bond(1, 2, Bond::DOUBLE);
+    auto residue = Residue("ALA", 42);
+    residue.add_atom(0);
+    residue.add_atom(1);
+    residue.set("chainid", "A");
+    frame.add_residue(residue);
+    frame.add_residue(Residue("no id"));
+
+    auto energy = frame.add_column<double>("energy");
+    auto force = frame.add_column<Vector3D>("force");
+    for (size_t i = 0; i < natoms; i++) {
+        energy[i] = 1.0 / static_cast<double>(i + 1);
+        force[i] = Vector3D(static_cast<double>(i), 0.1, -0.2);
+    }
+
+    return frame;
+}
+
+static void check_frame(const Frame& actual, const Frame& expected) {
+    CHECK(actual.size() == expected.size());
+    CHECK(actual.step() == expected.step());
+    CHECK(actual.cell() == expected.cell());
+    CHECK(actual.cell().shape() == expected.cell().shape());
+    CHECK(actual.properties() == expected.properties());
+
+    CHECK(actual.positions() == expected.positions());
+    REQUIRE(actual.velocities());
+    CHECK(*actual.velocities() == *expected.velocities());
+
+    CHECK(actual.columns() == expected.columns());
+    CHECK(*actual.column<double>("energy") == *expected.column<double>("energy"));
+    CHECK(*actual.column<Vector3D>("force") == *expected.column<Vector3D>("force"));
+
+    const auto& topology = actual.topology();
+    const auto& expected_topology = expected.topology();
+    for (size_t i = 0; i < topology.size(); i++) {
+        CHECK(topology[i] == expected_topology[i]);
+    }
+    CHECK(topology.bonds() == expected_topology.bonds());
+    CHECK(topology.bond_orders() == expected_topology.bond_orders());
+    CHECK(topology.residues() == expected_topology.residues());
+}
+
+TEST_CASE("Read and write Chemfiles Binary files") {
+    auto frames = std::vector<Frame>();
+    frames.push_back(test_frame(0, 10));
+    frames.push_back(test_frame(10, 10));
+    // more atoms than fit in a single compressed block
+    frames.push_back(test_frame(20, 100000));
+    frames[1].set("name", "second frame");
+    frames[1].set_cell(UnitCell());
+
+    for (auto format: {"Chemfiles Binary", "Chemfiles Binary / GZ", "Chemfiles Binary / XZ"}) {
+        auto tmpfile = NamedTempPath(".chfl");
+        {
+            auto file = Trajectory(tmpfile, 'w', format);
+            for (const auto& frame: frames) {
+                file.write(frame);
+            }
+        }
+
+        auto file = Trajectory(tmpfile);
+        REQUIRE(file.nsteps() == 3);
+
+        auto frame = file.read();
+        check_frame(frame, frames[0]);
+        frame = file.read();
+        check_frame(frame, frames[1]);
+        CHECK(frame.cell().shape() == UnitCell::INFINITE);
+        frame = file.read();
+        check_frame(frame, frames[2]);
+
+        frame = file.read_step(1);
+        check_frame(frame, frames[1]);
+        frame = file.read_step(0);
+        check_frame(frame, frames[0]);
+    }
+}
+
+TEST_CASE("Chemfiles Binary files with single precision frames") {
+    auto tmpfile = NamedTempPath(".chfl");
+    auto frame = test_frame(0, 10);
+    frame.positions()[3] = Vector3D(0.1, 0.2, 0.3);
+    frame.set_single_precision(true);
+    {
+        auto file = Trajectory(tmpfile, 'w', "Chemfiles Binary / GZ");
+        file.write(frame);
+    }
+
+    auto file = Trajectory(tmpfile);
+    auto read = file.read();
+    CHECK_FALSE(read.single_precision());
+    CHECK(read.positions()[3] == Vector3D(
+        static_cast<double>(0.1f), static_cast<double>(0.2f), static_cast<double>(0.3f)
+    ));
+
+    file.set_single_precision(true);
+    read = file.read_step(0);
+    CHECK(read.single_precision());
+    CHECK(read.positions_f32() == frame.positions_f32());
+    CHECK(*read.velocities_f32() == *frame.velocities_f32());
+
+    // double precision data read in a single precision frame
+    tmpfile = NamedTempPath(".chfl");
+    frame.set_single_precision(false);
+    {
+        auto file = Trajectory(tmpfile, 'w');
+        file.write(frame);
+    }
+    file = Trajectory(tmpfile);
+    file.set_single_precision(true);
+    read = file.read();
+    CHECK(read.positions_f32()[3] == Vector3F{0.1f, 0.2f, 0.3f});
+}
+
+TEST_CASE("Append to Chemfiles Binary files") {
+    auto tmpfile = NamedTempPath(".chfl");
+    auto first = test_frame(0, 10);
+    auto second = test_frame(1, 12);
+    {
+        auto file = Trajectory(tmpfile, 'w');
+        file.write(first);
+    }
+    {
+        auto file = Trajectory(tmpfile, 'a', "Chemfiles Binary / XZ");
+        CHECK(file.nsteps() == 1);
+        file.write(second);
+        file.write(first);
+    }
+
+    auto file = Trajectory(tmpfile);
+    REQUIRE(file.nsteps() == 3);
+    check_frame(file.read(), first);
+    check_frame(file.read(), second);
+    check_frame(file.read(), first);
+}
+
+TEST_CASE("Chemfiles Binary files without index") {
+    auto tmpfile = NamedTempPath(".chfl");
+    auto frame = test_frame(0, 10);
+    {
+        auto file = Trajectory(tmpfile, 'w', "Chemfiles Binary / GZ");
+        file.write(frame);
+        file.write(frame);
+    }
+
+    // remove the index and the end of the second frame, as if the writer had
+    // been interrupted
+    auto content = read_binary_file(tmpfile);
+    {
+        std::ofstream file(tmpfile, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size() - 70));
+    }
+
+    std::string warning;
+    set_warning_callback([&](const std::string& message) {
+        warning = message;
+    });
+
+    auto file = Trajectory(tmpfile);
+    CHECK(warning == "Chemfiles Binary reader: ignoring incomplete block at the end of '" + tmpfile.path() + "'");
+    REQUIRE(file.nsteps() == 1);
+    check_frame(file.read(), frame);
+
+    set_warning_callback([](const std::string&) {});
+}
+
+TEST_CASE("Errors in Chemfiles Binary format") {
+    auto tmpfile = NamedTempPath(".chfl");
+    {
+        std::ofstream file(tmpfile);
+        file << "not a chemfiles file";
+    }
+    CHECK_THROWS_WITH(Trajectory(tmpfile),
+        "'" + tmpfile.path() + "' is not a Chemfiles Binary file"
+    );
+
+    CHECK_THROWS_WITH(Trajectory(tmpfile, 'w', "Chemfiles Binary / BZ2"),
+        "bzip2 compression is not supported by Chemfiles Binary format, use GZ or XZ instead"
+    );
+}
+
+TEST_CASE("Invalid topology blocks in Chemfiles Binary format") {
+    auto tmpfile = NamedTempPath(".chfl");
+    {
+        auto file = Trajectory(tmpfile, 'w', "Chemfiles Binary / GZ");
+        file.write(test_frame(0, 10));
+    }
+    auto content = read_binary_file(tmpfile);
+
+    // the topology is the first block after the 16 bytes header, and its
+    // content starts with the codec, the raw size and the stored size
+    const size_t raw_size_offset = 16 + 12 + 1;
+    const size_t stored_size_offset = raw_size_offset + 8;
+    auto read_u64 = [&](size_t offset) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < 8; i++) {
+            value |= static_cast<uint64_t>(content[offset + i]) << (8 * i);
+        }
+        return value;
+    };
+    auto write_u64 = [&](size_t offset, uint64_t value) {
+        auto patched = content;
+        for (size_t i = 0; i < 8; i++) {
+            patched[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+        std::ofstream file(tmpfile, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(patched.data()), static_cast<std::streamsize>(patched.size()));
+    };
+    auto stored_size = read_u64(stored_size_offset);
+
+    SECTION("Raw size") {
+        // this would allocate 1 EiB when reading the topology
+        write_u64(raw_size_offset, uint64_t(1) << 60);
+        auto file = Trajectory(tmpfile);
+        CHECK_THROWS_WITH(file.read(),
+            "invalid topology block in Chemfiles Binary file '" + tmpfile.path() + "': " +
+            std::to_string(stored_size) + " bytes can not be decompressed to 1152921504606846976 bytes"
+        );
+    }
+
+    SECTION("Stored size") {
+        write_u64(stored_size_offset, stored_size + 100);
+        auto file = Trajectory(tmpfile);
+        CHECK_THROWS_WITH(file.read(),
+            "invalid topology block in Chemfiles Binary file '" + tmpfile.path() + "': expected " +
+            std::to_string(stored_size) + " bytes of data, got " + std::to_string(stored_size + 100)
+        );
+    }
+}
+
+TEST_CASE("Invalid frame blocks in Chemfiles Binary format") {
+    auto tmpfile = NamedTempPath(".chfl");
+    {
+        auto file = Trajectory(tmpfile, 'w', "Chemfiles Binary / GZ");
+        file.write(test_frame(0, 10));
+    }
+    auto content = read_binary_file(tmpfile);
+
+    auto read_u64 = [&](size_t offset) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < 8; i++) {
+            value |= static_cast<uint64_t>(content[offset + i]) << (8 * i);
+        }
+        return value;
+    };
+    auto write_u64 = [&](size_t offset, uint64_t value) {
+        auto patched = content;
+        for (size_t i = 0; i < 8; i++) {
+            patched[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+        std::ofstream file(tmpfile, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(patched.data()), static_cast<std::streamsize>(patched.size()));
+    };
+
+    // the frame block comes after the 16 bytes header and the topology block.
+    // The frame header starts after the block kind, the block size and the
+    // header size, with the step, the topology index and the number of atoms.
+    auto frame_offset = static_cast<size_t>(16 + 12 + read_u64(16 + 4));
+    const size_t natoms_offset = frame_offset + 4 + 8 + 8 + 8 + 8;
+    REQUIRE(read_u64(natoms_offset) == 10);
+
+    SECTION("Number of atoms") {
+        // this would allocate memory for 2^40 atoms when reading the frame
+        write_u64(natoms_offset, uint64_t(1) << 40);
+        auto file = Trajectory(tmpfile);
+        CHECK_THROWS_WITH(file.read(),
+            "invalid frame block in Chemfiles Binary file '" + tmpfile.path() + "': "
+            "expected 10 atoms from the topology, got 1099511627776"
+        );
+    }
+
+    SECTION("Block size") {
+        // the last column is "force", followed by its type, width, codec,
+        // number of values per block, number of blocks and blocks sizes
+        auto name = std::string("force");
+        auto position = std::search(content.begin() + static_cast<std::ptrdiff_t>(frame_offset), content.end(), name.begin(), name.end());
+        REQUIRE(position != content.end());
+        auto block_size_offset = static_cast<size_t>(position - content.begin()) + name.size() + 3 + 8 + 8;
+        REQUIRE(read_u64(block_size_offset - 8) == 1);
+
+        // 30 values of 8 bytes can not fit in an empty compressed block
+        write_u64(block_size_offset, 0);
+        auto file = Trajectory(tmpfile);
+        CHECK_THROWS_WITH(file.read(),
+            "invalid frame block in Chemfiles Binary file '" + tmpfile.path() + "': "
+            "0 bytes can not be decompressed to 240 bytes"
+        );
+    }
+}
@@ -291,6 +291,36 @@ TEST_CASE("Read and write files in memory") {
         CHECK(approx_eq(positions[1], Vector3D(25.66, 25.37, 18.33), 1e-2));
         CHECK(approx_eq(positions[678], Vector3D(27.57, 32.25, 37.53), 1e-2));
     }
+
+    SECTION("Large frames") {
+        // frames with many atoms are parsed by multiple threads
+        const size_t natoms = 30000;
+        auto content = std::string("water\n" + std::to_string(natoms) + "\n");
+        for (size_t i = 0; i < natoms; i++) {
+            auto resid = std::to_string(i / 3 + 1);
+            content += std::string(5 - resid.size(), ' ') + resid + "SOL  ";
+            content += (i % 3 == 0) ? "   OW" : "   HW";
+            content += "    1   0.125   0.250   1.000  0.1000  0.2000  0.3000\n";
+        }
+        content += "   3.00000   3.00000   3.00000\n";
+
+        auto file = Trajectory::memory_reader(content.data(), content.size(), "GRO");
+        auto frame = file.read();
+        REQUIRE(frame.size() == natoms);
+        CHECK(frame.topology().residues().size() == natoms / 3);
+
+        auto positions = frame.positions();
+        auto velocities = *frame.velocities();
+        for (size_t i = 0; i < natoms; i++) {
+            CHECK(frame[i].name() == ((i % 3 == 0) ? "OW" : "HW"));
+            CHECK(approx_eq(positions[i], Vector3D(1.25, 2.5, 10.0), 1e-12));
+            CHECK(approx_eq(velocities[i], Vector3D(1.0, 2.0, 3.0), 1e-12));
+            auto residue = frame.topology().residue_for_atom(i);
+            REQUIRE(residue);
+            CHECK(residue->id().value() == static_cast<int64_t>(i / 3 + 1));
+            CHECK(residue->name() == "SOL");
+        }
+    }
 }
 
 
@@ -1,9 +1,19 @@
 // Chemfiles, a modern library for chemistry file reading and writing
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
 
+#include <cstdio>
+#include <fstream>
+
 #include "catch.hpp"
 #include "chemfiles.hpp"
 #include "helpers.hpp"
+
+#include "chemfiles/files/BinaryFile.hpp"
+
+#ifndef CHEMFILES_WINDOWS
+#include <sys/resource.h>
+#endif
+
 using namespace chemfiles;
 
 // {wrapped, scaled_wrapped, unwrapped, scaled_unwrapped}.lammpstrj
@@ -174,12 +184,12 @@ TEST_CASE("Read files in LAMMPS Atom format") {
         CHECK(approx_eq(positions[390], Vector3D(10.4004,12.4805, 0.693361), 1e-3));
         CHECK(approx_eq(positions[789], Vector3D(10.4004,13.1739, 1.38672), 1e-3));
 
-        CHECK(approx_eq(frame[390].get("c_stress[6]")->as_double(), -1.38816, 1e-3));
-        CHECK(approx_eq(frame[390].get("v_sq_pos")->as_double(), 264.412, 1e-3));
-        CHECK(approx_eq(frame[390].get("i_flag")->as_double(), 1.0, 1e-12));
-        CHECK(approx_eq(frame[789].get("c_stress[1]")->as_double(), -59.7086, 1e-3));
-        CHECK(approx_eq(frame[789].get("v_sq_pos")->as_double(), 283.642, 1e-3));
-        CHECK(approx_eq(frame[789].get("i_flag")->as_double(), 0.0, 1e-12));
+        CHECK(approx_eq(frame.column<double>("c_stress[6]").value()[390], -1.38816, 1e-3));
+        CHECK(approx_eq(frame.column<double>("v_sq_pos").value()[390], 264.412, 1e-3));
+        CHECK(approx_eq(frame.column<double>("i_flag").value()[390], 1.0, 1e-12));
+        CHECK(approx_eq(frame.column<double>("c_stress[1]").value()[789], -59.7086, 1e-3));
+        CHECK(approx_eq(frame.column<double>("v_sq_pos").value()[789], 283.642, 1e-3));
+        CHECK(approx_eq(frame.column<double>("i_flag").value()[789], 0.0, 1e-12));
 
         frame = file.read_step(3);
         CHECK(frame.size() == 4000);
@@ -190,12 +200,12 @@ TEST_CASE("Read files in LAMMPS Atom format") {
         CHECK(approx_eq(positions[2988], Vector3D(9.71147, 5.5884, 9.71147), 1e-3));
         CHECK(approx_eq(positions[3905], Vector3D(9.01993, 10.4242, 12.4797), 1e-3));
 
-        CHECK(approx_eq(frame[2988].get("c_stress[5]")->as_double(), 12.9949, 1e-3));
-        CHECK(approx_eq(frame[2988].get("v_sq_pos")->as_double(), 219.855, 1e-3));
-        CHECK(approx_eq(frame[2988].get("i_flag")->as_double(), 1.0, 1e-12));
-        CHECK(approx_eq(frame[3905].get("c_stress[2]")->as_double(), -67.6015, 1e-3));
-        CHECK(approx_eq(frame[3905].get("v_sq_pos")->as_double(), 345.766, 1e-3));
-        CHECK(approx_eq(frame[3905].get("i_flag")->as_double(), 0.0, 1e-12));
+        CHECK(approx_eq(frame.column<double>("c_stress[5]").value()[2988], 12.9949, 1e-3));
+        CHECK(approx_eq(frame.column<double>("v_sq_pos").value()[2988], 219.855, 1e-3));
+        CHECK(approx_eq(frame.column<double>("i_flag").value()[2988], 1.0, 1e-12));
+        CHECK(approx_eq(frame.column<double>("c_stress[2]").value()[3905], -67.6015, 1e-3));
+        CHECK(approx_eq(frame.column<double>("v_sq_pos").value()[3905], 345.766, 1e-3));
+        CHECK(approx_eq(frame.column<double>("i_flag").value()[3905], 0.0, 1e-12));
 
     }
 
@@ -429,6 +439,39 @@ ITEM: ATOMS id type x y z
         CHECK(frame[1].type() == "5");
     }
 
+    SECTION("Large frames") {
+        // frames with many atoms are parsed by multiple threads
+        const size_t natoms = 50000;
+        auto content = std::string(
+            "ITEM: TIMESTEP\n0\nITEM: NUMBER OF ATOMS\n" + std::to_string(natoms) + "\n"
+            "ITEM: BOX BOUNDS pp pp pp\n0 20\n0 30\n0 40\n"
+            "ITEM: ATOMS id type x y z vx c_foo\n"
+        );
+        // atoms are stored in reverse order in the file
+        for (size_t i = natoms; i > 0; i--) {
+            content += std::to_string(i) + " " + std::to_string(i % 3 + 1) + " ";
+            content += std::to_string(i) + " 1 2 " + std::to_string(2 * i) + " 0.5\n";
+        }
+
+        auto file = Trajectory::memory_reader(content.data(), content.size(), "LAMMPS");
+        auto frame = file.read();
+        REQUIRE(frame.size() == natoms);
+        auto positions = frame.positions();
+        auto velocities = *frame.velocities();
+        auto foo = *frame.column<double>("c_foo");
+        for (size_t i = 0; i < natoms; i++) {
+            CHECK(positions[i] == Vector3D(static_cast<double>(i + 1), 1, 2));
+            CHECK(velocities[i][0] == 2.0 * static_cast<double>(i + 1));
+            CHECK(frame[i].type() == std::to_string((i + 1) % 3 + 1));
+            CHECK(foo[i] == 0.5);
+        }
+
+        // duplicated atom ids
+        content.replace(content.rfind("\n1 2 1 1 2"), 2, "\n2");
+        file = Trajectory::memory_reader(content.data(), content.size(), "LAMMPS");
+        CHECK_THROWS_WITH(file.read(), "found atoms with the same ID in LAMMPS format: 2 is already present");
+    }
+
     SECTION("Frame properties") {
         std::string content(R"(ITEM: UNITS
 lj
@@ -530,6 +573,34 @@ ITEM: ATOMS type element z mass y x vy vz q id
         CHECK(approx_eq(frame[1].charge(), 2.5, 1e-6));
     }
 
+    SECTION("Custom atom properties") {
+        std::string content(R"(ITEM: TIMESTEP
+0
+ITEM: NUMBER OF ATOMS
+3
+ITEM: BOX BOUNDS pp pp pp
+0.0 10.0
+0.0 10.0
+0.0 10.0
+ITEM: ATOMS id type x y z c_pe v_label
+3 1 0.0 0.0 0.0 -3.5 abc
+1 1 1.0 1.0 1.0 -1.5 def
+2 1 2.0 2.0 2.0 bad ghi
+)");
+
+        auto file = Trajectory::memory_reader(content.data(), content.size(), "LAMMPS");
+        auto frame = file.read();
+        CHECK(frame.columns() == std::vector<std::string>{"c_pe"});
+
+        auto energy = frame.column<double>("c_pe").value();
+        CHECK(energy[0] == -1.5);
+        CHECK(energy[2] == -3.5);
+        CHECK_FALSE(frame[0].get("c_pe"));
+        // values which are not numbers are stored as string properties
+        CHECK(frame[1].get("c_pe")->as_string() == "bad");
+        CHECK(frame[2].get("v_label")->as_string() == "abc");
+    }
+
     SECTION("Best position representation") {
         std::string content(R"(ITEM: TIMESTEP
 0
@@ -625,3 +696,356 @@ ITEM: ATOMS id type xs ys zs ix iy iz
         CHECK(approx_eq(positions[0], Vector3D(44.0, 28.5, 16.0), 1e-3));
     }
 }
+
+/// Write a single step of a LAMMPS binary dump, using the same layout as
+/// LAMMPS. The `values` contain `size_one` values for each atom, and are split
+/// in `nchunks` chunks, as if they were written by multiple processes. Like
+/// LAMMPS, the unit style is only written in the `first_step` of a dump.
+static void write_binary_step(BinaryFile& file, bool first_step, int64_t timestep, const std::string& columns, int32_t size_one, const std::vector<double>& values, int32_t nchunks) {
+    auto natoms = static_cast<int64_t>(values.size()) / size_one;
+
+    file.write_single_i64(-10);
+    file.write_char("DUMPCUSTOM", 10);
+    file.write_single_i32(1);
+    file.write_single_i32(2);
+
+    file.write_single_i64(timestep);
+    file.write_single_i64(natoms);
+    // triclinic
+    file.write_single_i32(1);
+    int32_t boundary[6] = {0, 0, 0, 0, 0, 0};
+    file.write_i32(boundary, 6);
+    double bounds[6] = {-1.0, 9.0, 0.0, 20.0, 0.0, 30.0};
+    file.write_f64(bounds, 6);
+    double tilts[3] = {1.0, 0.0, 2.0};
+    file.write_f64(tilts, 3);
+    file.write_single_i32(size_one);
+
+    if (first_step) {
+        file.write_single_i32(4);
+        file.write_char("real", 4);
+    } else {
+        file.write_single_i32(0);
+    }
+    file.write_single_char(1);
+    file.write_single_f64(static_cast<double>(timestep) * 0.5);
+    file.write_single_i32(static_cast<int32_t>(columns.size()));
+    file.write_char(columns.data(), columns.size());
+
+    file.write_single_i32(nchunks);
+    auto per_chunk = static_cast<size_t>((natoms + nchunks - 1) / nchunks) * static_cast<size_t>(size_one);
+    for (size_t start = 0; start < values.size(); start += per_chunk) {
+        auto count = std::min(per_chunk, values.size() - start);
+        file.write_single_i32(static_cast<int32_t>(count));
+        file.write_f64(values.data() + start, count);
+    }
+}
+
+TEST_CASE("Read files in LAMMPS binary format") {
+    auto columns = std::string("id type xs ys zs ix vx vy vz q c_pe");
+    // atoms are not sorted by id
+    auto values = std::vector<double> {
+        2, 1, 0.5, 0.5, 0.5, 0, 1.0, 2.0, 3.0, -0.5, 42.0,
+        1, 2, 0.1, 0.2, 0.3, 1, 0.0, 0.0, 0.0, 0.5, 33.0,
+        3, 2, 0.0, 0.0, 0.0, 0, 0.0, 0.0, 0.0, 0.0, 0.0,
+    };
+
+    SECTION("Read steps") {
+        auto filename = NamedTempPath(".bin");
+        {
+            auto file = LittleEndianFile(filename, File::WRITE);
+            write_binary_step(file, true, 0, columns, 11, values, 2);
+            values[2] = 0.25;
+            write_binary_step(file, false, 100, columns, 11, values, 1);
+            values[2] = 0.75;
+            write_binary_step(file, false, 200, columns, 11, values, 3);
+        }
+
+        auto file = Trajectory(filename);
+        REQUIRE(file.nsteps() == 3);
+
+        auto frame = file.read();
+        CHECK(frame.size() == 3);
+        CHECK(frame.step() == 0);
+        CHECK(frame.get("time")->as_double() == 0);
+        CHECK(frame.get("lammps_units")->as_string() == "real");
+
+        auto matrix = frame.cell().matrix();
+        CHECK(matrix == Matrix3D(10.0, 1.0, 0.0, 0.0, 20.0, 2.0, 0.0, 0.0, 30.0));
+
+        auto positions = frame.positions();
+        // x = xlo + xs * lx + ys * xy + zs * xz + ix * lx
+        CHECK(approx_eq(positions[0], Vector3D(10.2, 4.6, 9.0), 1e-12));
+        CHECK(approx_eq(positions[1], Vector3D(4.5, 11.0, 15.0), 1e-12));
+        CHECK(approx_eq(positions[2], Vector3D(-1.0, 0.0, 0.0), 1e-12));
+
+        REQUIRE(frame.velocities());
+        auto velocities = *frame.velocities();
+        CHECK(velocities[1] == Vector3D(1.0, 2.0, 3.0));
+
+        CHECK(frame[0].type() == "2");
+        CHECK(frame[1].type() == "1");
+        CHECK(frame[0].charge() == 0.5);
+        CHECK(frame[1].charge() == -0.5);
+
+        auto pe = frame.column<double>("c_pe");
+        REQUIRE(pe);
+        CHECK((*pe)[0] == 33.0);
+        CHECK((*pe)[1] == 42.0);
+
+        // the unit style is only in the first step
+        frame = file.read_step(1);
+        CHECK(frame.step() == 100);
+        CHECK(frame.get("time")->as_double() == 50);
+        CHECK(frame.get("lammps_units")->as_string() == "real");
+        CHECK(approx_eq(frame.positions()[1], Vector3D(2.0, 11.0, 15.0), 1e-12));
+
+        frame = file.read();
+        CHECK(frame.step() == 200);
+        CHECK(frame.get("time")->as_double() == 100);
+        CHECK(frame.get("lammps_units")->as_string() == "real");
+        CHECK(approx_eq(frame.positions()[1], Vector3D(7.0, 11.0, 15.0), 1e-12));
+
+        frame = file.read_step(0);
+        CHECK(frame.step() == 0);
+        CHECK(approx_eq(frame.positions()[1], Vector3D(4.5, 11.0, 15.0), 1e-12));
+    }
+
+    SECTION("Incomplete last step") {
+        auto filename = NamedTempPath(".bin");
+        {
+            auto file = LittleEndianFile(filename, File::WRITE);
+            write_binary_step(file, true, 0, columns, 11, values, 1);
+            // only write the header of the next step
+            file.write_single_i64(-10);
+            file.write_char("DUMPCUSTOM", 10);
+        }
+
+        auto file = Trajectory(filename);
+        CHECK(file.nsteps() == 1);
+        auto frame = file.read();
+        CHECK(frame.size() == 3);
+    }
+
+    SECTION("Errors") {
+        auto filename = NamedTempPath(".bin");
+        {
+            auto file = LittleEndianFile(filename, File::WRITE);
+            file.write_single_i64(-8);
+            file.write_char("DUMPYAML", 8);
+        }
+        CHECK_THROWS_WITH(Trajectory(filename),
+            "unsupported LAMMPS binary dump style 'DUMPYAML'"
+        );
+
+        {
+            auto file = LittleEndianFile(filename, File::WRITE);
+            write_binary_step(file, true, 0, "id type x y", 11, values, 1);
+        }
+        auto file = Trajectory(filename);
+        CHECK_THROWS_WITH(file.read(),
+            "invalid LAMMPS binary dump: got 4 column names for 11 values per atom"
+        );
+
+        CHECK_THROWS_WITH(Trajectory(filename, 'w'),
+            "LAMMPS binary format only supports reading"
+        );
+    }
+}
+
+TEST_CASE("Read LAMMPS dumps split over multiple files") {
+    // all the files are created next to this (unique) temporary path
+    auto tmpfile = NamedTempPath("");
+    auto base = tmpfile.path();
+    // remove all the files created by this test at scope exit
+    struct CreatedFiles {
+        ~CreatedFiles() {
+            for (const auto& path: paths) {
+                std::remove(path.c_str());
+            }
+        }
+        void push_back(std::string path) {
+            paths.emplace_back(std::move(path));
+        }
+        std::vector<std::string> paths;
+    } created;
+
+    auto write_text = [&](const std::string& path, const std::string& content) {
+        std::ofstream file(path);
+        file << content;
+        created.push_back(path);
+    };
+
+    auto text_step = [](size_t timestep, const std::string& atoms, size_t natoms) {
+        return "ITEM: TIMESTEP\n" + std::to_string(timestep) + "\n" +
+               "ITEM: NUMBER OF ATOMS\n" + std::to_string(natoms) + "\n" +
+               "ITEM: BOX BOUNDS pp pp pp\n0 10\n0 10\n0 10\n" +
+               "ITEM: ATOMS id type x y z c_pe\n" + atoms;
+    };
+
+    SECTION("One file per timestep") {
+        write_text(base + ".0.lammpstrj", text_step(0, "1 1 0 0 0 1.0\n2 2 1 1 1 2.0\n", 2));
+        write_text(base + ".100.lammpstrj", text_step(100, "2 2 1 1 2 2.0\n1 1 0 0 1 1.0\n", 2));
+        // timesteps are sorted by value, not lexicographically
+        write_text(base + ".20.lammpstrj", text_step(20, "1 1 0 0 3 1.0\n2 2 1 1 3 2.0\n", 2));
+
+        auto file = Trajectory(base + ".*.lammpstrj");
+        REQUIRE(file.nsteps() == 3);
+
+        auto frame = file.read();
+        CHECK(frame.step() == 0);
+        CHECK(frame.size() == 2);
+
+        frame = file.read();
+        CHECK(frame.step() == 20);
+
+        frame = file.read_step(2);
+        CHECK(frame.step() == 100);
+        CHECK(frame.positions()[0] == Vector3D(0, 0, 1));
+        CHECK(frame.positions()[1] == Vector3D(1, 1, 2));
+        CHECK(frame[1].type() == "2");
+    }
+
+    SECTION("One file per processor") {
+        write_text(base + ".0.lammpstrj",
+            text_step(0, "4 1 4 0 0 4.0\n2 1 2 0 0 2.0\n", 2) +
+            text_step(10, "4 1 4 1 0 4.0\n1 1 1 1 0 1.0\n", 2)
+        );
+        write_text(base + ".1.lammpstrj",
+            text_step(0, "3 2 3 0 0 3.0\n1 2 1 0 0 1.0\n", 2) +
+            text_step(10, "3 2 3 1 0 3.0\n", 1)
+        );
+        write_text(base + ".2.lammpstrj",
+            text_step(0, "", 0) +
+            text_step(10, "2 2 2 1 0 2.0\n", 1)
+        );
+
+        auto file = Trajectory(base + ".%.lammpstrj");
+        REQUIRE(file.nsteps() == 2);
+
+        auto frame = file.read();
+        CHECK(frame.step() == 0);
+        REQUIRE(frame.size() == 4);
+        auto positions = frame.positions();
+        auto pe = *frame.column<double>("c_pe");
+        for (size_t i = 0; i < 4; i++) {
+            CHECK(positions[i] == Vector3D(static_cast<double>(i + 1), 0, 0));
+            CHECK(pe[i] == static_cast<double>(i + 1));
+        }
+        CHECK(frame[0].type() == "2");
+        CHECK(frame[1].type() == "1");
+
+        frame = file.read();
+        CHECK(frame.step() == 10);
+        REQUIRE(frame.size() == 4);
+        positions = frame.positions();
+        for (size_t i = 0; i < 4; i++) {
+            CHECK(positions[i] == Vector3D(static_cast<double>(i + 1), 1, 0));
+        }
+        CHECK(frame[1].type() == "2");
+    }
+
+    SECTION("Binary files per timestep and processor") {
+        auto columns = std::string("id type x y z");
+        auto write_binary = [&](const std::string& path, int64_t timestep, const std::vector<double>& values) {
+            {
+                auto file = LittleEndianFile(path, File::WRITE);
+                // each processor writes the unit style in its first file
+                write_binary_step(file, timestep == 0, timestep, columns, 5, values, 1);
+            }
+            created.push_back(path);
+        };
+
+        write_binary(base + ".0.0.bin", 0, {2, 1, 2.0, 0, 0});
+        write_binary(base + ".0.1.bin", 0, {1, 1, 1.0, 0, 0, 3, 1, 3.0, 0, 0});
+        write_binary(base + ".5.0.bin", 5, {3, 1, 3.0, 5, 0});
+        write_binary(base + ".5.1.bin", 5, {1, 1, 1.0, 5, 0, 2, 1, 2.0, 5, 0});
+
+        auto file = Trajectory(base + ".*.%.bin");
+        REQUIRE(file.nsteps() == 2);
+
+        auto frame = file.read_step(1);
+        CHECK(frame.step() == 5);
+        // the unit style is taken from the first files
+        CHECK(frame.get("lammps_units")->as_string() == "real");
+        REQUIRE(frame.size() == 3);
+        auto positions = frame.positions();
+        CHECK(positions[0] == Vector3D(1.0, 5, 0));
+        CHECK(positions[1] == Vector3D(2.0, 5, 0));
+        CHECK(positions[2] == Vector3D(3.0, 5, 0));
+
+        frame = file.read_step(0);
+        CHECK(frame.step() == 0);
+        REQUIRE(frame.size() == 3);
+        CHECK(frame.positions()[2] == Vector3D(3.0, 0, 0));
+    }
+
+#ifndef CHEMFILES_WINDOWS
+    SECTION("More files than the limit of open files") {
+        // restrict the number of files this process can open at the same time
+        struct FilesLimit {
+            explicit FilesLimit(rlim_t limit) {
+                getrlimit(RLIMIT_NOFILE, &initial);
+                auto restricted = initial;
+                restricted.rlim_cur = limit;
+                setrlimit(RLIMIT_NOFILE, &restricted);
+            }
+            ~FilesLimit() {
+                setrlimit(RLIMIT_NOFILE, &initial);
+            }
+            struct rlimit initial;
+        };
+
+        const size_t count = 200;
+        for (size_t i = 0; i < count; i++) {
+            auto x = std::to_string(i);
+            write_text(base + ".step." + x + ".lammpstrj", text_step(i, "1 1 " + x + " 0 0 0.0\n", 1));
+            auto id = std::to_string(i + 1);
+            write_text(base + ".proc." + x + ".lammpstrj", text_step(0, id + " 1 " + x + " 0 0 0.0\n", 1));
+        }
+
+        auto limit = FilesLimit(64);
+
+        auto file = Trajectory(base + ".step.*.lammpstrj");
+        REQUIRE(file.nsteps() == count);
+        for (size_t i = 0; i < count; i++) {
+            auto frame = file.read();
+            CHECK(frame.step() == i);
+            CHECK(frame.positions()[0] == Vector3D(static_cast<double>(i), 0, 0));
+        }
+        auto frame = file.read_step(42);
+        CHECK(frame.step() == 42);
+
+        file = Trajectory(base + ".proc.%.lammpstrj");
+        REQUIRE(file.nsteps() == 1);
+        frame = file.read();
+        REQUIRE(frame.size() == count);
+        auto positions = frame.positions();
+        for (size_t i = 0; i < count; i++) {
+            CHECK(positions[i] == Vector3D(static_cast<double>(i), 0, 0));
+        }
+    }
+#endif
+
+    SECTION("Errors") {
+        CHECK_THROWS_WITH(Trajectory(base + ".*.lammpstrj"),
+            "could not find any file matching '" + base + ".*.lammpstrj'"
+        );
+
+        CHECK_THROWS_WITH(Trajectory(base + ".*.*.lammpstrj"),
+            "expected one '*' and/or one '%' wildcard in the file name for "
+            "LAMMPS multiple files, got '" + base + ".*.*.lammpstrj'"
+        );
+
+        write_text(base + ".0.lammpstrj", text_step(0, "1 1 0 0 0 1.0\n2 2 1 1 1 2.0\n", 2));
+        write_text(base + ".1.lammpstrj", text_step(0, "2 1 0 0 0 1.0\n3 2 1 1 1 2.0\n", 2));
+        auto file = Trajectory(base + ".%.lammpstrj");
+        CHECK_THROWS_WITH(file.read(),
+            "found atoms with the same ID in LAMMPS format: 2 is already present"
+        );
+
+        CHECK_THROWS_WITH(Trajectory(base + ".%.lammpstrj", 'w'),
+            "LAMMPS multiple files format only supports reading"
+        );
+    }
+}
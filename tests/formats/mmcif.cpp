@@ -231,4 +231,88 @@ TEST_CASE("Read and write files in memory") {
         CHECK(approx_eq(positions[0], Vector3D( -9.134, 11.149, 6.990), 1e-3));
         CHECK(approx_eq(positions[1401], Vector3D(4.437, -13.250, -22.569), 1e-3));
     }
+    SECTION("Quoted values and multiple models") {
+        auto content = std::string(
+            "data_TEST\n"
+            "_cell.length_a 10.0\n"
+            "_cell.length_b 10.0\n"
+            "_cell.length_c 10.0\n"
+            "#\n"
+            "loop_\n"
+            "_atom_site.group_PDB\n"
+            "_atom_site.id\n"
+            "_atom_site.type_symbol\n"
+            "_atom_site.label_atom_id\n"
+            "_atom_site.label_alt_id\n"
+            "_atom_site.label_comp_id\n"
+            "_atom_site.label_asym_id\n"
+            "_atom_site.label_entity_id\n"
+            "_atom_site.label_seq_id\n"
+            "_atom_site.Cartn_x\n"
+            "_atom_site.Cartn_y\n"
+            "_atom_site.Cartn_z\n"
+            "_atom_site.auth_asym_id\n"
+            "_atom_site.pdbx_PDB_model_num\n"
+            "ATOM   1 P P     . DA  A 1 1 1.000 2.000 3.000   A 1\n"
+            "ATOM   2 O \"O5'\" . DA  A 1 1 2.000 2.000 3.000   A 1\n"
+            "HETATM 3 C 'C 1' B LIG B 2 . 3.000 2.000 3.0(2) B 1\n"
+            "ATOM   4 P P     . DA  A 1 1 1.500 2.000 3.000   A 2\n"
+            "ATOM   5 O \"O5'\" . DA  A 1 1 2.500 2.000 3.000   A 2\n"
+            "HETATM 6 C 'C 1' B LIG B 2 . 3.500 2.000 3.0(2) B 2\n"
+            "#\n"
+        );
+
+        auto file = Trajectory::memory_reader(content.data(), content.size(), "mmCIF");
+        REQUIRE(file.nsteps() == 2);
+
+        auto frame = file.read();
+        REQUIRE(frame.size() == 3);
+        CHECK(frame[1].name() == "O5'");
+        CHECK(frame[2].name() == "C 1");
+        CHECK(frame[2].get("altloc")->as_string() == "B");
+        CHECK(approx_eq(frame.positions()[2], Vector3D(3.0, 2.0, 3.0), 1e-12));
+
+        const auto& topology = frame.topology();
+        REQUIRE(topology.residues().size() == 2);
+        CHECK(topology.residue_for_atom(1)->name() == "DA");
+        CHECK(topology.residue_for_atom(1)->size() == 2);
+        // residue id from the entity id
+        CHECK(topology.residue_for_atom(2)->id().value() == 2);
+        CHECK(topology.residue_for_atom(2)->get("chainname")->as_string() == "B");
+        CHECK_FALSE(topology.residue_for_atom(2)->get("is_standard_pdb")->as_bool());
+
+        frame = file.read();
+        REQUIRE(frame.size() == 3);
+        CHECK(frame[1].name() == "O5'");
+        CHECK(approx_eq(frame.positions()[0], Vector3D(1.5, 2.0, 3.0), 1e-12));
+    }
+
+    SECTION("Read files written by chemfiles") {
+        auto frame = Frame(UnitCell({10, 11, 12}));
+        frame.add_atom(Atom("N"), {1, 2, 3});
+        frame.add_atom(Atom("CA", "C"), {2, 2, 3});
+        frame.add_atom(Atom("Zn"), {5, 2, 3});
+        auto residue = Residue("GLY", 3);
+        residue.add_atom(0);
+        residue.add_atom(1);
+        residue.set("chainid", "A");
+        frame.add_residue(std::move(residue));
+
+        auto writer = Trajectory::memory_writer("mmCIF");
+        writer.write(frame);
+        writer.write(frame);
+        auto buffer = *writer.memory_buffer();
+        auto written = std::string(buffer.data(), buffer.size());
+
+        auto file = Trajectory::memory_reader(written.data(), written.size(), "mmCIF");
+        REQUIRE(file.nsteps() == 2);
+
+        frame = file.read_step(1);
+        REQUIRE(frame.size() == 3);
+        CHECK(frame[1].name() == "CA");
+        CHECK(frame[1].type() == "C");
+        CHECK(frame.topology().residues().size() == 1);
+        CHECK(frame.topology().residue_for_atom(1)->id().value() == 3);
+        CHECK_FALSE(frame.topology().residue_for_atom(2));
+    }
 }
@@ -163,6 +163,50 @@ TEST_CASE("Read files in MMTF format") {
         auto frame3 = file.read();
     }
 
+    SECTION("Lazy decoding of coordinates") {
+        // uncompressed files are read from memory-mapped data, and the
+        // coordinates are only decoded when reading the first frame
+        auto tmpfile = NamedTempPath(".mmtf");
+        {
+            auto trajectory = Trajectory(tmpfile, 'w');
+            for (size_t step = 0; step < 3; step++) {
+                auto frame = Frame();
+                auto shift = static_cast<double>(step);
+                frame.add_atom(Atom("O"), {shift, 0, 0});
+                frame.add_atom(Atom("H"), {shift + 1, 0, 0});
+                frame.add_bond(0, 1);
+                trajectory.write(frame);
+            }
+        }
+
+        auto check_frame = [](const Frame& frame, double shift) {
+            REQUIRE(frame.size() == 2);
+            CHECK(frame[0].name() == "O");
+            CHECK(approx_eq(frame.positions()[0], {shift, 0, 0}, 1e-3));
+            CHECK(approx_eq(frame.positions()[1], {shift + 1, 0, 0}, 1e-3));
+            CHECK(frame.topology().bonds() == std::vector<Bond>{{0, 1}});
+        };
+
+        auto file = Trajectory(tmpfile);
+        CHECK(file.nsteps() == 3);
+
+        // out of order, starting with the last step
+        check_frame(file.read_step(2), 2.0);
+        check_frame(file.read_step(0), 0.0);
+        // the same step twice
+        check_frame(file.read_step(1), 1.0);
+        check_frame(file.read_step(1), 1.0);
+        // sequential read after read_step
+        check_frame(file.read(), 2.0);
+
+        // the same from memory, starting with read_step
+        auto content = read_text_file(tmpfile);
+        file = Trajectory::memory_reader(content.data(), content.size(), "MMTF");
+        check_frame(file.read_step(1), 1.0);
+        check_frame(file.read_step(0), 0.0);
+        check_frame(file.read(), 1.0);
+    }
+
     SECTION("Alternative locations and symmetry operations") {
         auto file = Trajectory("data/mmtf/5A1I.mmtf");
 
@@ -636,4 +636,184 @@ TEST_CASE("Read and write files in memory") {
         CHECK(approx_eq(positions[0], Vector3D(0.299, 8.310, 11.721), 1e-4));
         CHECK(approx_eq(positions[296], Vector3D(6.798, 11.509, 12.704), 1e-4));
     }
+
+    SECTION("Models with the same topology") {
+        auto content = std::string(
+            "MODEL        1\n"
+            "ATOM      1  N   GLY A   1       1.000   2.000   3.000  1.00  0.00           N\n"
+            "ATOM      2  CA  GLY A   1       2.000   2.000   3.000  1.00  0.00           C\n"
+            "ATOM      3  C   GLY A   1       3.000   2.000   3.000  1.00  0.00           C\n"
+            "ATOM      4  O   GLY A   1       4.000   2.000   3.000  1.00  0.00           O\n"
+            "HETATM    5  O   WAT B   2       5.000   2.000   3.000  1.00  0.00           O\n"
+            "HETATM    6  H1  WAT B   2       6.000   2.000   3.000  1.00  0.00           H\n"
+            "CONECT    5    6\n"
+            "ENDMDL\n"
+            "MODEL        2\n"
+            "ATOM      1  N   GLY A   1       2.000   2.000   3.000  1.00  0.00           N\n"
+            "ATOM      2  CA  GLY A   1       3.000   2.000   3.000  1.00  0.00           C\n"
+            "ATOM      3  C   GLY A   1       4.000   2.000   3.000  1.00  0.00           C\n"
+            "ATOM      4  O   GLY A   1       5.000   2.000   3.000  1.00  0.00           O\n"
+            "HETATM    5  O   WAT B   2       6.000   2.000   3.000  1.00  0.00           O\n"
+            "HETATM    6  H1  WAT B   2       7.000   2.000   3.000  1.00  0.00           H\n"
+            "CONECT    5    6\n"
+            "ENDMDL\n"
+            "MODEL        3\n"
+            "ATOM      1  N   GLY A   1       3.000   2.000   3.000  1.00  0.00           N\n"
+            "ATOM      2  CA  GLY A   1       4.000   2.000   3.000  1.00  0.00           C\n"
+            "ATOM      3  C   GLY A   1       5.000   2.000   3.000  1.00  0.00           C\n"
+            "ATOM      4  O   GLY A   1       6.000   2.000   3.000  1.00  0.00           O\n"
+            "HETATM    5  O   HOH B   2       7.000   2.000   3.000  1.00  0.00           O\n"
+            "HETATM    6  H1  HOH B   2       8.000   2.000   3.000  1.00  0.00           H\n"
+            "CONECT    5    6\n"
+            "ENDMDL\n"
+            "MODEL        4\n"
+            "ATOM      1  N   GLY A   1       4.000   2.000   3.000  1.00  0.00           N\n"
+            "ATOM      2  CA  GLY A   1       5.000   2.000   3.000  1.00  0.00           C\n"
+            "ATOM      3  C   GLY A   1       6.000   2.000   3.000  1.00  0.00           C\n"
+            "ATOM      4  O   GLY A   1       7.000   2.000   3.000  1.00  0.00           O\n"
+            "HETATM    5  O   HOH B   2       8.000   2.000   3.000  1.00  0.00           O\n"
+            "HETATM    6  H1  HOH B   2       9.000   2.000   3.000  1.00  0.00           H\n"
+            "ENDMDL\n"
+            "END\n"
+        );
+
+        auto file = Trajectory::memory_reader(content.data(), content.size(), "PDB");
+        REQUIRE(file.nsteps() == 4);
+
+        auto check_frame = [](const Frame& frame, double shift, const std::string& water, size_t nbonds) {
+            REQUIRE(frame.size() == 6);
+            CHECK(frame[1].name() == "CA");
+            CHECK(frame[4].type() == "O");
+            CHECK(approx_eq(frame.positions()[0], Vector3D(1.0 + shift, 2.0, 3.0), 1e-12));
+            CHECK(approx_eq(frame.positions()[5], Vector3D(6.0 + shift, 2.0, 3.0), 1e-12));
+
+            const auto& topology = frame.topology();
+            REQUIRE(topology.residues().size() == 2);
+            CHECK(topology.residue_for_atom(0)->name() == "GLY");
+            CHECK(topology.residue_for_atom(4)->name() == water);
+            CHECK(topology.bonds().size() == nbonds);
+        };
+
+        auto frame = file.read();
+        check_frame(frame, 0.0, "WAT", 4);
+
+        // same topology as the previous model
+        frame = file.read();
+        check_frame(frame, 1.0, "WAT", 4);
+
+        // different residue name
+        frame = file.read();
+        check_frame(frame, 2.0, "HOH", 4);
+
+        // missing CONECT record
+        frame = file.read();
+        check_frame(frame, 3.0, "HOH", 3);
+
+        // reading again an earlier step
+        frame = file.read_step(1);
+        check_frame(frame, 1.0, "WAT", 4);
+        CHECK(frame.step() == 1);
+    }
+}
+
+TEST_CASE("Bonds in standard residues") {
+    auto read_bonds = [](const std::string& content) {
+        auto file = Trajectory::memory_reader(content.data(), content.size(), "PDB");
+        return file.read().topology().bonds();
+    };
+
+    SECTION("Amino acids") {
+        auto content = std::string(
+            "ATOM      1  N   GLY A   1       0.000   0.000   0.000  1.00  0.00           N\n"
+            "ATOM      2  CA  GLY A   1       1.000   0.000   0.000  1.00  0.00           C\n"
+            "ATOM      3  C   GLY A   1       2.000   0.000   0.000  1.00  0.00           C\n"
+            "ATOM      4  O   GLY A   1       3.000   0.000   0.000  1.00  0.00           O\n"
+            "ATOM      5  N   GLY A   2       4.000   0.000   0.000  1.00  0.00           N\n"
+            "ATOM      6  CA  GLY A   2       5.000   0.000   0.000  1.00  0.00           C\n"
+            "ATOM      7  C   GLY A   2       6.000   0.000   0.000  1.00  0.00           C\n"
+            "ATOM      8  O   GLY A   2       7.000   0.000   0.000  1.00  0.00           O\n"
+            "ATOM      9  OXT GLY A   2       8.000   0.000   0.000  1.00  0.00           O\n"
+            "END\n"
+        );
+
+        auto expected = std::vector<Bond>{
+            // first residue
+            {0, 1}, {1, 2}, {2, 3},
+            // peptide bond
+            {2, 4},
+            // second residue
+            {4, 5}, {5, 6}, {6, 7}, {6, 8},
+        };
+        CHECK(read_bonds(content) == expected);
+    }
+
+    SECTION("Nucleotides") {
+        auto content = std::string(
+            "ATOM      1 HO5'  DC A   1       0.000   0.000   0.000  1.00  0.00           H\n"
+            "ATOM      2  O5'  DC A   1       1.000   0.000   0.000  1.00  0.00           O\n"
+            "ATOM      3  C5'  DC A   1       2.000   0.000   0.000  1.00  0.00           C\n"
+            "ATOM      4  C4'  DC A   1       3.000   0.000   0.000  1.00  0.00           C\n"
+            "ATOM      5  C3'  DC A   1       4.000   0.000   0.000  1.00  0.00           C\n"
+            "ATOM      6  O3'  DC A   1       5.000   0.000   0.000  1.00  0.00           O\n"
+            "ATOM      7  P    DC A   2       6.000   0.000   0.000  1.00  0.00           P\n"
+            "ATOM      8  OP1  DC A   2       7.000   0.000   0.000  1.00  0.00           O\n"
+            "ATOM      9  O5'  DC A   2       8.000   0.000   0.000  1.00  0.00           O\n"
+            "ATOM     10  C5'  DC A   2       9.000   0.000   0.000  1.00  0.00           C\n"
+            "END\n"
+        );
+
+        auto expected = std::vector<Bond>{
+            // first residue, including the HO5' special case
+            {0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5},
+            // phosphodiester bond
+            {5, 6},
+            // second residue
+            {6, 7}, {6, 8}, {8, 9},
+        };
+        CHECK(read_bonds(content) == expected);
+    }
+
+    SECTION("HO5' without O5'") {
+        // this used to create a bond between HO5' and the atom at index 0
+        auto content = std::string(
+            "ATOM      1  C5'  DC A   1       0.000   0.000   0.000  1.00  0.00           C\n"
+            "ATOM      2  C4'  DC A   1       1.000   0.000   0.000  1.00  0.00           C\n"
+            "ATOM      3 HO5'  DC A   1       2.000   0.000   0.000  1.00  0.00           H\n"
+            "END\n"
+        );
+
+        CHECK(read_bonds(content) == std::vector<Bond>{{0, 1}});
+    }
+
+    SECTION("P without O3'") {
+        // this used to access the O3' atom of the second residue, which does
+        // not exist
+        auto content = std::string(
+            "ATOM      1  C3'  DC A   1       0.000   0.000   0.000  1.00  0.00           C\n"
+            "ATOM      2  O3'  DC A   1       1.000   0.000   0.000  1.00  0.00           O\n"
+            "ATOM      3  P    DC A   2       2.000   0.000   0.000  1.00  0.00           P\n"
+            "ATOM      4  OP1  DC A   2       3.000   0.000   0.000  1.00  0.00           O\n"
+            "END\n"
+        );
+
+        CHECK(read_bonds(content) == (std::vector<Bond>{{0, 1}, {1, 2}, {2, 3}}));
+    }
+
+    SECTION("CONECT records") {
+        auto content = std::string(
+            "HETATM    1  C1  LIG A   1       0.000   0.000   0.000  1.00  0.00           C\n"
+            "HETATM    2  C2  LIG A   1       1.000   0.000   0.000  1.00  0.00           C\n"
+            "HETATM    3  O3  LIG A   1       2.000   0.000   0.000  1.00  0.00           O\n"
+            "HETATM    4  N4  LIG A   1       3.000   0.000   0.000  1.00  0.00           N\n"
+            "CONECT    1    2    3    4\n"
+            "CONECT    2    1\n"
+            "CONECT    3    1\n"
+            "CONECT    4    1    3   12\n"
+            "END\n"
+        );
+
+        // bonds are only added once, and indexes outside of the frame are
+        // ignored
+        CHECK(read_bonds(content) == (std::vector<Bond>{{0, 1}, {0, 2}, {0, 3}, {2, 3}}));
+    }
 }
@@ -96,16 +96,17 @@ TEST_CASE("Read files in XYZ format") {
 
         // Atom level properties
         CHECK(approx_eq(frame.positions()[0], {2.33827271799, 4.55315540425, 11.5841360926}, 1e-12));
-        CHECK(frame[0].get("CS_0")->as_double() == 24.10);
-        CHECK(frame[0].get("CS_1")->as_double() == 31.34);
+        CHECK(frame.column<double>("CS_0").value()[0] == 24.10);
+        CHECK(frame.column<double>("CS_1").value()[0] == 31.34);
 
-        CHECK(frame[51].get("CS_0")->as_double() == -73.98);
-        CHECK(frame[51].get("CS_1")->as_double() == -81.85);
+        CHECK(frame.column<double>("CS_0").value()[51] == -73.98);
+        CHECK(frame.column<double>("CS_1").value()[51] == -81.85);
+        CHECK_FALSE(frame[0].get("CS_0"));
 
         // different types
         frame = file.read();
         CHECK(frame.size() == 62);
-        CHECK(approx_eq(frame[0].get("CS")->as_vector3d(), {198.20, 202.27, 202.27}, 1e-12));
+        CHECK(approx_eq(frame.column<Vector3D>("CS").value()[0], {198.20, 202.27, 202.27}, 1e-12));
 
         // Different syntaxes for bool values
         frame = file.read();
@@ -119,7 +120,7 @@ TEST_CASE("Read files in XYZ format") {
         CHECK(frame[6].get("bool")->as_bool() == false);
         CHECK(frame[7].get("bool")->as_bool() == false);
 
-        CHECK(frame[0].get("int")->as_double() == 33.0);
+        CHECK(frame.column<double>("int").value()[0] == 33.0);
         CHECK(frame[0].get("strings_0")->as_string() == "bar");
         CHECK(frame[0].get("strings_1")->as_string() == "\"test\"");
     }
@@ -312,6 +313,30 @@ TEST_CASE("Read and write files in memory") {
         auto frame = file.read();
     }
 
+    SECTION("Large frames") {
+        // frames with many atoms are parsed by multiple threads
+        const size_t natoms = 50000;
+        auto content = std::to_string(natoms) + "\nProperties=species:S:1:pos:R:3:charge:R:1\n";
+        for (size_t i = 0; i < natoms; i++) {
+            content += (i % 2 == 0 ? "O " : "H ") + std::to_string(i) + " 1 2 -0.5\n";
+        }
+
+        auto file = Trajectory::memory_reader(content.data(), content.size(), "XYZ");
+        auto frame = file.read();
+        REQUIRE(frame.size() == natoms);
+        auto positions = frame.positions();
+        auto charges = *frame.column<double>("charge");
+        for (size_t i = 0; i < natoms; i++) {
+            CHECK(frame[i].name() == (i % 2 == 0 ? "O" : "H"));
+            CHECK(positions[i] == Vector3D(static_cast<double>(i), 1, 2));
+            CHECK(charges[i] == -0.5);
+        }
+
+        content.replace(content.rfind("1 2 -0.5"), 8, "1 2 bad");
+        file = Trajectory::memory_reader(content.data(), content.size(), "XYZ");
+        CHECK_THROWS_WITH(file.read(), "error while reading ' bad': can not parse 'bad' as a double");
+    }
+
     SECTION("Writing to memory") {
         const auto expected_content =
 R"(4
@@ -367,3 +392,57 @@ H 0.332 8.726 10.882
 
     CHECK(writer.memory_buffer().value() == EXPECTED);
 }
+
+TEST_CASE("Per-atom columns in extended XYZ") {
+    std::string EXPECTED =
+R"(3
+Properties=species:S:1:pos:R:3:charge:R:1:force:R:3:tag:S:1
+O 0.417 8.303 11.737 -0.8 1 2 3 water
+H 1.32 8.48 12.003 0.4 4 5 6 water
+H 0.332 8.726 10.882 0.4 7 8 9 water
+)";
+
+    auto frame = Trajectory::memory_reader(EXPECTED.data(), EXPECTED.size(), "XYZ").read();
+    CHECK(frame.columns() == std::vector<std::string>{"charge", "force"});
+
+    auto charges = frame.column<double>("charge").value();
+    CHECK(charges[0] == -0.8);
+    CHECK(charges[2] == 0.4);
+
+    auto forces = frame.column<Vector3D>("force").value();
+    CHECK(forces[1] == Vector3D(4, 5, 6));
+
+    // numeric properties are only stored in columns
+    CHECK(frame[2].get("tag")->as_string() == "water");
+    CHECK_FALSE(frame[0].get("charge"));
+    CHECK_FALSE(frame[1].get("force"));
+
+    auto writer = Trajectory::memory_writer("XYZ");
+    writer.write(frame);
+    CHECK(writer.memory_buffer().value() == EXPECTED);
+
+    SECTION("Modified columns are written") {
+        auto content = std::string(
+            "2\n"
+            "Properties=species:S:1:pos:R:3:charge_x:R:1\n"
+            "O 0 0 0 1.5\n"
+            "H 1 0 0 -0.5\n"
+        );
+        frame = Trajectory::memory_reader(content.data(), content.size(), "XYZ").read();
+        (*frame.column<double>("charge_x"))[0] = 99;
+
+        writer = Trajectory::memory_writer("XYZ");
+        writer.write(frame);
+        auto buffer = writer.memory_buffer().value();
+        auto written = std::string(buffer.data(), buffer.size());
+        CHECK(written.find("O 0 0 0 99\n") != std::string::npos);
+        CHECK(written.find("1.5") == std::string::npos);
+
+        // columns take precedence over atomic properties with the same name
+        frame[0].set("charge_x", 1.5);
+        frame[1].set("charge_x", 1.5);
+        writer = Trajectory::memory_writer("XYZ");
+        writer.write(frame);
+        CHECK(writer.memory_buffer().value() == written);
+    }
+}
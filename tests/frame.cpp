@@ -52,6 +52,58 @@ TEST_CASE("Frame size") {
     CHECK_THROWS_AS(frame.remove(15), OutOfBounds);
 }
 
+TEST_CASE("Remove multiple atoms and extract subsets") {
+    auto frame = Frame(UnitCell({10, 10, 10}));
+    frame.set_step(42);
+    frame.set("name", "test");
+    for (size_t i = 0; i < 6; i++) {
+        auto value = static_cast<double>(i);
+        frame.add_atom(Atom("X" + std::to_string(i)), Vector3D(value, 0, 0));
+    }
+    frame.add_bond(1, 2);
+    frame.add_bond(2, 5);
+
+    SECTION("Remove") {
+        frame.remove(std::vector<size_t>{0, 3});
+        REQUIRE(frame.size() == 4);
+        CHECK(frame.topology().size() == 4);
+        CHECK_FALSE(frame.velocities());
+        CHECK(frame.positions()[0] == Vector3D(1, 0, 0));
+        CHECK(frame.positions()[3] == Vector3D(5, 0, 0));
+        CHECK(frame.topology()[2].name() == "X4");
+        CHECK(frame.topology().bonds() == (std::vector<Bond>{{0, 1}, {1, 3}}));
+
+        frame.add_velocities();
+        (*frame.velocities())[2] = Vector3D(4, 4, 4);
+        frame.remove(std::vector<size_t>{0});
+        CHECK(frame.size() == 3);
+        CHECK(frame.velocities()->size() == 3);
+        CHECK((*frame.velocities())[1] == Vector3D(4, 4, 4));
+
+        CHECK_THROWS_AS(frame.remove(std::vector<size_t>{1, 3}), OutOfBounds);
+        CHECK(frame.size() == 3);
+    }
+
+    SECTION("Subset") {
+        frame.add_velocities();
+        (*frame.velocities())[5] = Vector3D(5, 5, 5);
+
+        auto subset = frame.subset({5, 2});
+        REQUIRE(subset.size() == 2);
+        CHECK(subset.step() == 42);
+        CHECK(subset.cell() == frame.cell());
+        CHECK(subset.get("name")->as_string() == "test");
+        CHECK(subset.positions()[0] == Vector3D(5, 0, 0));
+        CHECK(subset.positions()[1] == Vector3D(2, 0, 0));
+        CHECK((*subset.velocities())[0] == Vector3D(5, 5, 5));
+        CHECK(subset.topology()[0].name() == "X5");
+        CHECK(subset.topology().bonds() == (std::vector<Bond>{{0, 1}}));
+
+        CHECK(frame.size() == 6);
+        CHECK_THROWS_AS(frame.subset({1, 6}), OutOfBounds);
+    }
+}
+
 TEST_CASE("Positions and velocities") {
     auto frame = Frame();
     frame.resize(15);
@@ -80,6 +132,125 @@ TEST_CASE("Positions and velocities") {
     }
 }
 
+TEST_CASE("Single precision storage") {
+    auto frame = Frame();
+    frame.add_atom(Atom("H"), {1, 2, 3});
+    frame.add_atom(Atom("O"), {4, 5, 6});
+    frame.add_velocities();
+    CHECK_FALSE(frame.single_precision());
+    CHECK_THROWS_WITH(frame.positions_f32(),
+        "can not call `Frame::positions_f32` on a frame using double "
+        "precision storage, use `Frame::set_single_precision` first"
+    );
+
+    frame.set_single_precision(true);
+    CHECK(frame.single_precision());
+    CHECK(frame.positions_f32()[1] == (Vector3F{{4, 5, 6}}));
+    CHECK(frame.velocities_f32()->size() == 2);
+
+    frame.positions_f32()[0] = {{1.5f, 2.5f, 3.5f}};
+    frame.add_atom(Atom("C"), {7, 8, 9});
+    frame.remove(1);
+    CHECK(frame.size() == 2);
+    CHECK(frame.positions_f32()[1] == (Vector3F{{7, 8, 9}}));
+    CHECK(frame.distance(0, 1) == Approx(sqrt(5.5 * 5.5 * 3)));
+
+    // const accessors return a double precision copy, without converting
+    // the frame
+    const auto& const_frame = frame;
+    CHECK(const_frame.positions() == (std::vector<Vector3D>{{1.5, 2.5, 3.5}, {7, 8, 9}}));
+    CHECK(const_frame.velocities()->size() == 2);
+    CHECK(const_frame.positions_f32()[0] == (Vector3F{{1.5f, 2.5f, 3.5f}}));
+    CHECK(const_frame.velocities_f32()->size() == 2);
+    frame.positions_f32()[0][0] = 10;
+    CHECK(const_frame.positions_f32()[0] == (Vector3F{{10, 2.5f, 3.5f}}));
+    CHECK(frame.single_precision());
+
+    // the copy is updated after modifications of the frame
+    CHECK(const_frame.positions()[0] == Vector3D(10, 2.5, 3.5));
+    (*frame.velocities_f32())[1] = {{1, 2, 3}};
+    CHECK((*const_frame.velocities())[1] == Vector3D(1, 2, 3));
+    frame.add_atom(Atom("N"), {-1, -2, -3});
+    CHECK(const_frame.positions().size() == 3);
+    CHECK(const_frame.positions()[2] == Vector3D(-1, -2, -3));
+    frame.remove(2);
+    CHECK(const_frame.positions().size() == 2);
+    CHECK(frame.single_precision());
+
+    auto subset = const_frame.subset({1});
+    CHECK(subset.single_precision());
+    CHECK(subset.positions_f32()[0] == (Vector3F{{7, 8, 9}}));
+
+    // non-const accessors convert the frame to double precision
+    frame.positions()[1] = Vector3D(0, 0, 1);
+    CHECK_FALSE(frame.single_precision());
+    CHECK(frame.positions()[0] == Vector3D(10, 2.5, 3.5));
+    CHECK(frame.positions()[1] == Vector3D(0, 0, 1));
+    CHECK(frame.velocities()->size() == 2);
+}
+
+TEST_CASE("Per-atom columns") {
+    auto frame = Frame();
+    frame.resize(4);
+    CHECK(frame.columns().empty());
+
+    auto charges = frame.add_column<double>("charge");
+    CHECK(charges.size() == 4);
+    CHECK(charges[3] == 0);
+    for (size_t i=0; i<4; i++) {
+        charges[i] = static_cast<double>(i);
+    }
+
+    auto forces = frame.add_column<Vector3D>("force");
+    forces[2] = Vector3D(1, 2, 3);
+
+    // adding an existing column returns the existing data
+    CHECK(frame.add_column<double>("charge")[3] == 3);
+    CHECK_THROWS_WITH(frame.add_column<Vector3D>("charge"),
+        "can not add a column named 'charge' to this frame: there is already "
+        "a column with this name and a different type"
+    );
+
+    CHECK(frame.columns() == std::vector<std::string>{"charge", "force"});
+    CHECK(frame.column_kind("charge").value() == Property::DOUBLE);
+    CHECK(frame.column_kind("force").value() == Property::VECTOR3D);
+    CHECK_FALSE(frame.column_kind("foo"));
+    CHECK_FALSE(frame.column<double>("foo"));
+    CHECK_FALSE(frame.column<double>("force"));
+
+    // columns follow the atoms
+    frame.add_atom(Atom("H"), Vector3D());
+    CHECK(frame.column<double>("charge")->size() == 5);
+    CHECK(frame.column<double>("charge").value()[4] == 0);
+
+    frame.remove(0);
+    CHECK(frame.column<double>("charge").value()[0] == 1);
+    CHECK(frame.column<Vector3D>("force").value()[1] == Vector3D(1, 2, 3));
+
+    frame.remove(std::vector<size_t>{0, 3});
+    CHECK(frame.column<double>("charge")->size() == 2);
+    CHECK(frame.column<double>("charge").value()[0] == 2);
+    CHECK(frame.column<double>("charge").value()[1] == 3);
+
+    const auto& const_frame = frame;
+    auto subset = const_frame.subset({1, 0});
+    CHECK(subset.column<double>("charge").value()[0] == 3);
+    CHECK(subset.column<Vector3D>("force").value()[1] == Vector3D(1, 2, 3));
+    CHECK(const_frame.column<Vector3D>("force").value()[0] == Vector3D(1, 2, 3));
+
+    auto clone = frame.clone();
+    clone.column<double>("charge").value()[0] = 42;
+    CHECK(frame.column<double>("charge").value()[0] == 2);
+
+    frame.resize(10);
+    CHECK(frame.column<Vector3D>("force")->size() == 10);
+    CHECK(frame.column<Vector3D>("force").value()[9] == Vector3D());
+
+    frame.remove_column("charge");
+    frame.remove_column("not there");
+    CHECK(frame.columns() == std::vector<std::string>{"force"});
+}
+
 TEST_CASE("Frame step") {
     auto frame = Frame();
     CHECK(frame.step() == 0);
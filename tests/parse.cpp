@@ -1,14 +1,18 @@
 // Chemfiles, a modern library for chemistry file reading and writing
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
 #include <catch.hpp>
 
 #include "chemfiles/parse.hpp"
 #include "chemfiles/Error.hpp"
 
-static bool relative_eq(double a, double b) {
-    return fabs((b - a) / a) < 1e-14;
-}
-
 TEST_CASE("String parsing") {
     SECTION("Double") {
         CHECK(chemfiles::parse<double>("12.5") == 12.5);
@@ -37,15 +41,29 @@ TEST_CASE("String parsing") {
         CHECK(chemfiles::parse<double>("+0.0") == 0.0);
         CHECK(chemfiles::parse<double>("-0.0") == 0.0);
 
-        // Some float are not parsed exactly, but up to a 1e-14 RELATIVE error
-        // which is good enough for our purposes
-        CHECK(relative_eq(chemfiles::parse<double>("1.97576e0"), 1.97576e0));
-        CHECK(relative_eq(chemfiles::parse<double>("2.27e-308"), 2.27e-308));
-        CHECK(relative_eq(chemfiles::parse<double>("1.15507e-173"), 1.15507e-173));
-        CHECK(relative_eq(
-            chemfiles::parse<double>("0.000000000000000000000000000000000000783475"),
-            0.000000000000000000000000000000000000783475
-        ));
+        // Parsing is correctly rounded
+        CHECK(chemfiles::parse<double>("1.97576e0") == 1.97576e0);
+        CHECK(chemfiles::parse<double>("2.27e-308") == 2.27e-308);
+        CHECK(chemfiles::parse<double>("1.15507e-173") == 1.15507e-173);
+        CHECK(chemfiles::parse<double>("0.000000000000000000000000000000000000783475") == 0.000000000000000000000000000000000000783475);
+        CHECK(chemfiles::parse<double>("3.14159265358979323846264338327950288") == 3.14159265358979323846264338327950288);
+        CHECK(chemfiles::parse<double>("123456789012345678901234567890") == 123456789012345678901234567890.0);
+        CHECK(chemfiles::parse<double>("1.7976931348623157e308") == 1.7976931348623157e308);
+        CHECK(chemfiles::parse<double>("2.2250738585072014e-308") == 2.2250738585072014e-308);
+        CHECK(chemfiles::parse<double>("9007199254740993") == 9007199254740993.0);
+        CHECK(chemfiles::parse<double>("0.1000000000000000055511151231257827") == 0.1);
+        CHECK(chemfiles::parse<double>("   -12345678.87654321e-5 ") == -12345678.87654321e-5);
+
+        // Fixed width columns
+        CHECK(chemfiles::parse<double>("  12.345") == 12.345);
+        CHECK(chemfiles::parse<double>(" -12.345") == -12.345);
+        CHECK(chemfiles::parse<double>("-0.00000") == 0.0);
+        CHECK(std::signbit(chemfiles::parse<double>("-0.000")));
+        CHECK(chemfiles::parse<double>("   1.10000\n") == 1.1);
+        CHECK(chemfiles::parse<double>("123456789.012345") == 123456789.012345);
+        // too many digits for the fixed point fast path
+        CHECK(chemfiles::parse<double>("1234567890.123456") == 1234567890.123456);
+        CHECK(chemfiles::parse<double>("0.1234567890123456789") == 0.1234567890123456789);
 
         CHECK_THROWS_WITH(
             chemfiles::parse<double>(""),
@@ -67,6 +85,14 @@ TEST_CASE("String parsing") {
             chemfiles::parse<double>("."),
             "can not parse '.' as a double"
         );
+        CHECK_THROWS_WITH(
+            chemfiles::parse<double>("-."),
+            "can not parse '-.' as a double"
+        );
+        CHECK_THROWS_WITH(
+            chemfiles::parse<double>("--1.5"),
+            "can not parse '--1.5' as a double"
+        );
 
         auto BAD = {
             "nan", "NaN", "nan(0xfff)",
@@ -393,3 +419,50 @@ TEST_CASE("hybrid encode and decode") {
         "the length of '12345' is greater than the width '2', this is a bug in chemfiles"
     );
 }
+
+// This is a benchmark for the parsing of doubles, hidden by default. Run it
+// with `parse "[.benchmark]"`
+TEST_CASE("Parsing doubles", "[.benchmark]") {
+    const size_t count = 1000000;
+    auto generator = std::mt19937(42);
+    auto distribution = std::uniform_real_distribution<double>(-999, 9999);
+
+    auto generate = [&](const char* format) {
+        auto values = std::vector<std::string>();
+        char buffer[64];
+        for (size_t i = 0; i < count; i++) {
+            std::snprintf(buffer, sizeof(buffer), format, distribution(generator));
+            values.emplace_back(buffer);
+        }
+        return values;
+    };
+
+    auto measure = [&](const std::vector<std::string>& values, bool use_strtod) {
+        double sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& value: values) {
+            if (use_strtod) {
+                sum += std::strtod(value.c_str(), nullptr);
+            } else {
+                sum += chemfiles::parse<double>(value);
+            }
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+        CHECK(std::isfinite(sum));
+        return elapsed.count() / static_cast<double>(values.size());
+    };
+
+    // the same values are parsed with the fixed point fast path, and with
+    // the general path thanks to the exponent
+    for (auto format: {"%8.3f", "%10.5f"}) {
+        auto fixed = generate(format);
+        auto general = fixed;
+        for (auto& value: general) {
+            value += "e0";
+        }
+
+        WARN(format << ": fixed point " << measure(fixed, false) << " ns/value, "
+             << "general " << measure(general, false) << " ns/value, "
+             << "strtod " << measure(fixed, true) << " ns/value");
+    }
+}
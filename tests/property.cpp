@@ -1,6 +1,8 @@
 // Chemfiles, a modern library for chemistry file reading and writing
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
 
+#include <algorithm>
+
 #include <catch.hpp>
 #include "helpers.hpp"
 #include "chemfiles/Property.hpp"
@@ -169,3 +171,62 @@ TEST_CASE("Property map") {
     }
     CHECK(properties_names == std::vector<std::string>{"bar", "foo"});
 }
+
+TEST_CASE("Property map storage") {
+    auto names = std::vector<std::string>{
+        "e", "c", "a", "a rather long property name, which allocates", "d", "b"
+    };
+
+    // an empty map is a single pointer
+    CHECK(sizeof(property_map) == sizeof(void*));
+
+    auto map = property_map();
+    CHECK(map.size() == 0);
+    CHECK(map.begin() == map.end());
+    CHECK_FALSE(map.get("a"));
+
+    for (size_t i = 0; i < names.size(); i++) {
+        map.set(names[i], static_cast<double>(i));
+
+        // copies and moves work with any number of properties
+        auto copy = map;
+        CHECK(copy == map);
+        CHECK(copy.size() == i + 1);
+
+        auto moved = std::move(copy);
+        CHECK(moved == map);
+        CHECK(copy.size() == 0); // NOLINT: use after move is fine here
+
+        copy = moved;
+        CHECK(copy == map);
+
+        moved = property_map();
+        CHECK(moved.size() == 0);
+        CHECK(moved != map);
+    }
+
+    CHECK(map.size() == 6);
+    auto sorted = std::vector<std::string>();
+    for (const auto& it: map) {
+        sorted.push_back(it.first);
+        CHECK(it.second.as_double() == static_cast<double>(
+            std::find(names.begin(), names.end(), it.first) - names.begin()
+        ));
+    }
+    CHECK(std::is_sorted(sorted.begin(), sorted.end()));
+
+    // replacing existing values does not change the size
+    map.set("c", "a long string value, which needs to be allocated");
+    map.set("e", Vector3D(1, 2, 3));
+    CHECK(map.size() == 6);
+    CHECK(map.get<Property::STRING>("c").value() == "a long string value, which needs to be allocated");
+    CHECK(map.get<Property::VECTOR3D>("e").value() == Vector3D(1, 2, 3));
+
+    auto single = property_map();
+    single.set("foo", "bar");
+    single.set("foo", false);
+    CHECK(single.size() == 1);
+    map = single;
+    CHECK(map.size() == 1);
+    CHECK(map.get<Property::BOOL>("foo").value() == false);
+}
@@ -39,6 +39,19 @@ TEST_CASE("Residue class usage") {
         CHECK(atoms == expected);
 
         CHECK(residue.contains(56));
+        CHECK_FALSE(residue.contains(29));
+        CHECK_FALSE(residue.contains(57));
+
+        // contiguous residues
+        residue = Residue("ALA");
+        CHECK_FALSE(residue.contains(0));
+        residue.add_atom(3);
+        residue.add_atom(4);
+        residue.add_atom(5);
+        CHECK(residue.contains(3));
+        CHECK(residue.contains(5));
+        CHECK_FALSE(residue.contains(2));
+        CHECK_FALSE(residue.contains(6));
     }
 
     SECTION("Properties") {
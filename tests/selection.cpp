@@ -117,6 +117,11 @@ TEST_CASE("Atoms selections") {
         selection = Selection("z >= 10");
         expected = std::vector<size_t>{};
         CHECK(selection.list(frame) == expected);
+
+        frame.set_single_precision(true);
+        selection = Selection("y != 2");
+        expected = std::vector<size_t>{0, 2, 3};
+        CHECK(selection.list(frame) == expected);
     }
 
     SECTION("velocities") {
@@ -143,6 +148,11 @@ TEST_CASE("Atoms selections") {
         selection = Selection("vy >= 10");
         expected = std::vector<size_t>{};
         CHECK(selection.list(frame) == expected);
+
+        frame.set_single_precision(true);
+        selection = Selection("vx != 2");
+        expected = std::vector<size_t>{0, 2, 3};
+        CHECK(selection.list(frame) == expected);
     }
 
     SECTION("is_bonded") {
@@ -483,6 +493,17 @@ TEST_CASE("Multiple selections") {
 
         selection = Selection("[numeric2] > 3");
         CHECK(selection.list(frame) == std::vector<size_t>{2ul});
+
+        // per-atom columns are used for numeric properties
+        auto column = frame.add_column<double>("column");
+        column[1] = 2.5;
+        column[3] = -1;
+        selection = Selection("[column] > 0");
+        CHECK(selection.list(frame) == std::vector<size_t>{1ul});
+
+        frame.add_column<double>("numeric")[1] = 3;
+        selection = Selection("[numeric] == 3");
+        CHECK(selection.list(frame) == (std::vector<size_t>{0ul, 1ul}));
     }
 }
 
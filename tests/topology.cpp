@@ -1,6 +1,8 @@
 // Chemfiles, a modern library for chemistry file reading and writing
 // Copyright (C) Guillaume Fraux and contributors -- BSD license
 
+#include <algorithm>
+
 #include <catch.hpp>
 #include "chemfiles.hpp"
 using namespace chemfiles;
@@ -183,6 +185,41 @@ TEST_CASE("Connectivity detection") {
         impropers.push_back({12, 19, 16, 18});
         CHECK(topology.impropers() == impropers);
     }
+
+    SECTION("Large systems") {
+        // a branched polymer, with enough bonds to use multiple threads
+        auto topology = Topology();
+        topology.resize(30000);
+        auto bonds = std::vector<Bond>();
+        for (size_t i=0; i<10000; i++) {
+            // backbone
+            if (i != 0) {
+                bonds.emplace_back(3 * i - 3, 3 * i);
+            }
+            // side chain
+            bonds.emplace_back(3 * i, 3 * i + 1);
+            bonds.emplace_back(3 * i + 1, 3 * i + 2);
+        }
+        topology.add_bonds(bonds);
+
+        const auto& angles = topology.angles();
+        CHECK(angles.size() == 39996);
+        CHECK(std::is_sorted(angles.begin(), angles.end()));
+        CHECK(std::adjacent_find(angles.begin(), angles.end()) == angles.end());
+        CHECK(angles[0] == Angle(0, 1, 2));
+        CHECK(angles[1] == Angle(0, 3, 4));
+        CHECK(angles[2] == Angle(0, 3, 6));
+        CHECK(angles[3] == Angle(1, 0, 3));
+
+        const auto& dihedrals = topology.dihedrals();
+        CHECK(dihedrals.size() == 59990);
+        CHECK(std::is_sorted(dihedrals.begin(), dihedrals.end()));
+        CHECK(std::adjacent_find(dihedrals.begin(), dihedrals.end()) == dihedrals.end());
+
+        const auto& impropers = topology.impropers();
+        CHECK(impropers.size() == 9998);
+        CHECK(impropers[0] == Improper(0, 3, 4, 6));
+    }
 }
 
 TEST_CASE("Out of bounds errors") {
@@ -197,6 +234,7 @@ TEST_CASE("Out of bounds errors") {
 
     CHECK_THROWS_AS(topology.add_bond(0, 25), OutOfBounds);
     CHECK_THROWS_AS(topology.add_bond(25, 0), OutOfBounds);
+    CHECK_THROWS_AS(topology.add_bonds(std::vector<Bond>{{0, 1}, {0, 25}}), OutOfBounds);
 
     CHECK_THROWS_AS(topology.remove_bond(0, 25), OutOfBounds);
     CHECK_THROWS_AS(topology.remove_bond(25, 0), OutOfBounds);
@@ -283,6 +321,48 @@ TEST_CASE("Add and remove items in the topology") {
         CHECK(topology.bonds() == (std::vector<Bond>{{1, 2}}));
         CHECK(topology.bond_orders()[0] == Bond::DOUBLE);
     }
+
+    SECTION("Multiple bonds") {
+        auto topology = Topology();
+        for (unsigned i=0; i<6; i++) {
+            topology.add_atom(Atom(""));
+        }
+
+        topology.add_bond(1, 2, Bond::DOUBLE);
+        topology.add_bond(4, 5, Bond::SINGLE);
+
+        auto bonds = std::vector<Bond>{{3, 4}, {0, 1}, {2, 1}, {4, 3}, {2, 3}};
+        auto orders = std::vector<Bond::BondOrder>{
+            Bond::TRIPLE, Bond::SINGLE, Bond::AROMATIC, Bond::SINGLE, Bond::UNKNOWN
+        };
+        topology.add_bonds(bonds, orders);
+
+        CHECK(topology.bonds() == (std::vector<Bond>{{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}}));
+        // existing bonds and the first duplicated bond keep their bond order
+        CHECK(topology.bond_orders() == (std::vector<Bond::BondOrder>{
+            Bond::SINGLE, Bond::DOUBLE, Bond::UNKNOWN, Bond::TRIPLE, Bond::SINGLE
+        }));
+        CHECK(topology.angles() == (std::vector<Angle>{{0, 1, 2}, {1, 2, 3}, {2, 3, 4}, {3, 4, 5}}));
+        CHECK(topology.dihedrals() == (std::vector<Dihedral>{{0, 1, 2, 3}, {1, 2, 3, 4}, {2, 3, 4, 5}}));
+
+        topology.add_atom(Atom(""));
+        topology.add_bonds(std::vector<Bond>{{5, 6}});
+        CHECK(topology.bonds().size() == 6);
+        CHECK(topology.bond_orders()[5] == Bond::UNKNOWN);
+        CHECK(topology.angles().size() == 5);
+
+        // removing atoms keep the bonds sorted
+        topology.remove_bond(0, 1);
+        topology.remove(0);
+        CHECK(topology.bonds() == (std::vector<Bond>{{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}}));
+        CHECK(topology.bond_orders()[0] == Bond::DOUBLE);
+        CHECK(topology.angles().size() == 4);
+
+        CHECK_THROWS_WITH(
+            topology.add_bonds(std::vector<Bond>{{0, 1}, {1, 2}}, std::vector<Bond::BondOrder>{Bond::SINGLE}),
+            "mismatched sizes in `Connectivity::add_bonds`: got 2 bonds and 1 bond orders"
+        );
+    }
 }
 
 TEST_CASE("Residues in topologies") {
@@ -330,4 +410,174 @@ TEST_CASE("Residues in topologies") {
     CHECK(all_residues[1].contains(8));
     CHECK(!all_residues[1].contains(9));
     CHECK(all_residues[2].size() == 2); // Totally removed
+
+    // the atom to residue mapping is also updated
+    CHECK(topology.residue_for_atom(8)->contains(8));
+    CHECK(topology.residue_for_atom(8)->size() == 3);
+    CHECK(topology.residue_for_atom(5)->size() == 2);
+    CHECK_FALSE(topology.residue_for_atom(7));
+
+    // atoms after the end of the topology do not allocate memory for all the
+    // atoms before them
+    auto huge = size_t(1) << 40;
+    residue = Residue("Y");
+    residue.add_atom(7);
+    residue.add_atom(12);
+    residue.add_atom(huge);
+    topology.add_residue(residue);
+    CHECK(topology.residue_for_atom(7)->name() == "Y");
+    CHECK(topology.residue_for_atom(12)->name() == "Y");
+    CHECK(topology.residue_for_atom(huge)->name() == "Y");
+    CHECK_FALSE(topology.residue_for_atom(huge - 1));
+
+    residue = Residue("Z");
+    residue.add_atom(huge);
+    CHECK_THROWS_WITH(topology.add_residue(residue),
+        "can not add this residue: atom 1099511627776 is already in another residue"
+    );
+
+    // atoms added to the topology later keep their residue
+    topology.resize(20);
+    residue = Residue("Z");
+    residue.add_atom(15);
+    topology.add_residue(residue);
+    CHECK(topology.residue_for_atom(12)->name() == "Y");
+    CHECK(topology.residue_for_atom(15)->name() == "Z");
+    CHECK_FALSE(topology.residue_for_atom(13));
+
+    residue = Residue("Z");
+    residue.add_atom(12);
+    CHECK_THROWS_AS(topology.add_residue(residue), Error);
+}
+
+TEST_CASE("Remove multiple atoms and extract subsets") {
+    auto topology = Topology();
+    for (auto name: {"C", "H", "H", "O", "N", "H", "C"}) {
+        topology.add_atom(Atom(name));
+    }
+    topology.add_bond(0, 1, Bond::SINGLE);
+    topology.add_bond(0, 2, Bond::SINGLE);
+    topology.add_bond(0, 3, Bond::DOUBLE);
+    topology.add_bond(3, 4, Bond::SINGLE);
+    topology.add_bond(4, 5, Bond::SINGLE);
+    topology.add_bond(4, 6, Bond::TRIPLE);
+
+    auto residue = Residue("A", 1);
+    residue.add_atom(0);
+    residue.add_atom(1);
+    residue.add_atom(2);
+    residue.set("foo", "bar");
+    topology.add_residue(residue);
+
+    residue = Residue("B", 2);
+    residue.add_atom(4);
+    residue.add_atom(5);
+    residue.add_atom(6);
+    topology.add_residue(residue);
+
+    SECTION("Remove") {
+        topology.remove(std::vector<size_t>{5, 1, 3, 1});
+        REQUIRE(topology.size() == 4);
+        CHECK(topology[0].name() == "C");
+        CHECK(topology[1].name() == "H");
+        CHECK(topology[2].name() == "N");
+        CHECK(topology[3].name() == "C");
+
+        CHECK(topology.bonds() == (std::vector<Bond>{{0, 1}, {2, 3}}));
+        CHECK(topology.bond_orders() == (std::vector<Bond::BondOrder>{Bond::SINGLE, Bond::TRIPLE}));
+
+        REQUIRE(topology.residues().size() == 2);
+        CHECK(topology.residue(0).size() == 2);
+        CHECK(topology.residue(0).contains(0));
+        CHECK(topology.residue(0).contains(1));
+        CHECK(topology.residue(1).size() == 2);
+        CHECK(topology.residue(1).contains(2));
+        CHECK(topology.residue(1).contains(3));
+        CHECK(topology.residue_for_atom(3)->name() == "B");
+
+        // removing all atoms from a residue keeps it
+        topology.remove(std::vector<size_t>{2, 3});
+        CHECK(topology.residues().size() == 2);
+        CHECK(topology.residue(1).size() == 0);
+
+        CHECK_THROWS_WITH(
+            topology.remove(std::vector<size_t>{0, 10}),
+            "out of bounds atomic index in `Topology::remove`: we have 2 atoms, but the index is 10"
+        );
+        CHECK(topology.size() == 2);
+    }
+
+    SECTION("Subset") {
+        auto subset = topology.subset({6, 4, 0, 1, 3});
+        REQUIRE(subset.size() == 5);
+        CHECK(subset[0].name() == "C");
+        CHECK(subset[1].name() == "N");
+        CHECK(subset[2].name() == "C");
+        CHECK(subset[3].name() == "H");
+        CHECK(subset[4].name() == "O");
+
+        CHECK(subset.bonds() == (std::vector<Bond>{{0, 1}, {1, 4}, {2, 3}, {2, 4}}));
+        CHECK(subset.bond_orders() == (std::vector<Bond::BondOrder>{
+            Bond::TRIPLE, Bond::SINGLE, Bond::SINGLE, Bond::DOUBLE
+        }));
+
+        REQUIRE(subset.residues().size() == 2);
+        CHECK(subset.residue(0).name() == "A");
+        CHECK(subset.residue(0).id().value() == 1);
+        CHECK(subset.residue(0).get("foo")->as_string() == "bar");
+        CHECK(subset.residue(0).size() == 2);
+        CHECK(subset.residue(0).contains(2));
+        CHECK(subset.residue(0).contains(3));
+        CHECK(subset.residue(1).name() == "B");
+        CHECK(subset.residue(1).size() == 2);
+        CHECK(subset.residue(1).contains(0));
+        CHECK(subset.residue(1).contains(1));
+        CHECK_FALSE(subset.residue_for_atom(4));
+
+        // residues without any atom in the subset are not included
+        subset = topology.subset({3});
+        CHECK(subset.residues().empty());
+        CHECK(subset.bonds().empty());
+
+        // the initial topology is not modified
+        CHECK(topology.size() == 7);
+
+        CHECK_THROWS_WITH(
+            topology.subset({0, 10}),
+            "out of bounds atomic index in `Topology::subset`: we have 7 atoms, but the index is 10"
+        );
+        CHECK_THROWS_WITH(
+            topology.subset({0, 3, 0}),
+            "invalid indexes in `Topology::subset`: atom 0 is present multiple times"
+        );
+    }
+
+    SECTION("Residues with atoms outside of the topology") {
+        // residues can contain atoms which are not (yet) in the topology,
+        // these are shifted to stay after the end of the topology
+        topology = Topology();
+        for (size_t i = 0; i < 5; i++) {
+            topology.add_atom(Atom("X"));
+        }
+        residue = Residue("C");
+        residue.add_atom(3);
+        residue.add_atom(9);
+        topology.add_residue(residue);
+
+        topology.remove(0);
+        REQUIRE(topology.residue(0).size() == 2);
+        CHECK(topology.residue(0).contains(2));
+        CHECK(topology.residue(0).contains(8));
+        CHECK(topology.residue_for_atom(8)->name() == "C");
+
+        topology.remove(std::vector<size_t>{0, 1});
+        REQUIRE(topology.residue(0).size() == 2);
+        CHECK(topology.residue(0).contains(0));
+        CHECK(topology.residue(0).contains(6));
+
+        auto subset = topology.subset({1, 0});
+        REQUIRE(subset.residues().size() == 1);
+        CHECK(subset.residue(0).contains(1));
+        CHECK(subset.residue(0).contains(6));
+    }
 }
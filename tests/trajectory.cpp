@@ -153,6 +153,153 @@ TEST_CASE("Associate an unit cell and a trajectory") {
     }
 }
 
+static void write_subset_test_file(const std::string& path) {
+    auto file = Trajectory(path, 'w');
+    for (size_t step = 0; step < 2; step++) {
+        auto frame = Frame(UnitCell({10, 10, 10}));
+        for (size_t i = 0; i < 6; i++) {
+            auto value = static_cast<double>(i + 10 * step);
+            frame.add_atom(Atom(i % 3 == 0 ? "O" : "H"), {value, 0, 1});
+        }
+        file.write(frame);
+    }
+}
+
+TEST_CASE("Reading a subset of atoms") {
+    auto topology = Topology();
+    auto residue = Residue("WAT", 1);
+    for (size_t i = 0; i < 6; i++) {
+        topology.add_atom(Atom(i % 3 == 0 ? "O" : "H"));
+        residue.add_atom(i);
+    }
+    topology.add_residue(residue);
+    topology.add_bond(0, 1);
+    topology.add_bond(0, 2);
+    topology.add_bond(3, 4, Bond::SINGLE);
+    topology.add_bond(3, 5);
+
+    auto check_subset = [](const Frame& frame, size_t step) {
+        auto offset = static_cast<double>(10 * step);
+        REQUIRE(frame.size() == 3);
+        CHECK(approx_eq(frame.positions()[0], {offset + 1, 0, 1}, 1e-4));
+        CHECK(approx_eq(frame.positions()[1], {offset + 3, 0, 1}, 1e-4));
+        CHECK(approx_eq(frame.positions()[2], {offset + 4, 0, 1}, 1e-4));
+        CHECK(approx_eq(frame.cell().lengths(), {10, 10, 10}, 1e-4));
+    };
+
+    for (auto extension: {".xtc", ".trr", ".nc", ".xyz"}) {
+        auto tmpfile = NamedTempPath(extension);
+        write_subset_test_file(tmpfile);
+
+        auto file = Trajectory(tmpfile);
+        file.set_topology(topology);
+        file.set_atom_subset(std::vector<size_t>{4, 1, 3, 4});
+
+        auto frame = file.read();
+        check_subset(frame, 0);
+        CHECK(frame[0].name() == "H");
+        CHECK(frame[1].name() == "O");
+        CHECK(frame.topology().bonds() == std::vector<Bond>{{1, 2}});
+        CHECK(frame.topology().bond_order(1, 2) == Bond::SINGLE);
+        REQUIRE(frame.topology().residues().size() == 1);
+        CHECK(frame.topology().residues()[0].size() == 3);
+        CHECK(frame.topology().residues()[0].id().value() == 1);
+
+        check_subset(file.read_step(1), 1);
+        check_subset(file.read_step(0), 0);
+
+        // reading all atoms again
+        file.set_atom_subset(std::vector<size_t>());
+        CHECK(file.read_step(1).size() == 6);
+    }
+
+    SECTION("Using a selection") {
+        auto tmpfile = NamedTempPath(".xtc");
+        write_subset_test_file(tmpfile);
+
+        auto file = Trajectory(tmpfile);
+        file.set_topology(topology);
+        file.set_atom_subset(Selection("index 1 or index 3 or index 4"));
+        check_subset(file.read(), 0);
+        check_subset(file.read(), 1);
+
+        file.set_atom_subset(Selection("name Zn"));
+        CHECK_THROWS_AS(file.read_step(0), SelectionError);
+        CHECK_THROWS_AS(file.set_atom_subset(Selection("pairs: all")), SelectionError);
+    }
+
+    SECTION("Errors") {
+        auto tmpfile = NamedTempPath(".xtc");
+        write_subset_test_file(tmpfile);
+
+        auto file = Trajectory(tmpfile);
+        CHECK_THROWS_AS(file.set_atom_subset(std::vector<size_t>{2, 6}), FormatError);
+
+        file.set_topology(topology);
+        CHECK_THROWS_AS(file.set_atom_subset(std::vector<size_t>{2, 8}), OutOfBounds);
+
+        file.set_atom_subset(std::vector<size_t>{2, 5});
+        auto small = Topology();
+        small.resize(3);
+        CHECK_THROWS_AS(file.set_topology(small), OutOfBounds);
+
+        auto xyz_tmpfile = NamedTempPath(".xyz");
+        write_subset_test_file(xyz_tmpfile);
+        file = Trajectory(xyz_tmpfile);
+        file.set_atom_subset(std::vector<size_t>{2, 6});
+        CHECK_THROWS_AS(file.read(), OutOfBounds);
+    }
+}
+
+TEST_CASE("Reading frames in single precision") {
+    for (auto extension: {".xtc", ".trr", ".nc", ".xyz"}) {
+        auto tmpfile = NamedTempPath(extension);
+        write_subset_test_file(tmpfile);
+
+        auto file = Trajectory(tmpfile);
+        file.set_single_precision(true);
+
+        auto frame = file.read();
+        CHECK(frame.single_precision());
+        REQUIRE(frame.size() == 6);
+        CHECK(frame.positions_f32()[4] == (Vector3F{{4, 0, 1}}));
+        CHECK(frame.cell().lengths() == Vector3D(10, 10, 10));
+
+        file.set_atom_subset(std::vector<size_t>{1, 5});
+        frame = file.read_step(1);
+        CHECK(frame.single_precision());
+        REQUIRE(frame.size() == 2);
+        CHECK(frame.positions_f32()[0] == (Vector3F{{11, 0, 1}}));
+        CHECK(frame.positions_f32()[1] == (Vector3F{{15, 0, 1}}));
+
+        file.set_single_precision(false);
+        frame = file.read_step(0);
+        CHECK_FALSE(frame.single_precision());
+        CHECK(approx_eq(frame.positions()[1], {5, 0, 1}, 1e-4));
+    }
+}
+
+TEST_CASE("Writing frames in single precision") {
+    auto frame = Frame();
+    frame.add_atom(Atom("H"), {1, 2, 3}, {0, 0, 1});
+    frame.add_atom(Atom("O"), {4, 5, 6}, {0, 1, 0});
+    frame.set_single_precision(true);
+
+    // XYZ writer needs a double precision copy of the frame, XTC uses the
+    // single precision data directly
+    for (auto extension: {".xyz", ".xtc"}) {
+        auto tmpfile = NamedTempPath(extension);
+        {
+            auto file = Trajectory(tmpfile, 'w');
+            file.write(frame);
+        }
+        CHECK(frame.single_precision());
+
+        auto read = Trajectory(tmpfile).read();
+        CHECK(approx_eq(read.positions()[1], {4, 5, 6}, 1e-4));
+    }
+}
+
 TEST_CASE("Specify a format parameter") {
     auto file = Trajectory("data/xyz/helium.xyz.but.not.really", 'r', "XYZ");
     auto frame = file.read();
@@ -266,6 +413,70 @@ TEST_CASE("reading a files from multiple threads") {
     read_from_multiple_threads("data/netcdf/water.nc", 297);
 }
 
+static std::string write_frames(const std::string& format, size_t threads) {
+    auto file = Trajectory::memory_writer(format);
+    file.set_write_threads(threads);
+    for (size_t step = 0; step < 50; step++) {
+        auto frame = Frame(UnitCell({10, 11, 12}));
+        frame.set_step(step);
+        for (size_t i = 0; i < 100; i++) {
+            auto value = static_cast<double>(step * 100 + i);
+            frame.add_atom(Atom("C"), {value, 0.5 * value, 0.25 * value});
+        }
+        file.write(frame);
+    }
+
+    auto buffer = file.memory_buffer().value();
+    return std::string(buffer.data(), buffer.size());
+}
+
+TEST_CASE("Writing frames from multiple threads") {
+    SECTION("Supported formats") {
+        for (auto format: {"XYZ", "GRO", "SDF", "Tinker"}) {
+            auto expected = write_frames(format, 1);
+            CHECK(write_frames(format, 2) == expected);
+            CHECK(write_frames(format, 4) == expected);
+        }
+    }
+
+    SECTION("Unsupported formats write sequentially") {
+        auto expected = write_frames("PDB", 1);
+        CHECK(write_frames("PDB", 4) == expected);
+    }
+
+    SECTION("Files") {
+        auto tmpfile = NamedTempPath(".xyz");
+        auto file = Trajectory(tmpfile, 'w');
+        file.set_write_threads(3);
+        auto topology = Topology();
+        for (size_t i = 0; i < 10; i++) {
+            topology.add_atom(Atom("Zn"));
+        }
+        file.set_topology(topology);
+
+        for (size_t step = 0; step < 20; step++) {
+            auto frame = Frame();
+            frame.resize(10);
+            frame.positions()[0] = Vector3D(static_cast<double>(step), 0, 0);
+            file.write(frame);
+        }
+        CHECK(file.nsteps() == 20);
+        file.close();
+
+        file = Trajectory(tmpfile, 'r');
+        REQUIRE(file.nsteps() == 20);
+        for (size_t step = 0; step < 20; step++) {
+            auto frame = file.read();
+            CHECK(frame[0].name() == "Zn");
+            CHECK(frame.positions()[0] == Vector3D(static_cast<double>(step), 0, 0));
+        }
+
+        CHECK_THROWS_WITH(file.set_write_threads(4),
+            "the file at '" + tmpfile.path() + "' was not opened in write or append mode"
+        );
+    }
+}
+
 #endif
 
 TEST_CASE("Errors") {
@@ -129,3 +129,23 @@ TEST_CASE("split") {
     expected = std::vector<chemfiles::string_view>{"bla  bla", " jk:fiuks"};
     CHECK(chemfiles::split(",,bla  bla, jk:fiuks", ',') == expected);
 }
+
+TEST_CASE("FieldSplitter") {
+    auto splitter = chemfiles::FieldSplitter();
+    CHECK(splitter.split("  bla bla\t  foo,bar \r\n") == 3);
+    CHECK(splitter.size() == 3);
+    CHECK(splitter[0] == "bla");
+    CHECK(splitter[1] == "bla");
+    CHECK(splitter[2] == "foo,bar");
+
+    auto expected = std::vector<chemfiles::string_view>{"1", "-2.5", "a"};
+    CHECK(splitter.split("1 -2.5 a") == 3);
+    CHECK(std::vector<chemfiles::string_view>(splitter.begin(), splitter.end()) == expected);
+
+    CHECK(splitter.split("") == 0);
+    CHECK(splitter.split(" \t  ") == 0);
+    CHECK(splitter.size() == 0);
+
+    CHECK(splitter.split("single") == 1);
+    CHECK(splitter[0] == "single");
+}